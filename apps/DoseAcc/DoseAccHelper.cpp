@@ -22,6 +22,7 @@
 #include "rttbExceptionMacros.h"
 
 #include "rttbITKImageAccessorConverter.h"
+#include "rttbCachedDoseAccessor.h"
 #include "rttbSimpleMappableDoseAccessor.h"
 #include "rttbMatchPointTransformation.h"
 #include "rttbLinearInterpolation.h"
@@ -151,6 +152,8 @@ rttb::apps::doseAcc::processData(rttb::apps::doseAcc::ApplicationData& appData)
 	            appData);
 
 	std::cout << std::endl << "generate output image... ";
+	//evaluate the (mapped) dose pipeline once, in parallel slabs
+	outputAccessor = boost::make_shared<rttb::core::CachedDoseAccessor>(outputAccessor);
 	io::itk::ITKImageAccessorConverter converter(outputAccessor);
 	converter.setFailOnInvalidIDs(true);
 	converter.process();
@@ -20,6 +20,7 @@
 #include "mapRegistrationFileReader.h"
 
 #include "rttbITKImageAccessorConverter.h"
+#include "rttbCachedDoseAccessor.h"
 #include "rttbSimpleMappableDoseAccessor.h"
 #include "rttbMatchPointTransformation.h"
 #include "rttbLinearInterpolation.h"
@@ -99,6 +100,8 @@ rttb::apps::doseMap::processData(rttb::apps::doseMap::ApplicationData& appData)
 	            appData);
 
 	std::cout << std::endl << "generate output image... ";
+	//evaluate the (mapped) dose pipeline once, in parallel slabs
+	outputAccessor = boost::make_shared<rttb::core::CachedDoseAccessor>(outputAccessor);
 	io::itk::ITKImageAccessorConverter converter(outputAccessor);
 	converter.setFailOnInvalidIDs(true);
 	converter.process();
@@ -27,9 +27,10 @@
 #include "rttbDoseStatistics.h"
 #include "rttbDVH.h"
 #include "rttbDVHCalculator.h"
+#include "rttbMultiStructureDVHCalculator.h"
 #include "rttbDVHXMLFileWriter.h"
 #include "rttbDoseStatisticsCalculator.h"
-#include "rttbBoostMaskAccessor.h"
+#include "rttbStructureSetVoxelizer.h"
 #include "rttbGenericMaskedDoseIterator.h"
 #include "rttbDoseStatisticsXMLWriter.h"
 
@@ -55,11 +56,16 @@ rttb::apps::doseTool::generateMasks(
 
 			 bool strict = !appData._allowSelfIntersection;
 
+			std::vector<size_t> structureIndices;
+
 			for (size_t i = 0; i < maxIterationCount; i++) {
-				maskAccessorPtrVector.emplace_back(boost::make_shared<rttb::masks::boost::BoostMaskAccessor>(appData._struct->getStructure(i), appData._dose->getGeometricInfo(), strict));
-				maskAccessorPtrVector.at(i)->updateMask();
+				structureIndices.push_back(i);
 				appData._structNames.push_back(appData._struct->getStructure(i)->getLabel());
 			}
+
+			//all structures are voxelized concurrently
+			rttb::masks::boost::StructureSetVoxelizer voxelizer(appData._struct, appData._dose->getGeometricInfo(), strict);
+			maskAccessorPtrVector = voxelizer.voxelize(structureIndices);
 		} else {
 			std::cout << "no structures in structure set!" << std::endl;
 		}
@@ -81,11 +87,9 @@ rttb::apps::doseTool::generateMaskedDoseIterator(
 
 rttb::algorithms::DoseStatistics::Pointer
 calculateDoseStatistics(
-    rttb::core::DoseIteratorInterface::Pointer doseIterator, bool calculateComplexDoseStatistics,
+    rttb::algorithms::DoseStatisticsCalculator& doseStatsCalculator, bool calculateComplexDoseStatistics,
     rttb::DoseTypeGy prescribedDose)
 {
-	rttb::algorithms::DoseStatisticsCalculator doseStatsCalculator(doseIterator);
-
 	if (calculateComplexDoseStatistics) {
 		return doseStatsCalculator.calculateDoseStatistics(prescribedDose);
 	} else {
@@ -152,15 +156,44 @@ void rttb::apps::doseTool::processData(rttb::apps::doseTool::ApplicationData& ap
         appData);
     std::cout << "done." << std::endl;
 
+    rttb::IDType structUID;
+    rttb::IDType doseUID;
+
+    if (appData._computeDVH) {
+        //Generate random UID
+        if (appData._structLoadStyle == "itk") {
+            structUID = "struct.fromVoxelizedITK";
+            doseUID = "dose.fromVoxelizedITK";
+        } else {
+            structUID = appData._struct->getUID();
+            doseUID = appData._dose->getUID();
+        }
+    }
+
+    //without dose statistics, the DVHs of several structures are computed together with one pass over the dose
+    core::MultiStructureDVHCalculator::DVHListType dvhs;
+
+    if (appData._computeDVH && !appData._computeDoseStatistics && maskAccessorPtrVector.size() > 1) {
+        std::cout << std::endl << "computing DVHs... ";
+        core::MultiStructureDVHCalculator calc(appData._dose, maskAccessorPtrVector,
+            std::vector<rttb::IDType>(maskAccessorPtrVector.size(), structUID), doseUID, 0, 201, true);
+        dvhs = calc.generateDVHs();
+        std::cout << "done." << std::endl;
+    }
+
     for (size_t i = 0; i < maskAccessorPtrVector.size(); i++) {
         core::DoseIteratorInterface::Pointer spDoseIterator(generateMaskedDoseIterator(
             maskAccessorPtrVector.at(i),
             appData._dose));
 
+        //if dose statistics are computed, the DVH is generated from the values recorded by the statistics calculator
+        boost::shared_ptr<algorithms::DoseStatisticsCalculator> doseStatsCalculator;
+
         if (appData._computeDoseStatistics) {
             std::cout << std::endl << "computing dose statistics... ";
+            doseStatsCalculator = boost::make_shared<algorithms::DoseStatisticsCalculator>(spDoseIterator);
             auto statistics = calculateDoseStatistics(
-                spDoseIterator,
+                *doseStatsCalculator,
                 appData._computeComplexDoseStatistics, appData._prescribedDose);
             std::cout << "done." << std::endl;
 
@@ -179,23 +212,21 @@ void rttb::apps::doseTool::processData(rttb::apps::doseTool::ApplicationData& ap
         }
 
         if (appData._computeDVH) {
-            std::cout << std::endl << "computing DVH... ";
-            rttb::IDType structUID;
-            rttb::IDType doseUID;
-
-            //Generate random UID
-            if (appData._structLoadStyle == "itk") {
-                structUID = "struct.fromVoxelizedITK";
-                doseUID = "dose.fromVoxelizedITK";
+            core::DVH::Pointer dvh;
+
+            if (!dvhs.empty()) {
+                dvh = dvhs.at(i);
             } else {
-                structUID = appData._struct->getUID();
-                doseUID = appData._dose->getUID();
+                std::cout << std::endl << "computing DVH... ";
+
+                if (doseStatsCalculator) {
+                    dvh = doseStatsCalculator->calculateDVH(structUID, doseUID);
+                } else {
+                    dvh = calculateDVH(spDoseIterator, structUID, doseUID);
+                }
+                std::cout << "done." << std::endl;
             }
 
-            core::DVH::Pointer dvh = calculateDVH(spDoseIterator, structUID,
-                doseUID);
-            std::cout << "done." << std::endl;
-
             std::cout << std::endl << "writing DVH to file... ";
             std::string outputFilename;
 
@@ -15,7 +15,7 @@
 
 #include <iostream>
 
-#include "rttbBoostMaskAccessor.h"
+#include "rttbStructureSetVoxelizer.h"
 
 #include "itkMacro.h"
 
@@ -50,25 +50,6 @@ void rttb::apps::voxelizerTool::removeSpecialCharacters(std::string& label)
 	}
 }
 
-rttb::core::MaskAccessorInterface::Pointer rttb::apps::voxelizerTool::createMask(
-    rttb::core::DoseAccessorInterface::Pointer doseAccessorPtr,
-    rttb::core::Structure::Pointer structurePtr,
-    bool strict)
-{
-    rttb::core::MaskAccessorInterface::Pointer maskAccessorPtr;
-
-    if (doseAccessorPtr != nullptr && structurePtr != nullptr)
-    {
-        maskAccessorPtr = boost::make_shared<rttb::masks::boost::BoostMaskAccessor>
-            (structurePtr, doseAccessorPtr->getGeometricInfo(),
-                strict);
-
-        maskAccessorPtr->updateMask();
-    }
-
-    return maskAccessorPtr;
-}
-
 void rttb::apps::voxelizerTool::writeMaskToFile(std::vector<core::MaskAccessorInterface::Pointer> maskVector,
     const std::string& outputFileName, bool voxelization)
 {
@@ -154,16 +135,14 @@ void rttb::apps::voxelizerTool::processData(rttb::apps::voxelizerTool::Applicati
     if (appData._struct->getNumberOfStructures()>0)
     {
         std::vector<core::MaskAccessorInterface::Pointer> maskVector;            
+        rttb::masks::boost::StructureSetVoxelizer voxelizer(appData._struct, appData._dose->getGeometricInfo(),
+            !appData._noStrictVoxelization);
 
         if (appData._addStructures)
         {
-            for (size_t i=0; i<appData._struct->getNumberOfStructures(); i++ )
-            {
-              std::cout << "creating mask #" << i << "...";
-                maskVector.push_back(createMask(appData._dose, appData._struct->getStructure(i),
-                    !appData._noStrictVoxelization));
-                std::cout << "done" << std::endl;
-            }
+            std::cout << "creating " << appData._struct->getNumberOfStructures() << " masks...";
+            maskVector = voxelizer.voxelize();
+            std::cout << "done" << std::endl;
             std::cout << "writing mask to file...";
             writeMaskToFile(maskVector, appData._outputFilename, appData._binaryVoxelization);
             std::cout << "done" << std::endl;
@@ -179,12 +158,17 @@ void rttb::apps::voxelizerTool::processData(rttb::apps::voxelizerTool::Applicati
                 maxIterationCount = appData._struct->getNumberOfStructures();
             }
 
-            for (size_t i = 0; i<maxIterationCount; i++)
+            std::vector<size_t> structureIndices;
+
+            for (size_t i = 0; i < maxIterationCount; i++)
+            {
+                structureIndices.push_back(i);
+            }
+
+            //the masks are created concurrently, each one is written (and released) as soon as it is ready
+            std::cout << "creating " << maxIterationCount << " masks..." << std::endl;
+            voxelizer.voxelize(structureIndices, [&appData](size_t i, core::MaskAccessorInterface::Pointer currentMask)
             {
-                std::cout << "creating mask #" << i << "...";
-                auto currentMask = createMask(appData._dose, appData._struct->getStructure(i),
-                    !appData._noStrictVoxelization);
-                std::cout << "done" << std::endl;
                 std::string labelOfInterest = appData._struct->getStructure(i)->getLabel();
                 removeSpecialCharacters(labelOfInterest);
 
@@ -201,7 +185,7 @@ void rttb::apps::voxelizerTool::processData(rttb::apps::voxelizerTool::Applicati
                 std::cout << "writing mask #" << i << " to file...";
                 writeMaskToFile(currenMaskVector, outputName, appData._binaryVoxelization);
                 std::cout << "done" << std::endl;
-            }
+            });
         }
     }
     else
@@ -37,14 +37,6 @@ namespace rttb
 			*/
 			void removeSpecialCharacters(std::string& label);
 
-            /**@brief create a mask with _rtStructureSet and _doseAccessor object.
-            @return a mask object
-            */
-            core::MaskAccessorInterface::Pointer createMask(
-                core::DoseAccessorInterface::Pointer doseAccessorPtr,
-              rttb::core::Structure::Pointer structurePtr,
-                bool strict);
-
             /**@brief write the mask into the outputfile
             @param Outputfilename
             */
@@ -2,6 +2,9 @@ SET(CPP_FILES
   rttbDoseStatistics.cpp
   rttbDoseStatisticsCalculator.cpp
   rttbArithmetic.cpp
+  rttbSortedDoseBuffer.cpp
+  rttbDoseQuantileSketch.cpp
+  rttbDoseExtremaTracker.cpp
   
   rttbVolumeToDoseMeasureCollectionCalculator.cpp
   rttbDxVolumeToDoseMeasureCollectionCalculator.cpp
@@ -23,6 +26,9 @@ SET(H_FILES
   rttbDoseStatisticsCalculator.h
   rttbArithmetic.h
   rttbBinaryFunctorAccessor.h
+  rttbSortedDoseBuffer.h
+  rttbDoseQuantileSketch.h
+  rttbDoseExtremaTracker.h
   
   rttbVolumeToDoseMeasureCollectionCalculator.h
   rttbDxVolumeToDoseMeasureCollectionCalculator.h
@@ -13,6 +13,8 @@
 //
 //------------------------------------------------------------------------
 
+#include <vector>
+
 #include "rttbNullPointerException.h"
 #include "rttbInvalidParameterException.h"
 
@@ -43,13 +45,23 @@ namespace rttb
 					throw core::InvalidParameterException("The geometricInfo of all given accessors needs to be equal.");
 				}
 
-				//apply operation op to doses with equal geometricInfo (same grid)
-				GridSizeType numVoxels = dose1->getGridSize();
+				//apply operation op to doses with equal geometricInfo (same grid), the input values are read slice-wise
+				const core::GeometricInfo& geoInfo = dose1->getGeometricInfo();
+				const GridSizeType sliceSize = static_cast<GridSizeType>(geoInfo.getNumColumns()) * geoInfo.getNumRows();
+				std::vector<GenericValueType> values1(sliceSize);
+				std::vector<GenericValueType> values2(sliceSize);
+				VoxelGridID id = 0;
 
-				for (VoxelGridID id = 0; id < numVoxels; ++id)
+				for (GridIndexType slice = 0; slice < geoInfo.getNumSlices(); ++slice)
 				{
-					DoseTypeGy opVal = op.calc(dose1->getValueAt(id), dose2->getValueAt(id));
-					result->setDoseAt(id, opVal);
+					dose1->getSlice(slice, values1.data());
+					dose2->getSlice(slice, values2.data());
+
+					for (GridSizeType i = 0; i < sliceSize; ++i, ++id)
+					{
+						DoseTypeGy opVal = op.calc(values1[i], values2[i]);
+						result->setDoseAt(id, opVal);
+					}
 				}
 			}
 
@@ -72,13 +84,21 @@ namespace rttb
 
 				//apply operation op to accessors with equal geometricInfo (same grid)
 				core::MaskVoxel mVoxel(0);
-				GridSizeType numVoxels = dose->getGridSize();
+				const core::GeometricInfo& geoInfo = dose->getGeometricInfo();
+				const GridSizeType sliceSize = static_cast<GridSizeType>(geoInfo.getNumColumns()) * geoInfo.getNumRows();
+				std::vector<GenericValueType> doseValues(sliceSize);
+				VoxelGridID id = 0;
 
-				for (VoxelGridID id = 0; id < numVoxels; ++id)
+				for (GridIndexType slice = 0; slice < geoInfo.getNumSlices(); ++slice)
 				{
-					mask->getMaskAt(id, mVoxel);
-					DoseTypeGy opVal = op.calc(dose->getValueAt(id), mVoxel.getRelevantVolumeFraction());
-					result->setDoseAt(id, opVal);
+					dose->getSlice(slice, doseValues.data());
+
+					for (GridSizeType i = 0; i < sliceSize; ++i, ++id)
+					{
+						mask->getMaskAt(id, mVoxel);
+						DoseTypeGy opVal = op.calc(doseValues[i], mVoxel.getRelevantVolumeFraction());
+						result->setDoseAt(id, opVal);
+					}
 				}
 			}
 
@@ -81,6 +81,13 @@ namespace rttb
 			*/
 			GenericValueType getValueAt(const VoxelGridIndex3D& aIndex) const override;
 
+			/*! @brief Returns the result doses computed by the functor for a consecutive ID range.
+			    The operand values are read in bulk from both operand accessors.
+				@exception IndexOutOfBoundsException if the ID range is not completely inside the grid.
+				@pre <TDoseOperation>.calc(dose1,dose2) has to be implemented
+			*/
+			void getValues(VoxelGridID aFirstID, GridSizeType aNumberOfValues, GenericValueType* values) const override;
+
 			const IDType getUID() const override
 			{
 				return IDType();
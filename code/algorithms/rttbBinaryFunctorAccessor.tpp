@@ -18,6 +18,8 @@
 #ifndef __BINARY_FUNCTOR_ACCESSOR_TPP
 #define __BINARY_FUNCTOR_ACCESSOR_TPP
 
+#include <vector>
+
 namespace rttb
 {
 	namespace algorithms
@@ -71,6 +73,19 @@ namespace rttb
 			}
 		}
 
+		template <class TDoseOperation> void BinaryFunctorAccessor<TDoseOperation>::getValues(
+		    const VoxelGridID aFirstID, const GridSizeType aNumberOfValues, GenericValueType* values) const
+		{
+			_spData1->getValues(aFirstID, aNumberOfValues, values);
+			std::vector<GenericValueType> values2(aNumberOfValues);
+			_spData2->getValues(aFirstID, aNumberOfValues, values2.data());
+
+			for (GridSizeType i = 0; i < aNumberOfValues; ++i)
+			{
+				values[i] = _functor.calc(values[i], values2[i]);
+			}
+		}
+
 	}
 }
 #endif
\ No newline at end of file
@@ -0,0 +1,145 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+#include <algorithm>
+#include <limits>
+
+#include <boost/make_shared.hpp>
+
+#include "rttbDoseExtremaTracker.h"
+
+namespace rttb
+{
+
+	namespace algorithms
+	{
+		DoseExtremaTracker::DoseExtremaTracker(unsigned int maxNumberMinimaPositions,
+		                                       unsigned int maxNumberMaximaPositions) :
+			_maxNumberMinima(maxNumberMinimaPositions), _maxNumberMaxima(maxNumberMaximaPositions), _numberOfValues(0),
+			_minimum(std::numeric_limits<DoseTypeGy>::max()), _maximum(std::numeric_limits<DoseTypeGy>::lowest())
+		{
+			_minimumPositions.reserve(_maxNumberMinima);
+			_maximumPositions.reserve(_maxNumberMaxima);
+			_coldestVoxels.reserve(_maxNumberMinima);
+			_hottestVoxels.reserve(_maxNumberMaxima);
+		}
+
+		bool DoseExtremaTracker::isHotter(const RankedVoxel& aVoxel, const RankedVoxel& anotherVoxel)
+		{
+			return aVoxel.dose > anotherVoxel.dose
+			       || (aVoxel.dose == anotherVoxel.dose && aVoxel.insertionIndex < anotherVoxel.insertionIndex);
+		}
+
+		bool DoseExtremaTracker::isColder(const RankedVoxel& aVoxel, const RankedVoxel& anotherVoxel)
+		{
+			return aVoxel.dose < anotherVoxel.dose
+			       || (aVoxel.dose == anotherVoxel.dose && aVoxel.insertionIndex < anotherVoxel.insertionIndex);
+		}
+
+		void DoseExtremaTracker::insert(const DoseTypeGy* doseValues, const VoxelGridID* ids,
+		                                std::size_t numberOfValues)
+		{
+			for (std::size_t i = 0; i < numberOfValues; ++i, ++_numberOfValues)
+			{
+				const DoseTypeGy dose = doseValues[i];
+
+				if (dose > _maximum)
+				{
+					_maximum = dose;
+					_maximumPositions.clear();
+				}
+
+				if (dose < _minimum)
+				{
+					_minimum = dose;
+					_minimumPositions.clear();
+				}
+
+				if (dose == _maximum && _maximumPositions.size() < _maxNumberMaxima)
+				{
+					_maximumPositions.emplace_back(dose, ids[i]);
+				}
+
+				if (dose == _minimum && _minimumPositions.size() < _maxNumberMinima)
+				{
+					_minimumPositions.emplace_back(dose, ids[i]);
+				}
+
+				const RankedVoxel voxel = {dose, _numberOfValues, ids[i]};
+
+				//a later voxel with the same dose never replaces the top of a full heap
+				if (_hottestVoxels.size() < _maxNumberMaxima)
+				{
+					_hottestVoxels.push_back(voxel);
+					std::push_heap(_hottestVoxels.begin(), _hottestVoxels.end(), isHotter);
+				}
+				else if (_maxNumberMaxima > 0 && dose > _hottestVoxels.front().dose)
+				{
+					std::pop_heap(_hottestVoxels.begin(), _hottestVoxels.end(), isHotter);
+					_hottestVoxels.back() = voxel;
+					std::push_heap(_hottestVoxels.begin(), _hottestVoxels.end(), isHotter);
+				}
+
+				if (_coldestVoxels.size() < _maxNumberMinima)
+				{
+					_coldestVoxels.push_back(voxel);
+					std::push_heap(_coldestVoxels.begin(), _coldestVoxels.end(), isColder);
+				}
+				else if (_maxNumberMinima > 0 && dose < _coldestVoxels.front().dose)
+				{
+					std::pop_heap(_coldestVoxels.begin(), _coldestVoxels.end(), isColder);
+					_coldestVoxels.back() = voxel;
+					std::push_heap(_coldestVoxels.begin(), _coldestVoxels.end(), isColder);
+				}
+			}
+		}
+
+		DoseExtremaTracker::ResultListPointer DoseExtremaTracker::toResultList(std::vector<RankedVoxel> voxels,
+		        bool (*ranking)(const RankedVoxel&, const RankedVoxel&))
+		{
+			std::sort(voxels.begin(), voxels.end(), ranking);
+			ResultListPointer result = boost::make_shared<std::vector<std::pair<DoseTypeGy, VoxelGridID> > >();
+			result->reserve(voxels.size());
+
+			for (const auto& voxel : voxels)
+			{
+				result->emplace_back(voxel.dose, voxel.id);
+			}
+
+			return result;
+		}
+
+		DoseExtremaTracker::ResultListPointer DoseExtremaTracker::getMinimumPositions() const
+		{
+			return boost::make_shared<std::vector<std::pair<DoseTypeGy, VoxelGridID> > >(_minimumPositions);
+		}
+
+		DoseExtremaTracker::ResultListPointer DoseExtremaTracker::getMaximumPositions() const
+		{
+			return boost::make_shared<std::vector<std::pair<DoseTypeGy, VoxelGridID> > >(_maximumPositions);
+		}
+
+		DoseExtremaTracker::ResultListPointer DoseExtremaTracker::getColdestVoxels() const
+		{
+			return toResultList(_coldestVoxels, isColder);
+		}
+
+		DoseExtremaTracker::ResultListPointer DoseExtremaTracker::getHottestVoxels() const
+		{
+			return toResultList(_hottestVoxels, isHotter);
+		}
+
+	}//end namespace algorithms
+}//end namespace rttb
@@ -0,0 +1,124 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+#ifndef __DOSE_EXTREMA_TRACKER_H
+#define __DOSE_EXTREMA_TRACKER_H
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "rttbBaseType.h"
+#include "rttbCommon.h"
+#include "rttbDoseStatistics.h"
+
+#include "RTTBAlgorithmsExports.h"
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+
+namespace rttb
+{
+
+	namespace algorithms
+	{
+		/*! @class DoseExtremaTracker
+		@brief Finds the minimum, the maximum and their positions in one sequential pass over the dose values.
+		@details Besides the positions where the dose is exactly minimal/maximal, the k coldest/hottest voxels are kept
+		in bounded heaps (k = maxNumberMinimaPositions/maxNumberMaximaPositions). Memory is O(k), every value costs
+		O(1) comparisons and O(log k) only if it enters a heap. Ties are resolved in favour of the voxel inserted first,
+		so all results are deterministic and equal to those of a sequential scan.
+		*/
+		class RTTBAlgorithms_EXPORT DoseExtremaTracker
+		{
+		public:
+			rttbClassMacroNoParent(DoseExtremaTracker)
+			using ResultListPointer = DoseStatistics::ResultListPointer;
+
+		private:
+			struct RankedVoxel
+			{
+				DoseTypeGy dose;
+				std::size_t insertionIndex;
+				VoxelGridID id;
+			};
+
+			std::size_t _maxNumberMinima;
+			std::size_t _maxNumberMaxima;
+			std::size_t _numberOfValues;
+			DoseTypeGy _minimum;
+			DoseTypeGy _maximum;
+			std::vector<std::pair<DoseTypeGy, VoxelGridID> > _minimumPositions;
+			std::vector<std::pair<DoseTypeGy, VoxelGridID> > _maximumPositions;
+			/*! @brief heap of the hottest voxels, the least hot one on top*/
+			std::vector<RankedVoxel> _hottestVoxels;
+			/*! @brief heap of the coldest voxels, the least cold one on top*/
+			std::vector<RankedVoxel> _coldestVoxels;
+
+			static bool isHotter(const RankedVoxel& aVoxel, const RankedVoxel& anotherVoxel);
+			static bool isColder(const RankedVoxel& aVoxel, const RankedVoxel& anotherVoxel);
+
+			static ResultListPointer toResultList(std::vector<RankedVoxel> voxels,
+			                                      bool (*ranking)(const RankedVoxel&, const RankedVoxel&));
+
+		public:
+			/*! @brief Constructor.
+				@param maxNumberMinimaPositions maximal number of minimum positions and of coldest voxels
+				@param maxNumberMaximaPositions maximal number of maximum positions and of hottest voxels
+			*/
+			DoseExtremaTracker(unsigned int maxNumberMinimaPositions, unsigned int maxNumberMaximaPositions);
+
+			/*! @brief Adds the next numberOfValues values in iteration order.*/
+			void insert(const DoseTypeGy* doseValues, const VoxelGridID* ids, std::size_t numberOfValues);
+
+			std::size_t getNumberOfValues() const
+			{
+				return _numberOfValues;
+			};
+
+			/*! @pre getNumberOfValues() > 0*/
+			DoseTypeGy getMinimum() const
+			{
+				return _minimum;
+			};
+
+			/*! @pre getNumberOfValues() > 0*/
+			DoseTypeGy getMaximum() const
+			{
+				return _maximum;
+			};
+
+			/*! @brief the first (in iteration order) positions where the dose is minimal*/
+			ResultListPointer getMinimumPositions() const;
+
+			/*! @brief the first (in iteration order) positions where the dose is maximal*/
+			ResultListPointer getMaximumPositions() const;
+
+			/*! @brief the coldest voxels in ascending dose order*/
+			ResultListPointer getColdestVoxels() const;
+
+			/*! @brief the hottest voxels in descending dose order*/
+			ResultListPointer getHottestVoxels() const;
+		};
+	}
+}
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif
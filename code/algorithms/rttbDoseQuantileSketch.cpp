@@ -0,0 +1,151 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+#include "rttbDoseQuantileSketch.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "rttbInvalidParameterException.h"
+
+namespace rttb
+{
+
+	namespace algorithms
+	{
+		DoseQuantileSketch::DoseQuantileSketch(double relativeAccuracy) : _relativeAccuracy(relativeAccuracy),
+			_minimumBucketIndex(0), _zeroBucketVoxelProportion(0), _totalVoxelProportion(0),
+			_minimum(std::numeric_limits<DoseTypeGy>::max()), _maximum(std::numeric_limits<DoseTypeGy>::lowest())
+		{
+			if (!(relativeAccuracy > 0 && relativeAccuracy < 1))
+			{
+				throw core::InvalidParameterException("relativeAccuracy must be in (0, 1)!");
+			}
+
+			_logGamma = std::log((1 + relativeAccuracy) / (1 - relativeAccuracy));
+		}
+
+		int DoseQuantileSketch::getBucketIndex(DoseTypeGy dose) const
+		{
+			return static_cast<int>(std::ceil(std::log(dose) / _logGamma));
+		}
+
+		void DoseQuantileSketch::addToBucket(int bucketIndex, FractionType voxelProportion)
+		{
+			if (_bucketVoxelProportions.empty())
+			{
+				_minimumBucketIndex = bucketIndex;
+			}
+			else if (bucketIndex < _minimumBucketIndex)
+			{
+				_bucketVoxelProportions.insert(_bucketVoxelProportions.begin(), _minimumBucketIndex - bucketIndex, 0);
+				_minimumBucketIndex = bucketIndex;
+			}
+
+			const std::size_t position = static_cast<std::size_t>(bucketIndex - _minimumBucketIndex);
+
+			if (position >= _bucketVoxelProportions.size())
+			{
+				_bucketVoxelProportions.resize(position + 1, 0);
+			}
+
+			_bucketVoxelProportions[position] += voxelProportion;
+		}
+
+		void DoseQuantileSketch::insert(DoseTypeGy dose, FractionType voxelProportion)
+		{
+			_minimum = std::min(_minimum, dose);
+			_maximum = std::max(_maximum, dose);
+			_totalVoxelProportion += voxelProportion;
+
+			if (dose < minimumIndexedDose)
+			{
+				_zeroBucketVoxelProportion += voxelProportion;
+			}
+			else
+			{
+				addToBucket(getBucketIndex(dose), voxelProportion);
+			}
+		}
+
+		void DoseQuantileSketch::merge(const DoseQuantileSketch& other)
+		{
+			if (other._relativeAccuracy != _relativeAccuracy)
+			{
+				throw core::InvalidParameterException("Only sketches with the same relative accuracy can be merged!");
+			}
+
+			_minimum = std::min(_minimum, other._minimum);
+			_maximum = std::max(_maximum, other._maximum);
+			_totalVoxelProportion += other._totalVoxelProportion;
+			_zeroBucketVoxelProportion += other._zeroBucketVoxelProportion;
+
+			for (std::size_t i = 0; i < other._bucketVoxelProportions.size(); ++i)
+			{
+				if (other._bucketVoxelProportions[i] != 0)
+				{
+					addToBucket(other._minimumBucketIndex + static_cast<int>(i), other._bucketVoxelProportions[i]);
+				}
+			}
+		}
+
+		std::size_t DoseQuantileSketch::getNumberOfBuckets() const
+		{
+			std::size_t numberOfBuckets = _zeroBucketVoxelProportion != 0 ? 1 : 0;
+
+			for (const auto voxelProportion : _bucketVoxelProportions)
+			{
+				if (voxelProportion != 0)
+				{
+					++numberOfBuckets;
+				}
+			}
+
+			return numberOfBuckets;
+		}
+
+		void DoseQuantileSketch::getBuckets(std::vector<DoseTypeGy>& representativeDoses,
+		                                    std::vector<FractionType>& voxelProportions) const
+		{
+			representativeDoses.clear();
+			voxelProportions.clear();
+
+			if (_zeroBucketVoxelProportion != 0)
+			{
+				representativeDoses.push_back(std::min(std::max(DoseTypeGy(0), _minimum), _maximum));
+				voxelProportions.push_back(_zeroBucketVoxelProportion);
+			}
+
+			const double gamma = std::exp(_logGamma);
+
+			for (std::size_t i = 0; i < _bucketVoxelProportions.size(); ++i)
+			{
+				if (_bucketVoxelProportions[i] != 0)
+				{
+					const int bucketIndex = _minimumBucketIndex + static_cast<int>(i);
+					const DoseTypeGy representative = 2 * std::exp(bucketIndex * _logGamma) / (gamma + 1);
+					representativeDoses.push_back(std::min(std::max(representative, _minimum), _maximum));
+					voxelProportions.push_back(_bucketVoxelProportions[i]);
+				}
+			}
+		}
+
+		std::size_t DoseQuantileSketch::getMemorySize() const
+		{
+			return sizeof(DoseQuantileSketch) + _bucketVoxelProportions.capacity() * sizeof(FractionType);
+		}
+	}
+}
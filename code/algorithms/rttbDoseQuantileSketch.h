@@ -0,0 +1,114 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+#ifndef __DOSE_QUANTILE_SKETCH_H
+#define __DOSE_QUANTILE_SKETCH_H
+
+#include <vector>
+
+#include "rttbBaseType.h"
+#include "rttbCommon.h"
+
+#include "RTTBAlgorithmsExports.h"
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+
+namespace rttb
+{
+
+	namespace algorithms
+	{
+		/*! @class DoseQuantileSketch
+		@brief Mergeable summary of a dose distribution with a fixed relative accuracy, used instead of the sorted dose
+		values if a structure is too large to keep every voxel.
+		@details The doses are accumulated in logarithmic buckets: bucket k holds the voxel proportions of all doses in
+		(gamma^(k-1), gamma^k] with gamma = (1 + relativeAccuracy) / (1 - relativeAccuracy). Every dose of a bucket is
+		represented by 2 * gamma^k / (gamma + 1), which differs from it by at most relativeAccuracy (relative). Doses
+		below minimumIndexedDose share one bucket represented by 0 Gy.
+		Memory depends on the dose range and the accuracy only (about ln(max/min) / (2 * relativeAccuracy) buckets),
+		not on the number of voxels. Sketches of disjoint parts of a structure (e.g. filled by different threads) can be
+		merged; up to rounding, the result does not depend on the order of insertion or merging.
+		*/
+		class RTTBAlgorithms_EXPORT DoseQuantileSketch
+		{
+		public:
+			rttbClassMacroNoParent(DoseQuantileSketch)
+
+			/*! @brief doses below this value are counted as 0 Gy*/
+			static constexpr DoseTypeGy minimumIndexedDose = 1e-6;
+
+		private:
+			double _relativeAccuracy;
+			double _logGamma;
+			/*! @brief voxel proportions of the buckets _minimumBucketIndex, _minimumBucketIndex + 1, ...*/
+			std::vector<FractionType> _bucketVoxelProportions;
+			int _minimumBucketIndex;
+			FractionType _zeroBucketVoxelProportion;
+			FractionType _totalVoxelProportion;
+			DoseTypeGy _minimum;
+			DoseTypeGy _maximum;
+
+			int getBucketIndex(DoseTypeGy dose) const;
+			void addToBucket(int bucketIndex, FractionType voxelProportion);
+
+		public:
+			/*! @brief Constructor.
+				@param relativeAccuracy maximal relative difference between a dose and its representative
+				@exception InvalidParameterException if relativeAccuracy is not in (0, 1)
+			*/
+			explicit DoseQuantileSketch(double relativeAccuracy = 0.01);
+
+			virtual ~DoseQuantileSketch() = default;
+
+			void insert(DoseTypeGy dose, FractionType voxelProportion);
+
+			/*! @brief Adds all values of another sketch.
+				@exception InvalidParameterException if the sketches have a different relative accuracy
+			*/
+			void merge(const DoseQuantileSketch& other);
+
+			double getRelativeAccuracy() const
+			{
+				return _relativeAccuracy;
+			};
+
+			/*! @brief sum of all inserted voxel proportions (number of voxels)*/
+			FractionType getTotalVoxelProportion() const
+			{
+				return _totalVoxelProportion;
+			};
+
+			/*! @brief number of non empty buckets*/
+			std::size_t getNumberOfBuckets() const;
+
+			/*! @brief Representative dose and voxel proportion of every non empty bucket in ascending dose order. The
+				representatives are clipped to the range of the inserted doses.
+			*/
+			void getBuckets(std::vector<DoseTypeGy>& representativeDoses, std::vector<FractionType>& voxelProportions) const;
+
+			/*! @brief memory used by the sketch in bytes*/
+			std::size_t getMemorySize() const;
+		};
+	}
+}
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif
@@ -43,7 +43,7 @@ namespace rttb
 			_MOHx(::boost::make_shared<VolumeToDoseMeasureCollection>(MOHx)),
 			_MOCx(::boost::make_shared<VolumeToDoseMeasureCollection>(MOCx)), 
 			_MaxOHx(::boost::make_shared<VolumeToDoseMeasureCollection>(MaxOHx)), 
-			_MinOCx(::boost::make_shared<VolumeToDoseMeasureCollection>(MinOCx))
+			_MinOCx(::boost::make_shared<VolumeToDoseMeasureCollection>(MinOCx)), _relativeErrorBound(0)
 		{
 			if (maximumVoxelPositions == nullptr)
 			{
@@ -65,6 +65,9 @@ namespace rttb
 				_minimumVoxelPositions = minimumVoxelPositions;
 			}
 
+			_coldestVoxels = boost::make_shared<std::vector<std::pair<DoseTypeGy, VoxelGridID> > >();
+			_hottestVoxels = boost::make_shared<std::vector<std::pair<DoseTypeGy, VoxelGridID> > >();
+
 			if (referenceDose <= 0)
 			{
 				_referenceDose = _maximum;
@@ -90,6 +93,16 @@ namespace rttb
 			_maximumVoxelPositions = maximumVoxelPositions;
 		}
 
+		void DoseStatistics::setColdestVoxels(ResultListPointer coldestVoxels)
+		{
+			_coldestVoxels = coldestVoxels;
+		}
+
+		void DoseStatistics::setHottestVoxels(ResultListPointer hottestVoxels)
+		{
+			_hottestVoxels = hottestVoxels;
+		}
+
 		void DoseStatistics::setDx(VolumeToDoseMeasureCollection::Pointer DxValues)
 		{
 			_Dx = DxValues;
@@ -132,6 +145,11 @@ namespace rttb
 			}
 		}
 
+		void DoseStatistics::setRelativeErrorBound(double relativeErrorBound)
+		{
+			_relativeErrorBound = relativeErrorBound;
+		}
+
 		VoxelNumberType DoseStatistics::getNumberOfVoxels() const
 		{
 			return _numVoxels;
@@ -148,6 +166,11 @@ namespace rttb
 			return _referenceDose;
 		}
 
+		double DoseStatistics::getRelativeErrorBound() const
+		{
+			return _relativeErrorBound;
+		}
+
 
 		DoseStatisticType DoseStatistics::getMaximum() const
 		{
@@ -250,6 +273,16 @@ namespace rttb
 			return _minimumVoxelPositions;
 		}
 
+		DoseStatistics::ResultListPointer DoseStatistics::getColdestVoxels() const
+		{
+			return _coldestVoxels;
+		}
+
+		DoseStatistics::ResultListPointer DoseStatistics::getHottestVoxels() const
+		{
+			return _hottestVoxels;
+		}
+
 		DoseToVolumeMeasureCollection DoseStatistics::getVx() const
 		{
 			return *_Vx;
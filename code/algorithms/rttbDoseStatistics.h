@@ -66,6 +66,8 @@ namespace rttb
       VolumeType _volume;
       ResultListPointer _minimumVoxelPositions;
 			ResultListPointer _maximumVoxelPositions;
+			ResultListPointer _coldestVoxels;
+			ResultListPointer _hottestVoxels;
 			VolumeToDoseMeasureCollection::Pointer _Dx;
 			DoseToVolumeMeasureCollection::Pointer _Vx;
 			VolumeToDoseMeasureCollection::Pointer _MOHx;
@@ -73,6 +75,7 @@ namespace rttb
 			VolumeToDoseMeasureCollection::Pointer _MaxOHx;
 			VolumeToDoseMeasureCollection::Pointer _MinOCx;
       DoseTypeGy _referenceDose; //for Vx computation
+			double _relativeErrorBound;
 
 		public:
 			/*! @brief Standard Constructor
@@ -99,6 +102,8 @@ namespace rttb
 
 			void setMinimumVoxelPositions(ResultListPointer minimumVoxelPositions);
 			void setMaximumVoxelPositions(ResultListPointer maximumVoxelPositions);
+			void setColdestVoxels(ResultListPointer coldestVoxels);
+			void setHottestVoxels(ResultListPointer hottestVoxels);
 			void setDx(VolumeToDoseMeasureCollection::Pointer DxValues);
 			void setVx(DoseToVolumeMeasureCollection::Pointer VxValues);
 			void setMOHx(VolumeToDoseMeasureCollection::Pointer MOHxValues);
@@ -106,6 +111,7 @@ namespace rttb
 			void setMaxOHx(VolumeToDoseMeasureCollection::Pointer MaxOHxValues);
 			void setMinOCx(VolumeToDoseMeasureCollection::Pointer MinOCxValues);
 			void setReferenceDose(DoseTypeGy referenceDose);
+			void setRelativeErrorBound(double relativeErrorBound);
 
 			/*! @brief Get number of voxels in doseIterator, with sub-voxel accuracy.
 			*/
@@ -119,6 +125,12 @@ namespace rttb
 			*/
 			DoseTypeGy getReferenceDose() const;
 
+			/*! @brief Get the maximal relative error of Dx, MOHx and MOCx (and of the dose of Vx) if they were approximated
+				(see DoseStatisticsCalculator::setApproximateMode()).
+				@return 0 if all values are exact
+			*/
+			double getRelativeErrorBound() const;
+
 			/*! @brief Get the maximum of the current dose distribution.
 				@return Return the maximum dose in Gy
 			*/
@@ -139,6 +151,16 @@ namespace rttb
 			*/
 			ResultListPointer getMinimumVoxelPositions() const;
 
+			/*! @brief Get the coldest voxels (VoxelGridID and dose value in Gy) in ascending dose order, regardless of
+				whether their dose equals the minimum. Voxels with the same dose are in iteration order.
+			*/
+			ResultListPointer getColdestVoxels() const;
+
+			/*! @brief Get the hottest voxels (VoxelGridID and dose value in Gy) in descending dose order, regardless of
+				whether their dose equals the maximum. Voxels with the same dose are in iteration order.
+			*/
+			ResultListPointer getHottestVoxels() const;
+
 			/*! @brief Get the mean of the current dose distribution.
 				@return Return the mean dose in Gy
 			*/
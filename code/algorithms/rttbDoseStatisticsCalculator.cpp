@@ -15,19 +15,99 @@
 
 #include "rttbDoseStatisticsCalculator.h"
 
+#include <algorithm>
+#include <vector>
+#include <functional>
+
 #include <boost/shared_ptr.hpp>
 #include <boost/make_shared.hpp>
 #include <boost/assign/list_of.hpp>
 
+#include "rttbDVHCalculator.h"
 #include "rttbNullPointerException.h"
 #include "rttbInvalidDoseException.h"
 #include "rttbInvalidParameterException.h"
+#include "rttbThreadPool.h"
+#include "rttbCompensatedSum.h"
+#include "rttbBlockwiseReduction.h"
+#include "rttbDoseQuantileSketch.h"
+#include "rttbDoseExtremaTracker.h"
 
 namespace rttb
 {
 
 	namespace algorithms
 	{
+		namespace
+		{
+			/*! @brief compensated sums of the voxel proportions, of the dose and of the squared dose (all weighted with
+				the voxel proportions)*/
+			struct DoseMoments
+			{
+				core::CompensatedSum voxelProportion;
+				core::CompensatedSum dose;
+				core::CompensatedSum squaredDose;
+
+				void add(const DoseMoments& other)
+				{
+					voxelProportion.add(other.voxelProportion);
+					dose.add(other.dose);
+					squaredDose.add(other.squaredDose);
+				}
+			};
+
+			/*! @brief number of values that are read from the dose iterator at once in approximate mode*/
+			const std::size_t streamBlockSize = 1 << 16;
+
+			/*! @brief number of consecutive values that are inserted into one partial sketch*/
+			const std::size_t sketchBlockSize = 1 << 14;
+
+			/*! @brief inserts the values block by block into partial sketches (concurrently if multiThreading is set) and
+				merges them into sketch in block order, so that sketch does not depend on the number of threads.*/
+			void insertIntoSketch(DoseQuantileSketch& sketch, double relativeAccuracy, const DoseTypeGy* doseValues,
+			                      const FractionType* voxelProportions, std::size_t numberOfValues, bool multiThreading)
+			{
+				const std::size_t numberOfBlocks = (numberOfValues + sketchBlockSize - 1) / sketchBlockSize;
+				std::vector<DoseQuantileSketch> blockSketches(numberOfBlocks, DoseQuantileSketch(relativeAccuracy));
+
+				auto fillBlock = [&](std::size_t block)
+				{
+					const std::size_t end = std::min(numberOfValues, (block + 1) * sketchBlockSize);
+
+					for (std::size_t i = block * sketchBlockSize; i < end; ++i)
+					{
+						blockSketches[block].insert(doseValues[i], voxelProportions[i]);
+					}
+				};
+
+				if (multiThreading && numberOfBlocks > 1)
+				{
+					core::ThreadPool::TaskGroup group(core::ThreadPool::getDefault());
+
+					for (std::size_t block = 0; block < numberOfBlocks; ++block)
+					{
+						group.run([&fillBlock, block]()
+						{
+							fillBlock(block);
+						});
+					}
+
+					group.wait();
+				}
+				else
+				{
+					for (std::size_t block = 0; block < numberOfBlocks; ++block)
+					{
+						fillBlock(block);
+					}
+				}
+
+				for (const auto& blockSketch : blockSketches)
+				{
+					sketch.merge(blockSketch);
+				}
+			}
+		}
 
 		DoseStatisticsCalculator::DoseStatisticsCalculator(DoseIteratorPointer aDoseIterator)
 		{
@@ -44,6 +124,9 @@ namespace rttb
 			_complexDoseStatisticsCalculated = false;
 
 			_multiThreading = false;
+			_approximateMode = false;
+			_relativeAccuracy = 0.01;
+			_voxelVolume = 0;
 			_mutex = ::boost::make_shared<std::mutex>();
 		}
 
@@ -136,12 +219,6 @@ namespace rttb
 		void DoseStatisticsCalculator::calculateSimpleDoseStatistics(unsigned int maxNumberMinimaPositions,
 			unsigned int maxNumberMaximaPositions)
 		{
-			_doseVector.clear();
-			_voxelProportionVector.clear();
-
-			std::multimap<double, int> doseValueVSIndexMap;
-			std::vector<double> voxelProportionVectorTemp;
-
 
 			DoseStatisticType maximumDose = 0;
 			DoseStatisticType minimumDose = std::numeric_limits<DoseStatisticType>::max();
@@ -149,45 +226,71 @@ namespace rttb
 			DoseStatisticType stdDeviationDose;
 
 
-			DoseTypeGy sum = 0;
 			VolumeType numVoxels = 0.0;
-			DoseTypeGy squareSum = 0;
 			VolumeType volume = 0;
 
-			_doseIterator->reset();
-			int i = 0;
-			DoseTypeGy doseValue = 0;
+			DoseQuantileSketch::Pointer sketch;
 
-			while (_doseIterator->isPositionValid())
+			if (_approximateMode)
 			{
-				doseValue = _doseIterator->getCurrentDoseValue();
+				//the values are streamed from _doseIterator whenever they are needed, only the sketch is kept
+				_bufferedDoseIterator = nullptr;
+				sketch = ::boost::make_shared<DoseQuantileSketch>(_relativeAccuracy);
+				_doseIterator->reset();
+				_voxelVolume = _doseIterator->getCurrentVoxelVolume();
+			}
+			else
+			{
+				//the only pass over _doseIterator, everything else uses the recorded values
+				_bufferedDoseIterator = ::boost::dynamic_pointer_cast<core::BufferedDoseIterator>(_doseIterator);
 
-				if (i == 0)
+				if (!_bufferedDoseIterator)
 				{
-					minimumDose = doseValue;
-					volume = _doseIterator->getCurrentVoxelVolume();
+					_bufferedDoseIterator = ::boost::make_shared<core::BufferedDoseIterator>(_doseIterator);
 				}
 
-				rttb::FractionType voxelProportion = _doseIterator->getCurrentRelevantVolumeFraction();
-				sum += doseValue * voxelProportion;
+				_voxelVolume = _bufferedDoseIterator->getCurrentVoxelVolume();
+			}
+
+			//the extrema and their positions are found in the same pass
+			DoseExtremaTracker extrema(maxNumberMinimaPositions, maxNumberMaximaPositions);
+			core::BlockwiseReduction<DoseMoments> moments;
 
-				numVoxels += voxelProportion;
-				squareSum += doseValue * doseValue * voxelProportion;
+			visitDoseValues([&](const DoseTypeGy* doseValues, const FractionType* voxelProportions, const VoxelGridID* ids,
+			                    std::size_t numberOfValues)
+			{
+				extrema.insert(doseValues, ids, numberOfValues);
 
-				if (doseValue > maximumDose)
+				moments.process(numberOfValues, [doseValues, voxelProportions](std::size_t begin, std::size_t end,
+				                DoseMoments & blockMoments)
 				{
-					maximumDose = doseValue;
-				}
-				else if (doseValue < minimumDose)
+					for (std::size_t i = begin; i < end; ++i)
+					{
+						const DoseTypeGy doseValue = doseValues[i];
+						const rttb::FractionType voxelProportion = voxelProportions[i];
+
+						blockMoments.voxelProportion.add(voxelProportion);
+						blockMoments.dose.add(doseValue * voxelProportion);
+						blockMoments.squaredDose.add(doseValue * doseValue * voxelProportion);
+					}
+				}, _multiThreading);
+
+				if (sketch)
 				{
-					minimumDose = doseValue;
+					insertIntoSketch(*sketch, _relativeAccuracy, doseValues, voxelProportions, numberOfValues, _multiThreading);
 				}
+			});
 
-				voxelProportionVectorTemp.push_back(voxelProportion);
-				doseValueVSIndexMap.insert(std::pair<double, int>(doseValue, i));
+			const DoseMoments sums = moments.getResult();
+			numVoxels = sums.voxelProportion.getSum();
+			const DoseStatisticType sum = sums.dose.getSum();
+			const DoseStatisticType squareSum = sums.squaredDose.getSum();
 
-				i++;
-				_doseIterator->next();
+			if (extrema.getNumberOfValues() > 0)
+			{
+				minimumDose = extrema.getMinimum();
+				maximumDose = extrema.getMaximum();
+				volume = _voxelVolume;
 			}
 
 			if (numVoxels != 0)
@@ -216,11 +319,16 @@ namespace rttb
 
 			}
 
-			//sort dose values and corresponding volume fractions in member variables
-			for (auto & it : doseValueVSIndexMap)
+			if (sketch)
 			{
-				_doseVector.push_back((float)it.first);
-				_voxelProportionVector.push_back(voxelProportionVectorTemp.at(it.second));
+				//the buckets of the sketch take the place of the single voxels
+				_sortedDoses = ::boost::make_shared<SortedDoseBuffer>(*sketch);
+			}
+			else
+			{
+				//sort dose values and corresponding volume fractions
+				_sortedDoses = ::boost::make_shared<SortedDoseBuffer>(_bufferedDoseIterator->getDoseValues(),
+				               _bufferedDoseIterator->getRelevantVolumeFractions());
 			}
 
 			volume *= numVoxels;
@@ -228,14 +336,14 @@ namespace rttb
 			_statistics = boost::make_shared<DoseStatistics>(minimumDose, maximumDose, meanDose,
 				stdDeviationDose, numVoxels,
 				volume);
+			_statistics->setRelativeErrorBound(_approximateMode ? _relativeAccuracy : 0);
 
-			_simpleDoseStatisticsCalculated = true;
-
-			ResultListPointer minimumVoxelPositions = computeMinimumPositions(maxNumberMinimaPositions);
-			ResultListPointer maximumVoxelPositions = computeMaximumPositions(maxNumberMaximaPositions);
+			_statistics->setMinimumVoxelPositions(extrema.getMinimumPositions());
+			_statistics->setMaximumVoxelPositions(extrema.getMaximumPositions());
+			_statistics->setColdestVoxels(extrema.getColdestVoxels());
+			_statistics->setHottestVoxels(extrema.getHottestVoxels());
 
-			_statistics->setMinimumVoxelPositions(minimumVoxelPositions);
-			_statistics->setMaximumVoxelPositions(maximumVoxelPositions);
+			_simpleDoseStatisticsCalculated = true;
 		}
 
 
@@ -266,35 +374,48 @@ namespace rttb
 				precomputeVolumeValuesNonConst = defaultPrecomputeVolumeValues;
 			}
 
-			_Vx = ::boost::make_shared<VxDoseToVolumeMeasureCollectionCalculator>(precomputeDoseValuesNonConst, referenceDose, _doseIterator);
-			_Vx->compute();
+			//in approximate mode, _sortedDoses holds the buckets of the sketch
+			_Vx = ::boost::make_shared<VxDoseToVolumeMeasureCollectionCalculator>(precomputeDoseValuesNonConst, referenceDose,
+				_sortedDoses, _voxelVolume, _multiThreading);
 
 			_Dx = ::boost::make_shared<DxVolumeToDoseMeasureCollectionCalculator>(precomputeVolumeValuesNonConst, _statistics->getVolume(),
-				this->_doseVector, this->_voxelProportionVector, this->_doseIterator->getCurrentVoxelVolume(), _statistics->getMinimum());
-			_Dx->compute();
+				this->_sortedDoses, _voxelVolume, _statistics->getMinimum(), _multiThreading);
 
 			_MOHx = ::boost::make_shared<MOHxVolumeToDoseMeasureCollectionCalculator>(precomputeVolumeValuesNonConst, _statistics->getVolume(),
-				this->_doseVector, this->_voxelProportionVector, this->_doseIterator->getCurrentVoxelVolume());
-			_MOHx->compute();
+				this->_sortedDoses, _voxelVolume, _multiThreading);
 
 			_MOCx = ::boost::make_shared<MOCxVolumeToDoseMeasureCollectionCalculator>(precomputeVolumeValuesNonConst, _statistics->getVolume(),
-				this->_doseVector, this->_voxelProportionVector, this->_doseIterator->getCurrentVoxelVolume());
-			_MOCx->compute();
+				this->_sortedDoses, _voxelVolume, _multiThreading);
 
-			_MaxOHx = ::boost::make_shared<MaxOHxVolumeToDoseMeasureCollectionCalculator>(precomputeVolumeValuesNonConst, _statistics->getVolume(),
-				this->_doseVector, this->_voxelProportionVector, this->_doseIterator->getCurrentVoxelVolume());
-			_MaxOHx->compute();
+			//MaxOHx and MinOCx depend on the dose of a single neighbouring voxel, which a sketch does not preserve
+			if (_approximateMode)
+			{
+				_MaxOHx = nullptr;
+				_MinOCx = nullptr;
+			}
+			else
+			{
+				_MaxOHx = ::boost::make_shared<MaxOHxVolumeToDoseMeasureCollectionCalculator>(precomputeVolumeValuesNonConst,
+					_statistics->getVolume(), this->_sortedDoses, _voxelVolume, _multiThreading);
+
+				_MinOCx = ::boost::make_shared<MinOCxVolumeToDoseMeasureCollectionCalculator>(precomputeVolumeValuesNonConst,
+					_statistics->getVolume(), this->_sortedDoses, _voxelVolume, _statistics->getMinimum(), _statistics->getMaximum(),
+					_multiThreading);
+			}
 
-			_MinOCx = ::boost::make_shared<MinOCxVolumeToDoseMeasureCollectionCalculator>(precomputeVolumeValuesNonConst, _statistics->getVolume(),
-				this->_doseVector, this->_voxelProportionVector, this->_doseIterator->getCurrentVoxelVolume(), _statistics->getMinimum(), _statistics->getMaximum());
-			_MinOCx->compute();
+			computeMeasureCollections();
 
 			_statistics->setVx(_Vx->getMeasureCollection());
 			_statistics->setDx(_Dx->getMeasureCollection());
 			_statistics->setMOHx(_MOHx->getMeasureCollection());
 			_statistics->setMOCx(_MOCx->getMeasureCollection());
-			_statistics->setMaxOHx(_MaxOHx->getMeasureCollection());
-			_statistics->setMinOCx(_MinOCx->getMeasureCollection());
+
+			if (_MaxOHx && _MinOCx)
+			{
+				_statistics->setMaxOHx(_MaxOHx->getMeasureCollection());
+				_statistics->setMinOCx(_MinOCx->getMeasureCollection());
+			}
+
 			_statistics->setReferenceDose(referenceDose);
 			_complexDoseStatisticsCalculated = true;
 		}
@@ -309,8 +430,12 @@ namespace rttb
 			_Dx->addPrecomputeVolumeValues(values);
 			_MOHx->addPrecomputeVolumeValues(values);
 			_MOCx->addPrecomputeVolumeValues(values);
-			_MaxOHx->addPrecomputeVolumeValues(values);
-			_MinOCx->addPrecomputeVolumeValues(values);
+
+			if (_MaxOHx && _MinOCx)
+			{
+				_MaxOHx->addPrecomputeVolumeValues(values);
+				_MinOCx->addPrecomputeVolumeValues(values);
+			}
 		}
 		void DoseStatisticsCalculator::recalculateDoseStatistics()
 		{
@@ -318,86 +443,80 @@ namespace rttb
 			{
 				throw core::InvalidDoseException("Complex DoseStatistics have to be computed in order to call recalculateDoseStatistics()");
 			}
-			_Vx->compute();			
-			_Dx->compute();
-			_MOHx->compute();
-			_MOCx->compute();
-			_MaxOHx->compute();
-			_MinOCx->compute();
+			computeMeasureCollections();
 		}
 
-		DoseStatisticsCalculator::ResultListPointer DoseStatisticsCalculator::computeMaximumPositions(
-			unsigned int maxNumberMaxima) const
+		void DoseStatisticsCalculator::computeMeasureCollections()
 		{
-			if (!_simpleDoseStatisticsCalculated)
+			std::vector<std::function<void()>> computations = { [this]() { _Vx->compute(); }, [this]() { _Dx->compute(); },
+				[this]() { _MOHx->compute(); }, [this]() { _MOCx->compute(); } };
+
+			if (_MaxOHx && _MinOCx)
 			{
-				throw core::InvalidDoseException("simple DoseStatistics have to be computed in order to call computeMaximumPositions()");
+				computations.emplace_back([this]() { _MaxOHx->compute(); });
+				computations.emplace_back([this]() { _MinOCx->compute(); });
 			}
 
-			ResultListPointer maxVoxelVector =
-				boost::make_shared<std::vector<std::pair<DoseTypeGy, VoxelGridID> > >();
-
-			unsigned int count = 0;
-			this->_doseIterator->reset();
-			DoseTypeGy doseValue = 0;
-
-			while (_doseIterator->isPositionValid() && count < maxNumberMaxima)
+			if (_multiThreading)
 			{
-				doseValue = _doseIterator->getCurrentDoseValue();
+				//the calculators distribute their values on the same pool, waiting tasks help processing them
+				core::ThreadPool::TaskGroup tasks(core::ThreadPool::getDefault());
 
-				if (doseValue == _statistics->getMaximum())
+				for (const auto& computation : computations)
 				{
-					VoxelGridID currentID = _doseIterator->getCurrentVoxelGridID();
-					std::pair<DoseTypeGy, VoxelGridID> voxel(doseValue, currentID);
-					maxVoxelVector->push_back(voxel);
-					count++;
+					tasks.run(computation);
 				}
 
-				_doseIterator->next();
+				tasks.wait();
+			}
+			else
+			{
+				for (const auto& computation : computations)
+				{
+					computation();
+				}
 			}
-
-			return maxVoxelVector;
 		}
 
-		DoseStatisticsCalculator::ResultListPointer DoseStatisticsCalculator::computeMinimumPositions(
-			unsigned int maxNumberMinima) const
+		core::DVH::Pointer DoseStatisticsCalculator::calculateDVH(const IDType& structureID, const IDType& doseID,
+		        DoseTypeGy deltaD, int numberOfBins) const
 		{
 			if (!_simpleDoseStatisticsCalculated)
 			{
-				throw core::InvalidDoseException("simple DoseStatistics have to be computed in order to call computeMinimumPositions()");
-
+				throw core::InvalidDoseException("DoseStatistics have to be computed in order to call calculateDVH()");
 			}
 
-			ResultListPointer minVoxelVector =
-				boost::make_shared<std::vector<std::pair<DoseTypeGy, VoxelGridID> > >();
+			if (_bufferedDoseIterator)
+			{
+				core::DVHCalculator calculator(_bufferedDoseIterator, structureID, doseID, deltaD, numberOfBins);
+				return calculator.generateDVH();
+			}
 
-			/*! @todo: Architecture Annotation:
-				Finding the positions for the minimum only once reduces computation time,
-				but will require sensible use by the programmers. To be save the output vector
-				minVoxelVector will be always cleared here to garantee that no false values are
-				presented. This change may be revoced to increase computation speed later on
-				(only compute if(minVoxelVector->size()==0)).
-				*/
-			unsigned int count = 0;
-			this->_doseIterator->reset();
-			DoseTypeGy doseValue = 0;
+			core::DVHCalculator calculator(_doseIterator, structureID, doseID, deltaD, numberOfBins);
+			return calculator.generateDVH();
+		}
 
-			while (_doseIterator->isPositionValid() && count < maxNumberMinima)
+		void DoseStatisticsCalculator::visitDoseValues(const DoseBlockVisitor& visitor) const
+		{
+			if (_bufferedDoseIterator)
 			{
-				doseValue = _doseIterator->getCurrentDoseValue();
+				visitor(_bufferedDoseIterator->getDoseValues().data(), _bufferedDoseIterator->getRelevantVolumeFractions().data(),
+				        _bufferedDoseIterator->getVoxelGridIDs().data(), _bufferedDoseIterator->getNumberOfValues());
+				return;
+			}
 
-				if (doseValue == _statistics->getMinimum())
-				{
-					VoxelGridID currentID = _doseIterator->getCurrentVoxelGridID();
-					std::pair<DoseTypeGy, VoxelGridID> voxel(doseValue, currentID);
-					minVoxelVector->push_back(voxel);
-					count++;
-				}
+			std::vector<DoseTypeGy> doseValues(streamBlockSize);
+			std::vector<FractionType> voxelProportions(streamBlockSize);
+			std::vector<VoxelGridID> ids(streamBlockSize);
 
-				_doseIterator->next();
-			}
+			_doseIterator->reset();
+			std::size_t numberOfValues = 0;
 
-			return minVoxelVector;
+			while ((numberOfValues = _doseIterator->nextBlock(doseValues.size(), doseValues.data(), voxelProportions.data(),
+			                         ids.data())) > 0)
+			{
+				visitor(doseValues.data(), voxelProportions.data(), ids.data(), numberOfValues);
+			}
 		}
 
 		void DoseStatisticsCalculator::setMultiThreading(const bool choice) 
@@ -405,6 +524,17 @@ namespace rttb
 			_multiThreading = choice;
 		}
 
+		void DoseStatisticsCalculator::setApproximateMode(const bool choice, const double relativeAccuracy)
+		{
+			if (choice && !(relativeAccuracy > 0 && relativeAccuracy < 1))
+			{
+				throw core::InvalidParameterException("relativeAccuracy must be in (0, 1)!");
+			}
+
+			_approximateMode = choice;
+			_relativeAccuracy = relativeAccuracy;
+		}
+
 	}//end namespace algorithms
 }//end namespace rttb
 
@@ -16,6 +16,7 @@
 #ifndef __DOSE_STATISTICS_CALCULATOR_H
 #define __DOSE_STATISTICS_CALCULATOR_H
 
+#include <functional>
 #include <vector>
 #include <mutex>
 
@@ -27,11 +28,14 @@
 #include "RTTBAlgorithmsExports.h"
 
 #include "rttbDxVolumeToDoseMeasureCollectionCalculator.h"
+#include "rttbBufferedDoseIterator.h"
+#include "rttbDVH.h"
 #include "rttbVxDoseToVolumeMeasureCollectionCalculator.h"
 #include "rttbMOHxVolumeToDoseMeasureCollectionCalculator.h"
 #include "rttbMOCxVolumeToDoseMeasureCollectionCalculator.h"
 #include "rttbMaxOHxVolumeToDoseMeasureCollectionCalculator.h"
 #include "rttbMinOCxVolumeToDoseMeasureCollectionCalculator.h"
+#include "rttbSortedDoseBuffer.h"
 
 #ifdef _MSC_VER
 #pragma warning(push)
@@ -50,6 +54,11 @@ namespace rttb
 		complex dose specific measures such as Vx (volume irradiated with a dose >=x), Dx (minimal dose delivered
 		to x% of the VOI) or MOHx (mean in the hottest volume). For a complete list, see calculateDoseStatistics().
 		@note the complex dose statistics are precomputed and cannot be computed "on the fly" lateron! The doses/volumes that should be used for precomputation have to be set in calculateDoseStatistics()
+		@note The dose iterator is read only once per calculateDoseStatistics() call (see core::BufferedDoseIterator).
+		The extrema positions are found during this pass, the complex statistics and calculateDVH() use the recorded values.
+		@note In approximate mode (see setApproximateMode()) nothing is recorded: Dx, Vx, MOHx and MOCx are computed from a
+		DoseQuantileSketch that is filled in the same pass, MaxOHx and MinOCx are not computed.
+		The relative error bound is reported by DoseStatistics::getRelativeErrorBound().
 		*/
 		class RTTBAlgorithms_EXPORT DoseStatisticsCalculator
 		{
@@ -61,13 +70,14 @@ namespace rttb
 		private:
 			DoseIteratorPointer _doseIterator;
 
-			/*! @brief Contains relevant dose values sorted in descending order.
+			/*! @brief Values of _doseIterator, recorded during calculateSimpleDoseStatistics(). All further passes use it.
 			*/
-			std::vector<DoseTypeGy> _doseVector;
+			core::BufferedDoseIterator::Pointer _bufferedDoseIterator;
 
-			/*! @brief Contains the corresponding voxel proportions to the values in doseVector.
+			/*! @brief Contains relevant dose values sorted in ascending order and the cumulative volumes.
+				Shared by all measure collection calculators; every precomputed value is a binary search in it.
 			*/
-			std::vector<double> _voxelProportionVector;
+			SortedDoseBuffer::Pointer _sortedDoses;
 			/*! @brief The doseStatistics are stored here.
 			*/
 			DoseStatisticsPointer _statistics;
@@ -77,6 +87,11 @@ namespace rttb
 
 			bool _multiThreading;
 
+			bool _approximateMode;
+			double _relativeAccuracy;
+
+			DoseVoxelVolumeType _voxelVolume;
+
 			::boost::shared_ptr<std::mutex> _mutex;
 
 			VxDoseToVolumeMeasureCollectionCalculator::Pointer _Vx;
@@ -86,30 +101,33 @@ namespace rttb
 			MaxOHxVolumeToDoseMeasureCollectionCalculator::Pointer _MaxOHx;
 			MinOCxVolumeToDoseMeasureCollectionCalculator::Pointer _MinOCx;
 
-			/*! @brief Calculates the positions where the dose has its maximum
-				@param maxNumberMaximaPositions the maximal amount of computed positions
-				@pre maximumDose must be defined in _statistics with the correct value
-			*/
-			ResultListPointer computeMaximumPositions(unsigned int maxNumberMaximaPositions) const;
-			/*! @brief Calculates the positions where the dose has its minimum
-				@param maxNumberMinimaPositions the maximal amount of computed positions (they are read sequentially using the iterator until maxNumberMinimaPositions have been read, other positions are not considered)
-				@pre minimumDose must be defined in _statistics with the correct value
-			*/
-			ResultListPointer computeMinimumPositions(unsigned int maxNumberMinimaPositions) const;
-			
-			/*! @brief Calculates simple dose statistics (min, mean, max, stdDev, minDosePositions, maxDosePositions)
+			/*! @brief Calculates simple dose statistics (min, mean, max, stdDev, minDosePositions, maxDosePositions,
+				coldest and hottest voxels) in one pass (see DoseExtremaTracker)
 				@param maxNumberMinimaPositions the maximal amount of computed positions where the dose has its minimum that is computed
+				(the first ones in iteration order), and the number of coldest voxels
 				@param maxNumberMaximaPositions the maximal amount of computed positions where the dose has its maximum that is computed
+				(the first ones in iteration order), and the number of hottest voxels
 			*/
 			void calculateSimpleDoseStatistics(unsigned int maxNumberMinimaPositions,
 			                                   unsigned int maxNumberMaximaPositions);
 			/*! @brief Calculates complex dose statistics (Dx, Vx, MOHx, MOCx, MaxOHx, MinOCx)
-				@warning computations can take quite long (>1 min) for large structures as many statistics are precomputed
+				@details The values are sorted once, every x value is then computed in O(log n). Thus addPrecomputeValues()
+				and recalculateDoseStatistics() are cheap, also for many values.
 			*/
 			void calculateComplexDoseStatistics(DoseTypeGy referenceDose,
 			                                    const std::vector<double>& precomputeDoseValues,
 			                                    const std::vector<double>& precomputeVolumeValues);
 
+			/*! @brief Computes the pending values of all measure collection calculators, concurrently if multithreading is set.*/
+			void computeMeasureCollections();
+
+			using DoseBlockVisitor = std::function<void(const DoseTypeGy*, const FractionType*, const VoxelGridID*, std::size_t)>;
+
+			/*! @brief Calls visitor for consecutive blocks of (dose, voxel proportion, id) in iteration order: once for the
+				recorded values, or block-wise from _doseIterator in approximate mode.
+			*/
+			void visitDoseValues(const DoseBlockVisitor& visitor) const;
+
 
 		public:
 			~DoseStatisticsCalculator();
@@ -130,6 +148,7 @@ namespace rttb
 			<li>standard deviation dose
 			<li>voxel positions of minimum dose
 			<li>voxel positions of maximum dose
+			<li>the maxNumberMinimaPositions coldest and the maxNumberMaximaPositions hottest voxels
 			</ul>
 			Additionally, these statistics are computed if computeComplexMeasures=true:
 			<ul>
@@ -188,7 +207,31 @@ namespace rttb
 			*/
 			void recalculateDoseStatistics();
 
+			/*! @brief Computes the DVH from the values recorded by calculateDoseStatistics(), without reading the dose
+				iterator again.
+				@param deltaD the bin width in Gy. If 0, it is determined from the maximum dose, like in
+				core::DVHCalculator.
+				@exception InvalidDoseException if the dose statistics are not already calculated
+				@exception InvalidParameterException if numberOfBins<=0, deltaD<0 or numberOfBins is too small
+			*/
+			core::DVH::Pointer calculateDVH(const IDType& structureID, const IDType& doseID, DoseTypeGy deltaD = 0,
+			                                int numberOfBins = 201) const;
+
+			/*! @brief If set, the complex dose statistics and the sums of the simple dose statistics are computed
+				concurrently on core::ThreadPool::getDefault(). The sums are reduced blockwise (see core::BlockwiseReduction),
+				so the results do not depend on the number of threads. Has to be set before calculateDoseStatistics() is called.
+			*/
 			void setMultiThreading(bool choice);
+
+			/*! @brief If set, the dose values are not recorded and the complex dose statistics Dx, MOHx and MOCx are
+				approximated within relativeAccuracy (relative error) using O(dose range / relativeAccuracy) memory instead
+				of O(number of voxels). MOHx/MOCx are then the mean of exactly the hottest/coldest x volume, whereas the exact
+				computation includes the whole voxel at the border. Vx is the exact volume for a dose within relativeAccuracy
+				of x. MaxOHx and MinOCx are not computed.
+				Has to be set before calculateDoseStatistics() is called.
+				@exception InvalidParameterException if choice is set and relativeAccuracy is not in (0, 1)
+			*/
+			void setApproximateMode(bool choice, double relativeAccuracy = 0.01);
 		};
 
 	}
@@ -14,6 +14,9 @@
 //------------------------------------------------------------------------
 
 #include "rttbDoseToVolumeMeasureCollection.h"
+
+#include <boost/make_shared.hpp>
+
 #include "rttbInvalidParameterException.h"
 #include "rttbDataNotAvailableException.h"
 
@@ -23,7 +26,7 @@ namespace rttb
 	namespace algorithms
 	{
 		DoseToVolumeMeasureCollection::DoseToVolumeMeasureCollection(complexStatistics name, DoseTypeGy referenceDose) :
-			_name(name), _referenceDose(referenceDose), _values(std::map<VolumeType, DoseTypeGy>()) {}
+			_name(name), _referenceDose(referenceDose), _values(std::map<VolumeType, DoseTypeGy>()), _valuesMutex(::boost::make_shared<std::mutex>()) {}
 
 		void DoseToVolumeMeasureCollection::setReferenceDose(DoseTypeGy referenceDose)
 		{
@@ -32,6 +35,7 @@ namespace rttb
 
 		void DoseToVolumeMeasureCollection::insertValue(DoseTypeGy dose, VolumeType volume)
 		{
+			std::lock_guard<std::mutex> lock(*_valuesMutex);
 			this->_values.insert(std::pair<DoseTypeGy, VolumeType>(dose, volume));
 		}
 
@@ -71,6 +75,7 @@ namespace rttb
 
 		DoseToVolumeMeasureCollection::DoseToVolumeFunctionType DoseToVolumeMeasureCollection::getAllValues() const
 		{
+			std::lock_guard<std::mutex> lock(*_valuesMutex);
 			return this->_values;
 		}
 
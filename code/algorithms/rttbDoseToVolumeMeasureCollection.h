@@ -16,6 +16,10 @@
 #ifndef __DOSE_TO_VOLUME_MEASURE_COLLECTION_H
 #define __DOSE_TO_VOLUME_MEASURE_COLLECTION_H
 
+#include <mutex>
+
+#include <boost/shared_ptr.hpp>
+
 #include "rttbMeasureCollection.h"
 #include <rttbCommon.h>
 
@@ -43,6 +47,7 @@ namespace rttb
 			complexStatistics _name;
 			DoseTypeGy _referenceDose;
 			DoseToVolumeFunctionType _values;
+			::boost::shared_ptr<std::mutex> _valuesMutex;
 
 		public:
 			DoseToVolumeMeasureCollection(complexStatistics name, DoseTypeGy referenceDose = -1);
@@ -51,6 +56,7 @@ namespace rttb
 			*/
 			void setReferenceDose(DoseTypeGy referenceDose);
 
+			/*! @brief Inserts a value; may be called concurrently by several threads.*/
 			void insertValue(DoseTypeGy dose, VolumeType volume);
 
 			/*! @brief Gets the volume irradiated with a dose >= x, depending on the complexStatistics name.
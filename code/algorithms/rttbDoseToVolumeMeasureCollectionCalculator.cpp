@@ -15,9 +15,8 @@
 
 #include "rttbDoseToVolumeMeasureCollectionCalculator.h"
 
-#include <thread>
-
 #include "rttbInvalidParameterException.h"
+#include "rttbThreadPool.h"
 #include "rttbUtils.h"
 
 #include <boost/make_shared.hpp>
@@ -37,15 +36,20 @@ namespace rttb
 
 		void DoseToVolumeMeasureCollectionCalculator::compute()
 		{
-			std::vector<std::thread> threads;
+			core::ThreadPool::TaskGroup tasks(core::ThreadPool::getDefault());
+			//a shared dose iterator cannot be traversed by several threads at once
+			const bool concurrent = _multiThreading && _doseIterator == nullptr;
 
 			for (double _precomputeDoseValue : _precomputeDoseValues)
 			{
 				double xAbsolute = _precomputeDoseValue * _referenceDose;
 				if (!rttb::core::isKey(_measureCollection->getAllValues(), xAbsolute)) {
-					if (_multiThreading)
+					if (concurrent)
 					{
-						throw rttb::core::InvalidParameterException("MultiThreading is not implemented yet.");
+						tasks.run([this, xAbsolute]()
+						{
+							insertIntoMeasureCollection(xAbsolute, this->computeSpecificValue(xAbsolute));
+						});
 					}
 					else
 					{
@@ -54,10 +58,7 @@ namespace rttb
 				}
 			}
 
-			for (auto & thread : threads)
-			{
-				thread.join();
-			}
+			tasks.wait();
 		}
 		
 		void DoseToVolumeMeasureCollectionCalculator::addPrecomputeDoseValues(const std::vector<double>& values)
@@ -62,6 +62,8 @@ namespace rttb
 
 		public:
 			/*! @brief Computes not already computed values for the measureCollection. Algorithm for the specific complex Statistic has to be implemented in the corresponding subclass.
+				@details With multiThreading the values are computed concurrently on core::ThreadPool::getDefault(),
+				unless the calculator works on a dose iterator.
 			*/
 			void compute();
 			/*! @brief Adds additional values to the _precomputeDoseValues vector.
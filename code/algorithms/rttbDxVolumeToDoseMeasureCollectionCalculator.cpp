@@ -21,35 +21,21 @@ namespace rttb
 	namespace algorithms
 	{
 		DxVolumeToDoseMeasureCollectionCalculator::DxVolumeToDoseMeasureCollectionCalculator(const std::vector<double>& precomputeVolumeValues,
-			const VolumeType volume, const std::vector<DoseTypeGy>& doseVector, const std::vector<double>& voxelProportionVector,
+			const VolumeType volume, SortedDoseBuffer::ConstPointer sortedDoses, 
 			const DoseVoxelVolumeType currentVoxelVolume, const DoseStatisticType minimum, bool multiThreading) :
-			VolumeToDoseMeasureCollectionCalculator(precomputeVolumeValues, volume, doseVector, voxelProportionVector, currentVoxelVolume,
+			VolumeToDoseMeasureCollectionCalculator(precomputeVolumeValues, volume, sortedDoses, currentVoxelVolume,
 				VolumeToDoseMeasureCollection::Dx, multiThreading), _minimum(minimum) {}
 
 		DoseTypeGy DxVolumeToDoseMeasureCollectionCalculator::computeSpecificValue(double xAbsolute) const
 		{
-			double noOfVoxel = xAbsolute / _currentVoxelVolume;
-			DoseTypeGy resultDose = 0;
+			const std::size_t index = _sortedDoses->findFromTop(xAbsolute / _currentVoxelVolume);
 
-			double countVoxels = 0;
-			bool voxelOverflow = false;
-			for (auto i = _doseVector.size() - 1; i != static_cast<size_t>(-1); i--)
+			if (index == _sortedDoses->size())
 			{
-				countVoxels += _voxelProportionVector.at(i);
-
-				if (countVoxels >= noOfVoxel)
-				{
-					voxelOverflow = true;
-					resultDose = _doseVector.at(i);
-					break;
-				}
+				return _minimum;
 			}
 
-			if (!voxelOverflow)
-			{
-				resultDose = _minimum;
-			}
-			return resultDose;
+			return _sortedDoses->getDoseValues()[index];
 		}
 	}
 }
\ No newline at end of file
@@ -37,7 +37,7 @@ namespace rttb
 
 		public:			
 			DxVolumeToDoseMeasureCollectionCalculator(const std::vector<double>& precomputeVolumeValues, const VolumeType volume,
-				const std::vector<DoseTypeGy>& doseVector, const std::vector<double>& voxelProportionVector, 
+				SortedDoseBuffer::ConstPointer sortedDoses, 
 				const DoseVoxelVolumeType currentVoxelVolume, const DoseStatisticType minimum, bool multiThreading = false);
 
 		protected:
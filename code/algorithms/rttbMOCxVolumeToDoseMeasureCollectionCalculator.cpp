@@ -21,9 +21,9 @@ namespace rttb
 	namespace algorithms
 	{
 		MOCxVolumeToDoseMeasureCollectionCalculator::MOCxVolumeToDoseMeasureCollectionCalculator(const std::vector<double>& precomputeVolumeValues,
-			const VolumeType volume, const std::vector<DoseTypeGy>& doseVector, const std::vector<double>& voxelProportionVector,
+			const VolumeType volume, SortedDoseBuffer::ConstPointer sortedDoses, 
 			const DoseVoxelVolumeType currentVoxelVolume, bool multiThreading) : VolumeToDoseMeasureCollectionCalculator(precomputeVolumeValues, volume,
-				doseVector, voxelProportionVector, currentVoxelVolume, VolumeToDoseMeasureCollection::MOCx, multiThreading) {}
+				sortedDoses, currentVoxelVolume, VolumeToDoseMeasureCollection::MOCx, multiThreading) {}
 
 		DoseTypeGy MOCxVolumeToDoseMeasureCollectionCalculator::computeSpecificValue(double xAbsolute) const
 		{
@@ -34,22 +34,21 @@ namespace rttb
 			}
 			else
 			{
-				double countVoxels = 0;
-				double sum = 0;
-				auto it = _doseVector.begin();
-				auto itD = _voxelProportionVector.begin();
+				const std::size_t index = _sortedDoses->findFromBottom(noOfVoxel);
+				const DoseCalcType totalDose = _sortedDoses->getCumulativeDose(0);
+				//if the structure is smaller than xAbsolute, all voxels are used
+				DoseCalcType sum = index == _sortedDoses->size() ? totalDose : totalDose -
+				                   _sortedDoses->getCumulativeDose(index + 1);
 
-				for (; it != _doseVector.end(); ++it, ++itD)
+				if (_sortedDoses->hasAggregatedPositions() && index != _sortedDoses->size())
 				{
-					double voxelProportion = *itD;
-					countVoxels += voxelProportion;
-					sum += (*it) * voxelProportion;
-
-					if (countVoxels >= noOfVoxel)
-					{
-						break;
-					}
+					//only the needed part of the last position
+					const FractionType belowIndex = _sortedDoses->getTotalVoxelProportion() -
+					                                _sortedDoses->getCumulativeVoxelProportion(index);
+					sum = totalDose - _sortedDoses->getCumulativeDose(index) + (noOfVoxel - belowIndex) *
+					      _sortedDoses->getDoseValues()[index];
 				}
+
 				return static_cast<DoseTypeGy>(sum / noOfVoxel);
 			}
 		}
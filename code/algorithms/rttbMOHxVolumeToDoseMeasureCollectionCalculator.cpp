@@ -21,9 +21,9 @@ namespace rttb
 	namespace algorithms
 	{
 		MOHxVolumeToDoseMeasureCollectionCalculator::MOHxVolumeToDoseMeasureCollectionCalculator(const std::vector<double>& precomputeVolumeValues,
-			const VolumeType volume, const std::vector<DoseTypeGy>& doseVector, const std::vector<double>& voxelProportionVector,
+			const VolumeType volume, SortedDoseBuffer::ConstPointer sortedDoses, 
 			const DoseVoxelVolumeType currentVoxelVolume, bool multiThreading) :
-			VolumeToDoseMeasureCollectionCalculator(precomputeVolumeValues, volume, doseVector, voxelProportionVector, currentVoxelVolume,
+			VolumeToDoseMeasureCollectionCalculator(precomputeVolumeValues, volume, sortedDoses, currentVoxelVolume,
 				VolumeToDoseMeasureCollection::MOHx, multiThreading) {}
 
 		DoseTypeGy MOHxVolumeToDoseMeasureCollectionCalculator::computeSpecificValue(double xAbsolute) const
@@ -36,20 +36,23 @@ namespace rttb
 			}
 			else
 			{
-				double countVoxels = 0;
-				double sum = 0;
+				const std::size_t index = _sortedDoses->findFromTop(noOfVoxel);
 
-				for (auto i = _doseVector.size() - 1; i!=static_cast<size_t>(-1); i--)
+				//if the structure is smaller than xAbsolute, all voxels are used
+				if (index == _sortedDoses->size())
 				{
-					double voxelProportion = _voxelProportionVector.at(i);
-					countVoxels += voxelProportion;
-					sum += _doseVector.at(i) * voxelProportion;
-
-					if (countVoxels >= noOfVoxel)
-					{
-						break;
-					}
+					return static_cast<DoseTypeGy>(_sortedDoses->getCumulativeDose(0) / noOfVoxel);
 				}
+
+				DoseCalcType sum = _sortedDoses->getCumulativeDose(index);
+
+				if (_sortedDoses->hasAggregatedPositions())
+				{
+					//only the needed part of the last position
+					sum = _sortedDoses->getCumulativeDose(index + 1) + (noOfVoxel - _sortedDoses->getCumulativeVoxelProportion(
+					          index + 1)) * _sortedDoses->getDoseValues()[index];
+				}
+
 				return static_cast<DoseTypeGy>(sum / noOfVoxel);
 			}
 		}
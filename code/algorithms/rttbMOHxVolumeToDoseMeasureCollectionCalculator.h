@@ -36,7 +36,7 @@ namespace rttb
 
 		public:
 			MOHxVolumeToDoseMeasureCollectionCalculator(const std::vector<double>& precomputeVolumeValues, const VolumeType volume,
-				const std::vector<DoseTypeGy>& doseVector, const std::vector<double>& voxelProportionVector,
+				SortedDoseBuffer::ConstPointer sortedDoses, 
 				const DoseVoxelVolumeType currentVoxelVolume, bool multiThreading = false);
 
 		protected:
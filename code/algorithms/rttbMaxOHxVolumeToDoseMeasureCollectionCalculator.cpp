@@ -21,31 +21,20 @@ namespace rttb
 	namespace algorithms
 	{
 		MaxOHxVolumeToDoseMeasureCollectionCalculator::MaxOHxVolumeToDoseMeasureCollectionCalculator(const std::vector<double>& precomputeVolumeValues,
-			const VolumeType volume, const std::vector<DoseTypeGy>& doseVector, const std::vector<double>& voxelProportionVector,
+			const VolumeType volume, SortedDoseBuffer::ConstPointer sortedDoses, 
 			const DoseVoxelVolumeType currentVoxelVolume, bool multiThreading) : VolumeToDoseMeasureCollectionCalculator(precomputeVolumeValues, volume,
-				doseVector, voxelProportionVector, currentVoxelVolume, VolumeToDoseMeasureCollection::MaxOHx, multiThreading) {}
+				sortedDoses, currentVoxelVolume, VolumeToDoseMeasureCollection::MaxOHx, multiThreading) {}
 
 		DoseTypeGy MaxOHxVolumeToDoseMeasureCollectionCalculator::computeSpecificValue(double xAbsolute) const
 		{
-			double noOfVoxel = xAbsolute / _currentVoxelVolume;
-			DoseTypeGy resultDose = 0;
+			const std::size_t index = _sortedDoses->findFromTop(xAbsolute / _currentVoxelVolume);
 
-			double countVoxels = 0;
-			for (auto i = _doseVector.size() - 1; i!=static_cast<size_t>(-1); i--)
+			if (index == _sortedDoses->size() || index == 0)
 			{
-				countVoxels += _voxelProportionVector.at(i);
-
-				if (countVoxels >= noOfVoxel)
-				{
-					if (i > 0)
-					{
-						resultDose = _doseVector.at(i - 1);
-					}
-					break;
-				}
+				return 0;
 			}
 
-			return resultDose;
+			return _sortedDoses->getDoseValues()[index - 1];
 		}
 	}
 }
\ No newline at end of file
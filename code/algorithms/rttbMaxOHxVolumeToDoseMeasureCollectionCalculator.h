@@ -31,7 +31,7 @@ namespace rttb
 		public:
       rttbClassMacro(MaxOHxVolumeToDoseMeasureCollectionCalculator, VolumeToDoseMeasureCollectionCalculator)
 			MaxOHxVolumeToDoseMeasureCollectionCalculator(const std::vector<double>& precomputeVolumeValues, const VolumeType volume,
-				const std::vector<DoseTypeGy>& doseVector, const std::vector<double>& voxelProportionVector,
+				SortedDoseBuffer::ConstPointer sortedDoses, 
 				const DoseVoxelVolumeType currentVoxelVolume, bool multiThreading = false);
 
 		protected:
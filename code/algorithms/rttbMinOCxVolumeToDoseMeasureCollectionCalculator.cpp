@@ -21,49 +21,28 @@ namespace rttb
 	namespace algorithms
 	{
 		MinOCxVolumeToDoseMeasureCollectionCalculator::MinOCxVolumeToDoseMeasureCollectionCalculator(const std::vector<double>& precomputeVolumeValues,
-			const VolumeType volume, const std::vector<DoseTypeGy>& doseVector, const std::vector<double>& voxelProportionVector,
+			const VolumeType volume, SortedDoseBuffer::ConstPointer sortedDoses, 
 			const DoseVoxelVolumeType currentVoxelVolume, const DoseStatisticType minimum, const DoseStatisticType maximum, 
 			bool multiThreading) : VolumeToDoseMeasureCollectionCalculator(precomputeVolumeValues, volume,
-				doseVector, voxelProportionVector, currentVoxelVolume, VolumeToDoseMeasureCollection::MinOCx, 
+				sortedDoses, currentVoxelVolume, VolumeToDoseMeasureCollection::MinOCx, 
 				multiThreading), _minimum(minimum), _maximum(maximum) {}
 
 		DoseTypeGy MinOCxVolumeToDoseMeasureCollectionCalculator::computeSpecificValue(double xAbsolute) const
 		{
-			double noOfVoxel = xAbsolute / _currentVoxelVolume;
-			DoseTypeGy resultDose = 0;
+			const std::size_t index = _sortedDoses->findFromBottom(xAbsolute / _currentVoxelVolume);
 
-			double countVoxels = 0;
-			auto it = _doseVector.begin();
-			auto itD = _voxelProportionVector.begin();
-
-			for (; itD != _voxelProportionVector.end(); ++itD, ++it)
+			if (index == _sortedDoses->size())
 			{
-				countVoxels += *itD;
-
-				if (countVoxels >= noOfVoxel)
-				{
-					break;
-				}
+				return (DoseTypeGy)_minimum;
 			}
-
-			if (it != _doseVector.end())
+			else if (index + 1 < _sortedDoses->size())
 			{
-				++it;
-
-				if (it != _doseVector.end())
-				{
-					resultDose = *it;
-				}
-				else
-				{
-					resultDose = (DoseTypeGy)_maximum;
-				}
+				return _sortedDoses->getDoseValues()[index + 1];
 			}
 			else
 			{
-				resultDose = (DoseTypeGy)_minimum;
+				return (DoseTypeGy)_maximum;
 			}
-			return resultDose;
 		}
 	}
 }
\ No newline at end of file
@@ -0,0 +1,191 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+#include "rttbSortedDoseBuffer.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+
+#include "rttbInvalidParameterException.h"
+#include "rttbThreadPool.h"
+
+namespace rttb
+{
+
+	namespace algorithms
+	{
+		namespace
+		{
+			/*! @brief sort key: the dose and the original position, so that equal doses keep their order*/
+			using SortKey = std::pair<DoseTypeGy, std::uint32_t>;
+
+			/*! @brief every sorting task gets at least this number of values*/
+			const std::size_t minimumValuesPerChunk = 1 << 16;
+
+			/*! @brief Sorts keys in numberOfChunks tasks on the shared thread pool: every task sorts one chunk, then
+				the sorted chunks are merged pairwise (again one task per merge).
+			*/
+			void parallelSort(std::vector<SortKey>& keys, std::size_t numberOfChunks)
+			{
+				std::vector<std::size_t> bounds(numberOfChunks + 1);
+
+				for (std::size_t chunk = 0; chunk <= numberOfChunks; ++chunk)
+				{
+					bounds[chunk] = keys.size() * chunk / numberOfChunks;
+				}
+
+				core::ThreadPool::TaskGroup sortGroup(core::ThreadPool::getDefault());
+
+				for (std::size_t chunk = 0; chunk < numberOfChunks; ++chunk)
+				{
+					sortGroup.run([&keys, &bounds, chunk]()
+					{
+						std::sort(keys.begin() + bounds[chunk], keys.begin() + bounds[chunk + 1]);
+					});
+				}
+
+				sortGroup.wait();
+
+				for (std::size_t width = 1; width < numberOfChunks; width *= 2)
+				{
+					core::ThreadPool::TaskGroup mergeGroup(core::ThreadPool::getDefault());
+
+					for (std::size_t chunk = 0; chunk + width < numberOfChunks; chunk += 2 * width)
+					{
+						const std::size_t first = bounds[chunk];
+						const std::size_t middle = bounds[chunk + width];
+						const std::size_t last = bounds[std::min(chunk + 2 * width, numberOfChunks)];
+						mergeGroup.run([&keys, first, middle, last]()
+						{
+							std::inplace_merge(keys.begin() + first, keys.begin() + middle, keys.begin() + last);
+						});
+					}
+
+					mergeGroup.wait();
+				}
+			}
+		}
+
+		SortedDoseBuffer::SortedDoseBuffer(const std::vector<DoseTypeGy>& doseValues,
+		                                   const std::vector<FractionType>& voxelProportions, unsigned int numberOfThreads) :
+			_aggregatedPositions(false)
+		{
+			if (doseValues.size() != voxelProportions.size())
+			{
+				throw core::InvalidParameterException("doseValues and voxelProportions must have the same size!");
+			}
+
+			std::vector<SortKey> keys(doseValues.size());
+
+			for (std::size_t i = 0; i < keys.size(); ++i)
+			{
+				keys[i] = SortKey(doseValues[i], static_cast<std::uint32_t>(i));
+			}
+
+			if (numberOfThreads == 0)
+			{
+				numberOfThreads = core::ThreadPool::getDefault().getNumberOfThreads();
+			}
+
+			const std::size_t numberOfChunks = std::max<std::size_t>(1, std::min<std::size_t>(numberOfThreads,
+			                                   keys.size() / minimumValuesPerChunk));
+
+			if (numberOfChunks == 1)
+			{
+				std::sort(keys.begin(), keys.end());
+			}
+			else
+			{
+				parallelSort(keys, numberOfChunks);
+			}
+
+			_doseValues.resize(keys.size());
+			_cumulativeVoxelProportions.resize(keys.size() + 1);
+			_cumulativeDoses.resize(keys.size() + 1);
+			_cumulativeVoxelProportions.back() = 0;
+			_cumulativeDoses.back() = 0;
+
+			for (std::size_t i = keys.size(); i > 0; --i)
+			{
+				const DoseTypeGy dose = keys[i - 1].first;
+				const FractionType voxelProportion = voxelProportions[keys[i - 1].second];
+				_doseValues[i - 1] = dose;
+				_cumulativeVoxelProportions[i - 1] = _cumulativeVoxelProportions[i] + voxelProportion;
+				_cumulativeDoses[i - 1] = _cumulativeDoses[i] + dose * voxelProportion;
+			}
+		}
+
+		SortedDoseBuffer::SortedDoseBuffer(const DoseQuantileSketch& sketch) : _aggregatedPositions(true)
+		{
+			std::vector<FractionType> voxelProportions;
+			//already in ascending order
+			sketch.getBuckets(_doseValues, voxelProportions);
+
+			_cumulativeVoxelProportions.resize(_doseValues.size() + 1);
+			_cumulativeDoses.resize(_doseValues.size() + 1);
+			_cumulativeVoxelProportions.back() = 0;
+			_cumulativeDoses.back() = 0;
+
+			for (std::size_t i = _doseValues.size(); i > 0; --i)
+			{
+				_cumulativeVoxelProportions[i - 1] = _cumulativeVoxelProportions[i] + voxelProportions[i - 1];
+				_cumulativeDoses[i - 1] = _cumulativeDoses[i] + _doseValues[i - 1] * voxelProportions[i - 1];
+			}
+		}
+
+		FractionType SortedDoseBuffer::getVoxelProportionAtLeast(DoseTypeGy dose) const
+		{
+			const auto first = std::lower_bound(_doseValues.cbegin(), _doseValues.cend(), dose);
+			return _cumulativeVoxelProportions[first - _doseValues.cbegin()];
+		}
+
+		std::size_t SortedDoseBuffer::findFromTop(FractionType numberOfVoxels) const
+		{
+			//_cumulativeVoxelProportions is non-increasing: find the first index below numberOfVoxels
+			const auto end = _cumulativeVoxelProportions.cbegin() + _doseValues.size();
+			const auto below = std::partition_point(_cumulativeVoxelProportions.cbegin(), end,
+			                                        [numberOfVoxels](FractionType cumulative)
+			{
+				return cumulative >= numberOfVoxels;
+			});
+
+			if (below == _cumulativeVoxelProportions.cbegin())
+			{
+				return _doseValues.size();
+			}
+
+			return (below - _cumulativeVoxelProportions.cbegin()) - 1;
+		}
+
+		std::size_t SortedDoseBuffer::findFromBottom(FractionType numberOfVoxels) const
+		{
+			const FractionType total = getTotalVoxelProportion();
+			const auto reached = std::partition_point(_cumulativeVoxelProportions.cbegin() + 1,
+			                     _cumulativeVoxelProportions.cend(), [numberOfVoxels, total](FractionType cumulative)
+			{
+				return total - cumulative < numberOfVoxels;
+			});
+
+			return reached - (_cumulativeVoxelProportions.cbegin() + 1);
+		}
+
+		std::size_t SortedDoseBuffer::getMemorySize() const
+		{
+			return _doseValues.capacity() * sizeof(DoseTypeGy) + _cumulativeVoxelProportions.capacity() * sizeof(
+			           FractionType) + _cumulativeDoses.capacity() * sizeof(DoseCalcType);
+		}
+	}
+}
@@ -0,0 +1,155 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+#ifndef __SORTED_DOSE_BUFFER_H
+#define __SORTED_DOSE_BUFFER_H
+
+#include <vector>
+
+#include "rttbBaseType.h"
+#include "rttbCommon.h"
+
+#include "RTTBAlgorithmsExports.h"
+
+#include "rttbDoseQuantileSketch.h"
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+
+namespace rttb
+{
+
+	namespace algorithms
+	{
+		/*! @class SortedDoseBuffer
+		@brief Dose values of a structure sorted by ascending dose, with cumulative voxel proportions and cumulative
+		dose*voxel proportion, so that Vx, Dx, MOHx, MOCx, MaxOHx and MinOCx are answered by binary search.
+		@details Structure of arrays, 24 bytes per voxel: the sorted doses, and for every position i the sums over all
+		positions >= i (the "hottest" part) of the voxel proportions and of dose*voxel proportion. The sums are
+		accumulated from the highest dose downwards, i.e. in the order in which the calculators used to walk the sorted
+		values. Equal doses keep the order in which they were given, so the index does not depend on the number of
+		threads used for sorting.
+		The doses are sorted as double (DoseTypeGy) keys together with their original position (16 bytes per voxel,
+		freed after construction). Float keys would halve this, but would merge doses that differ only beyond float
+		precision and thereby change the order of the cumulative sums, i.e. the statistics would no longer be
+		bit-identical to the former multimap based calculation.
+		The buffer is built once per structure and shared by the measure collection calculators of one
+		DoseStatisticsCalculator.
+		*/
+		class RTTBAlgorithms_EXPORT SortedDoseBuffer
+		{
+		public:
+			rttbClassMacroNoParent(SortedDoseBuffer)
+
+		private:
+			std::vector<DoseTypeGy> _doseValues;
+			/*! @brief _cumulativeVoxelProportions[i]: sum of the voxel proportions of positions >= i (size()+1 entries)*/
+			std::vector<FractionType> _cumulativeVoxelProportions;
+			/*! @brief _cumulativeDoses[i]: sum of dose*voxel proportion of positions >= i (size()+1 entries)*/
+			std::vector<DoseCalcType> _cumulativeDoses;
+			bool _aggregatedPositions;
+
+		public:
+			/*! @brief Sorts the given values and builds the cumulative sums.
+				@param doseValues dose values (e.g. in iteration order)
+				@param voxelProportions the voxel proportions corresponding to doseValues
+				@param numberOfThreads number of chunks that are sorted in parallel on the shared thread pool. 0: use the
+				number of threads of the pool.
+				@exception InvalidParameterException if doseValues and voxelProportions differ in size
+			*/
+			SortedDoseBuffer(const std::vector<DoseTypeGy>& doseValues, const std::vector<FractionType>& voxelProportions,
+			                 unsigned int numberOfThreads = 0);
+
+			/*! @brief Uses the buckets of a sketch as positions: every position stands for all voxels of a bucket.*/
+			explicit SortedDoseBuffer(const DoseQuantileSketch& sketch);
+
+			virtual ~SortedDoseBuffer() = default;
+
+			std::size_t size() const
+			{
+				return _doseValues.size();
+			};
+
+			bool empty() const
+			{
+				return _doseValues.empty();
+			};
+
+			/*! @brief true if a position stands for several voxels of (approximately) the same dose, i.e. the buffer was
+				built from a DoseQuantileSketch. Measures that use a part of a position have to interpolate within it.
+			*/
+			bool hasAggregatedPositions() const
+			{
+				return _aggregatedPositions;
+			};
+
+			/*! @brief dose values in ascending order*/
+			const std::vector<DoseTypeGy>& getDoseValues() const
+			{
+				return _doseValues;
+			};
+
+			/*! @brief sum of the voxel proportions of the positions >= index.
+				@pre index <= size()
+			*/
+			FractionType getCumulativeVoxelProportion(std::size_t index) const
+			{
+				return _cumulativeVoxelProportions[index];
+			};
+
+			/*! @brief sum of dose*voxel proportion of the positions >= index.
+				@pre index <= size()
+			*/
+			DoseCalcType getCumulativeDose(std::size_t index) const
+			{
+				return _cumulativeDoses[index];
+			};
+
+			/*! @brief sum of all voxel proportions (number of voxels)*/
+			FractionType getTotalVoxelProportion() const
+			{
+				return _cumulativeVoxelProportions.front();
+			};
+
+			/*! @brief sum of voxel proportions of all positions with a dose >= dose (O(log n))*/
+			FractionType getVoxelProportionAtLeast(DoseTypeGy dose) const;
+
+			/*! @brief Walking from the highest dose downwards: the first position at which the accumulated voxel
+				proportion reaches numberOfVoxels, i.e. the largest index with getCumulativeVoxelProportion(index) >=
+				numberOfVoxels (O(log n)).
+				@return the index, or size() if the total voxel proportion is below numberOfVoxels.
+			*/
+			std::size_t findFromTop(FractionType numberOfVoxels) const;
+
+			/*! @brief Walking from the lowest dose upwards: the first position at which the accumulated voxel
+				proportion (getTotalVoxelProportion() - getCumulativeVoxelProportion(index + 1)) reaches
+				numberOfVoxels (O(log n)).
+				@return the index, or size() if the total voxel proportion is below numberOfVoxels.
+			*/
+			std::size_t findFromBottom(FractionType numberOfVoxels) const;
+
+			/*! @brief memory used by the index in bytes*/
+			std::size_t getMemorySize() const;
+		};
+	}
+}
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif
@@ -14,6 +14,9 @@
 //------------------------------------------------------------------------
 
 #include "rttbVolumeToDoseMeasureCollection.h"
+
+#include <boost/make_shared.hpp>
+
 #include "rttbInvalidParameterException.h"
 #include "rttbDataNotAvailableException.h"
 
@@ -23,7 +26,7 @@ namespace rttb
 	namespace algorithms
 	{
 		VolumeToDoseMeasureCollection::VolumeToDoseMeasureCollection(complexStatistics name, VolumeType volume) :
-			_name(name), _volume(volume), _values(std::map<VolumeType, DoseTypeGy>()) {}
+			_name(name), _volume(volume), _values(std::map<VolumeType, DoseTypeGy>()), _valuesMutex(::boost::make_shared<std::mutex>()) {}
 
 		void VolumeToDoseMeasureCollection::setVolume(VolumeType volume)
 		{
@@ -32,6 +35,7 @@ namespace rttb
 
 		void VolumeToDoseMeasureCollection::insertValue(VolumeType volume, DoseTypeGy dose)
 		{
+			std::lock_guard<std::mutex> lock(*_valuesMutex);
 			this->_values.insert(std::pair<VolumeType, DoseTypeGy>(volume, dose));
 		}
 
@@ -77,6 +81,7 @@ namespace rttb
 
 		VolumeToDoseMeasureCollection::VolumeToDoseFunctionType VolumeToDoseMeasureCollection::getAllValues() const
 		{
+			std::lock_guard<std::mutex> lock(*_valuesMutex);
 			return this->_values;
 		}
 
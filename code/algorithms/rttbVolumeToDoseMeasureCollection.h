@@ -16,6 +16,10 @@
 #ifndef __VOLUME_TO_DOSE_MEASURE_COLLECTION_H
 #define __VOLUME_TO_DOSE_MEASURE_COLLECTION_H
 
+#include <mutex>
+
+#include <boost/shared_ptr.hpp>
+
 #include "rttbMeasureCollection.h"
 #include <rttbCommon.h>
 
@@ -43,6 +47,7 @@ namespace rttb
       complexStatistics _name;
 			VolumeType _volume;
 			VolumeToDoseFunctionType _values;
+			::boost::shared_ptr<std::mutex> _valuesMutex;
 
 		public:
 			VolumeToDoseMeasureCollection(complexStatistics name, VolumeType volume = -1);
@@ -51,6 +56,7 @@ namespace rttb
 			*/
 			void setVolume(VolumeType volume);
 
+			/*! @brief Inserts a value; may be called concurrently by several threads.*/
 			void insertValue(VolumeType volume, DoseTypeGy dose);
 
 			/*! @brief Gets the x of the current volume, depending on the complexStatistics name.
@@ -15,9 +15,9 @@
 
 #include "rttbVolumeToDoseMeasureCollectionCalculator.h"
 
-#include <thread>
-
 #include "rttbInvalidParameterException.h"
+#include "rttbNullPointerException.h"
+#include "rttbThreadPool.h"
 #include "rttbUtils.h"
 
 #include <boost/make_shared.hpp>
@@ -27,9 +27,23 @@ namespace rttb
 
 	namespace algorithms
 	{
+		namespace
+		{
+			SortedDoseBuffer::ConstPointer checkSortedDoses(SortedDoseBuffer::ConstPointer sortedDoses)
+			{
+				if (sortedDoses == nullptr)
+				{
+					throw core::NullPointerException("sortedDoses must not be nullptr!");
+				}
+
+				return sortedDoses;
+			}
+		}
+
 		VolumeToDoseMeasureCollectionCalculator::VolumeToDoseMeasureCollectionCalculator(const std::vector<double>& precomputeVolumeValues, const VolumeType volume,
-			const std::vector<DoseTypeGy>& doseVector, const std::vector<double>& voxelProportionVector, const DoseVoxelVolumeType currentVoxelVolume,
-			VolumeToDoseMeasureCollection::complexStatistics name, bool multiThreading) : _doseVector(doseVector), _currentVoxelVolume(currentVoxelVolume), _voxelProportionVector(voxelProportionVector),
+			SortedDoseBuffer::ConstPointer sortedDoses, const DoseVoxelVolumeType currentVoxelVolume,
+			VolumeToDoseMeasureCollection::complexStatistics name, bool multiThreading) : _sortedDoses(checkSortedDoses(sortedDoses)),
+			_currentVoxelVolume(currentVoxelVolume),
 			_volume(volume), _measureCollection(::boost::make_shared<VolumeToDoseMeasureCollection>(name)),  _multiThreading(multiThreading)
         {
             addPrecomputeVolumeValues(precomputeVolumeValues);
@@ -37,7 +51,7 @@ namespace rttb
 
 		void VolumeToDoseMeasureCollectionCalculator::compute()
 		{
-			std::vector<std::thread> threads;
+			core::ThreadPool::TaskGroup tasks(core::ThreadPool::getDefault());
 
 			for (double _precomputeVolumeValue : _precomputeVolumeValues)
 			{
@@ -45,7 +59,10 @@ namespace rttb
 				if (!rttb::core::isKey(_measureCollection->getAllValues(), xAbsolute)) {
 					if (_multiThreading)
 					{
-						throw rttb::core::InvalidParameterException("MultiThreading is not implemented yet.");
+						tasks.run([this, xAbsolute]()
+						{
+							insertIntoMeasureCollection(xAbsolute, this->computeSpecificValue(xAbsolute));
+						});
 					}
 					else
 					{
@@ -54,13 +71,7 @@ namespace rttb
 				}				
 			}
 
-			for (auto & thread : threads)
-			{
-        if (thread.joinable())
-        {
-          thread.join();
-        }
-			}
+			tasks.wait();
 		}
 		void VolumeToDoseMeasureCollectionCalculator::addPrecomputeVolumeValues(const std::vector<double>& values)
 		{
@@ -19,6 +19,7 @@
 #include "rttbVolumeToDoseMeasureCollection.h"
 #include <rttbCommon.h>
 #include "rttbDoseStatistics.h"
+#include "rttbSortedDoseBuffer.h"
 
 #ifdef _MSC_VER
 #pragma warning(push)
@@ -43,9 +44,9 @@ namespace rttb
 			typedef std::map<VolumeType, DoseTypeGy> VolumeToDoseFunctionType;
 
 		protected:
-			std::vector<DoseTypeGy> _doseVector;
+			/*! @brief sorted doses with cumulative volumes, shared with the other calculators of the structure*/
+			SortedDoseBuffer::ConstPointer _sortedDoses;
 			DoseVoxelVolumeType _currentVoxelVolume;
-			std::vector<double> _voxelProportionVector;
 
 		private:
       std::vector<double> _precomputeVolumeValues;
@@ -55,6 +56,7 @@ namespace rttb
 
 		public:
 			/*!  @brief Computes not already computed values for the measureCollection. Algorithm for the specific complex Statistic has to be implemented in the corresponding subclass.
+				@details With multiThreading the values are computed concurrently on core::ThreadPool::getDefault().
 			*/
 			void compute();
 			/*! @brief Adds additional values to the _precomputeVolumeValues vector.
@@ -65,7 +67,7 @@ namespace rttb
 
 		protected:
 			VolumeToDoseMeasureCollectionCalculator(const std::vector<double>& precomputeVolumeValues, const VolumeType volume,
-				const std::vector<DoseTypeGy>& doseVector, const std::vector<double>& voxelProportionVector,
+				SortedDoseBuffer::ConstPointer sortedDoses, 
 				const DoseVoxelVolumeType currentVoxelVolume, VolumeToDoseMeasureCollection::complexStatistics name, bool multiThreading);
 
 			void insertIntoMeasureCollection(VolumeType xAbsolute, DoseTypeGy resultDose);
@@ -15,6 +15,8 @@
 
 #include "rttbVxDoseToVolumeMeasureCollectionCalculator.h"
 
+#include "rttbNullPointerException.h"
+
 namespace rttb
 {
 
@@ -22,26 +24,45 @@ namespace rttb
 	{
 		VxDoseToVolumeMeasureCollectionCalculator::VxDoseToVolumeMeasureCollectionCalculator(const std::vector<double>& precomputeDoseValues,
 			const DoseTypeGy referenceDose, const core::DoseIteratorInterface::Pointer doseIterator, bool multiThreading) :
-			DoseToVolumeMeasureCollectionCalculator(precomputeDoseValues, referenceDose, doseIterator, DoseToVolumeMeasureCollection::Vx, multiThreading) {}
+			DoseToVolumeMeasureCollectionCalculator(precomputeDoseValues, referenceDose, doseIterator, DoseToVolumeMeasureCollection::Vx, multiThreading),
+			_currentVoxelVolume(0) {}
+
+		VxDoseToVolumeMeasureCollectionCalculator::VxDoseToVolumeMeasureCollectionCalculator(const std::vector<double>& precomputeDoseValues,
+			const DoseTypeGy referenceDose, SortedDoseBuffer::ConstPointer sortedDoses,
+			const DoseVoxelVolumeType currentVoxelVolume, bool multiThreading) :
+			DoseToVolumeMeasureCollectionCalculator(precomputeDoseValues, referenceDose, nullptr, DoseToVolumeMeasureCollection::Vx, multiThreading),
+			_sortedDoses(sortedDoses), _currentVoxelVolume(currentVoxelVolume)
+		{
+			if (_sortedDoses == nullptr)
+			{
+				throw core::NullPointerException("sortedDoses must not be nullptr!");
+			}
+		}
 
 		VolumeType VxDoseToVolumeMeasureCollectionCalculator::computeSpecificValue(double xAbsolute) const
 		{
+			if (_sortedDoses)
+			{
+				return _sortedDoses->getVoxelProportionAtLeast(xAbsolute) * _currentVoxelVolume;
+			}
 
 			rttb::FractionType count = 0;
 			_doseIterator->reset();
 
-			DoseTypeGy currentDose = 0;
+			std::vector<DoseTypeGy> doseValues(core::DoseIteratorInterface::defaultBlockSize);
+			std::vector<FractionType> fractions(core::DoseIteratorInterface::defaultBlockSize);
+			std::size_t blockSize = 0;
 
-			while (_doseIterator->isPositionValid())
+			while ((blockSize = _doseIterator->nextBlock(doseValues.size(), doseValues.data(), fractions.data(),
+			                    nullptr)) > 0)
 			{
-				currentDose = _doseIterator->getCurrentDoseValue();
-
-				if (currentDose >= xAbsolute)
+				for (std::size_t i = 0; i < blockSize; ++i)
 				{
-					count += _doseIterator->getCurrentRelevantVolumeFraction();
+					if (doseValues[i] >= xAbsolute)
+					{
+						count += fractions[i];
+					}
 				}
-
-				_doseIterator->next();
 			}
 			return count * this->_doseIterator->getCurrentVoxelVolume();
 		}
@@ -17,6 +17,7 @@
 #define __DV_DOSE_TO_VOLUME_MEASURE_CALCULATOR_H
 
 #include "rttbDoseToVolumeMeasureCollectionCalculator.h"
+#include "rttbSortedDoseBuffer.h"
 
 #include <rttbCommon.h>
 
@@ -27,6 +28,8 @@ namespace rttb
 	{
 		/*! @class VxDoseToVolumeMeasureCollectionCalculator
 		@brief Class for calculating Vx DoseToVolume measures
+		@details Either iterates the dose for every value or, if constructed with a SortedDoseBuffer, answers every
+		value by binary search.
 		*/
 		class RTTBAlgorithms_EXPORT VxDoseToVolumeMeasureCollectionCalculator : public DoseToVolumeMeasureCollectionCalculator {
 
@@ -36,6 +39,17 @@ namespace rttb
 				const DoseTypeGy referenceDose, const core::DoseIteratorInterface::Pointer doseIterator,
 				bool multiThreading = false);
 
+			/*! @brief Constructor that uses the sorted doses instead of a dose iterator.
+				@exception NullPointerException if sortedDoses is nullptr
+			*/
+			VxDoseToVolumeMeasureCollectionCalculator(const std::vector<double>& precomputeDoseValues,
+				const DoseTypeGy referenceDose, SortedDoseBuffer::ConstPointer sortedDoses,
+				const DoseVoxelVolumeType currentVoxelVolume, bool multiThreading = false);
+
+		private:
+			SortedDoseBuffer::ConstPointer _sortedDoses;
+			DoseVoxelVolumeType _currentVoxelVolume;
+
 		protected:
 			VolumeType computeSpecificValue(double xAbsolute) const override;
 		};
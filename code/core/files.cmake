@@ -1,28 +1,51 @@
 SET(CPP_FILES 
+  rttbAccessorInterface.cpp
   rttbAccessorWithGeoInfoBase.cpp
+  rttbBlockCachedDoseAccessor.cpp
+  rttbBufferedDoseIterator.cpp
+  rttbCachedDoseAccessor.cpp
+  rttbCompactMask.cpp
+  rttbCompactMaskAccessor.cpp
+  rttbCompactMaskedDoseIterator.cpp
+  rttbDenseDoseAccessor.cpp
+  rttbDoseHistogram.cpp
   rttbDoseIteratorInterface.cpp
   rttbDVH.cpp
   rttbDVHCalculator.cpp
   rttbDVHSet.cpp
+  rttbDVHSetArithmetic.cpp
   rttbGenericDoseIterator.cpp
   rttbGenericMaskedDoseIterator.cpp
   rttbGeometricInfo.cpp
   rttbMaskedDoseIteratorInterface.cpp
   rttbMaskVoxel.cpp
+  rttbMultiStructureDVHCalculator.cpp
   rttbStructure.cpp
   rttbStructureSet.cpp
   rttbStrVectorStructureSetGenerator.cpp
+  rttbThreadPool.cpp
   rttbUtils.cpp
   rttbMutableMaskAccessorInterface.cpp
   rttbMutableDoseAccessorInterface.cpp
+  rttbMutableDenseDoseAccessor.cpp
   )
 
 SET(H_FILES 
   rttbAccessorInterface.h
   rttbAccessorWithGeoInfoBase.h
   rttbBaseType.h
+  rttbBlockwiseReduction.h
+  rttbBlockCachedDoseAccessor.h
+  rttbBufferedDoseIterator.h
+  rttbCachedDoseAccessor.h
+  rttbCompactMask.h
+  rttbCompactMaskAccessor.h
+  rttbCompactMaskedDoseIterator.h
+  rttbCompensatedSum.h
   rttbDataNotAvailableException.h
+  rttbDenseDoseAccessor.h
   rttbDoseAccessorInterface.h
+  rttbDoseHistogram.h
   rttbDoseIteratorInterface.h
   rttbDoseAccessorGeneratorBase.h
   rttbDoseAccessorGeneratorInterface.h
@@ -30,6 +53,7 @@ SET(H_FILES
   rttbDVHCalculator.h
   rttbDVHGeneratorInterface.h
   rttbDVHSet.h
+  rttbDVHSetArithmetic.h
   rttbException.h
   rttbExceptionMacros.h
   rttbGenericDoseIterator.h
@@ -47,7 +71,9 @@ SET(H_FILES
   rttbMaskAccessorProcessorInterface.h
   rttbMaskedDoseIteratorInterface.h
   rttbMaskVoxel.h
+  rttbMultiStructureDVHCalculator.h
   rttbMutableDoseAccessorInterface.h
+  rttbMutableDenseDoseAccessor.h
   rttbMutableMaskAccessorInterface.h
   rttbNullPointerException.h
   rttbPaddingException.h
@@ -55,6 +81,7 @@ SET(H_FILES
   rttbStructureSet.h
   rttbStructureSetGeneratorInterface.h
   rttbStrVectorStructureSetGenerator.h
+  rttbThreadPool.h
   rttbUtils.h
   rttbCommon.h
 )
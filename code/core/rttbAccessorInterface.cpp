@@ -0,0 +1,79 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+
+#include "rttbAccessorInterface.h"
+#include "rttbIndexOutOfBoundsException.h"
+
+namespace rttb
+{
+	namespace core
+	{
+
+		void AccessorInterface::getValues(VoxelGridID aFirstID, GridSizeType aNumberOfValues,
+		                                  GenericValueType* values) const
+		{
+			if (aFirstID < 0 || aNumberOfValues < 0 || aFirstID + aNumberOfValues > getGridSize())
+			{
+				throw IndexOutOfBoundsException("Requested voxel ID range is not inside the grid!");
+			}
+
+			for (GridSizeType i = 0; i < aNumberOfValues; ++i)
+			{
+				values[i] = getValueAt(static_cast<VoxelGridID>(aFirstID + i));
+			}
+		}
+
+		void AccessorInterface::getValuesInRegion(const VoxelGridIndex3D& aRegionStart,
+		        const ImageSize& aRegionSize, GenericValueType* values) const
+		{
+			const GeometricInfo& geoInfo = getGeometricInfo();
+
+			if (aRegionStart.x() + aRegionSize(0) > static_cast<GridIndexType>(geoInfo.getNumColumns())
+			    || aRegionStart.y() + aRegionSize(1) > static_cast<GridIndexType>(geoInfo.getNumRows())
+			    || aRegionStart.z() + aRegionSize(2) > static_cast<GridIndexType>(geoInfo.getNumSlices()))
+			{
+				throw IndexOutOfBoundsException("Requested region is not inside the grid!");
+			}
+
+			const GridSizeType numberOfColumns = aRegionSize(0);
+
+			for (GridIndexType slice = aRegionStart.z(); slice < aRegionStart.z() + aRegionSize(2); ++slice)
+			{
+				for (GridIndexType row = aRegionStart.y(); row < aRegionStart.y() + aRegionSize(1); ++row)
+				{
+					VoxelGridID rowStartID = 0;
+					geoInfo.convert(VoxelGridIndex3D(aRegionStart.x(), row, slice), rowStartID);
+					getValues(rowStartID, numberOfColumns, values);
+					values += numberOfColumns;
+				}
+			}
+		}
+
+		void AccessorInterface::getSlice(GridIndexType aSlice, GenericValueType* values) const
+		{
+			const GeometricInfo& geoInfo = getGeometricInfo();
+
+			if (aSlice >= static_cast<GridIndexType>(geoInfo.getNumSlices()))
+			{
+				throw IndexOutOfBoundsException("Requested slice is not inside the grid!");
+			}
+
+			const GridSizeType sliceSize = static_cast<GridSizeType>(geoInfo.getNumColumns()) * geoInfo.getNumRows();
+			getValues(static_cast<VoxelGridID>(aSlice * sliceSize), sliceSize, values);
+		}
+
+	}//end namespace core
+}//end namespace rttb
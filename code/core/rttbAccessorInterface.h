@@ -78,6 +78,30 @@ namespace rttb
 
 			virtual GenericValueType getValueAt(const VoxelGridIndex3D& aIndex) const = 0;
 
+			/*! @brief copies the values of aNumberOfValues voxels with consecutive IDs (starting with aFirstID) into values.
+				@details The default implementation calls getValueAt(VoxelGridID) for every voxel. Accessors that hold
+				their data in a contiguous buffer should override it and copy/convert directly from that buffer.
+				@pre values must provide space for aNumberOfValues elements.
+				@exception IndexOutOfBoundsException if the ID range is not completely inside the grid.
+			*/
+			virtual void getValues(VoxelGridID aFirstID, GridSizeType aNumberOfValues, GenericValueType* values) const;
+
+			/*! @brief copies the values of a box shaped region into values (column index running fastest, then row, then slice).
+				@details Every row of the region is a consecutive ID range and is read with getValues().
+				@param aRegionStart index of the first voxel of the region
+				@param aRegionSize number of voxels of the region in column/row/slice direction
+				@pre values must provide space for aRegionSize(0)*aRegionSize(1)*aRegionSize(2) elements.
+				@exception IndexOutOfBoundsException if the region is not completely inside the grid.
+			*/
+			void getValuesInRegion(const VoxelGridIndex3D& aRegionStart, const ImageSize& aRegionSize,
+			                       GenericValueType* values) const;
+
+			/*! @brief copies all values of slice aSlice into values (column index running fastest).
+				@pre values must provide space for getNumColumns()*getNumRows() elements.
+				@exception IndexOutOfBoundsException if aSlice is not inside the grid.
+			*/
+			void getSlice(GridIndexType aSlice, GenericValueType* values) const;
+
 			/*! @brief is true if dose is on a homogeneous grid
 				@remarks Inhomogeneous grids are not supported at the moment, but if they will be supported in the future
 				the interface does not need to change.
@@ -16,6 +16,8 @@
 #ifndef __BASE_TYPE_NEW_H
 #define __BASE_TYPE_NEW_H
 
+#include <array>
+#include <cmath>
 #include <string>
 #include <vector>
 #include <list>
@@ -104,68 +106,91 @@ namespace rttb
 
 	/*! @class WorldCoordinate3D
 		@brief 3D coordinate in real world coordinates like in DICOM to define ImagePositionPatient.
+		@details Fixed-size value type (trivially copyable, no heap allocation). Coordinate temporaries are
+		created per sample in interpolation, gamma search, voxelization and mapping, so they must stay on the stack.
 	*/
-	class WorldCoordinate3D: public boost::numeric::ublas::vector<WorldCoordinate>
+	class WorldCoordinate3D
 	{
 	public:
-		WorldCoordinate3D() : boost::numeric::ublas::vector<WorldCoordinate>(3,0) {}
-		explicit WorldCoordinate3D(const WorldCoordinate value) : boost::numeric::ublas::vector<WorldCoordinate>(3,
-			        value) {}
-		WorldCoordinate3D(const WorldCoordinate xValue, const WorldCoordinate yValue,
-		                  const WorldCoordinate zValue)
-			: boost::numeric::ublas::vector<WorldCoordinate>(3, xValue)
+		using value_type = WorldCoordinate;
+		using ArrayType = std::array<WorldCoordinate, 3>;
+
+	private:
+		ArrayType _data;
+
+	public:
+		constexpr WorldCoordinate3D() : _data{ {0, 0, 0} } {}
+		constexpr explicit WorldCoordinate3D(const WorldCoordinate value) : _data{ {value, value, value} } {}
+		constexpr WorldCoordinate3D(const WorldCoordinate xValue, const WorldCoordinate yValue,
+		                  const WorldCoordinate zValue) : _data{ {xValue, yValue, zValue} } {}
+
+		constexpr WorldCoordinate x() const
 		{
-			(*this)(1) = yValue;
-			(*this)(2) = zValue;
+			return _data[0];
+		}
+		constexpr WorldCoordinate y() const
+		{
+			return _data[1];
+		}
+		constexpr WorldCoordinate z() const
+		{
+			return _data[2];
 		}
 
-		WorldCoordinate3D(const WorldCoordinate3D& w): boost::numeric::ublas::vector<WorldCoordinate>(3)
+		static constexpr std::size_t size()
 		{
-			(*this)(0) = w.x();
-			(*this)(1) = w.y();
-			(*this)(2) = w.z();
+			return 3;
 		}
 
-		const WorldCoordinate x() const
+		WorldCoordinate& operator()(const std::size_t i)
 		{
-			return (*this)(0);
+			return _data[i];
 		}
-		const WorldCoordinate y() const
+		constexpr const WorldCoordinate& operator()(const std::size_t i) const
 		{
-			return (*this)(1);
+			return _data[i];
 		}
-		const WorldCoordinate z() const
+		WorldCoordinate& operator[](const std::size_t i)
 		{
-			return (*this)(2);
+			return _data[i];
+		}
+		constexpr const WorldCoordinate& operator[](const std::size_t i) const
+		{
+			return _data[i];
 		}
 
-		//vector cross product (not included in boost.ublas)
-		WorldCoordinate3D cross(const WorldCoordinate3D& aVector) const
+		WorldCoordinate* data()
 		{
-			WorldCoordinate3D result;
-			WorldCoordinate x = (*this)(0);
-			WorldCoordinate y = (*this)(1);
-			WorldCoordinate z = (*this)(2);
+			return _data.data();
+		}
+		const WorldCoordinate* data() const
+		{
+			return _data.data();
+		}
 
-			result(0) = y * aVector(2) - z * aVector(1);
-			result(1) = z * aVector(0) - x * aVector(2);
-			result(2) = x * aVector(1) - y * aVector(0);
+		//vector cross product
+		constexpr WorldCoordinate3D cross(const WorldCoordinate3D& aVector) const
+		{
+			return WorldCoordinate3D(y() * aVector.z() - z() * aVector.y(),
+			                         z() * aVector.x() - x() * aVector.z(),
+			                         x() * aVector.y() - y() * aVector.x());
+		}
 
-			return result;
+		constexpr WorldCoordinate dot(const WorldCoordinate3D& aVector) const
+		{
+			return x() * aVector.x() + y() * aVector.y() + z() * aVector.z();
 		}
 
-		const std::string toString() const
+		/*! @brief Euclidean length of the vector.*/
+		WorldCoordinate norm() const
 		{
-      std::string s = std::to_string(x()) + " " + std::to_string(y()) + " " + std::to_string(z());
-			return s;
+			return std::sqrt(dot(*this));
 		}
 
-		WorldCoordinate3D& operator=(const WorldCoordinate3D& wc)
+		const std::string toString() const
 		{
-			(*this)(0) = wc.x();
-			(*this)(1) = wc.y();
-			(*this)(2) = wc.z();
-			return (*this);
+      std::string s = std::to_string(x()) + " " + std::to_string(y()) + " " + std::to_string(z());
+			return s;
 		}
 
 		WorldCoordinate3D& operator=(const boost::numeric::ublas::vector<WorldCoordinate>& wc)
@@ -176,42 +201,50 @@ namespace rttb
 			return (*this);
 		}
 
-		WorldCoordinate3D operator-(const boost::numeric::ublas::vector<WorldCoordinate>& wc) const
+		constexpr WorldCoordinate3D operator-(const WorldCoordinate3D& wc) const
 		{
-			return WorldCoordinate3D((*this)(0) - wc(0), (*this)(1) - wc(1), (*this)(2) - wc(2));
+			return WorldCoordinate3D(x() - wc.x(), y() - wc.y(), z() - wc.z());
 		}
 
-		WorldCoordinate3D operator+(const boost::numeric::ublas::vector<WorldCoordinate>& wc) const
+		constexpr WorldCoordinate3D operator+(const WorldCoordinate3D& wc) const
 		{
-			return WorldCoordinate3D((*this)(0) + wc(0), (*this)(1) + wc(1), (*this)(2) + wc(2));
+			return WorldCoordinate3D(x() + wc.x(), y() + wc.y(), z() + wc.z());
 		}
 
-		friend bool operator==(const WorldCoordinate3D& wc1, const WorldCoordinate3D& wc2)
+		constexpr WorldCoordinate3D operator*(const WorldCoordinate factor) const
 		{
-			if (wc1.size() != wc2.size())
-			{
-				return false;
-			}
+			return WorldCoordinate3D(x() * factor, y() * factor, z() * factor);
+		}
 
-			for (size_t i = 0; i < wc1.size(); i++)
-			{
-				if (wc1(i) != wc2(i))
-				{
-					return false;
-				}
-			}
+		WorldCoordinate3D& operator+=(const WorldCoordinate3D& wc)
+		{
+			_data[0] += wc.x();
+			_data[1] += wc.y();
+			_data[2] += wc.z();
+			return (*this);
+		}
 
-			return true;
+		WorldCoordinate3D& operator-=(const WorldCoordinate3D& wc)
+		{
+			_data[0] -= wc.x();
+			_data[1] -= wc.y();
+			_data[2] -= wc.z();
+			return (*this);
 		}
 
-		bool equalsAlmost(const WorldCoordinate3D& another, double errorConstantWC = 1e-5) const
+		friend bool operator==(const WorldCoordinate3D& wc1, const WorldCoordinate3D& wc2)
 		{
-			if (size() != another.size())
-			{
-				return false;
-			}
+			return wc1._data == wc2._data;
+		}
 
-			double dist = norm_2(*this - another);
+		friend bool operator!=(const WorldCoordinate3D& wc1, const WorldCoordinate3D& wc2)
+		{
+			return !(wc1 == wc2);
+		}
+
+		bool equalsAlmost(const WorldCoordinate3D& another, double errorConstantWC = 1e-5) const
+		{
+			double dist = (*this - another).norm();
 			return dist < errorConstantWC;
 		}
 
@@ -223,6 +256,12 @@ namespace rttb
 
 	};
 
+	/*! @brief Euclidean norm of a WorldCoordinate3D (drop-in for boost::numeric::ublas::norm_2).*/
+	inline WorldCoordinate norm_2(const WorldCoordinate3D& aVector)
+	{
+		return aVector.norm();
+	}
+
     /* ! @brief continuous index */
 	using ContinuousVoxelGridIndex3D = rttb::WorldCoordinate3D;
 
@@ -429,32 +468,57 @@ namespace rttb
 
 	/*! @class VoxelGridIndex3D
 		@brief 3D voxel grid index in a discret geometry (matrix/image).
-        @details analogous to DICOM where ImagePositionPatient gives the position of the center of the first coordinate (0/0/0)
+        @details analogous to DICOM where ImagePositionPatient gives the position of the center of the first coordinate (0/0/0).
+        Fixed-size value type (trivially copyable, no heap allocation).
 	*/
-	class VoxelGridIndex3D: public boost::numeric::ublas::vector<GridIndexType>
+	class VoxelGridIndex3D
 	{
 	public:
-		VoxelGridIndex3D() : boost::numeric::ublas::vector<GridIndexType>(3,0) {}
-		explicit VoxelGridIndex3D(const GridIndexType value) : boost::numeric::ublas::vector<GridIndexType>(3,
-			        value) {}
-		VoxelGridIndex3D(const GridIndexType xValue, const GridIndexType yValue, const GridIndexType zValue)
-			: boost::numeric::ublas::vector<GridIndexType>(3, xValue)
+		using value_type = GridIndexType;
+		using ArrayType = std::array<GridIndexType, 3>;
+
+	private:
+		ArrayType _data;
+
+	public:
+		constexpr VoxelGridIndex3D() : _data{ {0, 0, 0} } {}
+		constexpr explicit VoxelGridIndex3D(const GridIndexType value) : _data{ {value, value, value} } {}
+		constexpr VoxelGridIndex3D(const GridIndexType xValue, const GridIndexType yValue, const GridIndexType zValue)
+			: _data{ {xValue, yValue, zValue} } {}
+
+		constexpr GridIndexType x() const
 		{
-			(*this)(1) = yValue;
-			(*this)(2) = zValue;
+			return _data[0];
+		}
+		constexpr GridIndexType y() const
+		{
+			return _data[1];
+		}
+		constexpr GridIndexType z() const
+		{
+			return _data[2];
 		}
 
-		const GridIndexType x() const
+		static constexpr std::size_t size()
 		{
-			return (*this)(0);
+			return 3;
 		}
-		const GridIndexType y() const
+
+		GridIndexType& operator()(const std::size_t i)
 		{
-			return (*this)(1);
+			return _data[i];
 		}
-		const GridIndexType z() const
+		constexpr const GridIndexType& operator()(const std::size_t i) const
 		{
-			return (*this)(2);
+			return _data[i];
+		}
+		GridIndexType& operator[](const std::size_t i)
+		{
+			return _data[i];
+		}
+		constexpr const GridIndexType& operator[](const std::size_t i) const
+		{
+			return _data[i];
 		}
 
 		const std::string toString() const
@@ -473,20 +537,12 @@ namespace rttb
 
 		friend bool operator==(const VoxelGridIndex3D& gi1, const VoxelGridIndex3D& gi2)
 		{
-			if (gi1.size() != gi2.size())
-			{
-				return false;
-			}
-
-			for (size_t i = 0; i < gi1.size(); i++)
-			{
-				if (gi1(i) != gi2(i))
-				{
-					return false;
-				}
-			}
+			return gi1._data == gi2._data;
+		}
 
-			return true;
+		friend bool operator!=(const VoxelGridIndex3D& gi1, const VoxelGridIndex3D& gi2)
+		{
+			return !(gi1 == gi2);
 		}
 
 		friend std::ostream& operator<<(std::ostream& s, const VoxelGridIndex3D& aVector)
@@ -0,0 +1,204 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+#include <algorithm>
+
+#include <boost/make_shared.hpp>
+
+#include "rttbBlockCachedDoseAccessor.h"
+#include "rttbNullPointerException.h"
+#include "rttbInvalidParameterException.h"
+#include "rttbIndexOutOfBoundsException.h"
+
+namespace rttb
+{
+	namespace core
+	{
+
+		BlockCachedDoseAccessor::BlockCachedDoseAccessor(AccessorInterface::ConstPointer source,
+		        size_t maximumNumberOfTiles, GridIndexType tileSize) :
+			_source(source), _tileSize(tileSize), _maximumNumberOfTiles(maximumNumberOfTiles), _cacheID(createCacheID()),
+			_hits(0), _misses(0)
+		{
+			if (_source == nullptr)
+			{
+				throw NullPointerException("Source accessor must not be nullptr!");
+			}
+
+			if (_maximumNumberOfTiles == 0 || _tileSize == 0)
+			{
+				throw InvalidParameterException("Maximum number of tiles and tile size must be greater than 0!");
+			}
+
+			_geoInfo = _source->getGeometricInfo();
+			_numberOfTiles[0] = (_geoInfo.getNumColumns() + _tileSize - 1) / _tileSize;
+			_numberOfTiles[1] = (_geoInfo.getNumRows() + _tileSize - 1) / _tileSize;
+			_numberOfTiles[2] = (_geoInfo.getNumSlices() + _tileSize - 1) / _tileSize;
+		}
+
+		BlockCachedDoseAccessor::LastTile& BlockCachedDoseAccessor::getLastTileOfThread()
+		{
+			thread_local LastTile lastTile;
+			return lastTile;
+		}
+
+		std::uint64_t BlockCachedDoseAccessor::createCacheID()
+		{
+			static std::atomic<std::uint64_t> nextCacheID(1);
+			return nextCacheID++;
+		}
+
+		BlockCachedDoseAccessor::TilePointer BlockCachedDoseAccessor::getTile(const GridIndexType tileX,
+		        const GridIndexType tileY, const GridIndexType tileZ) const
+		{
+			const TileKeyType key = tileX + static_cast<TileKeyType>(_numberOfTiles[0]) * (tileY + static_cast<TileKeyType>
+			                        (_numberOfTiles[1]) * tileZ);
+			const std::uint64_t cacheID = _cacheID;
+			LastTile& lastTile = getLastTileOfThread();
+
+			//the thread reads the same tile again: no lock needed, the tile is already filled
+			if (lastTile.cacheID == cacheID && lastTile.key == key)
+			{
+				++_hits;
+				return lastTile.tile;
+			}
+
+			TilePointer tile;
+
+			{
+				std::lock_guard<std::mutex> lock(_cacheMutex);
+				auto pos = _cache.find(key);
+
+				if (pos != _cache.end())
+				{
+					++_hits;
+					_lruList.splice(_lruList.begin(), _lruList, pos->second.lruPosition);
+					tile = pos->second.tile;
+				}
+				else
+				{
+					++_misses;
+					tile = boost::make_shared<Tile>();
+					tile->start = VoxelGridIndex3D(tileX * _tileSize, tileY * _tileSize, tileZ * _tileSize);
+					tile->size = ImageSize(std::min(_tileSize, _geoInfo.getNumColumns() - tile->start.x()),
+					                       std::min(_tileSize, _geoInfo.getNumRows() - tile->start.y()),
+					                       std::min(_tileSize, _geoInfo.getNumSlices() - tile->start.z()));
+
+					_lruList.push_front(key);
+					_cache.emplace(key, CacheEntry{ tile, _lruList.begin() });
+
+					if (_cache.size() > _maximumNumberOfTiles)
+					{
+						//threads still reading the evicted tile keep it alive via their TilePointer
+						_cache.erase(_lruList.back());
+						_lruList.pop_back();
+					}
+				}
+			}
+
+			//filled outside of the lock, so that different tiles can be filled concurrently
+			std::call_once(tile->filled, [this, &tile]()
+			{
+				tile->values.resize(static_cast<size_t>(tile->size(0)) * tile->size(1) * tile->size(2));
+				_source->getValuesInRegion(tile->start, tile->size, tile->values.data());
+			});
+
+			lastTile.cacheID = cacheID;
+			lastTile.key = key;
+			lastTile.tile = tile;
+			return tile;
+		}
+
+		GenericValueType BlockCachedDoseAccessor::getValueAt(const VoxelGridID aID) const
+		{
+			VoxelGridIndex3D aIndex;
+
+			if (_geoInfo.convert(aID, aIndex))
+			{
+				return getValueAt(aIndex);
+			}
+			else
+			{
+				return -1;
+			}
+		}
+
+		GenericValueType BlockCachedDoseAccessor::getValueAt(const VoxelGridIndex3D& aIndex) const
+		{
+			if (!_geoInfo.validIndex(aIndex))
+			{
+				return -1;
+			}
+
+			const TilePointer tile = getTile(aIndex.x() / _tileSize, aIndex.y() / _tileSize, aIndex.z() / _tileSize);
+			const GridIndexType x = aIndex.x() - tile->start.x();
+			const GridIndexType y = aIndex.y() - tile->start.y();
+			const GridIndexType z = aIndex.z() - tile->start.z();
+
+			return tile->values[x + tile->size(0) * (y + static_cast<size_t>(tile->size(1)) * z)];
+		}
+
+		void BlockCachedDoseAccessor::getValues(const VoxelGridID aFirstID, const GridSizeType aNumberOfValues,
+		                                        GenericValueType* values) const
+		{
+			if (aFirstID < 0 || aNumberOfValues < 0 || aFirstID + aNumberOfValues > getGridSize())
+			{
+				throw IndexOutOfBoundsException("Requested voxel ID range is not inside the grid!");
+			}
+
+			VoxelGridID currentID = aFirstID;
+			const VoxelGridID endID = aFirstID + static_cast<VoxelGridID>(aNumberOfValues);
+			VoxelGridIndex3D index;
+
+			while (currentID < endID)
+			{
+				_geoInfo.convert(currentID, index);
+
+				//copy the part of the row that lies inside the current tile
+				const TilePointer tile = getTile(index.x() / _tileSize, index.y() / _tileSize, index.z() / _tileSize);
+				const GridIndexType x = index.x() - tile->start.x();
+				const GridIndexType y = index.y() - tile->start.y();
+				const GridIndexType z = index.z() - tile->start.z();
+				const VoxelGridID segmentLength = std::min<VoxelGridID>(tile->size(0) - x, endID - currentID);
+				const auto first = tile->values.cbegin() + x + tile->size(0) * (y + static_cast<size_t>(tile->size(1)) * z);
+
+				values = std::copy(first, first + segmentLength, values);
+				currentID += segmentLength;
+			}
+		}
+
+		size_t BlockCachedDoseAccessor::getNumberOfCachedTiles() const
+		{
+			std::lock_guard<std::mutex> lock(_cacheMutex);
+			return _cache.size();
+		}
+
+		void BlockCachedDoseAccessor::resetCounters()
+		{
+			_hits = 0;
+			_misses = 0;
+		}
+
+		void BlockCachedDoseAccessor::clearCache()
+		{
+			std::lock_guard<std::mutex> lock(_cacheMutex);
+			_cache.clear();
+			_lruList.clear();
+			//the tiles remembered by the threads are not used anymore
+			_cacheID = createCacheID();
+		}
+
+	}//end namespace core
+}//end namespace rttb
@@ -0,0 +1,191 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+#ifndef __BLOCK_CACHED_DOSE_ACCESSOR_H
+#define __BLOCK_CACHED_DOSE_ACCESSOR_H
+
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+
+#include "rttbAccessorInterface.h"
+#include "rttbBaseType.h"
+#include "rttbCommon.h"
+
+#include "RTTBCoreExports.h"
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+
+namespace rttb
+{
+	namespace core
+	{
+
+		/*! @class BlockCachedDoseAccessor
+			@brief Decorator that caches the values of another accessor in cubic tiles with a bounded number of tiles.
+			@details A tile is read from the source (with getValuesInRegion()) the first time one of its voxels is
+			requested. If more than getMaximumNumberOfTiles() tiles are cached, the least recently used tile is dropped.
+			Thus random access with spatial locality (e.g. interpolation or gamma index search) mostly hits the cache,
+			while the memory stays bounded by maximumNumberOfTiles*tileSize^3 values.
+			The accessor can be read from several threads; different tiles are filled concurrently. Every thread remembers
+			the tile it read last, so consecutive reads of a thread within one tile need neither the cache mutex nor the
+			tile map. These reads do not refresh the LRU order for other threads, and a tile that is evicted while a thread
+			still remembers it stays alive until that thread reads another tile: the memory bound grows by at most one tile
+			per reading thread.
+			@remarks The source is read concurrently if the accessor is used by several threads, so its getValues()
+			has to be safe to call from several threads.
+			@sa CachedDoseAccessor for caching the complete grid.
+		*/
+		class RTTBCore_EXPORT BlockCachedDoseAccessor : public AccessorInterface
+		{
+		public:
+			rttbClassMacro(BlockCachedDoseAccessor, AccessorInterface);
+
+		private:
+			using TileKeyType = GridSizeType;
+
+			struct Tile
+			{
+				std::vector<GenericValueType> values;
+				std::once_flag filled;
+				VoxelGridIndex3D start;
+				ImageSize size;
+			};
+			using TilePointer = boost::shared_ptr<Tile>;
+
+			/*! @brief the tile a thread read last (see getLastTileOfThread()).*/
+			struct LastTile
+			{
+				/*! _cacheID of the accessor the tile belongs to, 0: none*/
+				std::uint64_t cacheID = 0;
+				TileKeyType key = 0;
+				TilePointer tile;
+			};
+
+			using LRUListType = std::list<TileKeyType>;
+			struct CacheEntry
+			{
+				TilePointer tile;
+				LRUListType::iterator lruPosition;
+			};
+
+			AccessorInterface::ConstPointer _source;
+			GeometricInfo _geoInfo;
+			GridIndexType _tileSize;
+			size_t _maximumNumberOfTiles;
+			GridIndexType _numberOfTiles[3];
+
+			mutable std::mutex _cacheMutex;
+			/*! most recently used tile at the front*/
+			mutable LRUListType _lruList;
+			mutable std::unordered_map<TileKeyType, CacheEntry> _cache;
+
+			/*! @brief process wide unique ID of the current cache content, a new ID is assigned by clearCache(). Marks
+				the last tiles of the threads that belong to this cache.*/
+			std::atomic<std::uint64_t> _cacheID;
+
+			mutable std::atomic<GridSizeType> _hits;
+			mutable std::atomic<GridSizeType> _misses;
+
+			/*! @brief returns the tile with the given tile coordinates (filled). Handles hit/miss counting and eviction.*/
+			TilePointer getTile(GridIndexType tileX, GridIndexType tileY, GridIndexType tileZ) const;
+
+			/*! @brief the tile the calling thread read last (of any BlockCachedDoseAccessor).*/
+			static LastTile& getLastTileOfThread();
+
+			/*! @brief returns a new process wide unique cache ID.*/
+			static std::uint64_t createCacheID();
+
+		public:
+			/*! @brief Constructor.
+				@param source accessor whose values are cached (geometric info and UID are taken from it).
+				@param maximumNumberOfTiles maximum number of tiles held at the same time.
+				@param tileSize edge length of a tile in voxels.
+				@exception NullPointerException if source is nullptr.
+				@exception InvalidParameterException if maximumNumberOfTiles or tileSize is 0.
+			*/
+			explicit BlockCachedDoseAccessor(AccessorInterface::ConstPointer source, size_t maximumNumberOfTiles = 256,
+			                                 GridIndexType tileSize = 32);
+
+			~BlockCachedDoseAccessor() override = default;
+
+			const GeometricInfo& getGeometricInfo() const override
+			{
+				return _geoInfo;
+			};
+
+			/*! @brief returns the value for an id, -1 if the id is not inside the grid.*/
+			GenericValueType getValueAt(const VoxelGridID aID) const override;
+
+			/*! @brief returns the value for an index, -1 if the index is not inside the grid.*/
+			GenericValueType getValueAt(const VoxelGridIndex3D& aIndex) const override;
+
+			/*! @brief copies the values row segment by row segment from the tiles.
+				@exception IndexOutOfBoundsException if the ID range is not completely inside the grid.
+			*/
+			void getValues(VoxelGridID aFirstID, GridSizeType aNumberOfValues, GenericValueType* values) const override;
+
+			const IDType getUID() const override
+			{
+				return _source->getUID();
+			};
+
+			GridIndexType getTileSize() const
+			{
+				return _tileSize;
+			};
+
+			size_t getMaximumNumberOfTiles() const
+			{
+				return _maximumNumberOfTiles;
+			};
+
+			/*! @brief returns the number of tiles currently held in the cache.*/
+			size_t getNumberOfCachedTiles() const;
+
+			/*! @brief number of value requests that were answered by an already cached tile.*/
+			GridSizeType getNumberOfHits() const
+			{
+				return _hits;
+			};
+
+			/*! @brief number of value requests that required to read a tile from the source.*/
+			GridSizeType getNumberOfMisses() const
+			{
+				return _misses;
+			};
+
+			/*! @brief sets the hit and miss counters to 0.*/
+			void resetCounters();
+
+			/*! @brief drops all cached tiles.*/
+			void clearCache();
+		};
+	}
+}
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif
@@ -0,0 +1,166 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+#ifndef __BLOCKWISE_REDUCTION_H
+#define __BLOCKWISE_REDUCTION_H
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "rttbInvalidParameterException.h"
+#include "rttbThreadPool.h"
+
+namespace rttb
+{
+	namespace core
+	{
+
+		/*! @class BlockwiseReduction
+			@brief Reduces a sequence of values in blocks of fixed size, so that the result is reproducible bit for bit.
+			@details The values are passed in one or several calls of process(). They are reduced into one Accumulator
+			per block of blockSize consecutive values (counted over all calls) and the block accumulators are merged in
+			block order. Since the block boundaries and the merge order depend neither on the number of threads nor on
+			how the values are split over the calls of process(), the result is always the same.
+			Accumulator has to be default constructible and to provide add(const Accumulator&), e.g. CompensatedSum or
+			a struct of several CompensatedSum.
+		*/
+		template <typename Accumulator>
+		class BlockwiseReduction
+		{
+		private:
+			std::size_t _blockSize;
+			Accumulator _result;
+			Accumulator _currentBlock;
+			std::size_t _numberOfValuesInCurrentBlock;
+
+		public:
+			static const std::size_t defaultBlockSize = 4096;
+
+			/*! @exception InvalidParameterException if aBlockSize is 0.*/
+			explicit BlockwiseReduction(std::size_t aBlockSize = defaultBlockSize) : _blockSize(aBlockSize),
+				_numberOfValuesInCurrentBlock(0)
+			{
+				if (_blockSize == 0)
+				{
+					throw InvalidParameterException("aBlockSize must not be 0!");
+				}
+			};
+
+			std::size_t getBlockSize() const
+			{
+				return _blockSize;
+			};
+
+			/*! @brief Reduces the next numberOfValues values of the sequence.
+				@param reduceRange callable (std::size_t begin, std::size_t end, Accumulator&) that adds the values
+				[begin, end) of this call to the accumulator. It is called concurrently for different ranges if
+				multiThreading is true.
+				@param multiThreading if true, the complete blocks are reduced in parallel on ThreadPool::getDefault().
+			*/
+			template <typename RangeReducer>
+			void process(std::size_t numberOfValues, RangeReducer reduceRange, bool multiThreading = false)
+			{
+				std::size_t begin = 0;
+
+				//complete the block left over by the last call
+				if (_numberOfValuesInCurrentBlock > 0)
+				{
+					const std::size_t end = std::min(numberOfValues, _blockSize - _numberOfValuesInCurrentBlock);
+					reduceRange(0, end, _currentBlock);
+					_numberOfValuesInCurrentBlock += end;
+					begin = end;
+
+					if (_numberOfValuesInCurrentBlock == _blockSize)
+					{
+						_result.add(_currentBlock);
+						_currentBlock = Accumulator();
+						_numberOfValuesInCurrentBlock = 0;
+					}
+				}
+
+				const std::size_t numberOfBlocks = (numberOfValues - begin) / _blockSize;
+
+				if (numberOfBlocks > 0)
+				{
+					std::vector<Accumulator> blocks(numberOfBlocks);
+					const std::size_t firstBlockBegin = begin;
+					const std::size_t blockSize = _blockSize;
+
+					auto reduceBlocks = [&blocks, &reduceRange, firstBlockBegin, blockSize](std::size_t firstBlock,
+					                    std::size_t lastBlock)
+					{
+						for (std::size_t block = firstBlock; block < lastBlock; ++block)
+						{
+							const std::size_t blockBegin = firstBlockBegin + block * blockSize;
+							reduceRange(blockBegin, blockBegin + blockSize, blocks[block]);
+						}
+					};
+
+					if (multiThreading && numberOfBlocks > 1)
+					{
+						ThreadPool& pool = ThreadPool::getDefault();
+						const std::size_t numberOfTasks = std::min<std::size_t>(numberOfBlocks, 4 * pool.getNumberOfThreads());
+						ThreadPool::TaskGroup group(pool);
+
+						for (std::size_t task = 0; task < numberOfTasks; ++task)
+						{
+							const std::size_t firstBlock = task * numberOfBlocks / numberOfTasks;
+							const std::size_t lastBlock = (task + 1) * numberOfBlocks / numberOfTasks;
+							group.run([&reduceBlocks, firstBlock, lastBlock]()
+							{
+								reduceBlocks(firstBlock, lastBlock);
+							});
+						}
+
+						group.wait();
+					}
+					else
+					{
+						reduceBlocks(0, numberOfBlocks);
+					}
+
+					for (const auto& block : blocks)
+					{
+						_result.add(block);
+					}
+
+					begin += numberOfBlocks * _blockSize;
+				}
+
+				if (begin < numberOfValues)
+				{
+					reduceRange(begin, numberOfValues, _currentBlock);
+					_numberOfValuesInCurrentBlock = numberOfValues - begin;
+				}
+			};
+
+			/*! @brief returns the reduction of all values processed so far.*/
+			Accumulator getResult() const
+			{
+				Accumulator result = _result;
+
+				if (_numberOfValuesInCurrentBlock > 0)
+				{
+					result.add(_currentBlock);
+				}
+
+				return result;
+			};
+		};
+	}
+}
+
+#endif
@@ -0,0 +1,168 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+#include "rttbBufferedDoseIterator.h"
+
+#include <algorithm>
+
+#include "rttbNullPointerException.h"
+
+namespace rttb
+{
+	namespace core
+	{
+		namespace
+		{
+			DoseIteratorInterface::DoseAccessorPointer getSourceAccessor(const DoseIteratorInterface::Pointer&
+			        aSourceIterator)
+			{
+				if (aSourceIterator == nullptr)
+				{
+					throw NullPointerException("aSourceIterator must not be nullptr! ");
+				}
+
+				return aSourceIterator->getDoseAccessor();
+			}
+		}
+
+		BufferedDoseIterator::BufferedDoseIterator(DoseIteratorPointer aSourceIterator) :
+			DoseIteratorInterface(getSourceAccessor(aSourceIterator)), _currentPosition(0)
+		{
+			aSourceIterator->reset();
+			_voxelVolume = aSourceIterator->getCurrentVoxelVolume();
+			_voxelizationID = aSourceIterator->getVoxelizationID();
+
+			std::size_t numberOfValues = 0;
+			std::size_t blockSize = 0;
+
+			do
+			{
+				_doseValues.resize(numberOfValues + defaultBlockSize);
+				_fractions.resize(numberOfValues + defaultBlockSize);
+				_ids.resize(numberOfValues + defaultBlockSize);
+
+				blockSize = aSourceIterator->nextBlock(defaultBlockSize, _doseValues.data() + numberOfValues,
+				                                       _fractions.data() + numberOfValues, _ids.data() + numberOfValues);
+				numberOfValues += blockSize;
+			}
+			while (blockSize > 0);
+
+			_doseValues.resize(numberOfValues);
+			_fractions.resize(numberOfValues);
+			_ids.resize(numberOfValues);
+			_doseValues.shrink_to_fit();
+			_fractions.shrink_to_fit();
+			_ids.shrink_to_fit();
+		}
+
+		bool BufferedDoseIterator::reset()
+		{
+			_currentPosition = 0;
+			return true;
+		}
+
+		void BufferedDoseIterator::next()
+		{
+			++_currentPosition;
+		}
+
+		bool BufferedDoseIterator::isPositionValid() const
+		{
+			return _currentPosition < _doseValues.size();
+		}
+
+		DoseVoxelVolumeType BufferedDoseIterator::getCurrentVoxelVolume() const
+		{
+			return _voxelVolume;
+		}
+
+		DoseTypeGy BufferedDoseIterator::getCurrentDoseValue() const
+		{
+			return _doseValues[_currentPosition];
+		}
+
+		FractionType BufferedDoseIterator::getCurrentRelevantVolumeFraction() const
+		{
+			return _fractions[_currentPosition];
+		}
+
+		VoxelGridID BufferedDoseIterator::getCurrentVoxelGridID() const
+		{
+			return _ids[_currentPosition];
+		}
+
+		std::size_t BufferedDoseIterator::nextBlock(const std::size_t aMaxNumberOfValues, DoseTypeGy* doseValues,
+		        FractionType* fractions, VoxelGridID* ids)
+		{
+			const std::size_t count = readPositions(_currentPosition, aMaxNumberOfValues, doseValues, fractions, ids);
+			_currentPosition += count;
+			return count;
+		}
+
+		std::size_t BufferedDoseIterator::getNumberOfPositions() const
+		{
+			return _doseValues.size();
+		}
+
+		std::size_t BufferedDoseIterator::readPositions(const std::size_t aFirstPosition,
+		        const std::size_t aMaxNumberOfValues, DoseTypeGy* doseValues, FractionType* fractions, VoxelGridID* ids) const
+		{
+			if (aFirstPosition >= _doseValues.size())
+			{
+				return 0;
+			}
+
+			const std::size_t count = std::min(aMaxNumberOfValues, _doseValues.size() - aFirstPosition);
+			std::copy_n(_doseValues.cbegin() + aFirstPosition, count, doseValues);
+
+			if (fractions)
+			{
+				std::copy_n(_fractions.cbegin() + aFirstPosition, count, fractions);
+			}
+
+			if (ids)
+			{
+				std::copy_n(_ids.cbegin() + aFirstPosition, count, ids);
+			}
+
+			return count;
+		}
+
+		IDType BufferedDoseIterator::getVoxelizationID() const
+		{
+			return _voxelizationID;
+		}
+
+		std::size_t BufferedDoseIterator::getNumberOfValues() const
+		{
+			return _doseValues.size();
+		}
+
+		const std::vector<DoseTypeGy>& BufferedDoseIterator::getDoseValues() const
+		{
+			return _doseValues;
+		}
+
+		const std::vector<FractionType>& BufferedDoseIterator::getRelevantVolumeFractions() const
+		{
+			return _fractions;
+		}
+
+		const std::vector<VoxelGridID>& BufferedDoseIterator::getVoxelGridIDs() const
+		{
+			return _ids;
+		}
+	}
+}
@@ -0,0 +1,115 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+#ifndef __BUFFERED_DOSE_ITERATOR_H
+#define __BUFFERED_DOSE_ITERATOR_H
+
+#include <vector>
+
+#include "rttbBaseType.h"
+#include "rttbCommon.h"
+#include "rttbDoseIteratorInterface.h"
+
+#include "RTTBCoreExports.h"
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+
+namespace rttb
+{
+	namespace core
+	{
+
+		/*! @class BufferedDoseIterator
+			@brief Dose iterator that reads another iterator exactly once and replays the recorded positions from memory.
+			@details Use it if several computations (e.g. dose statistics, Vx values and the DVH) iterate over the same
+			(masked) dose: the expensive source (mask voxelization, dose interpolation) is evaluated only in the
+			constructor, every further pass only reads the buffers. The source is released after reading.
+			Memory: one dose value, one volume fraction and one voxel grid ID per position.
+		*/
+		class RTTBCore_EXPORT BufferedDoseIterator : public DoseIteratorInterface
+		{
+		public:
+			rttbClassMacro(BufferedDoseIterator, DoseIteratorInterface);
+			using DoseIteratorPointer = DoseIteratorInterface::Pointer;
+
+		private:
+			std::vector<DoseTypeGy> _doseValues;
+			std::vector<FractionType> _fractions;
+			std::vector<VoxelGridID> _ids;
+
+			DoseVoxelVolumeType _voxelVolume;
+			IDType _voxelizationID;
+
+			std::size_t _currentPosition;
+
+			BufferedDoseIterator(const BufferedDoseIterator&) = delete; //not implemented on purpose -> non-copyable
+			BufferedDoseIterator& operator=(const
+			                                BufferedDoseIterator&) = delete;//not implemented on purpose -> non-copyable
+
+		public:
+			/*! @brief Constructor. Reads all positions of aSourceIterator.
+				@exception NullPointerException if aSourceIterator is nullptr.
+				@exception InvalidParameterException if the source has an inhomogeneous grid (see
+				DoseIteratorInterface::getCurrentVoxelVolume()).
+			*/
+			explicit BufferedDoseIterator(DoseIteratorPointer aSourceIterator);
+
+			bool reset() override;
+
+			void next() override;
+
+			bool isPositionValid() const override;
+
+			DoseVoxelVolumeType getCurrentVoxelVolume() const override;
+
+			DoseTypeGy getCurrentDoseValue() const override;
+
+			FractionType getCurrentRelevantVolumeFraction() const override;
+
+			VoxelGridID getCurrentVoxelGridID() const override;
+
+			std::size_t nextBlock(std::size_t aMaxNumberOfValues, DoseTypeGy* doseValues, FractionType* fractions,
+			                      VoxelGridID* ids) override;
+
+			std::size_t getNumberOfPositions() const override;
+
+			std::size_t readPositions(std::size_t aFirstPosition, std::size_t aMaxNumberOfValues, DoseTypeGy* doseValues,
+			                          FractionType* fractions, VoxelGridID* ids) const override;
+
+			/*! @brief returns the voxelization ID of the source iterator.*/
+			IDType getVoxelizationID() const override;
+
+			/*! @brief number of recorded positions*/
+			std::size_t getNumberOfValues() const;
+
+			/*! @brief dose values of all positions in iteration order*/
+			const std::vector<DoseTypeGy>& getDoseValues() const;
+
+			/*! @brief relevant volume fractions of all positions in iteration order*/
+			const std::vector<FractionType>& getRelevantVolumeFractions() const;
+
+			/*! @brief voxel grid IDs of all positions in iteration order*/
+			const std::vector<VoxelGridID>& getVoxelGridIDs() const;
+		};
+	}
+}
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif
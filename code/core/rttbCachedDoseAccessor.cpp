@@ -0,0 +1,148 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+#include <algorithm>
+
+#include "rttbCachedDoseAccessor.h"
+#include "rttbNullPointerException.h"
+#include "rttbInvalidParameterException.h"
+#include "rttbIndexOutOfBoundsException.h"
+#include "rttbThreadPool.h"
+
+namespace rttb
+{
+	namespace core
+	{
+
+		CachedDoseAccessor::CachedDoseAccessor(AccessorInterface::ConstPointer source, CachingMode mode,
+		                                       unsigned int numberOfThreads, GridIndexType slicesPerBlock) :
+			_source(source), _mode(mode), _slicesPerBlock(slicesPerBlock), _numberOfCachedBlocks(0)
+		{
+			if (_source == nullptr)
+			{
+				throw NullPointerException("Source accessor must not be nullptr!");
+			}
+
+			if (_slicesPerBlock == 0)
+			{
+				throw InvalidParameterException("Number of slices per block must be greater than 0!");
+			}
+
+			_geoInfo = _source->getGeometricInfo();
+			_UID = _source->getUID();
+
+			const GridIndexType numberOfSlices = _geoInfo.getNumSlices();
+			_slicesPerBlock = std::min(_slicesPerBlock, std::max<GridIndexType>(numberOfSlices, 1));
+			_blockSize = static_cast<GridSizeType>(_geoInfo.getNumColumns()) * _geoInfo.getNumRows() * _slicesPerBlock;
+			_numberOfBlocks = (numberOfSlices + _slicesPerBlock - 1) / _slicesPerBlock;
+			_values.resize(_geoInfo.getNumberOfVoxels());
+
+			if (_mode == CachingMode::OnDemand)
+			{
+				_blockFlags.reset(new std::once_flag[_numberOfBlocks]);
+			}
+			else
+			{
+				if (numberOfThreads == 0)
+				{
+					numberOfThreads = ThreadPool::getDefault().getNumberOfThreads();
+				}
+
+				materialize(numberOfThreads);
+				//all values are cached, the (possibly expensive) source pipeline is not needed anymore
+				_source.reset();
+			}
+		}
+
+		void CachedDoseAccessor::loadBlock(const GridIndexType aBlock) const
+		{
+			const GridSizeType firstID = aBlock * _blockSize;
+			const GridSizeType numberOfValues = std::min(_blockSize,
+			                                    static_cast<GridSizeType>(_values.size()) - firstID);
+			_source->getValues(static_cast<VoxelGridID>(firstID), numberOfValues, _values.data() + firstID);
+			++_numberOfCachedBlocks;
+		}
+
+		void CachedDoseAccessor::materialize(unsigned int numberOfThreads)
+		{
+			numberOfThreads = std::min(numberOfThreads, _numberOfBlocks);
+
+			if (numberOfThreads <= 1)
+			{
+				for (GridIndexType block = 0; block < _numberOfBlocks; ++block)
+				{
+					loadBlock(block);
+				}
+
+				return;
+			}
+
+			//every task evaluates a slab of consecutive blocks; wait() passes exceptions back to the calling thread
+			ThreadPool::TaskGroup group(ThreadPool::getDefault());
+			const GridIndexType blocksInAThread = _numberOfBlocks / numberOfThreads;
+			const GridIndexType remainingBlocks = _numberOfBlocks % numberOfThreads;
+			GridIndexType beginBlock = 0;
+
+			for (unsigned int i = 0; i < numberOfThreads; ++i)
+			{
+				const GridIndexType endBlock = beginBlock + blocksInAThread + (i < remainingBlocks ? 1 : 0);
+
+				group.run([this, beginBlock, endBlock]()
+				{
+					for (GridIndexType block = beginBlock; block < endBlock; ++block)
+					{
+						loadBlock(block);
+					}
+				});
+
+				beginBlock = endBlock;
+			}
+
+			group.wait();
+		}
+
+		GenericValueType CachedDoseAccessor::getValueAt(const VoxelGridIndex3D& aIndex) const
+		{
+			VoxelGridID aVoxelGridID;
+
+			if (_geoInfo.convert(aIndex, aVoxelGridID))
+			{
+				return getValueAt(aVoxelGridID);
+			}
+			else
+			{
+				return -1;
+			}
+		}
+
+		void CachedDoseAccessor::getValues(const VoxelGridID aFirstID, const GridSizeType aNumberOfValues,
+		                                   GenericValueType* values) const
+		{
+			if (aFirstID < 0 || aNumberOfValues < 0 || aFirstID + aNumberOfValues > getGridSize())
+			{
+				throw IndexOutOfBoundsException("Requested voxel ID range is not inside the grid!");
+			}
+
+			if (aNumberOfValues == 0)
+			{
+				return;
+			}
+
+			ensureCached(aFirstID, aNumberOfValues);
+			std::copy(_values.cbegin() + aFirstID, _values.cbegin() + aFirstID + aNumberOfValues, values);
+		}
+
+	}//end namespace core
+}//end namespace rttb
@@ -0,0 +1,164 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+#ifndef __CACHED_DOSE_ACCESSOR_H
+#define __CACHED_DOSE_ACCESSOR_H
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "rttbAccessorInterface.h"
+#include "rttbBaseType.h"
+#include "rttbCommon.h"
+
+#include "RTTBCoreExports.h"
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+
+namespace rttb
+{
+	namespace core
+	{
+
+		/*! @class CachedDoseAccessor
+			@brief Decorator that evaluates a (lazy) accessor only once and answers all further requests from a
+			contiguous buffer.
+			@details Intended for lazy pipelines (e.g. BinaryFunctorAccessor or mappable accessors) that are read
+			several times. The grid is split into blocks of whole slices. In CachingMode::Eager all blocks are
+			evaluated in the constructor as slabs on the shared ThreadPool; afterwards the source is released.
+			In CachingMode::OnDemand a block is evaluated the first time one of its voxels is requested.
+			@pre The source is read concurrently (eager mode with more than one thread, or concurrent reads in
+			on demand mode): its getValueAt()/getValues() and everything they call (operand accessors, interpolations,
+			transformations) must be safe to call from several threads at once, i.e. must not modify shared state
+			without synchronization. The RTTB lazy accessors (BinaryFunctorAccessor, SimpleMappableDoseAccessor,
+			RosuMappableDoseAccessor with the RTTB interpolations) only read their inputs; ConcurrentMappingTest checks
+			such a chain. A custom transformation has to fulfill this as well, otherwise use one thread.
+		*/
+		class RTTBCore_EXPORT CachedDoseAccessor : public AccessorInterface
+		{
+		public:
+			rttbClassMacro(CachedDoseAccessor, AccessorInterface);
+
+			enum class CachingMode
+			{
+				Eager, OnDemand
+			};
+
+		private:
+			AccessorInterface::ConstPointer _source;
+			GeometricInfo _geoInfo;
+			IDType _UID;
+			CachingMode _mode;
+			GridIndexType _slicesPerBlock;
+			GridSizeType _blockSize;
+			GridIndexType _numberOfBlocks;
+
+			mutable std::vector<GenericValueType> _values;
+			std::unique_ptr<std::once_flag[]> _blockFlags;
+			mutable std::atomic<GridIndexType> _numberOfCachedBlocks;
+
+			/*! @brief evaluates block aBlock of the source and stores the values in _values.*/
+			void loadBlock(GridIndexType aBlock) const;
+
+			/*! @brief makes sure that all blocks overlapping the ID range are cached.*/
+			void ensureCached(VoxelGridID aFirstID, GridSizeType aNumberOfValues) const
+			{
+				if (_mode == CachingMode::OnDemand)
+				{
+					const auto lastBlock = static_cast<GridIndexType>((aFirstID + aNumberOfValues - 1) / _blockSize);
+
+					for (auto block = static_cast<GridIndexType>(aFirstID / _blockSize); block <= lastBlock; ++block)
+					{
+						std::call_once(_blockFlags[block], &CachedDoseAccessor::loadBlock, this, block);
+					}
+				}
+			};
+
+			/*! @brief evaluates all blocks in numberOfThreads slabs on the shared ThreadPool.*/
+			void materialize(unsigned int numberOfThreads);
+
+		public:
+			/*! @brief Constructor.
+				@param source accessor whose values are cached (geometric info and UID are taken from it).
+				@param mode CachingMode::Eager evaluates all values in the constructor, CachingMode::OnDemand evaluates a block
+				when it is accessed for the first time.
+				@param numberOfThreads number of slabs that are evaluated in parallel in eager mode. 0: use the number of
+				threads of the shared ThreadPool.
+				@param slicesPerBlock number of slices that are evaluated together.
+				@exception NullPointerException if source is nullptr.
+				@exception InvalidParameterException if slicesPerBlock is 0.
+			*/
+			explicit CachedDoseAccessor(AccessorInterface::ConstPointer source, CachingMode mode = CachingMode::Eager,
+			                            unsigned int numberOfThreads = 0, GridIndexType slicesPerBlock = 1);
+
+			~CachedDoseAccessor() override = default;
+
+			const GeometricInfo& getGeometricInfo() const override
+			{
+				return _geoInfo;
+			};
+
+			GenericValueType getValueAt(const VoxelGridID aID) const override
+			{
+				if (!_geoInfo.validID(aID))
+				{
+					return -1;
+				}
+
+				ensureCached(aID, 1);
+				return _values[aID];
+			};
+
+			GenericValueType getValueAt(const VoxelGridIndex3D& aIndex) const override;
+
+			/*! @brief copies the values from the cache (missing blocks are evaluated first in on demand mode).
+				@exception IndexOutOfBoundsException if the ID range is not completely inside the grid.
+			*/
+			void getValues(VoxelGridID aFirstID, GridSizeType aNumberOfValues, GenericValueType* values) const override;
+
+			const IDType getUID() const override
+			{
+				return _UID;
+			};
+
+			CachingMode getCachingMode() const
+			{
+				return _mode;
+			};
+
+			GridIndexType getNumberOfBlocks() const
+			{
+				return _numberOfBlocks;
+			};
+
+			/*! @brief returns the number of blocks that have been evaluated so far (always all blocks in eager mode).*/
+			GridIndexType getNumberOfCachedBlocks() const
+			{
+				return _numberOfCachedBlocks;
+			};
+		};
+	}
+}
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif
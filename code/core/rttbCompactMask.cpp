@@ -0,0 +1,130 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+#include <algorithm>
+
+#include "rttbCompactMask.h"
+
+namespace rttb
+{
+	namespace core
+	{
+
+		CompactMask::CompactMask(const MaskVoxelList& voxels, const GeometricInfo& geoInfo)
+		{
+			const auto numberOfColumns = static_cast<VoxelGridID>(geoInfo.getNumColumns());
+
+			//sort the positions by ID; stable, so that the first occurrence of an ID is kept
+			std::vector<MaskVoxelList::size_type> order(voxels.size());
+
+			for (MaskVoxelList::size_type i = 0; i < order.size(); ++i)
+			{
+				order[i] = i;
+			}
+
+			std::stable_sort(order.begin(), order.end(), [&voxels](MaskVoxelList::size_type a, MaskVoxelList::size_type b)
+			{
+				return voxels[a].getVoxelGridID() < voxels[b].getVoxelGridID();
+			});
+
+			VoxelGridID lastID = -1;
+
+			for (auto pos : order)
+			{
+				const MaskVoxel& voxel = voxels[pos];
+				const VoxelGridID id = voxel.getVoxelGridID();
+
+				if (id == lastID)
+				{
+					continue;
+				}
+
+				if (voxel.getRelevantVolumeFraction() == 1)
+				{
+					//extend the last run if the voxel directly follows it in the same row
+					if (!_runs.empty() && _runs.back().firstID + static_cast<VoxelGridID>(_runs.back().length) == id
+					    && id % numberOfColumns != 0)
+					{
+						++_runs.back().length;
+					}
+					else
+					{
+						_runs.push_back(Run{ id, 1 });
+					}
+				}
+				else
+				{
+					_partialVoxels.push_back(PartialVoxel{ id, static_cast<FractionStorageType>(voxel.getRelevantVolumeFraction()) });
+				}
+
+				lastID = id;
+				++_numberOfVoxels;
+			}
+
+			_runs.shrink_to_fit();
+			_partialVoxels.shrink_to_fit();
+		}
+
+		CompactMask::MaskVoxelList CompactMask::toMaskVoxelList() const
+		{
+			MaskVoxelList result;
+			result.reserve(_numberOfVoxels);
+
+			for (auto it = begin(); it != end(); ++it)
+			{
+				result.emplace_back(it.getVoxelGridID(), it.getRelevantVolumeFraction());
+			}
+
+			return result;
+		}
+
+		bool CompactMask::getMaskAt(const VoxelGridID aID, MaskVoxel& voxel) const
+		{
+			voxel.setRelevantVolumeFraction(0);
+
+			//last run starting at or before aID
+			auto runIt = std::upper_bound(_runs.cbegin(), _runs.cend(), aID, [](VoxelGridID id, const Run& run)
+			{
+				return id < run.firstID;
+			});
+
+			if (runIt != _runs.cbegin())
+			{
+				--runIt;
+
+				if (aID < runIt->firstID + static_cast<VoxelGridID>(runIt->length))
+				{
+					voxel = MaskVoxel(aID, 1);
+					return true;
+				}
+			}
+
+			auto partialIt = std::lower_bound(_partialVoxels.cbegin(), _partialVoxels.cend(), aID,
+			                                  [](const PartialVoxel& partial, VoxelGridID id)
+			{
+				return partial.id < id;
+			});
+
+			if (partialIt != _partialVoxels.cend() && partialIt->id == aID)
+			{
+				voxel = MaskVoxel(aID, partialIt->fraction);
+				return true;
+			}
+
+			return false;
+		}
+
+	}//end namespace core
+}//end namespace rttb
@@ -0,0 +1,228 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+#ifndef __COMPACT_MASK_H
+#define __COMPACT_MASK_H
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <vector>
+
+#include "rttbBaseType.h"
+#include "rttbGeometricInfo.h"
+#include "rttbMaskVoxel.h"
+
+#include "RTTBCoreExports.h"
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+
+namespace rttb
+{
+	namespace core
+	{
+		/*! @class CompactMask
+			@brief Run length encoded representation of a mask voxel list.
+			@details Voxels with a relevant volume fraction of 1 are stored as runs of consecutive voxel grid IDs
+			(a run never crosses the end of a row), all other (boundary) voxels are stored explicitly with a float
+			fraction. Both lists are sorted by voxel grid ID; iteration visits all voxels in ascending ID order.
+			For large masks this needs about an order of magnitude less memory than MaskVoxelList.
+			@remarks Partial fractions are stored as float, so converting back to a MaskVoxelList can change them
+			by float precision. Voxel grid IDs that occur several times in the source list are stored once
+			(the first occurrence is kept).
+		*/
+		class RTTBCore_EXPORT CompactMask
+		{
+		public:
+			using MaskVoxelList = std::vector<MaskVoxel>;
+			using FractionStorageType = float;
+
+			/*! @brief length voxels with fraction 1, starting with firstID*/
+			struct Run
+			{
+				VoxelGridID firstID;
+				GridIndexType length;
+			};
+
+			/*! @brief voxel with a fraction other than 1*/
+			struct PartialVoxel
+			{
+				VoxelGridID id;
+				FractionStorageType fraction;
+			};
+
+			using RunList = std::vector<Run>;
+			using PartialVoxelList = std::vector<PartialVoxel>;
+
+			/*! @class ConstIterator
+				@brief Forward iterator that merges runs and partial voxels in ascending voxel grid ID order.
+				Dereferencing creates a MaskVoxel; getVoxelGridID()/getRelevantVolumeFraction() avoid that.
+			*/
+			class RTTBCore_EXPORT ConstIterator
+			{
+			public:
+				using iterator_category = std::forward_iterator_tag;
+				using value_type = MaskVoxel;
+				using difference_type = std::ptrdiff_t;
+				using pointer = const MaskVoxel*;
+				using reference = MaskVoxel;
+
+			private:
+				const CompactMask* _mask = nullptr;
+				RunList::size_type _runPos = 0;
+				GridIndexType _runOffset = 0;
+				PartialVoxelList::size_type _partialPos = 0;
+
+				VoxelGridID currentRunID() const
+				{
+					return _runPos < _mask->_runs.size() ? _mask->_runs[_runPos].firstID + static_cast<VoxelGridID>(_runOffset) :
+					       std::numeric_limits<VoxelGridID>::max();
+				};
+
+				VoxelGridID currentPartialID() const
+				{
+					return _partialPos < _mask->_partialVoxels.size() ? _mask->_partialVoxels[_partialPos].id :
+					       std::numeric_limits<VoxelGridID>::max();
+				};
+
+			public:
+				ConstIterator() = default;
+				ConstIterator(const CompactMask* mask, RunList::size_type runPos, PartialVoxelList::size_type partialPos) :
+					_mask(mask), _runPos(runPos), _partialPos(partialPos) {};
+
+				VoxelGridID getVoxelGridID() const
+				{
+					return std::min(currentRunID(), currentPartialID());
+				};
+
+				FractionType getRelevantVolumeFraction() const
+				{
+					return currentRunID() < currentPartialID() ? 1. : static_cast<FractionType>
+					       (_mask->_partialVoxels[_partialPos].fraction);
+				};
+
+				MaskVoxel operator*() const
+				{
+					return MaskVoxel(getVoxelGridID(), getRelevantVolumeFraction());
+				};
+
+				ConstIterator& operator++()
+				{
+					if (currentRunID() < currentPartialID())
+					{
+						if (++_runOffset == _mask->_runs[_runPos].length)
+						{
+							++_runPos;
+							_runOffset = 0;
+						}
+					}
+					else
+					{
+						++_partialPos;
+					}
+
+					return *this;
+				};
+
+				ConstIterator operator++(int)
+				{
+					ConstIterator result(*this);
+					++(*this);
+					return result;
+				};
+
+				bool operator==(const ConstIterator& other) const
+				{
+					return _mask == other._mask && _runPos == other._runPos && _runOffset == other._runOffset
+					       && _partialPos == other._partialPos;
+				};
+
+				bool operator!=(const ConstIterator& other) const
+				{
+					return !(*this == other);
+				};
+			};
+
+		private:
+			RunList _runs;
+			PartialVoxelList _partialVoxels;
+			GridSizeType _numberOfVoxels = 0;
+
+		public:
+			CompactMask() = default;
+
+			/*! @brief Constructor. Compacts the given voxel list (which does not need to be sorted).
+				@param voxels mask voxels, all IDs have to be valid in geoInfo.
+				@param geoInfo geometric info of the mask grid (runs are split at the end of a row).
+			*/
+			CompactMask(const MaskVoxelList& voxels, const GeometricInfo& geoInfo);
+
+			/*! @brief expands the mask to a MaskVoxelList (sorted by voxel grid ID).*/
+			MaskVoxelList toMaskVoxelList() const;
+
+			ConstIterator begin() const
+			{
+				return ConstIterator(this, 0, 0);
+			};
+
+			ConstIterator end() const
+			{
+				return ConstIterator(this, _runs.size(), _partialVoxels.size());
+			};
+
+			/*! @brief number of voxels of the mask (voxels in runs + partial voxels)*/
+			GridSizeType getNumberOfVoxels() const
+			{
+				return _numberOfVoxels;
+			};
+
+			bool empty() const
+			{
+				return _numberOfVoxels == 0;
+			};
+
+			const RunList& getRuns() const
+			{
+				return _runs;
+			};
+
+			const PartialVoxelList& getPartialVoxels() const
+			{
+				return _partialVoxels;
+			};
+
+			/*! @brief memory needed for the runs and partial voxels in bytes*/
+			size_t getMemorySize() const
+			{
+				return _runs.size() * sizeof(Run) + _partialVoxels.size() * sizeof(PartialVoxel);
+			};
+
+			/*! @brief looks up aID with binary search in runs and partial voxels.
+				@return true if aID is part of the mask; voxel then contains the mask information.
+				Otherwise the relevant volume fraction of voxel is set to 0.
+			*/
+			bool getMaskAt(VoxelGridID aID, MaskVoxel& voxel) const;
+		};
+	}
+}
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif
@@ -0,0 +1,94 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+#include <boost/make_shared.hpp>
+
+#include "rttbCompactMaskAccessor.h"
+#include "rttbNullPointerException.h"
+
+namespace rttb
+{
+	namespace core
+	{
+
+		CompactMaskAccessor::CompactMaskAccessor(CompactMaskPointer compactMask, const GeometricInfo& geoInfo,
+		        const IDType& aUID) : _compactMask(compactMask), _geoInfo(geoInfo), _maskUID(aUID)
+		{
+			if (_compactMask == nullptr)
+			{
+				throw NullPointerException("Compact mask must not be nullptr!");
+			}
+		}
+
+		CompactMaskAccessor::CompactMaskAccessor(MaskAccessorInterface::Pointer source)
+		{
+			if (source == nullptr)
+			{
+				throw NullPointerException("Source mask accessor must not be nullptr!");
+			}
+
+			_geoInfo = source->getGeometricInfo();
+			_maskUID = source->getMaskUID();
+			_compactMask = boost::make_shared<const CompactMask>(*(source->getRelevantVoxelVector()), _geoInfo);
+		}
+
+		CompactMaskAccessor::MaskVoxelListPointer CompactMaskAccessor::getRelevantVoxelVector()
+		{
+			return boost::make_shared<MaskVoxelList>(_compactMask->toMaskVoxelList());
+		}
+
+		CompactMaskAccessor::MaskVoxelListPointer CompactMaskAccessor::getRelevantVoxelVector(float lowerThreshold)
+		{
+			auto filteredVoxelVectorPointer = boost::make_shared<MaskVoxelList>();
+
+			for (auto it = _compactMask->begin(); it != _compactMask->end(); ++it)
+			{
+				if (it.getRelevantVolumeFraction() > lowerThreshold)
+				{
+					filteredVoxelVectorPointer->emplace_back(it.getVoxelGridID(), it.getRelevantVolumeFraction());
+				}
+			}
+
+			return filteredVoxelVectorPointer;
+		}
+
+		bool CompactMaskAccessor::getMaskAt(const VoxelGridID aID, MaskVoxel& voxel) const
+		{
+			voxel.setRelevantVolumeFraction(0);
+
+			if (!_geoInfo.validID(aID))
+			{
+				return false;
+			}
+
+			return _compactMask->getMaskAt(aID, voxel);
+		}
+
+		bool CompactMaskAccessor::getMaskAt(const VoxelGridIndex3D& aIndex, MaskVoxel& voxel) const
+		{
+			VoxelGridID aVoxelGridID;
+
+			if (_geoInfo.convert(aIndex, aVoxelGridID))
+			{
+				return getMaskAt(aVoxelGridID, voxel);
+			}
+			else
+			{
+				return false;
+			}
+		}
+
+	}//end namespace core
+}//end namespace rttb
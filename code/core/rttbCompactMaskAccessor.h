@@ -0,0 +1,102 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+#ifndef __COMPACT_MASK_ACCESSOR_H
+#define __COMPACT_MASK_ACCESSOR_H
+
+#include <boost/shared_ptr.hpp>
+
+#include "rttbBaseType.h"
+#include "rttbCompactMask.h"
+#include "rttbGeometricInfo.h"
+#include "rttbMaskAccessorInterface.h"
+
+#include "RTTBCoreExports.h"
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+
+namespace rttb
+{
+	namespace core
+	{
+		/*! @class CompactMaskAccessor
+			@brief Mask accessor that holds its mask as CompactMask.
+			@details Use it with CompactMaskedDoseIterator to iterate the mask without expanding it.
+			getRelevantVoxelVector() is only provided for compatibility: it expands the mask into a new list on every call.
+		*/
+		class RTTBCore_EXPORT CompactMaskAccessor : public MaskAccessorInterface
+		{
+		public:
+			rttbClassMacro(CompactMaskAccessor, MaskAccessorInterface);
+			using CompactMaskPointer = boost::shared_ptr<const CompactMask>;
+
+		private:
+			CompactMaskPointer _compactMask;
+			GeometricInfo _geoInfo;
+			IDType _maskUID;
+
+		public:
+			/*! @brief Constructor.
+				@exception NullPointerException if compactMask is nullptr.
+			*/
+			CompactMaskAccessor(CompactMaskPointer compactMask, const GeometricInfo& geoInfo, const IDType& aUID = "");
+
+			/*! @brief Constructor. Compacts the relevant voxels of source (geometric info and UID are taken from source).
+				@exception NullPointerException if source is nullptr.
+			*/
+			explicit CompactMaskAccessor(MaskAccessorInterface::Pointer source);
+
+			~CompactMaskAccessor() override = default;
+
+			/*! @brief the mask is complete after construction, nothing to do.*/
+			void updateMask() override {};
+
+			const GeometricInfo& getGeometricInfo() const override
+			{
+				return _geoInfo;
+			};
+
+			/*! @brief expands the compact mask (sorted by voxel grid ID).*/
+			MaskVoxelListPointer getRelevantVoxelVector() override;
+
+			/*! @brief expands all voxels of the compact mask with a relevant volume fraction above lowerThreshold.*/
+			MaskVoxelListPointer getRelevantVoxelVector(float lowerThreshold) override;
+
+			/*! @brief O(log n) lookup in the compact mask.*/
+			bool getMaskAt(const VoxelGridID aID, MaskVoxel& voxel) const override;
+
+			bool getMaskAt(const VoxelGridIndex3D& aIndex, MaskVoxel& voxel) const override;
+
+			IDType getMaskUID() const override
+			{
+				return _maskUID;
+			};
+
+			const CompactMaskPointer& getCompactMask() const
+			{
+				return _compactMask;
+			};
+		};
+	}
+}
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif
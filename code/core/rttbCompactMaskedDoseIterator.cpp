@@ -0,0 +1,160 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+#include <cassert>
+
+#include <boost/make_shared.hpp>
+
+#include "rttbCompactMaskedDoseIterator.h"
+#include "rttbCompactMaskAccessor.h"
+#include "rttbInvalidParameterException.h"
+
+namespace rttb
+{
+	namespace core
+	{
+
+		bool CompactMaskedDoseIterator::reset()
+		{
+			auto compactMaskAccessor = boost::dynamic_pointer_cast<CompactMaskAccessor>(_spMask);
+
+			if (compactMaskAccessor)
+			{
+				_compactMask = compactMaskAccessor->getCompactMask();
+			}
+			else if (!_compactMask)
+			{
+				_compactMask = boost::make_shared<const CompactMask>(*(_spMask->getRelevantVoxelVector()),
+				               _spMask->getGeometricInfo());
+			}
+
+			_currentMaskPos = _compactMask->begin();
+
+			const core::GeometricInfo& geoInfo = _spDoseAccessor->getGeometricInfo();
+			_currentVoxelVolume = geoInfo.getSpacing()(0) * geoInfo.getSpacing()(1) * geoInfo.getSpacing()(
+			                          2) / 1000;
+
+			return true;
+		}
+
+		void CompactMaskedDoseIterator::next()
+		{
+			++_currentMaskPos;
+		}
+
+		DoseVoxelVolumeType CompactMaskedDoseIterator::getCurrentVoxelVolume() const
+		{
+			if (_spDoseAccessor->isGridHomogeneous())
+			{
+				return _currentVoxelVolume;
+			}
+			else
+			{
+				throw InvalidParameterException("Inhomogeneous grids are currently not supported! ");
+			}
+		}
+
+		FractionType CompactMaskedDoseIterator::getCurrentRelevantVolumeFraction() const
+		{
+			if (_currentMaskPos != _compactMask->end())
+			{
+				return _currentMaskPos.getRelevantVolumeFraction();
+			}
+
+			return 0;
+		}
+
+		bool CompactMaskedDoseIterator::isPositionValid() const
+		{
+			if (!_compactMask || _currentMaskPos == _compactMask->end())
+			{
+				return false;
+			}
+
+			return _spDoseAccessor->getGeometricInfo().validID(_currentMaskPos.getVoxelGridID()) &&
+			       _spMask->getGeometricInfo().validID(_currentMaskPos.getVoxelGridID());
+		}
+
+		VoxelGridID CompactMaskedDoseIterator::getCurrentVoxelGridID() const
+		{
+			return _currentMaskPos.getVoxelGridID();
+		}
+
+		DoseTypeGy CompactMaskedDoseIterator::getCurrentMaskedDoseValue() const
+		{
+			assert(isPositionValid());
+			return getCurrentDoseValue() * getCurrentRelevantVolumeFraction();
+		}
+
+		DoseTypeGy CompactMaskedDoseIterator::getCurrentDoseValue() const
+		{
+			assert(_spDoseAccessor->getGeometricInfo().validID(_currentMaskPos.getVoxelGridID()));
+			return _spDoseAccessor->getValueAt(_currentMaskPos.getVoxelGridID());
+		}
+
+		std::size_t CompactMaskedDoseIterator::nextBlock(const std::size_t aMaxNumberOfValues, DoseTypeGy* doseValues,
+		        FractionType* fractions, VoxelGridID* ids)
+		{
+			//mask and dose share the same grid (checked in the constructor), so one bound check per voxel is sufficient
+			const GridSizeType numberOfVoxels = _spDoseAccessor->getGeometricInfo().getNumberOfVoxels();
+			std::size_t count = 0;
+			std::size_t runStart = 0;
+
+			if (!ids)
+			{
+				_blockIDs.resize(aMaxNumberOfValues);
+				ids = _blockIDs.data();
+			}
+
+			while (count < aMaxNumberOfValues && _currentMaskPos != _compactMask->end())
+			{
+				const VoxelGridID id = _currentMaskPos.getVoxelGridID();
+
+				if (id < 0 || id >= numberOfVoxels)
+				{
+					break;
+				}
+
+				ids[count] = id;
+
+				if (fractions)
+				{
+					fractions[count] = _currentMaskPos.getRelevantVolumeFraction();
+				}
+
+				++_currentMaskPos;
+				++count;
+			}
+
+			//read the dose values run by run (consecutive voxel IDs)
+			while (runStart < count)
+			{
+				const VoxelGridID firstID = ids[runStart];
+				std::size_t runEnd = runStart + 1;
+
+				while (runEnd < count && ids[runEnd] == firstID + static_cast<VoxelGridID>(runEnd - runStart))
+				{
+					++runEnd;
+				}
+
+				_spDoseAccessor->getValues(firstID, static_cast<GridSizeType>(runEnd - runStart), doseValues + runStart);
+				runStart = runEnd;
+			}
+
+			return count;
+		}
+
+	}//end namespace core
+}//end namespace rttb
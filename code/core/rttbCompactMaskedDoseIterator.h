@@ -0,0 +1,111 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+#ifndef __COMPACT_MASKED_DOSE_ITERATOR_H
+#define __COMPACT_MASKED_DOSE_ITERATOR_H
+
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+
+#include "rttbBaseType.h"
+#include "rttbCompactMask.h"
+#include "rttbMaskedDoseIteratorInterface.h"
+#include "rttbMaskAccessorInterface.h"
+
+#include "RTTBCoreExports.h"
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+
+namespace rttb
+{
+	namespace core
+	{
+		/*! @class CompactMaskedDoseIterator
+			@brief Masked dose iterator that walks a CompactMask in ascending voxel grid ID order.
+			@details Drop-in replacement for GenericMaskedDoseIterator. If the mask accessor is a CompactMaskAccessor,
+			its compact mask is used directly; otherwise the relevant voxel vector of the mask is compacted in reset().
+			@sa CompactMask, CompactMaskAccessor
+		*/
+		class RTTBCore_EXPORT CompactMaskedDoseIterator : public MaskedDoseIteratorInterface
+		{
+		public:
+			using MaskAccessorPointer = MaskedDoseIteratorInterface::MaskAccessorPointer;
+			using DoseAccessorPointer = MaskedDoseIteratorInterface::DoseAccessorPointer;
+			using CompactMaskPointer = boost::shared_ptr<const CompactMask>;
+
+		private:
+			CompactMaskPointer _compactMask;
+
+			CompactMask::ConstIterator _currentMaskPos;
+
+			/*! the volume in cm^3 of the current dose voxel*/
+			DoseVoxelVolumeType _currentVoxelVolume = 0.;
+
+			/*! voxel IDs of the current block, used by nextBlock() if the caller does not request the IDs*/
+			std::vector<VoxelGridID> _blockIDs;
+
+		public:
+			CompactMaskedDoseIterator(MaskAccessorPointer aSpMask, DoseAccessorPointer aDoseAccessor)
+				: MaskedDoseIteratorInterface(aSpMask, aDoseAccessor) {};
+
+			/*! @brief Set the position on the first mask voxel. Use also as initialization.
+			*/
+			bool reset() override;
+
+			/*! move to next mask position. The validity of the position is not checked here.
+			*/
+			void next() override;
+
+			/*! @brief Volume of one voxel (in cm3)
+				@exception InvalidParameterException  if a inhomogeneous grid is defined in the dose accessors, because
+				these grids are currently not supported.
+			*/
+			DoseVoxelVolumeType getCurrentVoxelVolume() const override;
+
+			FractionType getCurrentRelevantVolumeFraction() const override;
+
+			inline CompactMaskPointer getCompactMask() const
+			{
+				return _compactMask;
+			};
+
+			bool isPositionValid() const override;
+
+			/*! @brief get current VoxelGridID (on dose voxel grid)*/
+			VoxelGridID getCurrentVoxelGridID() const override;
+
+			/*! @return current dose value multiplied by current volume fraction*/
+			DoseTypeGy getCurrentMaskedDoseValue() const override;
+
+			/*! @return current dose value without masking*/
+			DoseTypeGy getCurrentDoseValue() const override;
+
+			/*! @brief collects the mask voxels of the block first and reads the dose values of consecutive voxel
+				IDs with one AccessorInterface::getValues() call per run.*/
+			std::size_t nextBlock(std::size_t aMaxNumberOfValues, DoseTypeGy* doseValues, FractionType* fractions,
+			                      VoxelGridID* ids) override;
+		};
+	}
+}
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif
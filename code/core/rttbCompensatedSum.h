@@ -0,0 +1,77 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+#ifndef __COMPENSATED_SUM_H
+#define __COMPENSATED_SUM_H
+
+#include <cmath>
+
+namespace rttb
+{
+	namespace core
+	{
+
+		/*! @class CompensatedSum
+			@brief Sum of double values with Kahan-Neumaier compensation.
+			@details The rounding error of every addition is collected in a separate compensation term, so the error of
+			the sum does not grow with the number of values. The result depends on the order of the additions; use
+			BlockwiseReduction to get a result that does not depend on the number of threads.
+			@remark The compensation is optimized away by value-unsafe floating point modes (e.g. -ffast-math).
+		*/
+		class CompensatedSum
+		{
+		private:
+			double _sum = 0;
+			double _compensation = 0;
+
+		public:
+			CompensatedSum() = default;
+
+			explicit CompensatedSum(double value) : _sum(value)
+			{
+			};
+
+			void add(double value)
+			{
+				const double sum = _sum + value;
+
+				if (std::abs(_sum) >= std::abs(value))
+				{
+					_compensation += (_sum - sum) + value;
+				}
+				else
+				{
+					_compensation += (value - sum) + _sum;
+				}
+
+				_sum = sum;
+			};
+
+			/*! @brief adds the sum and the compensation of other.*/
+			void add(const CompensatedSum& other)
+			{
+				add(other._sum);
+				_compensation += other._compensation;
+			};
+
+			double getSum() const
+			{
+				return _sum + _compensation;
+			};
+		};
+	}
+}
+
+#endif
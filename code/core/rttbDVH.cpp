@@ -13,13 +13,18 @@
 //
 //------------------------------------------------------------------------
 
+#include <algorithm>
 #include <iterator>
 #include <cmath>
+#include <utility>
+
+#include <boost/make_shared.hpp>
 
 #include "rttbDVH.h"
 #include "rttbException.h"
 #include "rttbInvalidParameterException.h"
 #include "rttbUtils.h"
+#include "rttbCompensatedSum.h"
 
 namespace rttb
 {
@@ -28,26 +33,39 @@ namespace rttb
 
 		DVH::~DVH() = default;
 
-		DVH::DVH(const DataDifferentialType& aDataDifferential, const DoseTypeGy& aDeltaD,
+		DVH::DVH(DataDifferentialType aDataDifferential, const DoseTypeGy& aDeltaD,
 		         const DoseVoxelVolumeType& aDeltaV,
-		         const IDType& aStructureID, const IDType& aDoseID): DVH(aDataDifferential, aDeltaD, aDeltaV, aStructureID, aDoseID, "")
+		         const IDType& aStructureID, const IDType& aDoseID): DVH(std::move(aDataDifferential), aDeltaD, aDeltaV, aStructureID, aDoseID, "")
 		{
 		}
 
-		DVH::DVH(const DataDifferentialType& aDataDifferential, DoseTypeGy aDeltaD,
+		DVH::DVH(DataDifferentialType aDataDifferential, DoseTypeGy aDeltaD,
 		         DoseVoxelVolumeType aDeltaV,
-		         const IDType& aStructureID, const IDType& aDoseID, const IDType& aVoxelizationID): _deltaD(aDeltaD), _deltaV(aDeltaV),
+		         const IDType& aStructureID, const IDType& aDoseID, const IDType& aVoxelizationID):
+			_dataDifferential(::boost::make_shared<const DataDifferentialType>(std::move(aDataDifferential))),
+			_deltaD(aDeltaD), _deltaV(aDeltaV),
 			_structureID(aStructureID), _doseID(aDoseID), _voxelizationID(aVoxelizationID)
 		{
-			_dataDifferential.clear();
-			_dataDifferential = aDataDifferential;
+			this->init();
+		}
 
+		DVH::DVH(const DVH& aDVH, DoseTypeGy aDeltaD) : _dataDifferential(aDVH._dataDifferential), _deltaD(aDeltaD),
+			_deltaV(aDVH._deltaV), _structureID(aDVH._structureID), _doseID(aDVH._doseID),
+			_voxelizationID(aDVH._voxelizationID), _label(aDVH._label)
+		{
 			this->init();
 		}
 
-		DVH::DVH(const DVH& copy) : DVH(copy._dataDifferential, copy._deltaD, copy._deltaV, copy._structureID, copy._doseID, copy._voxelizationID)
+		DVH::DVH(const DVH& copy) : DVH(copy, copy._deltaD)
+		{
+		}
+
+		DVH::DVH(DVH&& source) noexcept : _dataDifferential(source._dataDifferential), _deltaD(source._deltaD),
+			_deltaV(source._deltaV), _structureID(std::move(source._structureID)), _doseID(std::move(source._doseID)),
+			_voxelizationID(std::move(source._voxelizationID)), _label(std::move(source._label))
 		{
-      _label = copy._label;
+			//source is a valid DVH, so there is nothing to check
+			takeLazyData(source);
 		}
 
 		DVH& DVH::operator=(const DVH& copy)
@@ -60,16 +78,47 @@ namespace rttb
 				_doseID = copy._doseID;
 				_voxelizationID = copy._voxelizationID;
 				_label = copy._label;
-
-				_dataDifferential.clear();
 				_dataDifferential = copy._dataDifferential;
-
 			}
 
 			this->init();
 			return *this;
 		}
 
+		DVH& DVH::operator=(DVH&& source) noexcept
+		{
+			if (this != &source)
+			{
+				_deltaD = source._deltaD;
+				_deltaV = source._deltaV;
+				_structureID = std::move(source._structureID);
+				_doseID = std::move(source._doseID);
+				_voxelizationID = std::move(source._voxelizationID);
+				_label = std::move(source._label);
+				_dataDifferential = source._dataDifferential;
+				takeLazyData(source);
+			}
+
+			return *this;
+		}
+
+		void DVH::takeLazyData(DVH& source) noexcept
+		{
+			_maximum = source._maximum;
+			_minimum = source._minimum;
+			_mean = source._mean;
+			_numberOfVoxels = source._numberOfVoxels;
+			_stdDeviation = source._stdDeviation;
+			_variance = source._variance;
+			_statisticsCalculated = source._statisticsCalculated.load();
+
+			//source computes its cumulative data again if needed
+			_dataCumulative = std::move(source._dataCumulative);
+			_cumulativeCalculated = source._cumulativeCalculated.load();
+			source._dataCumulative.clear();
+			source._cumulativeCalculated = false;
+		}
+
 		bool operator==(const DVH& aDVH, const DVH& otherDVH)
 		{
       bool result;
@@ -108,13 +157,14 @@ namespace rttb
 		}
 
 
-		std::deque<DoseCalcType> DVH::getDataDifferential() const
+		const DVH::DataDifferentialType& DVH::getDataDifferential() const
 		{
-			return _dataDifferential;
+			return *_dataDifferential;
 		}
 
-		std::deque<DoseCalcType> DVH::getDataCumulative() const
+		const DVH::DataDifferentialType& DVH::getDataCumulative() const
 		{
+			calcCumulativeDVH();
 			return _dataCumulative;
 		}
 
@@ -155,60 +205,84 @@ namespace rttb
 
 		DoseStatisticType DVH::getMaximum() const
 		{
+			calcStatistics();
 			return _maximum;
 		}
 
 		DoseStatisticType DVH::getMinimum() const
 		{
+			calcStatistics();
 			return _minimum;
 		}
 
 		DoseStatisticType DVH::getMean() const
 		{
+			calcStatistics();
 			return _mean;
 		}
 
 		DVHVoxelNumber DVH::getNumberOfVoxels() const
 		{
+			calcStatistics();
 			return _numberOfVoxels;
 		}
 
 		DoseStatisticType DVH::getStdDeviation() const
 		{
+			calcStatistics();
 			return _stdDeviation;
 		}
 
 		DoseStatisticType DVH::getVariance() const
 		{
+			calcStatistics();
 			return _variance;
 		}
 
 		void DVH::init()
 		{
+			_statisticsCalculated = false;
+			_cumulativeCalculated = false;
+			_dataCumulative.clear();
+
 			if (_deltaD == 0 || _deltaV == 0)
 			{
 				throw InvalidParameterException("DVH init error: neither _deltaD nor _deltaV must be zero!");
 			}
 
-			if (this->_dataDifferential.empty())
+			if (!_dataDifferential || _dataDifferential->empty())
 			{
 				throw InvalidParameterException("DVH init error: data differential is empty!");
 			}
+		}
+
+		void DVH::calcStatistics() const
+		{
+			if (_statisticsCalculated.load(std::memory_order_acquire))
+			{
+				return;
+			}
 
-			double sum = 0;
-			double squareSum = 0;
-			_numberOfVoxels = 0;
+			std::lock_guard<std::mutex> lock(_lazyDataMutex);
+
+			if (_statisticsCalculated.load(std::memory_order_relaxed))
+			{
+				return;
+			}
+
+			CompensatedSum numberOfVoxels;
+			CompensatedSum sum;
+			CompensatedSum squareSum;
 			_maximum = 0;
 			_minimum = 0;
-			_dataCumulative.clear();
 
-			DataDifferentialType::iterator it;
+			DataDifferentialType::const_iterator it;
 
 			int i = 0;
 
-			for (it = _dataDifferential.begin(); it != _dataDifferential.end(); ++it)
+			for (it = _dataDifferential->cbegin(); it != _dataDifferential->cend(); ++it)
 			{
-				_numberOfVoxels += (*it);
+				numberOfVoxels.add(*it);
 
 				if ((*it) > 0)
 				{
@@ -220,45 +294,62 @@ namespace rttb
 					_minimum = (i + 0.5) * this->_deltaD;
 				}
 
-				sum += (*it) * (i + 0.5) * this->_deltaD;
+				sum.add((*it) * (i + 0.5) * this->_deltaD);
 
-				squareSum += (*it) * pow((i + 0.5) * this->_deltaD, 2);
+				squareSum.add((*it) * pow((i + 0.5) * this->_deltaD, 2));
 
 				i++;
 			}
 
-			_mean = sum / _numberOfVoxels;
+			_numberOfVoxels = numberOfVoxels.getSum();
+			_mean = sum.getSum() / _numberOfVoxels;
 
-			_variance = (squareSum / _numberOfVoxels - _mean * _mean);
+			_variance = (squareSum.getSum() / _numberOfVoxels - _mean * _mean);
 			_stdDeviation = pow(_variance, 0.5);
 
-			this->calcCumulativeDVH();
+			_statisticsCalculated.store(true, std::memory_order_release);
 		}
 
-		void DVH::calcCumulativeDVH()
+		void DVH::calcCumulativeDVH() const
 		{
+			if (_cumulativeCalculated.load(std::memory_order_acquire))
+			{
+				return;
+			}
 
-			_dataCumulative.clear();
+			std::lock_guard<std::mutex> lock(_lazyDataMutex);
+
+			if (_cumulativeCalculated.load(std::memory_order_relaxed))
+			{
+				return;
+			}
+
+			_dataCumulative.resize(_dataDifferential->size());
 
 			DoseCalcType cumulativeDVHi = 0;
 
-			for (auto valueItr = _dataDifferential.rbegin(); valueItr != _dataDifferential.rend(); ++valueItr) {
-				cumulativeDVHi += *valueItr;
-				_dataCumulative.push_front(cumulativeDVHi);
+			for (std::size_t i = _dataDifferential->size(); i > 0; --i)
+			{
+				cumulativeDVHi += (*_dataDifferential)[i - 1];
+				_dataCumulative[i - 1] = cumulativeDVHi;
 			}
+
+			_cumulativeCalculated.store(true, std::memory_order_release);
 		}
 
 		DoseStatisticType DVH::getMedian() const
 		{
 
+			const DataDifferentialType& dataDifferential = *_dataDifferential;
+			const DVHVoxelNumber numberOfVoxels = getNumberOfVoxels();
 			double median_voxel = 0;
 			int median_i = 0;
 
-			for (GridIndexType i = 0; i < this->_dataDifferential.size(); i++)
+			for (GridIndexType i = 0; i < dataDifferential.size(); i++)
 			{
-				if (median_voxel < (_numberOfVoxels - median_voxel))
+				if (median_voxel < (numberOfVoxels - median_voxel))
 				{
-					median_voxel += _dataDifferential[i];
+					median_voxel += dataDifferential[i];
 					median_i = i;
 				}
 			}
@@ -270,14 +361,15 @@ namespace rttb
 		DoseStatisticType DVH::getModal() const
 		{
 
+			const DataDifferentialType& dataDifferential = *_dataDifferential;
 			double modal_voxel = 0;
 			int modal_i = 0;
 
-			for (GridIndexType i = 0; i < this->_dataDifferential.size(); i++)
+			for (GridIndexType i = 0; i < dataDifferential.size(); i++)
 			{
-				if (modal_voxel < _dataDifferential[i])
+				if (modal_voxel < dataDifferential[i])
 				{
-					modal_voxel = _dataDifferential[i];
+					modal_voxel = dataDifferential[i];
 					modal_i = i;
 				}
 			}
@@ -289,11 +381,12 @@ namespace rttb
 		VolumeType DVH::getVx(DoseTypeGy xDoseAbsolute) const
 		{
 
+			const DataDifferentialType& dataCumulative = getDataCumulative();
 			auto i = static_cast<GridIndexType>(xDoseAbsolute / _deltaD);
 
-			if (i < _dataCumulative.size())
+			if (i < dataCumulative.size())
 			{
-				VolumeType vx = (_dataCumulative.at(i));
+				VolumeType vx = (dataCumulative.at(i));
 				vx = (vx * this->_deltaV);
 				return vx;
 			}
@@ -305,19 +398,18 @@ namespace rttb
 
 		DoseTypeGy DVH::getDx(VolumeType xVolumeAbsolute) const
 		{
-			GridIndexType i = 0;
+			const DataDifferentialType& dataCumulative = getDataCumulative();
+			const DoseVoxelVolumeType deltaV = this->_deltaV;
 
-			for (; i < _dataCumulative.size(); i++)
+			//first bin with a volume below xVolumeAbsolute
+			auto firstBelow = std::partition_point(dataCumulative.cbegin(), dataCumulative.cend(),
+			                                       [xVolumeAbsolute, deltaV](DoseCalcType voxels)
 			{
-				double volumeAbsoluteI = _dataCumulative[i] * this->_deltaV;
-
-				if (xVolumeAbsolute > volumeAbsoluteI)
-				{
-					break;
-				}
-			}
+				return !(xVolumeAbsolute > voxels * deltaV);
+			});
+			const auto i = static_cast<GridIndexType>(firstBelow - dataCumulative.cbegin());
 
-			if (i <= _dataCumulative.size() && i > 0)
+			if (i <= dataCumulative.size() && i > 0)
 			{
 				DoseTypeGy dx = (i - 1) * this->_deltaD;
 				return dx;
@@ -333,20 +425,16 @@ namespace rttb
 			return (relativePercent * getNumberOfVoxels() * getDeltaV() / 100.0);
 		}
 
-		std::deque<DoseCalcType> DVH::convertAbsoluteToRelative(bool isCumulative) const
+		DVH::DataDifferentialType DVH::convertAbsoluteToRelative(bool isCumulative) const
 		{
+			const DataDifferentialType& absoluteData = isCumulative ? getDataCumulative() : getDataDifferential();
+			const DVHVoxelNumber numberOfVoxels = getNumberOfVoxels();
+			DataDifferentialType relativeData;
+			relativeData.reserve(absoluteData.size());
 
-			DataDifferentialType relativeData, absoluteData;
-			if (isCumulative) {
-				absoluteData = getDataCumulative();
-			}
-			else {
-				absoluteData = getDataDifferential();
-			}
-
-			for (std::deque<DoseCalcType>::iterator it = absoluteData.begin(); it != absoluteData.end(); ++it)
+			for (auto it = absoluteData.cbegin(); it != absoluteData.cend(); ++it)
 			{
-				relativeData.push_back((*it) / getNumberOfVoxels());
+				relativeData.push_back((*it) / numberOfVoxels);
 			}
 
 			return relativeData;
@@ -364,14 +452,8 @@ namespace rttb
 
 		std::map <DoseTypeGy, PercentType> DVH::getNormalizedDVH(DVHType dvhType) const {
 			std::map <DoseTypeGy, PercentType> normalizedDVH;
-			DataDifferentialType data;
-			
-			if (dvhType.Type == DVHType::Cumulative) {
-				data = getDataCumulative();
-			}
-			else {
-				data = getDataDifferential();
-			}
+			const DataDifferentialType& data = (dvhType.Type == DVHType::Cumulative) ? getDataCumulative() :
+			                                   getDataDifferential();
 
 			if (data.empty()) {
 				throw InvalidParameterException("DVH data is empty. Can't retrieve normalized DVH");
@@ -16,9 +16,11 @@
 #ifndef __DVH_H
 #define __DVH_H
 
-#include <deque>
-#include <ostream>
+#include <atomic>
 #include <map>
+#include <mutex>
+#include <ostream>
+#include <vector>
 
 #include "boost/shared_ptr.hpp"
 
@@ -39,18 +41,21 @@ namespace rttb
 
 		/*! @class DVH
 		@brief This is a class representing a dose volume histogram (DVH)
+		@details The differential data is immutable and shared between copies (and DVHs with another bin width, see
+		DVH(const DVH&, DoseTypeGy)), so copying a DVH does not copy the histogram. The statistical values and the
+		cumulative data are computed on first access.
 		*/
 		class RTTBCore_EXPORT DVH
 		{
 		public:
-			using DataDifferentialType = std::deque<DoseCalcType>;
+			using DataDifferentialType = std::vector<DoseCalcType>;
       rttbClassMacroNoParent(DVH);
 
 		private:
 			/*! @brief Differential dvh data index is the dose bin, value is the voxel number (sub voxel accuracy)
 				of the dose bin
 			*/
-			DataDifferentialType _dataDifferential;
+			::boost::shared_ptr<const DataDifferentialType> _dataDifferential;
 			
 			/*! @brief Absolute dose value of a dose-bin in Gy
 			*/
@@ -67,26 +72,35 @@ namespace rttb
 
 			StructureLabel _label;
 
-			DoseStatisticType _maximum;
-			DoseStatisticType _minimum;
-			DoseStatisticType _mean;
-			DoseStatisticType _modal;
-			DVHVoxelNumber _numberOfVoxels;
-			DoseStatisticType _median;
-			DoseStatisticType _stdDeviation;
-			DoseStatisticType _variance;
-			DataDifferentialType _dataCumulative;
+			mutable DoseStatisticType _maximum;
+			mutable DoseStatisticType _minimum;
+			mutable DoseStatisticType _mean;
+			mutable DVHVoxelNumber _numberOfVoxels;
+			mutable DoseStatisticType _stdDeviation;
+			mutable DoseStatisticType _variance;
+			mutable DataDifferentialType _dataCumulative;
+
+			/*! @brief guards the lazy computation of the statistical values and the cumulative data*/
+			mutable std::mutex _lazyDataMutex;
+			mutable std::atomic<bool> _statisticsCalculated{false};
+			mutable std::atomic<bool> _cumulativeCalculated{false};
 
 			/*! @brief DVH initialization
-				The DVH is initialized and all statistical values are calculated.
+				The DVH data is checked, the statistical values and the cumulative data are reset to be computed on demand.
 				@throw <InvalidParameterException> if _deltaV or _deltaD are zero
 				@throw <InvalidParameterException> is _data differential is empty
 			*/
 			void init();
 
-      /*! @brief Calculate the cumulative data of dvh
+			/*! @brief Calculates the statistical values once.*/
+			void calcStatistics() const;
+
+      /*! @brief Calculate the cumulative data of dvh once
       */
-      void calcCumulativeDVH();
+      void calcCumulativeDVH() const;
+
+			/*! @brief Takes over the statistical values and the cumulative data computed by source.*/
+			void takeLazyData(DVH& source) noexcept;
 
 
 		public:
@@ -96,7 +110,7 @@ namespace rttb
 				@throw <InvalidParameterException> if _deltaV or _deltaD are zero
 				@throw <InvalidParameterException> is _data differential is empty
 			*/
-			DVH(const DataDifferentialType& aDataDifferential, const DoseTypeGy& aDeltaD,
+			DVH(DataDifferentialType aDataDifferential, const DoseTypeGy& aDeltaD,
 			    const DoseVoxelVolumeType& aDeltaV,
 			    const IDType& aStructureID, const IDType& aDoseID);
 
@@ -104,17 +118,30 @@ namespace rttb
 				@throw <InvalidParameterException> if _deltaV or _deltaD are zero
 				@throw <InvalidParameterException> is _data differential is empty
 			*/
-			DVH(const DataDifferentialType& aDataDifferential, DoseTypeGy aDeltaD, DoseVoxelVolumeType aDeltaV,
+			DVH(DataDifferentialType aDataDifferential, DoseTypeGy aDeltaD, DoseVoxelVolumeType aDeltaV,
 			    const IDType& aStructureID, const IDType& aDoseID, const IDType& aVoxelizationID);
 
+			/*! @brief DVH with the histogram of aDVH (shared, not copied) and another bin width, e.g. for a scaled dose.
+				@throw <InvalidParameterException> if aDeltaD is zero
+			*/
+			DVH(const DVH& aDVH, DoseTypeGy aDeltaD);
+
 			DVH(const DVH& copy);
 
+			/*! @brief The histogram is shared (not moved), so source stays a valid DVH with the same histogram; its IDs and
+				label are unspecified afterwards.
+			*/
+			DVH(DVH&& source) noexcept;
+
 			/*!
 				@throw <InvalidParameterException> if _deltaV or _deltaD are zero
 				@throw <InvalidParameterException> is _data differential is empty
 			*/
 			DVH& operator=(const DVH& copy);
 
+			/*! @brief See DVH(DVH&&) for the state of source afterwards.*/
+			DVH& operator=(DVH&& source) noexcept;
+
 			void setLabel(StructureLabel aLabel);
 			StructureLabel getLabel() const;
 
@@ -124,14 +151,14 @@ namespace rttb
 				@return Return differential data of the dvh (relative or absolute depending on the
 				input parameter).
 			*/
-			DataDifferentialType getDataDifferential() const;
+			const DataDifferentialType& getDataDifferential() const;
 
       /*! @param relativeVolume default false-> Value is the voxel number of the dose bin;
       if true-> value is the relative volume % between 0 and 1,
       (the voxel number of this dose bin)/(number of voxels)
       @return Return cumulative data of the dvh
       */
-      DataDifferentialType getDataCumulative() const;
+      const DataDifferentialType& getDataCumulative() const;
 
 			DoseVoxelVolumeType getDeltaV() const;
 			DoseTypeGy getDeltaD() const;
@@ -172,6 +199,7 @@ namespace rttb
 			*/
 			VolumeType getVx(DoseTypeGy xDoseAbsolute) const;
 			/*! @brief Get Dx the minimal dose delivered to x
+				@details The bin is found by binary search in the (non-increasing) cumulative data.
 				@return Return absolute dose value in Gy
 				Return -1 if not initialized
 			*/
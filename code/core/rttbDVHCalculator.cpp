@@ -13,11 +13,16 @@
 //
 //------------------------------------------------------------------------
 
+#include <algorithm>
+#include <utility>
+
 #include <boost/make_shared.hpp>
 
 #include "rttbDVHCalculator.h"
+#include "rttbDoseHistogram.h"
 #include "rttbNullPointerException.h"
 #include "rttbInvalidParameterException.h"
+#include "rttbThreadPool.h"
 
 namespace rttb
 {
@@ -26,7 +31,7 @@ namespace rttb
 
 		DVHCalculator::DVHCalculator(DoseIteratorPointer aDoseIterator, const IDType& aStructureID,
 		                             const IDType& aDoseID,
-		                             DoseTypeGy aDeltaD, const int aNumberOfBins)
+		                             DoseTypeGy aDeltaD, const int aNumberOfBins, unsigned int aNumberOfThreads)
 		{
 			if (aDoseIterator == nullptr)
 			{
@@ -44,74 +49,58 @@ namespace rttb
 
 			_numberOfBins = aNumberOfBins;
 			_deltaD = aDeltaD;
+			setNumberOfThreads(aNumberOfThreads);
+		}
 
-			if (_deltaD == 0)
-			{
-				aDoseIterator->reset();
-				DoseTypeGy max = 0;
-
-				while (aDoseIterator->isPositionValid())
-				{
-					DoseTypeGy currentVal = 0;
-					currentVal = aDoseIterator->getCurrentDoseValue();
-
-					if (currentVal > max)
-					{
-						max = currentVal;
-					}
-
-					aDoseIterator->next();
-				}
-
-				_deltaD = (max * 1.5 / _numberOfBins);
+		DVHCalculator::~DVHCalculator() = default;
 
-				if (_deltaD == 0)
-				{
-					_deltaD = 0.1;
-				}
+		void DVHCalculator::setNumberOfThreads(unsigned int aNumberOfThreads)
+		{
+			if (aNumberOfThreads == 0)
+			{
+				aNumberOfThreads = std::max(ThreadPool::getDefault().getNumberOfThreads(), 1u);
 			}
 
+			_numberOfThreads = aNumberOfThreads;
 		}
 
-		DVHCalculator::~DVHCalculator() = default;
-
 		DVH::Pointer DVHCalculator::generateDVH()
 		{
-
-			std::deque<DoseCalcType> dataDifferential(_numberOfBins, 0);
-
-			// calculate DVH
+			DoseHistogram histogram(_deltaD, _numberOfBins);
 			_doseIteratorPtr->reset();
+			const std::size_t numberOfPositions = _doseIteratorPtr->getNumberOfPositions();
 
-			while (_doseIteratorPtr->isPositionValid())
+			if (numberOfPositions > 0)
 			{
-				DoseTypeGy currentVal = 0;
-				FractionType voxelProportion = _doseIteratorPtr->getCurrentRelevantVolumeFraction();
-				currentVal = _doseIteratorPtr->getCurrentDoseValue();
-
-				auto dose_bin = static_cast<int>(currentVal / _deltaD);
+				const DoseIteratorInterface& iterator = *_doseIteratorPtr;
 
-				if (dose_bin < _numberOfBins)
+				histogram.addPositions(numberOfPositions, [&iterator](std::size_t aFirstPosition,
+				                       std::size_t aMaxNumberOfValues, DoseTypeGy * doseValues, FractionType * fractions)
 				{
-					dataDifferential[dose_bin] += voxelProportion;
-				}
-				else
+					return iterator.readPositions(aFirstPosition, aMaxNumberOfValues, doseValues, fractions, nullptr);
+				}, _numberOfThreads);
+			}
+			else
+			{
+				histogram.addBlocks([this](std::size_t aMaxNumberOfValues, DoseTypeGy * doseValues,
+				                           FractionType * fractions)
 				{
-					throw InvalidParameterException("_numberOfBins is too small: dose bin out of bounds! ");
-				}
-
-				_doseIteratorPtr->next();
+					return _doseIteratorPtr->nextBlock(aMaxNumberOfValues, doseValues, fractions, nullptr);
+				});
 			}
 
+			_deltaD = histogram.getDeltaD();
+			DVH::DataDifferentialType dataDifferential = histogram.getDataDifferential();
+
 			if (boost::dynamic_pointer_cast<MaskedDoseIteratorPointer>(_doseIteratorPtr))
 			{
-				_dvh = boost::make_shared<DVH>(dataDifferential, _deltaD, _doseIteratorPtr->getCurrentVoxelVolume(),
+				_dvh = boost::make_shared<DVH>(std::move(dataDifferential), _deltaD, _doseIteratorPtr->getCurrentVoxelVolume(),
 				                               _structureID,
 				                               _doseID, _doseIteratorPtr->getVoxelizationID());
 			}
 			else
 			{
-				_dvh = boost::make_shared<DVH>(dataDifferential, _deltaD, _doseIteratorPtr->getCurrentVoxelVolume(),
+				_dvh = boost::make_shared<DVH>(std::move(dataDifferential), _deltaD, _doseIteratorPtr->getCurrentVoxelVolume(),
 				                               _structureID,
 				                               _doseID);
 			}
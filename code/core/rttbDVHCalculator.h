@@ -16,6 +16,8 @@
 #ifndef __DVH_CALCULATOR_H
 #define __DVH_CALCULATOR_H
 
+#include <vector>
+
 #include "rttbBaseType.h"
 #include "rttbDoseIteratorInterface.h"
 #include "rttbMaskedDoseIteratorInterface.h"
@@ -35,6 +37,11 @@ namespace rttb
 
 		/*! @class DVHCalculator
 			@brief Calculates a DVH for a given DoseIterator.
+			@details The positions of the iterator are split into chunks that are binned with DoseHistogram. If the
+			iterator supports positional reads (DoseIteratorInterface::readPositions()), up to the given number of chunks
+			are read and binned concurrently on ThreadPool::getDefault(); otherwise they are read one after the other with
+			DoseIteratorInterface::nextBlock(). Since chunking and summation order do not depend on the number of threads,
+			the DVH is bit-identical for any number of threads.
 		*/
         class RTTBCore_EXPORT DVHCalculator : public DVHGeneratorInterface
 		{
@@ -48,13 +55,27 @@ namespace rttb
 			DoseTypeGy _deltaD;
 			int _numberOfBins;
 
+		private:
+			unsigned int _numberOfThreads;
+
+		public:
 			/*! @brief Constructor.
 				@param aDeltaD the absolute dose value in Gy for dose_bin [i,i+1). Optional, if aDeltaD==0,
-				it will be calculated using aDeltaD=max(aDoseIterator)*1.5/aNumberOfBins
+				it will be calculated in generateDVH() during the same pass over the iterator that also generates the DVH:
+				aDeltaD=max(aDoseIterator)*1.5/aNumberOfBins, rounded up as described in DoseHistogram::getDeltaD()
+				@param aNumberOfThreads number of chunks that are binned concurrently in generateDVH(). 0: the number of
+				threads of ThreadPool::getDefault().
 				@exception InvalidParameterException throw if _numberOfBins<=0 or _deltaD<0
 			*/
 			DVHCalculator(DoseIteratorPointer aDoseIterator, const IDType& aStructureID, const IDType& aDoseID,
-			              const DoseTypeGy aDeltaD = 0, const int aNumberOfBins = 201);
+			              const DoseTypeGy aDeltaD = 0, const int aNumberOfBins = 201, unsigned int aNumberOfThreads = 1);
+
+			void setNumberOfThreads(unsigned int aNumberOfThreads);
+
+			unsigned int getNumberOfThreads() const
+			{
+				return _numberOfThreads;
+			};
 
 			~DVHCalculator();
 
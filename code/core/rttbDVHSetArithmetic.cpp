@@ -0,0 +1,313 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include <boost/make_shared.hpp>
+
+#include "rttbDVHSetArithmetic.h"
+#include "rttbInvalidParameterException.h"
+
+namespace rttb
+{
+	namespace core
+	{
+		namespace
+		{
+			/*! @brief checks dvhs and aDeltaD and returns the common bin width (aDeltaD or the largest bin width)*/
+			DoseTypeGy getCommonDeltaD(const DVHSet::DVHSetType& dvhs, DoseTypeGy aDeltaD)
+			{
+				if (dvhs.empty())
+				{
+					throw InvalidParameterException("dvhs must not be empty!");
+				}
+
+				if (aDeltaD < 0)
+				{
+					throw InvalidParameterException("aDeltaD must not be negative!");
+				}
+
+				if (aDeltaD == 0)
+				{
+					for (const auto& dvh : dvhs)
+					{
+						aDeltaD = std::max(aDeltaD, dvh.getDeltaD());
+					}
+				}
+
+				return aDeltaD;
+			}
+
+			/*! @brief distributes the voxels of every bin of data (bin width deltaD) over the bins of width newDeltaD in
+				proportion to the overlap*/
+			DVH::DataDifferentialType resample(const DVH::DataDifferentialType& data, DoseTypeGy deltaD,
+			                                   DoseTypeGy newDeltaD)
+			{
+				const double binsPerNewBin = std::round(newDeltaD / deltaD);
+
+				if (binsPerNewBin >= 1 && std::abs(binsPerNewBin * deltaD - newDeltaD) <= errorConstant * newDeltaD)
+				{
+					//integer multiple: every bin falls into exactly one new bin
+					const auto factor = static_cast<std::size_t>(binsPerNewBin);
+					DVH::DataDifferentialType resampled((data.size() + factor - 1) / factor, 0);
+
+					for (std::size_t bin = 0; bin < data.size(); ++bin)
+					{
+						resampled[bin / factor] += data[bin];
+					}
+
+					return resampled;
+				}
+
+				DVH::DataDifferentialType resampled(static_cast<std::size_t>(std::ceil(data.size() * deltaD / newDeltaD)), 0);
+
+				for (std::size_t bin = 0; bin < data.size(); ++bin)
+				{
+					if (data[bin] == 0)
+					{
+						continue;
+					}
+
+					const DoseTypeGy binEnd = (bin + 1) * deltaD;
+					DoseTypeGy begin = bin * deltaD;
+					auto newBin = static_cast<std::size_t>(begin / newDeltaD);
+
+					while (begin < binEnd)
+					{
+						const DoseTypeGy end = std::min(binEnd, (newBin + 1) * newDeltaD);
+
+						if (end > begin)
+						{
+							if (newBin >= resampled.size())
+							{
+								resampled.resize(newBin + 1, 0);
+							}
+
+							resampled[newBin] += data[bin] * (end - begin) / deltaD;
+							begin = end;
+						}
+
+						++newBin;
+					}
+				}
+
+				return resampled;
+			}
+
+			/*! @brief absolute volume of bin of the aligned DVH (0 beyond its last bin)*/
+			VolumeType getBinVolume(const DVH::DataDifferentialType& data, DoseVoxelVolumeType deltaV, std::size_t bin)
+			{
+				return bin < data.size() ? data[bin] * deltaV : 0;
+			}
+
+			/*! @brief all DVHs of the set in the order target volume, healthy tissue, whole volume subset*/
+			DVHSet::DVHSetType getAllDVHs(const DVHSet& dvhSet)
+			{
+				DVHSet::DVHSetType dvhs;
+				dvhs.reserve(dvhSet.size());
+
+				for (const DVHSet::DVHSetType* subset : { &dvhSet.getTargetVolumeSet(), &dvhSet.getHealthyTissueSet(),
+				                                           &dvhSet.getWholeVolumeSet() })
+				{
+					dvhs.insert(dvhs.end(), subset->cbegin(), subset->cend());
+				}
+
+				return dvhs;
+			}
+
+			std::size_t getMaximumNumberOfBins(const DVHSet::DVHSetType& dvhs)
+			{
+				std::size_t numberOfBins = 0;
+
+				for (const auto& dvh : dvhs)
+				{
+					numberOfBins = std::max(numberOfBins, dvh.getDataDifferential().size());
+				}
+
+				return numberOfBins;
+			}
+		}
+
+		DVHSet::DVHSetType alignBinWidths(const DVHSet::DVHSetType& dvhs, DoseTypeGy aDeltaD)
+		{
+			const DoseTypeGy deltaD = getCommonDeltaD(dvhs, aDeltaD);
+
+			DVHSet::DVHSetType aligned;
+			aligned.reserve(dvhs.size());
+
+			for (const auto& dvh : dvhs)
+			{
+				if (dvh.getDeltaD() == deltaD)
+				{
+					aligned.push_back(dvh);
+				}
+				else
+				{
+					DVH resampledDVH(resample(dvh.getDataDifferential(), dvh.getDeltaD(), deltaD), deltaD, dvh.getDeltaV(),
+					                 dvh.getStructureID(), dvh.getDoseID(), dvh.getVoxelizationID());
+					resampledDVH.setLabel(dvh.getLabel());
+					aligned.push_back(std::move(resampledDVH));
+				}
+			}
+
+			return aligned;
+		}
+
+		DVHSet alignBinWidths(const DVHSet& dvhSet, DoseTypeGy aDeltaD)
+		{
+			//one bin width for all subsets
+			const DoseTypeGy deltaD = getCommonDeltaD(getAllDVHs(dvhSet), aDeltaD);
+			const auto alignSubset = [deltaD](const DVHSet::DVHSetType & subset)
+			{
+				return subset.empty() ? subset : alignBinWidths(subset, deltaD);
+			};
+
+			return DVHSet(alignSubset(dvhSet.getTargetVolumeSet()), alignSubset(dvhSet.getHealthyTissueSet()),
+			              alignSubset(dvhSet.getWholeVolumeSet()), dvhSet.getStrSetID(), dvhSet.getDoseID());
+		}
+
+		DVHBand calculateDVHBand(const DVHSet::DVHSetType& dvhs, DVHType type, DoseTypeGy aDeltaD)
+		{
+			const DVHSet::DVHSetType aligned = alignBinWidths(dvhs, aDeltaD);
+			const std::size_t numberOfBins = getMaximumNumberOfBins(aligned);
+
+			DVHBand band;
+			band.deltaD = aligned.front().getDeltaD();
+			band.type = type;
+			band.minimum.resize(numberOfBins);
+			band.maximum.resize(numberOfBins);
+			band.mean.assign(numberOfBins, 0);
+
+			for (std::size_t index = 0; index < aligned.size(); ++index)
+			{
+				const DVH& dvh = aligned[index];
+				const DVH::DataDifferentialType& data = (type.Type == DVHType::Cumulative) ? dvh.getDataCumulative() :
+				                                        dvh.getDataDifferential();
+
+				for (std::size_t bin = 0; bin < numberOfBins; ++bin)
+				{
+					const VolumeType volume = getBinVolume(data, dvh.getDeltaV(), bin);
+
+					if (index == 0)
+					{
+						band.minimum[bin] = volume;
+						band.maximum[bin] = volume;
+					}
+					else
+					{
+						band.minimum[bin] = std::min(band.minimum[bin], volume);
+						band.maximum[bin] = std::max(band.maximum[bin], volume);
+					}
+
+					band.mean[bin] += volume;
+				}
+			}
+
+			for (auto& mean : band.mean)
+			{
+				mean /= aligned.size();
+			}
+
+			return band;
+		}
+
+		DVH::Pointer calculateWeightedSum(const DVHSet::DVHSetType& dvhs, const std::vector<double>& weights,
+		                                  DoseTypeGy aDeltaD)
+		{
+			if (weights.size() != dvhs.size())
+			{
+				throw InvalidParameterException("The number of weights must match the number of DVHs!");
+			}
+
+			if (std::any_of(weights.cbegin(), weights.cend(), [](double weight)
+			{
+				return weight < 0;
+			}))
+			{
+				throw InvalidParameterException("weights must not be negative!");
+			}
+
+			const DVHSet::DVHSetType aligned = alignBinWidths(dvhs, aDeltaD);
+			const DVH& first = aligned.front();
+
+			DVH::DataDifferentialType dataDifferential(getMaximumNumberOfBins(aligned), 0);
+
+			for (std::size_t index = 0; index < aligned.size(); ++index)
+			{
+				//the volumes are summed up, expressed in voxels of the first DVH
+				const double factor = weights[index] * aligned[index].getDeltaV() / first.getDeltaV();
+				const DVH::DataDifferentialType& data = aligned[index].getDataDifferential();
+
+				for (std::size_t bin = 0; bin < data.size(); ++bin)
+				{
+					dataDifferential[bin] += data[bin] * factor;
+				}
+			}
+
+			auto sum = boost::make_shared<DVH>(std::move(dataDifferential), first.getDeltaD(), first.getDeltaV(),
+			                                   first.getStructureID(), first.getDoseID(), first.getVoxelizationID());
+			sum->setLabel(first.getLabel());
+			return sum;
+		}
+
+		DVHBand calculateDVHBand(const DVHSet& dvhSet, DVHType type, DoseTypeGy aDeltaD)
+		{
+			return calculateDVHBand(getAllDVHs(dvhSet), type, aDeltaD);
+		}
+
+		DVH::Pointer calculateWeightedSum(const DVHSet& dvhSet, const std::vector<double>& weights, DoseTypeGy aDeltaD)
+		{
+			return calculateWeightedSum(getAllDVHs(dvhSet), weights, aDeltaD);
+		}
+
+		std::vector<VolumeType> getVx(const DVHSet::DVHSetType& dvhs, DoseTypeGy xDoseAbsolute)
+		{
+			std::vector<VolumeType> vx;
+			vx.reserve(dvhs.size());
+
+			for (const auto& dvh : dvhs)
+			{
+				vx.push_back(dvh.getVx(xDoseAbsolute));
+			}
+
+			return vx;
+		}
+
+		std::vector<DoseTypeGy> getDx(const DVHSet::DVHSetType& dvhs, VolumeType xVolumeAbsolute)
+		{
+			std::vector<DoseTypeGy> dx;
+			dx.reserve(dvhs.size());
+
+			for (const auto& dvh : dvhs)
+			{
+				dx.push_back(dvh.getDx(xVolumeAbsolute));
+			}
+
+			return dx;
+		}
+
+		std::vector<VolumeType> getVx(const DVHSet& dvhSet, DoseTypeGy xDoseAbsolute)
+		{
+			return getVx(getAllDVHs(dvhSet), xDoseAbsolute);
+		}
+
+		std::vector<DoseTypeGy> getDx(const DVHSet& dvhSet, VolumeType xVolumeAbsolute)
+		{
+			return getDx(getAllDVHs(dvhSet), xVolumeAbsolute);
+		}
+	}
+}
@@ -0,0 +1,122 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+#ifndef __DVH_SET_ARITHMETIC_H
+#define __DVH_SET_ARITHMETIC_H
+
+#include <vector>
+
+#include "rttbBaseType.h"
+#include "rttbDVH.h"
+#include "rttbDVHSet.h"
+
+#include "RTTBCoreExports.h"
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+
+/*! @file
+	@brief Batch operations on a list of DVHs, e.g. the DVHs of one structure for several perturbed scenarios of a plan.
+	@details The DVHs may have different bin widths (deltaD) and voxel volumes (deltaV); operations that combine the
+	bins of several DVHs resample them to a common bin width (see alignBinWidths()) and work on absolute volumes.
+	Every operation takes either a DVHSet::DVHSetType or a DVHSet; for a DVHSet all its DVHs are used in the order
+	target volume, healthy tissue, whole volume subset.
+*/
+
+namespace rttb
+{
+	namespace core
+	{
+
+		/*! @struct DVHBand
+			@brief Envelope of a list of DVHs: per dose bin the minimal, maximal and mean absolute volume (in cm3).
+			@details Bin i covers the doses [i*deltaD, (i+1)*deltaD). The vectors have the length of the longest DVH,
+			shorter DVHs contribute volume 0 to the remaining bins.
+		*/
+		struct RTTBCore_EXPORT DVHBand
+		{
+			DoseTypeGy deltaD;
+			DVHType type;
+			std::vector<VolumeType> minimum;
+			std::vector<VolumeType> maximum;
+			std::vector<VolumeType> mean;
+		};
+
+		/*! @brief Resamples the DVHs to the common bin width aDeltaD.
+			@details The voxels of a bin are assumed to be uniformly distributed over the bin and are split between the new
+			bins in proportion to the overlap. DVHs that already have the bin width aDeltaD share their histogram with
+			the result (see DVH). IDs and labels are kept.
+			@param aDeltaD the common bin width; 0: the largest bin width of the DVHs, so that no DVH is refined.
+			@exception InvalidParameterException if dvhs is empty or aDeltaD is negative.
+		*/
+		RTTBCore_EXPORT DVHSet::DVHSetType alignBinWidths(const DVHSet::DVHSetType& dvhs, DoseTypeGy aDeltaD = 0);
+
+		/*! @brief Resamples all DVHs of the set to one common bin width (see alignBinWidths(const DVHSet::DVHSetType&,
+			DoseTypeGy)); the subsets and IDs of the set are kept.
+			@exception InvalidParameterException if the set is empty or aDeltaD is negative.
+		*/
+		RTTBCore_EXPORT DVHSet alignBinWidths(const DVHSet& dvhSet, DoseTypeGy aDeltaD = 0);
+
+		/*! @brief Computes the per bin minimum, maximum and mean absolute volume of the DVHs.
+			@param type cumulative (default) or differential volumes.
+			@param aDeltaD the common bin width (see alignBinWidths()).
+			@exception InvalidParameterException if dvhs is empty or aDeltaD is negative.
+		*/
+		RTTBCore_EXPORT DVHBand calculateDVHBand(const DVHSet::DVHSetType& dvhs,
+		        DVHType type = { DVHType::Cumulative }, DoseTypeGy aDeltaD = 0);
+
+		/*! @brief Band of all DVHs of the set.*/
+		RTTBCore_EXPORT DVHBand calculateDVHBand(const DVHSet& dvhSet, DVHType type = { DVHType::Cumulative },
+		        DoseTypeGy aDeltaD = 0);
+
+		/*! @brief Computes the DVH of the weighted sum of the absolute volumes of the DVHs per bin, e.g. the expected
+			DVH over scenarios with their probabilities as weights.
+			@details The result has the common bin width (see alignBinWidths()), the voxel volume and the IDs of the
+			first DVH.
+			@exception InvalidParameterException if dvhs is empty, the number of weights does not match the number of
+			DVHs, a weight is negative or aDeltaD is negative.
+		*/
+		RTTBCore_EXPORT DVH::Pointer calculateWeightedSum(const DVHSet::DVHSetType& dvhs,
+		        const std::vector<double>& weights, DoseTypeGy aDeltaD = 0);
+
+		/*! @brief Weighted sum of all DVHs of the set; one weight per DVH in the order of the subsets.*/
+		RTTBCore_EXPORT DVH::Pointer calculateWeightedSum(const DVHSet& dvhSet, const std::vector<double>& weights,
+		        DoseTypeGy aDeltaD = 0);
+
+		/*! @brief Vx of every DVH (see DVH::getVx()), computed on the original bins of each DVH.
+			@return one value per DVH, in the order of dvhs.
+		*/
+		RTTBCore_EXPORT std::vector<VolumeType> getVx(const DVHSet::DVHSetType& dvhs, DoseTypeGy xDoseAbsolute);
+
+		/*! @brief Vx of all DVHs of the set, in the order of the subsets.*/
+		RTTBCore_EXPORT std::vector<VolumeType> getVx(const DVHSet& dvhSet, DoseTypeGy xDoseAbsolute);
+
+		/*! @brief Dx of every DVH (see DVH::getDx()), computed on the original bins of each DVH.
+			@return one value per DVH, in the order of dvhs.
+		*/
+		RTTBCore_EXPORT std::vector<DoseTypeGy> getDx(const DVHSet::DVHSetType& dvhs, VolumeType xVolumeAbsolute);
+
+		/*! @brief Dx of all DVHs of the set, in the order of the subsets.*/
+		RTTBCore_EXPORT std::vector<DoseTypeGy> getDx(const DVHSet& dvhSet, VolumeType xVolumeAbsolute);
+	}
+}
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif
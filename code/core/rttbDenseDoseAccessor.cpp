@@ -0,0 +1,96 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+#include <algorithm>
+
+#include <boost/make_shared.hpp>
+
+#include "rttbDenseDoseAccessor.h"
+#include "rttbNullPointerException.h"
+#include "rttbInvalidParameterException.h"
+#include "rttbIndexOutOfBoundsException.h"
+
+namespace rttb
+{
+	namespace core
+	{
+
+		DenseDoseAccessor::DenseDoseAccessor(const GeometricInfo& geoInfo, std::vector<GenericValueType> aValues,
+		                                     const IDType& aUID) : _UID(aUID)
+		{
+			if (static_cast<GridSizeType>(aValues.size()) != geoInfo.getNumberOfVoxels())
+			{
+				throw InvalidParameterException("Number of values does not match the size of the geometric info!");
+			}
+
+			_geoInfo = geoInfo;
+			auto valueVector = boost::make_shared<std::vector<GenericValueType> >(std::move(aValues));
+			//aliasing constructor: the buffer keeps the vector alive
+			_buffer = BufferPointer(valueVector, valueVector->data());
+		}
+
+		DenseDoseAccessor::DenseDoseAccessor(const GeometricInfo& geoInfo, BufferPointer buffer,
+		                                     const IDType& aUID) : _buffer(buffer), _UID(aUID)
+		{
+			if (_buffer == nullptr)
+			{
+				throw NullPointerException("Buffer must not be nullptr!");
+			}
+
+			_geoInfo = geoInfo;
+		}
+
+		DenseDoseAccessor::DenseDoseAccessor(AccessorInterface::ConstPointer source)
+		{
+			if (source == nullptr)
+			{
+				throw NullPointerException("Source accessor must not be nullptr!");
+			}
+
+			_geoInfo = source->getGeometricInfo();
+			_UID = source->getUID();
+
+			auto valueVector = boost::make_shared<std::vector<GenericValueType> >(_geoInfo.getNumberOfVoxels());
+			source->getValues(0, _geoInfo.getNumberOfVoxels(), valueVector->data());
+			_buffer = BufferPointer(valueVector, valueVector->data());
+		}
+
+		GenericValueType DenseDoseAccessor::getValueAt(const VoxelGridIndex3D& aIndex) const
+		{
+			VoxelGridID aVoxelGridID;
+
+			if (_geoInfo.convert(aIndex, aVoxelGridID))
+			{
+				return getValueAt(aVoxelGridID);
+			}
+			else
+			{
+				return -1;
+			}
+		}
+
+		void DenseDoseAccessor::getValues(const VoxelGridID aFirstID, const GridSizeType aNumberOfValues,
+		                                  GenericValueType* values) const
+		{
+			if (aFirstID < 0 || aNumberOfValues < 0 || aFirstID + aNumberOfValues > getGridSize())
+			{
+				throw IndexOutOfBoundsException("Requested voxel ID range is not inside the grid!");
+			}
+
+			std::copy(data() + aFirstID, data() + aFirstID + aNumberOfValues, values);
+		}
+
+	}//end namespace core
+}//end namespace rttb
@@ -0,0 +1,122 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+#ifndef __DENSE_DOSE_ACCESSOR_H
+#define __DENSE_DOSE_ACCESSOR_H
+
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+
+#include "rttbAccessorWithGeoInfoBase.h"
+#include "rttbBaseType.h"
+#include "rttbCommon.h"
+
+#include "RTTBCoreExports.h"
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+
+namespace rttb
+{
+	namespace core
+	{
+
+		/*! @class DenseDoseAccessor
+			@brief Accessor that holds all values in one contiguous buffer (column index running fastest, then row, then slice).
+			@details The buffer can be owned by the accessor or shared with another owner (e.g. an itk image), see the
+			constructor taking a BufferPointer. It is the materialization target for lazy accessor chains: constructing a
+			DenseDoseAccessor from any AccessorInterface evaluates the source once.
+		*/
+		class RTTBCore_EXPORT DenseDoseAccessor : public AccessorWithGeoInfoBase
+		{
+		public:
+			rttbClassMacro(DenseDoseAccessor, AccessorWithGeoInfoBase);
+			using BufferPointer = boost::shared_ptr<const GenericValueType>;
+
+		private:
+			BufferPointer _buffer;
+			IDType _UID;
+
+		protected:
+			/*! @brief the geometric info is set in the constructor, nothing to assemble.*/
+			void assembleGeometricInfo() override {};
+
+		public:
+			/*! @brief Constructor. Takes over the values of aValues.
+				@exception InvalidParameterException if the size of aValues does not match the grid size of geoInfo.
+			*/
+			DenseDoseAccessor(const GeometricInfo& geoInfo, std::vector<GenericValueType> aValues,
+			                  const IDType& aUID = "");
+
+			/*! @brief Constructor. Shares the buffer with its current owner (no copy).
+				@pre buffer must hold geoInfo.getNumberOfVoxels() values.
+				@exception NullPointerException if buffer is nullptr.
+			*/
+			DenseDoseAccessor(const GeometricInfo& geoInfo, BufferPointer buffer, const IDType& aUID = "");
+
+			/*! @brief Constructor. Materializes all values of source (geometric info and UID are taken from source).
+				@exception NullPointerException if source is nullptr.
+			*/
+			explicit DenseDoseAccessor(AccessorInterface::ConstPointer source);
+
+			~DenseDoseAccessor() override = default;
+
+			/*! @brief raw access to the contiguous value buffer (getGridSize() elements).*/
+			const GenericValueType* data() const
+			{
+				return _buffer.get();
+			};
+
+			/*! @brief returns the (possibly shared) buffer, e.g. to pass it to another accessor without copying.*/
+			const BufferPointer& getBuffer() const
+			{
+				return _buffer;
+			};
+
+			/*! @brief returns the value for an id, -1 if the id is not inside the grid.*/
+			GenericValueType getValueAt(const VoxelGridID aID) const override
+			{
+				if (!_geoInfo.validID(aID))
+				{
+					return -1;
+				}
+
+				return _buffer.get()[aID];
+			};
+
+			/*! @brief returns the value for an index, -1 if the index is not inside the grid.*/
+			GenericValueType getValueAt(const VoxelGridIndex3D& aIndex) const override;
+
+			/*! @brief copies the values directly from the buffer.
+				@exception IndexOutOfBoundsException if the ID range is not completely inside the grid.
+			*/
+			void getValues(VoxelGridID aFirstID, GridSizeType aNumberOfValues, GenericValueType* values) const override;
+
+			const IDType getUID() const override
+			{
+				return _UID;
+			};
+		};
+	}
+}
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif
@@ -0,0 +1,323 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cmath>
+#include <exception>
+#include <limits>
+
+#include "rttbDoseHistogram.h"
+#include "rttbInvalidParameterException.h"
+#include "rttbThreadPool.h"
+
+namespace rttb
+{
+	namespace core
+	{
+		namespace
+		{
+			/*! @brief number of positions that are binned together*/
+			const std::size_t chunkSize = 1 << 16;
+
+			/*! @brief the fine bin width is at most 2^-fineBinExponent of max*1.5/numberOfBins*/
+			const int fineBinExponent = 6;
+
+			/*! @brief exponent of a chunk without a dose > 0: all values are in bin 0*/
+			const int noExponent = std::numeric_limits<int>::min();
+
+			/*! @brief exponent of the largest power of two that is at most 2^-fineBinExponent of max*1.5/numberOfBins*/
+			int getFineBinExponent(DoseTypeGy max, int numberOfBins)
+			{
+				const DoseTypeGy deltaD = max * 1.5 / numberOfBins;
+
+				if (!(deltaD > 0))
+				{
+					return noExponent;
+				}
+
+				int exponent = 0;
+				std::frexp(deltaD, &exponent);
+				//deltaD is in [2^(exponent-1), 2^exponent)
+				return exponent - 1 - fineBinExponent;
+			}
+
+			/*! @brief bin of width 2^coarseExponent that contains the bin fineBin of width 2^fineExponent*/
+			std::size_t getCoarserBin(std::size_t fineBin, int fineExponent, int coarseExponent)
+			{
+				if (fineExponent == noExponent || coarseExponent - fineExponent >= std::numeric_limits<std::size_t>::digits)
+				{
+					return 0;
+				}
+
+				return fineBin >> (coarseExponent - fineExponent);
+			}
+
+			template <typename BinType, typename ValueType>
+			void addToBin(std::vector<BinType>& bins, std::size_t bin, const ValueType& value)
+			{
+				if (bin >= bins.size())
+				{
+					bins.resize(bin + 1);
+				}
+
+				bins[bin].add(value);
+			}
+		}
+
+		DoseHistogram::DoseHistogram(DoseTypeGy aDeltaD, int aNumberOfBins) : _deltaD(aDeltaD),
+			_numberOfBins(aNumberOfBins), _automaticDeltaD(aDeltaD == 0), _exponent(noExponent), _max(0)
+		{
+			if (aNumberOfBins <= 0 || aDeltaD < 0)
+			{
+				throw InvalidParameterException("aNumberOfBins/aDeltaD must be >0! ");
+			}
+
+			if (!_automaticDeltaD)
+			{
+				_bins.resize(_numberOfBins);
+			}
+		}
+
+		DoseHistogram::ChunkBins DoseHistogram::binChunk(const DoseTypeGy* doseValues, const FractionType* fractions,
+		        std::size_t aNumberOfValues) const
+		{
+			ChunkBins chunk;
+
+			if (_automaticDeltaD)
+			{
+				for (std::size_t i = 0; i < aNumberOfValues; ++i)
+				{
+					chunk.max = std::max(chunk.max, doseValues[i]);
+				}
+
+				chunk.exponent = getFineBinExponent(chunk.max, _numberOfBins);
+			}
+
+			for (std::size_t i = 0; i < aNumberOfValues; ++i)
+			{
+				long long dose_bin = 0;
+
+				if (!_automaticDeltaD)
+				{
+					dose_bin = static_cast<int>(doseValues[i] / _deltaD);
+
+					if (dose_bin >= _numberOfBins)
+					{
+						throw InvalidParameterException("_numberOfBins is too small: dose bin out of bounds! ");
+					}
+				}
+				else if (chunk.exponent != noExponent)
+				{
+					dose_bin = static_cast<long long>(std::ldexp(doseValues[i], -chunk.exponent));
+				}
+
+				if (dose_bin < 0)
+				{
+					throw InvalidParameterException("_numberOfBins is too small: dose bin out of bounds! ");
+				}
+
+				if (static_cast<std::size_t>(dose_bin) >= chunk.bins.size())
+				{
+					chunk.bins.resize(dose_bin + 1, 0);
+				}
+
+				chunk.bins[dose_bin] += fractions[i];
+			}
+
+			return chunk;
+		}
+
+		void DoseHistogram::addChunk(const ChunkBins& chunk)
+		{
+			if (!_automaticDeltaD)
+			{
+				for (std::size_t bin = 0; bin < chunk.bins.size(); ++bin)
+				{
+					_bins[bin].add(chunk.bins[bin]);
+				}
+
+				return;
+			}
+
+			_max = std::max(_max, chunk.max);
+
+			if (chunk.exponent != noExponent && chunk.exponent > _exponent)
+			{
+				//larger values arrived: merge the fine bins
+				std::vector<CompensatedSum> coarseBins;
+
+				for (std::size_t bin = 0; bin < _bins.size(); ++bin)
+				{
+					addToBin(coarseBins, getCoarserBin(bin, _exponent, chunk.exponent), _bins[bin]);
+				}
+
+				_bins.swap(coarseBins);
+				_exponent = chunk.exponent;
+			}
+
+			for (std::size_t bin = 0; bin < chunk.bins.size(); ++bin)
+			{
+				addToBin(_bins, getCoarserBin(bin, chunk.exponent, _exponent), chunk.bins[bin]);
+			}
+		}
+
+		void DoseHistogram::addPositions(std::size_t aNumberOfPositions, const RangeReader& aReader,
+		                                 unsigned int aNumberOfThreads)
+		{
+			const std::size_t numberOfChunks = (aNumberOfPositions + chunkSize - 1) / chunkSize;
+			const std::size_t chunksPerRound = std::max<std::size_t>(1, std::min<std::size_t>(aNumberOfThreads,
+			                                   numberOfChunks));
+
+			std::vector<std::vector<DoseTypeGy> > doseValues(chunksPerRound, std::vector<DoseTypeGy>(chunkSize));
+			std::vector<std::vector<FractionType> > fractions(chunksPerRound, std::vector<FractionType>(chunkSize));
+			std::vector<ChunkBins> chunks(chunksPerRound);
+			std::vector<std::size_t> counts(chunksPerRound);
+			std::vector<std::exception_ptr> errors(chunksPerRound);
+
+			//the chunks of a round are read and binned as tasks of the shared pool, then merged in chunk order, so no
+			//task ever waits for another one
+			for (std::size_t firstChunk = 0; firstChunk < numberOfChunks; firstChunk += chunksPerRound)
+			{
+				const std::size_t numberOfChunksInRound = std::min(chunksPerRound, numberOfChunks - firstChunk);
+
+				auto processChunk = [&](std::size_t slot)
+				{
+					const std::size_t firstPosition = (firstChunk + slot) * chunkSize;
+					const std::size_t chunkEnd = std::min(aNumberOfPositions, firstPosition + chunkSize);
+					errors[slot] = nullptr;
+
+					try
+					{
+						counts[slot] = aReader(firstPosition, chunkEnd - firstPosition, doseValues[slot].data(),
+						                       fractions[slot].data());
+						chunks[slot] = binChunk(doseValues[slot].data(), fractions[slot].data(), counts[slot]);
+					}
+					catch (...)
+					{
+						errors[slot] = std::current_exception();
+					}
+				};
+
+				if (numberOfChunksInRound == 1)
+				{
+					processChunk(0);
+				}
+				else
+				{
+					ThreadPool::TaskGroup group(ThreadPool::getDefault());
+
+					for (std::size_t slot = 0; slot < numberOfChunksInRound; ++slot)
+					{
+						group.run([&processChunk, slot]()
+						{
+							processChunk(slot);
+						});
+					}
+
+					group.wait();
+				}
+
+				for (std::size_t slot = 0; slot < numberOfChunksInRound; ++slot)
+				{
+					if (errors[slot])
+					{
+						std::rethrow_exception(errors[slot]);
+					}
+
+					addChunk(chunks[slot]);
+
+					//a short read ends the positions, the following chunks (and their errors) are ignored
+					const std::size_t firstPosition = (firstChunk + slot) * chunkSize;
+
+					if (counts[slot] < std::min(chunkSize, aNumberOfPositions - firstPosition))
+					{
+						return;
+					}
+				}
+			}
+		}
+
+		void DoseHistogram::addBlocks(const BlockReader& aReader)
+		{
+			std::vector<DoseTypeGy> doseValues(chunkSize);
+			std::vector<FractionType> fractions(chunkSize);
+			std::size_t count = chunkSize;
+
+			while (count == chunkSize)
+			{
+				count = 0;
+				std::size_t blockSize = 0;
+
+				//fill the whole chunk, so that the chunks are the same as in addPositions()
+				do
+				{
+					blockSize = aReader(chunkSize - count, doseValues.data() + count, fractions.data() + count);
+					count += blockSize;
+				}
+				while (blockSize > 0 && count < chunkSize);
+
+				if (count > 0)
+				{
+					addChunk(binChunk(doseValues.data(), fractions.data(), count));
+				}
+			}
+		}
+
+		DoseTypeGy DoseHistogram::getDeltaD() const
+		{
+			if (!_automaticDeltaD)
+			{
+				return _deltaD;
+			}
+
+			if (_exponent == noExponent)
+			{
+				return 0.1;
+			}
+
+			const DoseTypeGy numberOfFineBins = std::ceil(std::ldexp(_max * 1.5 / _numberOfBins, -_exponent));
+			return std::ldexp(numberOfFineBins, _exponent);
+		}
+
+		DVH::DataDifferentialType DoseHistogram::getDataDifferential() const
+		{
+			std::vector<CompensatedSum> bins(_numberOfBins);
+
+			if (!_automaticDeltaD || _exponent == noExponent)
+			{
+				std::copy(_bins.cbegin(), _bins.cend(), bins.begin());
+			}
+			else
+			{
+				const auto numberOfFineBins = static_cast<std::size_t>(std::ldexp(getDeltaD(), -_exponent));
+
+				for (std::size_t bin = 0; bin < _bins.size(); ++bin)
+				{
+					bins.at(bin / numberOfFineBins).add(_bins[bin]);
+				}
+			}
+
+			DVH::DataDifferentialType dataDifferential(_numberOfBins);
+
+			for (std::size_t bin = 0; bin < dataDifferential.size(); ++bin)
+			{
+				dataDifferential[bin] = bins[bin].getSum();
+			}
+
+			return dataDifferential;
+		}
+
+	}//end namespace core
+}//end namespace rttb
@@ -0,0 +1,132 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+#ifndef __DOSE_HISTOGRAM_H
+#define __DOSE_HISTOGRAM_H
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+#include "rttbBaseType.h"
+#include "rttbCompensatedSum.h"
+#include "rttbDVH.h"
+
+#include "RTTBCoreExports.h"
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+
+namespace rttb
+{
+	namespace core
+	{
+
+		/*! @class DoseHistogram
+			@brief Differential dose histogram that is filled chunk by chunk; the binning of DVHCalculator and
+			MultiStructureDVHCalculator.
+			@details The values are split into chunks of a fixed number of positions. Every chunk is binned into its own
+			bin array (which grows up to the highest bin used) and the chunk arrays are summed up in chunk order (with
+			CompensatedSum per bin). Since the chunks and the summation order do not depend on the number of threads, the
+			histogram is bit-identical for any number of threads.
+			If no bin width is given, the chunks are binned with a fine bin width that is a power of two; if a larger value
+			arrives, the fine bins are merged pairwise (which is exact for powers of two). The bin width is determined from
+			the maximum dose in getDeltaD(): max*1.5/numberOfBins, rounded up to a multiple of the fine bin width, which is
+			at most 1/64 of it. So the maximum is found in the same pass over the values and no value has to be kept.
+		*/
+		class RTTBCore_EXPORT DoseHistogram
+		{
+		public:
+			/*! @brief reads up to aMaxNumberOfValues values, starting at position aFirstPosition.
+				@details Called concurrently (on ThreadPool::getDefault()) for different chunks. If fewer values than requested (and available) are read,
+				the positions end there: later chunks are ignored.
+				@param fractions receives the relevant volume fractions.
+				@return number of values read.
+			*/
+			using RangeReader = std::function<std::size_t(std::size_t aFirstPosition, std::size_t aMaxNumberOfValues,
+			                    DoseTypeGy* doseValues, FractionType* fractions)>;
+
+			/*! @brief reads up to aMaxNumberOfValues values behind the values read before (e.g. with
+				DoseIteratorInterface::nextBlock()).
+				@return number of values read; 0 at the end.
+			*/
+			using BlockReader = std::function<std::size_t(std::size_t aMaxNumberOfValues, DoseTypeGy* doseValues,
+			                    FractionType* fractions)>;
+
+		private:
+			/*! @brief bin array of one chunk*/
+			struct ChunkBins
+			{
+				std::vector<DoseCalcType> bins;
+				/*! @brief exponent of the fine bin width (if no bin width is given)*/
+				int exponent = 0;
+				DoseTypeGy max = 0;
+			};
+
+			DoseTypeGy _deltaD;
+			int _numberOfBins;
+			/*! @brief true if the bin width is determined from the maximum dose*/
+			bool _automaticDeltaD;
+
+			std::vector<CompensatedSum> _bins;
+			int _exponent;
+			DoseTypeGy _max;
+
+			/*! @brief bins the values of one chunk.
+				@exception InvalidParameterException if a dose bin is out of bounds.
+			*/
+			ChunkBins binChunk(const DoseTypeGy* doseValues, const FractionType* fractions,
+			                   std::size_t aNumberOfValues) const;
+
+			/*! @brief adds the bins of the next chunk.*/
+			void addChunk(const ChunkBins& chunk);
+
+		public:
+			/*! @brief Constructor.
+				@param aDeltaD the absolute dose value in Gy for dose_bin [i,i+1). If 0, it is determined from the maximum
+				dose (see getDeltaD()).
+				@exception InvalidParameterException if aNumberOfBins<=0 or aDeltaD<0.
+			*/
+			DoseHistogram(DoseTypeGy aDeltaD, int aNumberOfBins);
+
+			/*! @brief bins aNumberOfPositions positions that are read chunk by chunk with aReader.
+				@details Up to aNumberOfThreads chunks are read and binned concurrently as tasks of
+				ThreadPool::getDefault(); they are merged in chunk order after the tasks have finished.
+				@exception InvalidParameterException if a dose bin is out of bounds.
+			*/
+			void addPositions(std::size_t aNumberOfPositions, const RangeReader& aReader, unsigned int aNumberOfThreads);
+
+			/*! @brief bins the values that are read block by block with aReader, until it returns 0.
+				@exception InvalidParameterException if a dose bin is out of bounds.
+			*/
+			void addBlocks(const BlockReader& aReader);
+
+			/*! @brief returns the bin width. If no bin width was given in the constructor, it is max*1.5/numberOfBins
+				rounded up to a multiple of the fine bin width (at most 1.6 % larger), or 0.1 if the maximum dose is 0.
+			*/
+			DoseTypeGy getDeltaD() const;
+
+			DVH::DataDifferentialType getDataDifferential() const;
+		};
+	}
+}
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif
@@ -15,6 +15,7 @@
 
 #include "rttbDoseIteratorInterface.h"
 #include "rttbNullPointerException.h"
+#include "rttbException.h"
 
 namespace rttb
 {
@@ -30,6 +31,38 @@ namespace rttb
 
 			_spDoseAccessor = aDoseAccessor;
 		}
+
+		std::size_t DoseIteratorInterface::nextBlock(const std::size_t aMaxNumberOfValues, DoseTypeGy* doseValues,
+		        FractionType* fractions, VoxelGridID* ids)
+		{
+			std::size_t count = 0;
+
+			while (count < aMaxNumberOfValues && isPositionValid())
+			{
+				doseValues[count] = getCurrentDoseValue();
+
+				if (fractions)
+				{
+					fractions[count] = getCurrentRelevantVolumeFraction();
+				}
+
+				if (ids)
+				{
+					ids[count] = getCurrentVoxelGridID();
+				}
+
+				next();
+				++count;
+			}
+
+			return count;
+		}
+
+		std::size_t DoseIteratorInterface::readPositions(std::size_t, std::size_t, DoseTypeGy*, FractionType*,
+		        VoxelGridID*) const
+		{
+			throw Exception("positional reads are not supported by this iterator! ");
+		}
 	}//end: namespace core
 }//end: namespace rttb
 
@@ -17,6 +17,8 @@
 #define __DOSE_ITERATOR_INTERFACE_NEW_H
 
 
+#include <cstddef>
+
 #include "rttbBaseType.h"
 #include "rttbCommon.h"
 #include "rttbDoseAccessorInterface.h"
@@ -40,6 +42,9 @@ namespace rttb
       rttbClassMacroNoParent(DoseIteratorInterface);
 			using DoseAccessorPointer = DoseAccessorInterface::Pointer;
 
+			/*! @brief block size that consumers of nextBlock() use by default*/
+			static constexpr std::size_t defaultBlockSize = 4096;
+
 		private:
 			DoseIteratorInterface(const DoseIteratorInterface&) = delete; //not implemented on purpose -> non-copyable
 			DoseIteratorInterface& operator=(const
@@ -79,6 +84,41 @@ namespace rttb
 
 			virtual VoxelGridID getCurrentVoxelGridID() const = 0;
 
+			/*! @brief Reads the values of up to aMaxNumberOfValues positions, starting with the current position, and moves
+				the iterator behind the last position read. Stops at the first invalid position (see isPositionValid()).
+				@details Batched alternative to the isPositionValid()/getCurrent...()/next() loop:
+				the default implementation runs exactly this loop, iterators override it to read whole blocks at once.
+				@param doseValues receives the dose values (must provide space for aMaxNumberOfValues elements).
+				@param fractions receives the relevant volume fractions; may be nullptr if not needed.
+				@param ids receives the voxel grid IDs; may be nullptr if not needed.
+				@return number of positions read. 0 if the current position is not valid (end of iteration).
+				@pre reset() has been called.
+			*/
+			virtual std::size_t nextBlock(std::size_t aMaxNumberOfValues, DoseTypeGy* doseValues, FractionType* fractions,
+			                              VoxelGridID* ids);
+
+			/*! @brief Number of positions that can be read with readPositions().
+				@return 0 if the iterator does not support positional reads (default).
+				@pre reset() has been called.
+			*/
+			virtual std::size_t getNumberOfPositions() const
+			{
+				return 0;
+			};
+
+			/*! @brief Reads the values of up to aMaxNumberOfValues positions, starting with position aFirstPosition
+				(0 is the first position after reset()). Stops at the first invalid position, like nextBlock().
+				@details The iterator is not moved, so several threads may read (e.g. disjoint) position ranges
+				concurrently, as long as the iterator is not reset or moved at the same time.
+				@param fractions receives the relevant volume fractions; may be nullptr if not needed.
+				@param ids receives the voxel grid IDs; may be nullptr if not needed.
+				@return number of positions read.
+				@pre reset() has been called.
+				@exception Exception if the iterator does not support positional reads (see getNumberOfPositions()).
+			*/
+			virtual std::size_t readPositions(std::size_t aFirstPosition, std::size_t aMaxNumberOfValues,
+			                                  DoseTypeGy* doseValues, FractionType* fractions, VoxelGridID* ids) const;
+
 			virtual IDType getVoxelizationID() const
 			{
 				return "";
@@ -89,6 +129,11 @@ namespace rttb
 				return _spDoseAccessor->getUID();
 			};
 
+			DoseAccessorPointer getDoseAccessor() const
+			{
+				return _spDoseAccessor;
+			};
+
 		}; //end class
 	}//end: namespace core
 }//end: namespace rttb
@@ -13,6 +13,9 @@
 //
 //------------------------------------------------------------------------
 
+#include <algorithm>
+#include <numeric>
+
 #include "rttbGenericDoseIterator.h"
 #include "rttbInvalidParameterException.h"
 
@@ -26,11 +29,13 @@ namespace rttb
 		{
 			_currentDoseVoxelGridID = 0;
 			_currentVoxelVolume = 0;
+			_sliceStartID = 0;
 		}
 
 		bool GenericDoseIterator::reset()
 		{
 			_currentDoseVoxelGridID = 0;
+			_sliceValues.clear();
 
 			if (_spDoseAccessor->isGridHomogeneous())
 			{
@@ -75,7 +80,13 @@ namespace rttb
 		{
 			if (isPositionValid())
 			{
-				return _spDoseAccessor->getValueAt(_currentDoseVoxelGridID);
+				if (_sliceValues.empty() || _currentDoseVoxelGridID < _sliceStartID
+				    || _currentDoseVoxelGridID >= _sliceStartID + static_cast<VoxelGridID>(_sliceValues.size()))
+				{
+					loadCurrentSlice();
+				}
+
+				return _sliceValues[_currentDoseVoxelGridID - _sliceStartID];
 			}
 			else
 			{
@@ -83,5 +94,62 @@ namespace rttb
 			}
 		}
 
+		std::size_t GenericDoseIterator::nextBlock(const std::size_t aMaxNumberOfValues, DoseTypeGy* doseValues,
+		        FractionType* fractions, VoxelGridID* ids)
+		{
+			if (!isPositionValid())
+			{
+				return 0;
+			}
+
+			const std::size_t count = readPositions(_currentDoseVoxelGridID, aMaxNumberOfValues, doseValues, fractions, ids);
+			_currentDoseVoxelGridID += static_cast<VoxelGridID>(count);
+			return count;
+		}
+
+		std::size_t GenericDoseIterator::getNumberOfPositions() const
+		{
+			return static_cast<std::size_t>(_spDoseAccessor->getGeometricInfo().getNumberOfVoxels());
+		}
+
+		std::size_t GenericDoseIterator::readPositions(const std::size_t aFirstPosition,
+		        const std::size_t aMaxNumberOfValues, DoseTypeGy* doseValues, FractionType* fractions, VoxelGridID* ids) const
+		{
+			const std::size_t numberOfPositions = getNumberOfPositions();
+
+			if (aFirstPosition >= numberOfPositions)
+			{
+				return 0;
+			}
+
+			const std::size_t count = std::min(numberOfPositions - aFirstPosition, aMaxNumberOfValues);
+			const auto firstID = static_cast<VoxelGridID>(aFirstPosition);
+
+			_spDoseAccessor->getValues(firstID, static_cast<GridSizeType>(count), doseValues);
+
+			if (fractions)
+			{
+				std::fill(fractions, fractions + count, 1.);
+			}
+
+			if (ids)
+			{
+				std::iota(ids, ids + count, firstID);
+			}
+
+			return count;
+		}
+
+		void GenericDoseIterator::loadCurrentSlice() const
+		{
+			const GeometricInfo& geoInfo = _spDoseAccessor->getGeometricInfo();
+			const VoxelGridID sliceSize = geoInfo.getNumColumns() * geoInfo.getNumRows();
+			const VoxelGridID slice = _currentDoseVoxelGridID / sliceSize;
+
+			_sliceValues.resize(sliceSize);
+			_spDoseAccessor->getSlice(slice, _sliceValues.data());
+			_sliceStartID = slice * sliceSize;
+		}
+
 	}//end: namespace core
 }//end: namespace rttb
\ No newline at end of file
@@ -38,6 +38,8 @@ namespace rttb
 
 		/*! @class GenericDoseIterator
 			@brief Standard implementation of the dose iterator interface.
+			@details The dose values are read slice-wise with AccessorInterface::getSlice() and buffered.
+			reset() discards the buffer, so changes of the accessor are visible after the next reset().
 		*/
 		class RTTBCore_EXPORT GenericDoseIterator : public DoseIteratorInterface
 		{
@@ -50,6 +52,14 @@ namespace rttb
 			VoxelGridID _currentDoseVoxelGridID;
 			DoseVoxelVolumeType _currentVoxelVolume;
 
+			/*! @brief dose values of the slice that contains the current position*/
+			mutable std::vector<DoseTypeGy> _sliceValues;
+			/*! @brief voxel ID of the first value in _sliceValues*/
+			mutable VoxelGridID _sliceStartID;
+
+			/*! @brief loads the slice containing the current position into _sliceValues*/
+			void loadCurrentSlice() const;
+
 			GenericDoseIterator(const GenericDoseIterator&) = delete; //not implemented on purpose -> non-copyable
 			GenericDoseIterator& operator=(const
 			                               GenericDoseIterator&) = delete;//not implemented on purpose -> non-copyable
@@ -95,6 +105,16 @@ namespace rttb
 				return _currentDoseVoxelGridID;
 			};
 
+			/*! @brief reads the dose values of consecutive voxels directly with AccessorInterface::getValues().*/
+			std::size_t nextBlock(std::size_t aMaxNumberOfValues, DoseTypeGy* doseValues, FractionType* fractions,
+			                      VoxelGridID* ids) override;
+
+			/*! @brief the positions are the voxel grid IDs of the dose.*/
+			std::size_t getNumberOfPositions() const override;
+
+			std::size_t readPositions(std::size_t aFirstPosition, std::size_t aMaxNumberOfValues, DoseTypeGy* doseValues,
+			                          FractionType* fractions, VoxelGridID* ids) const override;
+
 		};
 	}
 }
@@ -90,5 +90,79 @@ namespace rttb
 			return _spDoseAccessor->getValueAt(_currentMaskPos->getVoxelGridID());
 		}
 
+		std::size_t GenericMaskedDoseIterator::nextBlock(const std::size_t aMaxNumberOfValues, DoseTypeGy* doseValues,
+		        FractionType* fractions, VoxelGridID* ids)
+		{
+			if (!ids)
+			{
+				_blockIDs.resize(aMaxNumberOfValues);
+				ids = _blockIDs.data();
+			}
+
+			const std::size_t count = readPositions(_currentMaskPos - _maskVoxelVec->cbegin(), aMaxNumberOfValues,
+			                                        doseValues, fractions, ids);
+			_currentMaskPos += count;
+			return count;
+		}
+
+		std::size_t GenericMaskedDoseIterator::getNumberOfPositions() const
+		{
+			return _maskVoxelVec ? _maskVoxelVec->size() : 0;
+		}
+
+		std::size_t GenericMaskedDoseIterator::readPositions(const std::size_t aFirstPosition,
+		        const std::size_t aMaxNumberOfValues, DoseTypeGy* doseValues, FractionType* fractions, VoxelGridID* ids) const
+		{
+			//mask and dose share the same grid (checked in the constructor), so one bound check per voxel is sufficient
+			const GridSizeType numberOfVoxels = _spDoseAccessor->getGeometricInfo().getNumberOfVoxels();
+			const std::size_t numberOfPositions = getNumberOfPositions();
+			std::size_t count = 0;
+			std::size_t runStart = 0;
+			std::vector<VoxelGridID> blockIDs;
+
+			if (!ids)
+			{
+				blockIDs.resize(std::min(aMaxNumberOfValues, numberOfPositions - std::min(aFirstPosition, numberOfPositions)));
+				ids = blockIDs.data();
+			}
+
+			while (count < aMaxNumberOfValues && aFirstPosition + count < numberOfPositions)
+			{
+				const MaskVoxel& voxel = (*_maskVoxelVec)[aFirstPosition + count];
+				const VoxelGridID id = voxel.getVoxelGridID();
+
+				if (id < 0 || id >= numberOfVoxels)
+				{
+					break;
+				}
+
+				ids[count] = id;
+
+				if (fractions)
+				{
+					fractions[count] = voxel.getRelevantVolumeFraction();
+				}
+
+				++count;
+			}
+
+			//read the dose values run by run (consecutive voxel IDs)
+			while (runStart < count)
+			{
+				const VoxelGridID firstID = ids[runStart];
+				std::size_t runEnd = runStart + 1;
+
+				while (runEnd < count && ids[runEnd] == firstID + static_cast<VoxelGridID>(runEnd - runStart))
+				{
+					++runEnd;
+				}
+
+				_spDoseAccessor->getValues(firstID, static_cast<GridSizeType>(runEnd - runStart), doseValues + runStart);
+				runStart = runEnd;
+			}
+
+			return count;
+		}
+
 	}//end namespace core
 }//end namespace rttb
\ No newline at end of file
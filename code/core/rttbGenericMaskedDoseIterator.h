@@ -16,6 +16,8 @@
 #ifndef __GENERIC_MASKED_DOSE_ITERATOR_NEW_H
 #define __GENERIC_MASKED_DOSE_ITERATOR_NEW_H
 
+#include <vector>
+
 #include <boost/shared_ptr.hpp>
 
 #include "rttbBaseType.h"
@@ -58,6 +60,9 @@ namespace rttb
 			/*! the volume in cm^3 of the current dose voxel*/
 			DoseVoxelVolumeType _currentVoxelVolume = 0.;
 
+			/*! voxel IDs of the current block, used by nextBlock() if the caller does not request the IDs*/
+			std::vector<VoxelGridID> _blockIDs;
+
 		public:
 
 			GenericMaskedDoseIterator(MaskAccessorPointer aSpMask, DoseAccessorPointer aDoseAccessor)
@@ -97,6 +102,17 @@ namespace rttb
 
 			/*! @return current dose value without masking*/
 			DoseTypeGy getCurrentDoseValue() const override;
+
+			/*! @brief collects the mask voxels of the block first and reads the dose values of consecutive voxel
+				IDs with one AccessorInterface::getValues() call per run.*/
+			std::size_t nextBlock(std::size_t aMaxNumberOfValues, DoseTypeGy* doseValues, FractionType* fractions,
+			                      VoxelGridID* ids) override;
+
+			/*! @brief the positions are the indices in the mask voxel vector.*/
+			std::size_t getNumberOfPositions() const override;
+
+			std::size_t readPositions(std::size_t aFirstPosition, std::size_t aMaxNumberOfValues, DoseTypeGy* doseValues,
+			                          FractionType* fractions, VoxelGridID* ids) const override;
 		};
 	}
 }
@@ -34,6 +34,7 @@ namespace rttb
 		void GeometricInfo::setSpacing(const SpacingVectorType3D& aSpacingVector)
 		{
 			_spacing = aSpacingVector;
+			updateAffineMatrices();
 		}
 
 		const SpacingVectorType3D& GeometricInfo::getSpacing() const
@@ -44,6 +45,7 @@ namespace rttb
 		void GeometricInfo::setImagePositionPatient(const WorldCoordinate3D& aImagePositionPatient)
 		{
 			_imagePositionPatient = aImagePositionPatient;
+			updateAffineMatrices();
 		}
 
 		const WorldCoordinate3D& GeometricInfo::getImagePositionPatient() const
@@ -55,6 +57,28 @@ namespace rttb
 		{
 			_orientationMatrix = anOrientationMatrix;
 			computeInvertOrientation();
+			updateAffineMatrices();
+		}
+
+		void GeometricInfo::updateAffineMatrices()
+		{
+			for (std::size_t i = 0; i < 3; ++i)
+			{
+				for (std::size_t j = 0; j < 3; ++j)
+				{
+					_indexToWorldMatrix[i][j] = _orientationMatrix(i, j) * _spacing(j);
+					_worldToIndexMatrix[i][j] = _invertedOrientationMatrix(i, j) / _spacing(i);
+				}
+
+				_indexToWorldMatrix[i][3] = _imagePositionPatient(i);
+			}
+
+			for (std::size_t i = 0; i < 3; ++i)
+			{
+				_worldToIndexMatrix[i][3] = -(_worldToIndexMatrix[i][0] * _imagePositionPatient(0)
+				                              + (_worldToIndexMatrix[i][1] * _imagePositionPatient(1)
+				                                 + _worldToIndexMatrix[i][2] * _imagePositionPatient(2)));
+			}
 		}
 
 		bool GeometricInfo::computeInvertOrientation()
@@ -147,17 +171,7 @@ namespace rttb
 			ContinuousVoxelGridIndex3D& aIndex)
 		const
 		{
-			WorldCoordinate3D distanceToIP;
-			distanceToIP = aWorldCoordinate - _imagePositionPatient;
-
-			boost::numeric::ublas::vector<WorldCoordinate> result = boost::numeric::ublas::prod(
-			            _invertedOrientationMatrix,
-			            distanceToIP);
-
-			boost::numeric::ublas::vector<WorldCoordinate> resultS = boost::numeric::ublas::element_div(result,
-			        _spacing);
-
-			aIndex = ContinuousVoxelGridIndex3D(resultS(0), resultS(1), resultS(2));
+			aIndex = worldCoordinateToContinuousIndex(aWorldCoordinate);
 
             //if we convert ContinuousVoxelGridIndex3D (double) to VoxelGridIndex3D (unsigned int), we can't find out if it's negative. 
             //So we have to check before.
@@ -192,16 +206,7 @@ namespace rttb
 		        WorldCoordinate3D& aWorldCoordinate)
 		const
 		{
-
-			boost::numeric::ublas::vector<WorldCoordinate> resultS = boost::numeric::ublas::element_prod(
-			            aIndex,
-			            _spacing);
-
-			boost::numeric::ublas::vector<WorldCoordinate> result = boost::numeric::ublas::prod(
-			            _orientationMatrix,
-			            resultS);
-
-			aWorldCoordinate = result + _imagePositionPatient;
+			aWorldCoordinate = continuousIndexToWorldCoordinate(aIndex);
 
             //if we convert ContinuousVoxelGridIndex3D (double) to VoxelGridIndex3D (unsigned int), we can't find out if it's negative. 
             //So we have to check before.
@@ -226,6 +231,44 @@ namespace rttb
 			return continuousIndexToWorldCoordinate(indexDouble, aWorldCoordinate);
 		}
 
+		void GeometricInfo::worldCoordinateToContinuousIndex(const WorldCoordinate3D* aWorldCoordinates,
+		        std::size_t count, ContinuousVoxelGridIndex3D* aIndices) const
+		{
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				aIndices[i] = worldCoordinateToContinuousIndex(aWorldCoordinates[i]);
+			}
+		}
+
+		void GeometricInfo::continuousIndexToWorldCoordinate(const ContinuousVoxelGridIndex3D* aIndices,
+		        std::size_t count, WorldCoordinate3D* aWorldCoordinates) const
+		{
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				aWorldCoordinates[i] = continuousIndexToWorldCoordinate(aIndices[i]);
+			}
+		}
+
+		void GeometricInfo::indexRowToWorldCoordinates(GridIndexType aRow, GridIndexType aSlice,
+		        WorldCoordinate3D* aWorldCoordinates) const
+		{
+			const AffineMatrixType& m = _indexToWorldMatrix;
+			const WorldCoordinate y = aRow;
+			const WorldCoordinate z = aSlice;
+
+			//row and slice dependent part; same evaluation order as continuousIndexToWorldCoordinate()
+			const WorldCoordinate3D rowOffset(m[0][1] * y + m[0][2] * z + m[0][3],
+			                                  m[1][1] * y + m[1][2] * z + m[1][3],
+			                                  m[2][1] * y + m[2][2] * z + m[2][3]);
+
+			for (VoxelGridDimensionType column = 0; column < _numberOfColumns; ++column)
+			{
+				const auto x = static_cast<WorldCoordinate>(column);
+				aWorldCoordinates[column] = WorldCoordinate3D(m[0][0] * x + rowOffset.x(), m[1][0] * x + rowOffset.y(),
+				                            m[2][0] * x + rowOffset.z());
+			}
+		}
+
 		bool GeometricInfo::isInside(const VoxelGridIndex3D& aIndex) const
 		{
 			return (aIndex(0) >= 0 && aIndex(1) >= 0 && aIndex(2) >= 0
@@ -17,6 +17,8 @@
 #define __GEOMETRIC_INFO_NEW_H
 
 
+#include <array>
+#include <cstddef>
 #include <iostream>
 #include <sstream>
 
@@ -46,6 +48,10 @@ namespace rttb
 		{
     public:
       rttbClassMacroNoParent(GeometricInfo)
+
+			/*! @brief 3x4 affine matrix. The first three columns hold the linear part, the last column the translation.*/
+			using AffineMatrixType = std::array<std::array<WorldCoordinate, 4>, 3>;
+
 		private:
       WorldCoordinate3D _imagePositionPatient{ 0 };
 
@@ -58,6 +64,17 @@ namespace rttb
 			VoxelGridDimensionType _numberOfRows{0};
 			VoxelGridDimensionType _numberOfFrames{0};
 
+			/*! @brief index to world transform (orientation*spacing | imagePositionPatient).
+				Kept in sync with spacing, orientation and image position by updateAffineMatrices().*/
+			AffineMatrixType _indexToWorldMatrix{};
+			/*! @brief inverse of _indexToWorldMatrix. worldCoordinateToContinuousIndex() only uses its linear part
+				(inverted orientation / spacing) and subtracts the image position before the product, so that a large image
+				position does not cancel against the precomposed offset.*/
+			AffineMatrixType _worldToIndexMatrix{};
+
+			/*! @brief recomputes _indexToWorldMatrix and _worldToIndexMatrix from spacing, orientation and image position.*/
+			void updateAffineMatrices();
+
 			/* @brief Matrix inversion routine.
 			   Uses lu_factorize and lu_substitute in uBLAS to invert a matrix
 			   http://savingyoutime.wordpress.com/2009/09/21/c-matrix-inversion-boostublas/
@@ -91,6 +108,18 @@ namespace rttb
 				return _orientationMatrix;
 			};
 
+			/*! @brief returns the cached affine transform from (continuous) voxel grid index to world coordinates.*/
+			const AffineMatrixType& getIndexToWorldMatrix() const
+			{
+				return _indexToWorldMatrix;
+			};
+
+			/*! @brief returns the cached affine transform from world coordinates to (continuous) voxel grid index.*/
+			const AffineMatrixType& getWorldToIndexMatrix() const
+			{
+				return _worldToIndexMatrix;
+			};
+
 			void setImageSize(const ImageSize& aSize);
 
 			const ImageSize getImageSize() const;
@@ -159,6 +188,59 @@ namespace rttb
 			bool indexToWorldCoordinate(const VoxelGridIndex3D& aIndex,
 			                            WorldCoordinate3D& aWorldCoordinate) const;
 
+			/*! @brief converts world coordinates to double geometry coordinate using the cached affine matrix.
+				@details Same conversion as worldCoordinateToContinuousIndex(const WorldCoordinate3D&, ContinuousVoxelGridIndex3D&),
+				but without the inside check. Intended for inner loops (mapping, voxelization).
+			*/
+			ContinuousVoxelGridIndex3D worldCoordinateToContinuousIndex(const WorldCoordinate3D& aWorldCoordinate) const
+			{
+				const AffineMatrixType& m = _worldToIndexMatrix;
+				const WorldCoordinate x = aWorldCoordinate.x() - _imagePositionPatient.x();
+				const WorldCoordinate y = aWorldCoordinate.y() - _imagePositionPatient.y();
+				const WorldCoordinate z = aWorldCoordinate.z() - _imagePositionPatient.z();
+				return ContinuousVoxelGridIndex3D(m[0][0] * x + (m[0][1] * y + m[0][2] * z),
+				                                  m[1][0] * x + (m[1][1] * y + m[1][2] * z),
+				                                  m[2][0] * x + (m[2][1] * y + m[2][2] * z));
+			}
+
+			/*! @brief converts double geometry coordinate to world coordinates using the cached affine matrix.
+				@details Same conversion as continuousIndexToWorldCoordinate(const ContinuousVoxelGridIndex3D&, WorldCoordinate3D&),
+				but without the inside check. Gives bit-identical results to indexRowToWorldCoordinates().
+			*/
+			WorldCoordinate3D continuousIndexToWorldCoordinate(const ContinuousVoxelGridIndex3D& aIndex) const
+			{
+				const AffineMatrixType& m = _indexToWorldMatrix;
+				return WorldCoordinate3D(
+				           m[0][0] * aIndex.x() + (m[0][1] * aIndex.y() + m[0][2] * aIndex.z() + m[0][3]),
+				           m[1][0] * aIndex.x() + (m[1][1] * aIndex.y() + m[1][2] * aIndex.z() + m[1][3]),
+				           m[2][0] * aIndex.x() + (m[2][1] * aIndex.y() + m[2][2] * aIndex.z() + m[2][3]));
+			}
+
+			/*! @brief converts voxel grid index to world coordinates (voxel center) without inside check.*/
+			WorldCoordinate3D indexToWorldCoordinate(const VoxelGridIndex3D& aIndex) const
+			{
+				return continuousIndexToWorldCoordinate(ContinuousVoxelGridIndex3D(aIndex.x(), aIndex.y(), aIndex.z()));
+			}
+
+			/*! @brief converts count world coordinates to double geometry coordinates (no inside check).
+				@pre aIndices must provide space for count elements.
+			*/
+			void worldCoordinateToContinuousIndex(const WorldCoordinate3D* aWorldCoordinates, std::size_t count,
+			                                      ContinuousVoxelGridIndex3D* aIndices) const;
+
+			/*! @brief converts count double geometry coordinates to world coordinates (no inside check).
+				@pre aWorldCoordinates must provide space for count elements.
+			*/
+			void continuousIndexToWorldCoordinate(const ContinuousVoxelGridIndex3D* aIndices, std::size_t count,
+			                                      WorldCoordinate3D* aWorldCoordinates) const;
+
+			/*! @brief converts the voxel centers of a whole index row (all columns for the given row and slice) to world coordinates.
+				@details The row and slice dependent part of the transform is computed only once.
+				@pre aWorldCoordinates must provide space for getNumColumns() elements.
+			*/
+			void indexRowToWorldCoordinates(GridIndexType aRow, GridIndexType aSlice,
+			                                WorldCoordinate3D* aWorldCoordinates) const;
+
 			/*! @brief check if a given voxel grid index is inside the given voxel grid.*/
 			bool isInside(const VoxelGridIndex3D& aIndex) const;
 
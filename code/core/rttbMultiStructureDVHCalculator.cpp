@@ -0,0 +1,264 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+#include <algorithm>
+#include <utility>
+
+#include <boost/make_shared.hpp>
+
+#include "rttbMultiStructureDVHCalculator.h"
+#include "rttbDoseHistogram.h"
+#include "rttbGeometricInfo.h"
+#include "rttbThreadPool.h"
+#include "rttbNullPointerException.h"
+#include "rttbInvalidParameterException.h"
+
+namespace rttb
+{
+	namespace core
+	{
+		namespace
+		{
+			/*! @brief number of voxel table entries that are read by one task*/
+			const std::size_t readBlockSize = 1 << 16;
+		}
+
+		MultiStructureDVHCalculator::MultiStructureDVHCalculator(DoseAccessorPointer aDoseAccessor,
+		        const std::vector<MaskAccessorPointer>& aMaskAccessors, const std::vector<IDType>& aStructureIDs,
+		        const IDType& aDoseID, DoseTypeGy aDeltaD, int aNumberOfBins, bool aMultiThreading)
+		{
+			if (aDoseAccessor == nullptr)
+			{
+				throw NullPointerException("aDoseAccessor must not be nullptr! ");
+			}
+
+			if (aMaskAccessors.size() != aStructureIDs.size())
+			{
+				throw InvalidParameterException("every mask needs a structure ID! ");
+			}
+
+			for (const auto& mask : aMaskAccessors)
+			{
+				if (mask == nullptr)
+				{
+					throw NullPointerException("mask pointer must not be nullptr! ");
+				}
+
+				if (!(mask->getGeometricInfo() == aDoseAccessor->getGeometricInfo()))
+				{
+					throw Exception("Mask and Dose need to be defined on the same grid");
+				}
+			}
+
+			if (aNumberOfBins <= 0 || aDeltaD < 0)
+			{
+				throw InvalidParameterException("aNumberOfBins/aDeltaD must be >0! ");
+			}
+
+			_doseAccessor = aDoseAccessor;
+			_maskAccessors = aMaskAccessors;
+			_structureIDs = aStructureIDs;
+			_doseID = aDoseID;
+			_deltaD = aDeltaD;
+			_numberOfBins = aNumberOfBins;
+			_multiThreading = aMultiThreading;
+		}
+
+		void MultiStructureDVHCalculator::setMultiThreading(bool choice)
+		{
+			_multiThreading = choice;
+		}
+
+		MultiStructureDVHCalculator::VoxelTable MultiStructureDVHCalculator::readDose(
+		    std::vector<MaskAccessorInterface::MaskVoxelListPointer>& voxelLists) const
+		{
+			const GridSizeType numberOfVoxels = _doseAccessor->getGeometricInfo().getNumberOfVoxels();
+			VoxelTable table;
+			std::size_t numberOfMaskVoxels = 0;
+
+			for (auto& voxels : voxelLists)
+			{
+				const auto invalid = std::find_if(voxels->cbegin(), voxels->cend(), [numberOfVoxels](const MaskVoxel & voxel)
+				{
+					return voxel.getVoxelGridID() < 0 || voxel.getVoxelGridID() >= numberOfVoxels;
+				});
+
+				if (invalid != voxels->cend())
+				{
+					voxels = boost::make_shared<MaskAccessorInterface::MaskVoxelList>(voxels->cbegin(), invalid);
+				}
+
+				numberOfMaskVoxels += voxels->size();
+			}
+
+			table.voxelIDs.reserve(numberOfMaskVoxels);
+
+			for (const auto& voxels : voxelLists)
+			{
+				for (const auto& voxel : *voxels)
+				{
+					table.voxelIDs.push_back(voxel.getVoxelGridID());
+				}
+			}
+
+			std::sort(table.voxelIDs.begin(), table.voxelIDs.end());
+			table.voxelIDs.erase(std::unique(table.voxelIDs.begin(), table.voxelIDs.end()), table.voxelIDs.end());
+			table.voxelIDs.shrink_to_fit();
+			table.doseValues.resize(table.voxelIDs.size());
+
+			//read the dose values run by run (consecutive voxel IDs); the table is split into blocks that are read
+			//concurrently with multi-threading
+			auto readBlock = [this, &table](std::size_t blockStart)
+			{
+				const std::size_t blockEnd = std::min(table.voxelIDs.size(), blockStart + readBlockSize);
+				std::size_t runStart = blockStart;
+
+				while (runStart < blockEnd)
+				{
+					const VoxelGridID firstID = table.voxelIDs[runStart];
+					std::size_t runEnd = runStart + 1;
+
+					while (runEnd < blockEnd && table.voxelIDs[runEnd] == firstID + static_cast<VoxelGridID>(runEnd - runStart))
+					{
+						++runEnd;
+					}
+
+					_doseAccessor->getValues(firstID, static_cast<GridSizeType>(runEnd - runStart),
+					                         table.doseValues.data() + runStart);
+					runStart = runEnd;
+				}
+			};
+
+			if (_multiThreading && table.voxelIDs.size() > readBlockSize)
+			{
+				ThreadPool::TaskGroup group(ThreadPool::getDefault());
+
+				for (std::size_t blockStart = 0; blockStart < table.voxelIDs.size(); blockStart += readBlockSize)
+				{
+					group.run([&readBlock, blockStart]()
+					{
+						readBlock(blockStart);
+					});
+				}
+
+				group.wait();
+			}
+			else
+			{
+				for (std::size_t blockStart = 0; blockStart < table.voxelIDs.size(); blockStart += readBlockSize)
+				{
+					readBlock(blockStart);
+				}
+			}
+
+			return table;
+		}
+
+		DVH::Pointer MultiStructureDVHCalculator::binStructure(const VoxelTable& table,
+		        const MaskAccessorInterface::MaskVoxelList& voxels, const IDType& aStructureID,
+		        DoseVoxelVolumeType voxelVolume) const
+		{
+			//same chunking and summation order as DVHCalculator
+			DoseHistogram histogram(_deltaD, _numberOfBins);
+
+			histogram.addPositions(voxels.size(), [&table, &voxels](std::size_t aFirstPosition,
+			                       std::size_t aMaxNumberOfValues, DoseTypeGy * doseValues, FractionType * fractions)
+			{
+				const std::size_t count = std::min(aMaxNumberOfValues, voxels.size() - aFirstPosition);
+
+				for (std::size_t i = 0; i < count; ++i)
+				{
+					const MaskVoxel& voxel = voxels[aFirstPosition + i];
+					const auto position = std::lower_bound(table.voxelIDs.cbegin(), table.voxelIDs.cend(),
+					                                       voxel.getVoxelGridID());
+					doseValues[i] = table.doseValues[position - table.voxelIDs.cbegin()];
+					fractions[i] = voxel.getRelevantVolumeFraction();
+				}
+
+				return count;
+			}, 1);
+
+			return boost::make_shared<DVH>(histogram.getDataDifferential(), histogram.getDeltaD(), voxelVolume, aStructureID,
+			                               _doseID);
+		}
+
+		MultiStructureDVHCalculator::DVHListType MultiStructureDVHCalculator::generateDVHs()
+		{
+			if (!_doseAccessor->isGridHomogeneous())
+			{
+				throw InvalidParameterException("Inhomogeneous grids are currently not supported! ");
+			}
+
+			const GeometricInfo& geoInfo = _doseAccessor->getGeometricInfo();
+			const DoseVoxelVolumeType voxelVolume = geoInfo.getSpacing()(0) * geoInfo.getSpacing()(1) *
+			                                        geoInfo.getSpacing()(2) / 1000;
+
+			std::vector<MaskAccessorInterface::MaskVoxelListPointer> voxelLists;
+			voxelLists.reserve(_maskAccessors.size());
+
+			for (const auto& mask : _maskAccessors)
+			{
+				voxelLists.push_back(mask->getRelevantVoxelVector());
+			}
+
+			const VoxelTable table = readDose(voxelLists);
+			DVHListType dvhs(_maskAccessors.size());
+
+			if (_multiThreading && dvhs.size() > 1)
+			{
+				ThreadPool::TaskGroup group(ThreadPool::getDefault());
+
+				for (std::size_t i = 0; i < dvhs.size(); ++i)
+				{
+					group.run([&, i]()
+					{
+						dvhs[i] = binStructure(table, *voxelLists[i], _structureIDs[i], voxelVolume);
+					});
+				}
+
+				group.wait();
+			}
+			else
+			{
+				for (std::size_t i = 0; i < dvhs.size(); ++i)
+				{
+					dvhs[i] = binStructure(table, *voxelLists[i], _structureIDs[i], voxelVolume);
+				}
+			}
+
+			return dvhs;
+		}
+
+		DVHSet::Pointer MultiStructureDVHCalculator::generateDVHSet(const IDType& aStructureSetID,
+		        const std::vector<DVHRole>& aDVHRoles)
+		{
+			if (!aDVHRoles.empty() && aDVHRoles.size() != _maskAccessors.size())
+			{
+				throw InvalidParameterException("every structure needs a DVH role! ");
+			}
+
+			const DVHListType dvhs = generateDVHs();
+			auto dvhSet = boost::make_shared<DVHSet>(aStructureSetID, _doseID);
+
+			for (std::size_t i = 0; i < dvhs.size(); ++i)
+			{
+				dvhSet->insert(*dvhs[i], aDVHRoles.empty() ? DVHRole{DVHRole::HealthyTissue} : aDVHRoles[i]);
+			}
+
+			return dvhSet;
+		}
+
+	}//end namespace core
+}//end namespace rttb
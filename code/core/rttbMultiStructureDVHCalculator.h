@@ -0,0 +1,130 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+#ifndef __MULTI_STRUCTURE_DVH_CALCULATOR_H
+#define __MULTI_STRUCTURE_DVH_CALCULATOR_H
+
+#include <vector>
+
+#include "rttbBaseType.h"
+#include "rttbCommon.h"
+#include "rttbDoseAccessorInterface.h"
+#include "rttbMaskAccessorInterface.h"
+#include "rttbDVH.h"
+#include "rttbDVHSet.h"
+
+#include "RTTBCoreExports.h"
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+
+namespace rttb
+{
+	namespace core
+	{
+
+		/*! @class MultiStructureDVHCalculator
+			@brief Calculates the DVHs of several structures on the same dose with one pass over the dose grid.
+			@details The voxel IDs of all masks are merged into one sorted table of distinct voxels. The dose values of
+			this table are read once (run by run with getValues()), so voxels shared by several structures are read only
+			once. The DVH of every structure is then binned from the table in mask voxel order with DoseHistogram, like in
+			DVHCalculator, so every DVH is bit-identical to the one DVHCalculator generates for a GenericMaskedDoseIterator
+			of the same mask. With multi-threading, blocks of the table are read and the structures are binned concurrently
+			on ThreadPool::getDefault().
+		*/
+		class RTTBCore_EXPORT MultiStructureDVHCalculator
+		{
+		public:
+			rttbClassMacroNoParent(MultiStructureDVHCalculator)
+			using DoseAccessorPointer = DoseAccessorInterface::Pointer;
+			using MaskAccessorPointer = MaskAccessorInterface::Pointer;
+			using DVHListType = std::vector<DVH::Pointer>;
+
+		private:
+			DoseAccessorPointer _doseAccessor;
+			std::vector<MaskAccessorPointer> _maskAccessors;
+			std::vector<IDType> _structureIDs;
+			IDType _doseID;
+			DoseTypeGy _deltaD;
+			int _numberOfBins;
+			bool _multiThreading;
+
+			/*! @brief sorted distinct voxel IDs of all masks and their dose values*/
+			struct VoxelTable
+			{
+				std::vector<VoxelGridID> voxelIDs;
+				std::vector<DoseTypeGy> doseValues;
+			};
+
+			/*! @brief merges the voxel lists and reads the dose of every distinct voxel once.
+				@details Each mask voxel list is truncated at its first ID outside of the dose grid, like in
+				GenericMaskedDoseIterator::nextBlock().
+			*/
+			VoxelTable readDose(std::vector<MaskAccessorInterface::MaskVoxelListPointer>& voxelLists) const;
+
+			/*! @brief bins the voxels of one structure.
+				@exception InvalidParameterException if a dose bin is out of bounds.
+			*/
+			DVH::Pointer binStructure(const VoxelTable& table, const MaskAccessorInterface::MaskVoxelList& voxels,
+			                          const IDType& aStructureID, DoseVoxelVolumeType voxelVolume) const;
+
+		public:
+			/*! @brief Constructor.
+				@param aMaskAccessors masks of the structures, defined on the grid of aDoseAccessor.
+				@param aStructureIDs structure ID of every mask (same order as aMaskAccessors).
+				@param aDeltaD the absolute dose value in Gy for dose_bin [i,i+1). Optional, if aDeltaD==0,
+				it is calculated for every structure from the maximum of the structure dose, like in DVHCalculator.
+				@exception NullPointerException if the dose or a mask is nullptr.
+				@exception InvalidParameterException if the number of masks and structure IDs differ, aNumberOfBins<=0 or
+				aDeltaD<0.
+				@exception Exception if a mask is not defined on the dose grid.
+			*/
+			MultiStructureDVHCalculator(DoseAccessorPointer aDoseAccessor,
+			                            const std::vector<MaskAccessorPointer>& aMaskAccessors,
+			                            const std::vector<IDType>& aStructureIDs, const IDType& aDoseID,
+			                            DoseTypeGy aDeltaD = 0, int aNumberOfBins = 201, bool aMultiThreading = false);
+
+			void setMultiThreading(bool choice);
+
+			bool getMultiThreading() const
+			{
+				return _multiThreading;
+			};
+
+			/*! @brief Generates the DVHs of all structures.
+				@return one DVH per mask, in the order of the masks.
+				@exception InvalidParameterException if _numberOfBins is too small for the given aDeltaD or the grid is
+				inhomogeneous.
+			*/
+			DVHListType generateDVHs();
+
+			/*! @brief Generates the DVHs of all structures and collects them in a DVHSet.
+				@param aDVHRoles role of every structure (same order as the masks). If empty, all DVHs are inserted as
+				healthy tissue.
+				@exception InvalidParameterException if aDVHRoles is neither empty nor of the size of the mask list.
+			*/
+			DVHSet::Pointer generateDVHSet(const IDType& aStructureSetID,
+			                               const std::vector<DVHRole>& aDVHRoles = std::vector<DVHRole>());
+		};
+	}
+}
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif
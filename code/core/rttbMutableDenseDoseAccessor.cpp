@@ -0,0 +1,123 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+#include <algorithm>
+
+#include <boost/make_shared.hpp>
+
+#include "rttbMutableDenseDoseAccessor.h"
+#include "rttbNullPointerException.h"
+#include "rttbInvalidParameterException.h"
+#include "rttbIndexOutOfBoundsException.h"
+
+namespace rttb
+{
+	namespace core
+	{
+
+		MutableDenseDoseAccessor::MutableDenseDoseAccessor(const GeometricInfo& geoInfo,
+		        GenericValueType aInitialValue, const IDType& aUID) : _geoInfo(geoInfo), _UID(aUID)
+		{
+			auto valueVector = boost::make_shared<std::vector<GenericValueType> >(geoInfo.getNumberOfVoxels(),
+			                   aInitialValue);
+			//aliasing constructor: the buffer keeps the vector alive
+			_buffer = BufferPointer(valueVector, valueVector->data());
+		}
+
+		MutableDenseDoseAccessor::MutableDenseDoseAccessor(const GeometricInfo& geoInfo,
+		        std::vector<GenericValueType> aValues, const IDType& aUID) : _geoInfo(geoInfo), _UID(aUID)
+		{
+			if (static_cast<GridSizeType>(aValues.size()) != geoInfo.getNumberOfVoxels())
+			{
+				throw InvalidParameterException("Number of values does not match the size of the geometric info!");
+			}
+
+			auto valueVector = boost::make_shared<std::vector<GenericValueType> >(std::move(aValues));
+			_buffer = BufferPointer(valueVector, valueVector->data());
+		}
+
+		MutableDenseDoseAccessor::MutableDenseDoseAccessor(const GeometricInfo& geoInfo, BufferPointer buffer,
+		        const IDType& aUID) : _geoInfo(geoInfo), _buffer(buffer), _UID(aUID)
+		{
+			if (_buffer == nullptr)
+			{
+				throw NullPointerException("Buffer must not be nullptr!");
+			}
+		}
+
+		MutableDenseDoseAccessor::MutableDenseDoseAccessor(AccessorInterface::ConstPointer source)
+		{
+			if (source == nullptr)
+			{
+				throw NullPointerException("Source accessor must not be nullptr!");
+			}
+
+			_geoInfo = source->getGeometricInfo();
+			_UID = source->getUID();
+
+			auto valueVector = boost::make_shared<std::vector<GenericValueType> >(_geoInfo.getNumberOfVoxels());
+			source->getValues(0, _geoInfo.getNumberOfVoxels(), valueVector->data());
+			_buffer = BufferPointer(valueVector, valueVector->data());
+		}
+
+		GenericValueType MutableDenseDoseAccessor::getValueAt(const VoxelGridIndex3D& aIndex) const
+		{
+			VoxelGridID aVoxelGridID;
+
+			if (_geoInfo.convert(aIndex, aVoxelGridID))
+			{
+				return getValueAt(aVoxelGridID);
+			}
+			else
+			{
+				return -1;
+			}
+		}
+
+		void MutableDenseDoseAccessor::getValues(const VoxelGridID aFirstID, const GridSizeType aNumberOfValues,
+		        GenericValueType* values) const
+		{
+			if (aFirstID < 0 || aNumberOfValues < 0 || aFirstID + aNumberOfValues > getGridSize())
+			{
+				throw IndexOutOfBoundsException("Requested voxel ID range is not inside the grid!");
+			}
+
+			std::copy(data() + aFirstID, data() + aFirstID + aNumberOfValues, values);
+		}
+
+		void MutableDenseDoseAccessor::setDoseAt(const VoxelGridID aID, DoseTypeGy value)
+		{
+			if (!_geoInfo.validID(aID))
+			{
+				throw IndexOutOfBoundsException("Not a valid Position!");
+			}
+
+			_buffer.get()[aID] = value;
+		}
+
+		void MutableDenseDoseAccessor::setDoseAt(const VoxelGridIndex3D& aIndex, DoseTypeGy value)
+		{
+			VoxelGridID aVoxelGridID;
+
+			if (!_geoInfo.convert(aIndex, aVoxelGridID))
+			{
+				throw IndexOutOfBoundsException("Not a valid Position!");
+			}
+
+			setDoseAt(aVoxelGridID, value);
+		}
+
+	}//end namespace core
+}//end namespace rttb
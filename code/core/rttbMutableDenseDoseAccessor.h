@@ -0,0 +1,141 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+#ifndef __MUTABLE_DENSE_DOSE_ACCESSOR_H
+#define __MUTABLE_DENSE_DOSE_ACCESSOR_H
+
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+
+#include "rttbMutableDoseAccessorInterface.h"
+#include "rttbGeometricInfo.h"
+#include "rttbBaseType.h"
+#include "rttbCommon.h"
+
+#include "RTTBCoreExports.h"
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+
+namespace rttb
+{
+	namespace core
+	{
+
+		/*! @class MutableDenseDoseAccessor
+			@brief Mutable counterpart of DenseDoseAccessor. Holds all values in one contiguous, writable buffer
+			(column index running fastest, then row, then slice).
+			@details The buffer can be passed to a DenseDoseAccessor without copying (see getBuffer()).
+			@sa DenseDoseAccessor
+		*/
+		class RTTBCore_EXPORT MutableDenseDoseAccessor : public MutableDoseAccessorInterface
+		{
+		public:
+			rttbClassMacro(MutableDenseDoseAccessor, MutableDoseAccessorInterface);
+			using BufferPointer = boost::shared_ptr<GenericValueType>;
+
+		private:
+			GeometricInfo _geoInfo;
+			BufferPointer _buffer;
+			IDType _UID;
+
+		public:
+			/*! @brief Constructor. Allocates a buffer for geoInfo with all values set to aInitialValue.*/
+			explicit MutableDenseDoseAccessor(const GeometricInfo& geoInfo, GenericValueType aInitialValue = 0,
+			                                  const IDType& aUID = "");
+
+			/*! @brief Constructor. Takes over the values of aValues.
+				@exception InvalidParameterException if the size of aValues does not match the grid size of geoInfo.
+			*/
+			MutableDenseDoseAccessor(const GeometricInfo& geoInfo, std::vector<GenericValueType> aValues,
+			                         const IDType& aUID = "");
+
+			/*! @brief Constructor. Shares the buffer with its current owner (no copy).
+				@pre buffer must hold geoInfo.getNumberOfVoxels() values.
+				@exception NullPointerException if buffer is nullptr.
+			*/
+			MutableDenseDoseAccessor(const GeometricInfo& geoInfo, BufferPointer buffer, const IDType& aUID = "");
+
+			/*! @brief Constructor. Copies all values of source (geometric info and UID are taken from source).
+				@exception NullPointerException if source is nullptr.
+			*/
+			explicit MutableDenseDoseAccessor(AccessorInterface::ConstPointer source);
+
+			~MutableDenseDoseAccessor() override = default;
+
+			const GeometricInfo& getGeometricInfo() const override
+			{
+				return _geoInfo;
+			};
+
+			/*! @brief raw access to the contiguous value buffer (getGridSize() elements).*/
+			const GenericValueType* data() const
+			{
+				return _buffer.get();
+			};
+
+			/*! @brief raw writing access to the contiguous value buffer (getGridSize() elements).*/
+			GenericValueType* data()
+			{
+				return _buffer.get();
+			};
+
+			/*! @brief returns the (possibly shared) buffer, e.g. to pass it to a DenseDoseAccessor without copying.*/
+			const BufferPointer& getBuffer() const
+			{
+				return _buffer;
+			};
+
+			/*! @brief returns the value for an id, -1 if the id is not inside the grid.*/
+			GenericValueType getValueAt(const VoxelGridID aID) const override
+			{
+				if (!_geoInfo.validID(aID))
+				{
+					return -1;
+				}
+
+				return _buffer.get()[aID];
+			};
+
+			/*! @brief returns the value for an index, -1 if the index is not inside the grid.*/
+			GenericValueType getValueAt(const VoxelGridIndex3D& aIndex) const override;
+
+			/*! @brief copies the values directly from the buffer.
+				@exception IndexOutOfBoundsException if the ID range is not completely inside the grid.
+			*/
+			void getValues(VoxelGridID aFirstID, GridSizeType aNumberOfValues, GenericValueType* values) const override;
+
+			/*! @exception IndexOutOfBoundsException if aID is not inside the grid.*/
+			void setDoseAt(const VoxelGridID aID, DoseTypeGy value) override;
+
+			/*! @exception IndexOutOfBoundsException if aIndex is not inside the grid.*/
+			void setDoseAt(const VoxelGridIndex3D& aIndex, DoseTypeGy value) override;
+
+			const IDType getUID() const override
+			{
+				return _UID;
+			};
+		};
+	}
+}
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif
@@ -0,0 +1,295 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+#include "rttbThreadPool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <utility>
+
+namespace rttb
+{
+	namespace core
+	{
+
+		namespace
+		{
+			/*! @brief pool and worker index of the calling thread, if it is a worker.*/
+			thread_local const ThreadPool* currentPool = nullptr;
+			thread_local std::size_t currentWorkerIndex = 0;
+		}
+
+		ThreadPool::ThreadPool(unsigned int numberOfThreads) : _numberOfQueuedTasks(0), _stop(false)
+		{
+			if (numberOfThreads == 0)
+			{
+				numberOfThreads = std::max(std::thread::hardware_concurrency(), 1u);
+			}
+
+			//all queues have to exist before the first worker tries to steal
+			for (unsigned int i = 0; i < numberOfThreads; ++i)
+			{
+				_workerQueues.push_back(std::make_unique<WorkerQueue>());
+			}
+
+			for (unsigned int i = 0; i < numberOfThreads; ++i)
+			{
+				_workers.emplace_back(&ThreadPool::workerLoop, this, i);
+			}
+		}
+
+		ThreadPool::~ThreadPool()
+		{
+			{
+				std::lock_guard<std::mutex> lock(_mutex);
+				_stop = true;
+			}
+
+			_taskAvailable.notify_all();
+
+			for (auto& worker : _workers)
+			{
+				if (worker.joinable())
+				{
+					worker.join();
+				}
+			}
+		}
+
+		unsigned int ThreadPool::getNumberOfThreads() const
+		{
+			return static_cast<unsigned int>(_workers.size());
+		}
+
+		ThreadPool& ThreadPool::getDefault()
+		{
+			static ThreadPool defaultPool;
+			return defaultPool;
+		}
+
+		void ThreadPool::workerLoop(std::size_t aWorkerIndex)
+		{
+			currentPool = this;
+			currentWorkerIndex = aWorkerIndex;
+
+			while (true)
+			{
+				Task task;
+
+				if (takeTask(aWorkerIndex, task))
+				{
+					task();
+					continue;
+				}
+
+				std::unique_lock<std::mutex> lock(_mutex);
+				_taskAvailable.wait(lock, [this]()
+				{
+					return _stop || _numberOfQueuedTasks > 0;
+				});
+
+				if (_stop && _numberOfQueuedTasks == 0)
+				{
+					return;
+				}
+			}
+		}
+
+		std::size_t ThreadPool::getCurrentWorkerIndex() const
+		{
+			return currentPool == this ? currentWorkerIndex : _workerQueues.size();
+		}
+
+		void ThreadPool::enqueue(Task aTask)
+		{
+			const std::size_t workerIndex = getCurrentWorkerIndex();
+
+			if (workerIndex < _workerQueues.size())
+			{
+				WorkerQueue& queue = *_workerQueues[workerIndex];
+
+				{
+					std::lock_guard<std::mutex> lock(queue.mutex);
+					queue.tasks.push_back(std::move(aTask));
+					++_numberOfQueuedTasks;
+				}
+
+				//a worker that checked _numberOfQueuedTasks before the increment is already waiting and gets notified
+				std::lock_guard<std::mutex> lock(_mutex);
+			}
+			else
+			{
+				std::lock_guard<std::mutex> lock(_mutex);
+				_tasks.push_back(std::move(aTask));
+				++_numberOfQueuedTasks;
+			}
+
+			_taskAvailable.notify_one();
+		}
+
+		bool ThreadPool::takeTask(std::size_t aWorkerIndex, Task& aTask)
+		{
+			const std::size_t numberOfQueues = _workerQueues.size();
+
+			if (aWorkerIndex < numberOfQueues)
+			{
+				WorkerQueue& queue = *_workerQueues[aWorkerIndex];
+				std::lock_guard<std::mutex> lock(queue.mutex);
+
+				if (!queue.tasks.empty())
+				{
+					aTask = std::move(queue.tasks.back());
+					queue.tasks.pop_back();
+					--_numberOfQueuedTasks;
+					return true;
+				}
+			}
+
+			{
+				std::lock_guard<std::mutex> lock(_mutex);
+
+				if (!_tasks.empty())
+				{
+					aTask = std::move(_tasks.front());
+					_tasks.pop_front();
+					--_numberOfQueuedTasks;
+					return true;
+				}
+			}
+
+			//steal, starting with the next worker so that the victims are spread
+			for (std::size_t i = 1; i <= numberOfQueues; ++i)
+			{
+				WorkerQueue& queue = *_workerQueues[(aWorkerIndex + i) % numberOfQueues];
+				std::lock_guard<std::mutex> lock(queue.mutex);
+
+				if (!queue.tasks.empty())
+				{
+					aTask = std::move(queue.tasks.front());
+					queue.tasks.pop_front();
+					--_numberOfQueuedTasks;
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+		bool ThreadPool::runPendingTask()
+		{
+			Task task;
+
+			if (!takeTask(getCurrentWorkerIndex(), task))
+			{
+				return false;
+			}
+
+			task();
+			return true;
+		}
+
+		ThreadPool::TaskGroup::TaskGroup(ThreadPool& aPool) : _pool(aPool), _numberOfPendingTasks(0)
+		{
+		}
+
+		ThreadPool::TaskGroup::~TaskGroup()
+		{
+			try
+			{
+				wait();
+			}
+			catch (...)
+			{
+				//exceptions of the tasks are only reported by an explicit wait()
+			}
+		}
+
+		void ThreadPool::TaskGroup::run(Task aTask)
+		{
+			{
+				std::lock_guard<std::mutex> lock(_mutex);
+				++_numberOfPendingTasks;
+			}
+
+			_pool.enqueue([this, aTask]()
+			{
+				std::exception_ptr error;
+
+				try
+				{
+					aTask();
+				}
+				catch (...)
+				{
+					error = std::current_exception();
+				}
+
+				taskFinished(error);
+			});
+		}
+
+		void ThreadPool::TaskGroup::taskFinished(std::exception_ptr error)
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+
+			if (error && !_error)
+			{
+				_error = error;
+			}
+
+			if (--_numberOfPendingTasks == 0)
+			{
+				_finished.notify_all();
+			}
+		}
+
+		void ThreadPool::TaskGroup::wait()
+		{
+			while (true)
+			{
+				{
+					std::lock_guard<std::mutex> lock(_mutex);
+
+					if (_numberOfPendingTasks == 0)
+					{
+						break;
+					}
+				}
+
+				//help instead of blocking a thread of the pool; the tasks of this group may still be queued
+				if (!_pool.runPendingTask())
+				{
+					std::unique_lock<std::mutex> lock(_mutex);
+					_finished.wait_for(lock, std::chrono::milliseconds(1), [this]()
+					{
+						return _numberOfPendingTasks == 0;
+					});
+				}
+			}
+
+			std::exception_ptr error;
+
+			{
+				std::lock_guard<std::mutex> lock(_mutex);
+				std::swap(error, _error);
+			}
+
+			if (error)
+			{
+				std::rethrow_exception(error);
+			}
+		}
+	}
+}
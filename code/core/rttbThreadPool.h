@@ -0,0 +1,149 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+#ifndef __THREAD_POOL_H
+#define __THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "RTTBCoreExports.h"
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+
+namespace rttb
+{
+	namespace core
+	{
+
+		/*! @class ThreadPool
+			@brief Fixed number of persistent worker threads that execute tasks with work stealing.
+			@details Tasks are submitted and awaited with a TaskGroup. Every worker has its own queue: tasks submitted by a
+			worker are put into its queue and executed last in, first out by this worker, while idle threads steal the
+			oldest tasks of the other queues. Tasks submitted by other threads are put into a shared queue.
+			A thread that waits for a group executes queued tasks meanwhile, so tasks may themselves start and wait for
+			groups on the same pool without deadlock.
+			getDefault() returns a pool that is shared by the whole process.
+		*/
+		class RTTBCore_EXPORT ThreadPool
+		{
+		public:
+			using Task = std::function<void()>;
+
+			/*! @class TaskGroup
+				@brief A set of tasks on a ThreadPool that can be waited for.
+				@details The first exception thrown by a task of the group is rethrown by wait(); the remaining tasks are
+				still executed.
+			*/
+			class RTTBCore_EXPORT TaskGroup
+			{
+			private:
+				ThreadPool& _pool;
+				std::mutex _mutex;
+				std::condition_variable _finished;
+				std::size_t _numberOfPendingTasks;
+				std::exception_ptr _error;
+
+				TaskGroup(const TaskGroup&) = delete; //not implemented on purpose -> non-copyable
+				TaskGroup& operator=(const TaskGroup&) = delete;//not implemented on purpose -> non-copyable
+
+				void taskFinished(std::exception_ptr error);
+
+			public:
+				explicit TaskGroup(ThreadPool& aPool);
+
+				/*! @brief waits for all tasks, exceptions are discarded (call wait() to get them).*/
+				~TaskGroup();
+
+				void run(Task aTask);
+
+				/*! @brief Waits until all tasks of the group are finished and executes queued tasks of the pool meanwhile.
+					@exception rethrows the first exception thrown by a task of the group.
+				*/
+				void wait();
+			};
+
+		private:
+			struct WorkerQueue
+			{
+				std::mutex mutex;
+				std::deque<Task> tasks;
+			};
+
+			std::vector<std::thread> _workers;
+			std::vector<std::unique_ptr<WorkerQueue> > _workerQueues;
+			/*! @brief tasks submitted by threads that are not workers of this pool*/
+			std::deque<Task> _tasks;
+			std::mutex _mutex;
+			std::condition_variable _taskAvailable;
+			/*! @brief number of tasks in all queues, workers only sleep if it is 0*/
+			std::atomic<std::size_t> _numberOfQueuedTasks;
+			bool _stop;
+
+			ThreadPool(const ThreadPool&) = delete; //not implemented on purpose -> non-copyable
+			ThreadPool& operator=(const ThreadPool&) = delete;//not implemented on purpose -> non-copyable
+
+			void enqueue(Task aTask);
+
+			void workerLoop(std::size_t aWorkerIndex);
+
+			/*! @brief takes a task from the own queue of the worker (newest first), the shared queue or the queue of
+				another worker (oldest first).
+				@param aWorkerIndex index of the calling worker, or the number of workers if the calling thread is no worker.
+				@return false if all queues were empty.
+			*/
+			bool takeTask(std::size_t aWorkerIndex, Task& aTask);
+
+			/*! @brief index of the calling thread in _workers, or the number of workers if it is no worker of this pool.*/
+			std::size_t getCurrentWorkerIndex() const;
+
+			/*! @brief executes one queued task in the calling thread.
+				@return false if all queues were empty.
+			*/
+			bool runPendingTask();
+
+		public:
+			/*! @brief Constructor.
+				@param numberOfThreads number of worker threads. 0: use the number of hardware threads.
+			*/
+			explicit ThreadPool(unsigned int numberOfThreads = 0);
+
+			/*! @brief executes the remaining queued tasks and joins the workers.*/
+			~ThreadPool();
+
+			unsigned int getNumberOfThreads() const;
+
+			/*! @brief pool with one worker per hardware thread, shared by the whole process.*/
+			static ThreadPool& getDefault();
+		};
+	}
+}
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif
@@ -226,7 +226,7 @@ namespace rttb
             const WorldCoordinate z = _samplingStepSizes.z() * iZ;
             WorldCoordinate3D newPos = { x,y,z };
 
-            const auto newDistance = boost::numeric::ublas::norm_2(newPos);
+            const auto newDistance = newPos.norm();
             const auto penalty = (newDistance * newDistance) / (_dta * _dta);
             if (penalty > 0 && penalty <= 1)
             { //we skip the origin (penalty == 0) as it was added before the loop
@@ -13,7 +13,6 @@
 //
 //------------------------------------------------------------------------
 
-#include <list>
 #include <cassert>
 
 #include "rttbInterpolationBase.h"
@@ -45,7 +44,7 @@ namespace rttb
 		void InterpolationBase::getNeighborhoodVoxelValues(
 		    const WorldCoordinate3D& aWorldCoordinate,
 		    unsigned int neighborhood, std::array<double, 3>& target,
-		    boost::shared_ptr<DoseTypeGy[]> values) const
+		    NeighborhoodValuesType& values) const
 		{
 			if (_spOriginalData == nullptr)
 			{
@@ -65,11 +64,10 @@ namespace rttb
 				//determine the 8 voxels around the world coordinate
 				else if (neighborhood == 8)
 				{
-					std::list<VoxelGridIndex3D> cornerPoints;
+					std::array<VoxelGridIndex3D, 8> cornerPoints;
 
-					WorldCoordinate3D theNextVoxel;
-					_spOriginalData->getGeometricInfo().indexToWorldCoordinate(aIndex, theNextVoxel);
-					SpacingVectorType3D pixelSpacing = (_spOriginalData->getGeometricInfo()).getSpacing();
+					const WorldCoordinate3D theNextVoxel = _spOriginalData->getGeometricInfo().indexToWorldCoordinate(aIndex);
+					const SpacingVectorType3D& pixelSpacing = (_spOriginalData->getGeometricInfo()).getSpacing();
 					VoxelGridIndex3D leftTopFrontCoordinate;
 
 					//find the voxel with the smallest coordinate values in each dimension. This defines the standard cube
@@ -97,13 +95,15 @@ namespace rttb
 						}
 					}
 
+					unsigned int cornerCount = 0;
+
 					for (unsigned int zIncr = 0; zIncr < 2; zIncr++)
 					{
 						for (unsigned int yIncr = 0; yIncr < 2; yIncr++)
 						{
 							for (unsigned int xIncr = 0; xIncr < 2; xIncr++)
 							{
-								cornerPoints.emplace_back(leftTopFrontCoordinate[0] + xIncr,
+								cornerPoints[cornerCount++] = VoxelGridIndex3D(leftTopFrontCoordinate[0] + xIncr,
 								                                        leftTopFrontCoordinate[1] + yIncr,
 								                                        leftTopFrontCoordinate[2] + zIncr);
 							}
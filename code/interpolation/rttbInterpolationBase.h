@@ -43,6 +43,10 @@ namespace rttb
 		public:
       rttbClassMacroNoParent(InterpolationBase)
 
+			/*! @brief Fixed-size buffer for the values of the (at most 8) voxels of a neighborhood.
+			*/
+			using NeighborhoodValuesType = std::array<DoseTypeGy, 8>;
+
 			/*! @brief Constructor
 			*/
 			InterpolationBase() = default;
@@ -69,15 +73,15 @@ namespace rttb
 				@param aWorldCoordinate the coordinate where to start
 				@param neighborhood voxel around coordinate (currently only 0 and 8 implemented)
 				@param target coordinates inside the standard cube with values [0 1] in each dimension.
-				@param values dose values at all corner points of the standard cube. Is of type boost:shared_ptr[neighborhood]
-				@pre target and values have to be correctly initialized (e.g. std::array<double, 3> target = {0.0, 0.0, 0.0}; boost::shared_ptr<DoseTypeGy> values(new DoseTypeGy[8]()); where 8 is neighborhood)
+				@param values dose values at all corner points of the standard cube (only the first element is set for neighborhood 0)
+				@pre target has to be correctly initialized (e.g. std::array<double, 3> target = {0.0, 0.0, 0.0};)
 				@exception core::InvalidParameterException if neighborhood =! 0 && !=8
 				@exception core::MappingOutsideOfImageException if initial mapping of aWorldCoordinate is outside image
 				@exception core::NullPointerException if dose is nullptr
 			*/
 			void getNeighborhoodVoxelValues(const WorldCoordinate3D& aWorldCoordinate,
 			                                unsigned int neighborhood, std::array<double, 3>& target,
-			                                boost::shared_ptr<DoseTypeGy[]> values) const;
+			                                NeighborhoodValuesType& values) const;
 
 			/*! @brief returns the nearest inside voxel value
 				@pre the voxelGridIndex is outside the image and voxelGridIndex>image.size() for all dimensions. Also voxelGridIndex[]>=0 for all dimensions
@@ -15,15 +15,13 @@
 
 #include "rttbLinearInterpolation.h"
 
-#include <boost/make_shared.hpp>
-
 namespace rttb
 {
 	namespace interpolation
 	{
 
-		DoseTypeGy LinearInterpolation::trilinear(std::array<double, 3> target,
-		        boost::shared_ptr<DoseTypeGy[]> values) const
+		DoseTypeGy LinearInterpolation::trilinear(const std::array<double, 3>& target,
+		        const NeighborhoodValuesType& values) const
 		{
 			//4 linear interpolation in x direction
 			DoseTypeGy c_00 = values[0] * (1.0 - target[0]) + values[1] * target[0];
@@ -43,7 +41,7 @@ namespace rttb
 		{
 			//proper initialization of target and values
 			std::array<double, 3> target = {0.0, 0.0, 0.0};
-      auto values = boost::make_shared<DoseTypeGy[]>(8);
+			NeighborhoodValuesType values{};
 			getNeighborhoodVoxelValues(aWorldCoordinate, 8, target, values);
 
 			return trilinear(target, values);
@@ -47,7 +47,7 @@ namespace rttb
 				@sa InterpolationBase for details about target and values
 				@note Source: http://en.wikipedia.org/wiki/Trilinear_interpolation
 			*/
-			DoseTypeGy trilinear(std::array<double, 3> target, boost::shared_ptr<DoseTypeGy[]> values) const;
+			DoseTypeGy trilinear(const std::array<double, 3>& target, const NeighborhoodValuesType& values) const;
 		};
 
 	}
@@ -16,7 +16,6 @@
 #include "rttbNearestNeighborInterpolation.h"
 
 #include <array>
-#include <boost/make_shared.hpp>
 
 namespace rttb
 {
@@ -26,7 +25,7 @@ namespace rttb
 		{
 			//proper initialization of target and values (although target is irrelevant in nearest neighbor case)
 			std::array<double, 3> target = {{0.0, 0.0, 0.0}};
-      auto values = boost::make_shared<DoseTypeGy[]>(8);
+			NeighborhoodValuesType values{};
 			getNeighborhoodVoxelValues(aWorldCoordinate, 0, target, values);
 			return values[0];
 		}
@@ -136,9 +136,10 @@ namespace rttb
 		    const WorldCoordinate3D& aCoordinate) const
 		{
 			std::vector<WorldCoordinate3D> octants;
-			SpacingVectorType3D spacingTargetImage = _geoInfoTargetImage.getSpacing();
+			octants.reserve(8);
+			const SpacingVectorType3D& spacingTargetImage = _geoInfoTargetImage.getSpacing();
 
-			core::GeometricInfo geometricInfoDoseData = _spOriginalDoseDataMovingImage->getGeometricInfo();
+			const core::GeometricInfo& geometricInfoDoseData = _spOriginalDoseDataMovingImage->getGeometricInfo();
 
 			//as the corner point is the coordinate of the voxel (grid), 0.25 and 0.75 are the center of the subvoxels
 			for (double xOct = -0.25; xOct <= 0.25; xOct += 0.5)
@@ -280,6 +280,22 @@ namespace rttb
 				}
 			}
 
+			void DicomDoseAccessor::getValues(const VoxelGridID aFirstID, const GridSizeType aNumberOfValues,
+			        GenericValueType* values) const
+			{
+				if (aFirstID < 0 || aNumberOfValues < 0 || aFirstID + aNumberOfValues > static_cast<GridSizeType>(doseData.size()))
+				{
+					throw core::IndexOutOfBoundsException("Requested voxel ID range is not inside the grid!");
+				}
+
+				const Uint16* data = doseData.data() + aFirstID;
+
+				for (GridSizeType i = 0; i < aNumberOfValues; ++i)
+				{
+					values[i] = data[i] * _doseGridScaling;
+				}
+			}
+
 		}
 	}
 }
@@ -83,6 +83,11 @@ namespace rttb
 
 				GenericValueType getValueAt(const VoxelGridIndex3D& aIndex) const override;
 
+				/*! @brief converts the values directly from the pixel data buffer (value*doseGridScaling).
+				@exception IndexOutOfBoundsException if the ID range is not completely inside the grid.
+				*/
+				void getValues(VoxelGridID aFirstID, GridSizeType aNumberOfValues, GenericValueType* values) const override;
+
 				const IDType getUID() const override
 				{
 					return _doseUID;
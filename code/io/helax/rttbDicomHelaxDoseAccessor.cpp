@@ -25,6 +25,7 @@
 #include "rttbInvalidDoseException.h"
 #include "rttbDcmrtException.h"
 #include "rttbInvalidParameterException.h"
+#include "rttbIndexOutOfBoundsException.h"
 
 namespace rttb
 {
@@ -313,6 +314,22 @@ namespace rttb
 				}
 			}
 
+			void DicomHelaxDoseAccessor::getValues(const VoxelGridID aFirstID, const GridSizeType aNumberOfValues,
+			        GenericValueType* values) const
+			{
+				if (aFirstID < 0 || aNumberOfValues < 0 || aFirstID + aNumberOfValues > static_cast<GridSizeType>(_doseData.size()))
+				{
+					throw core::IndexOutOfBoundsException("Requested voxel ID range is not inside the grid!");
+				}
+
+				const Uint16* data = _doseData.data() + aFirstID;
+
+				for (GridSizeType i = 0; i < aNumberOfValues; ++i)
+				{
+					values[i] = data[i] * _doseGridScaling;
+				}
+			}
+
 		}
 	}
 
@@ -3,6 +3,7 @@ SET(CPP_FILES
 	itkMaskAccessorImageSource.cpp
 	rttbFileDispatch.cpp
 	rttbGenericImageReader.cpp
+	rttbITKDenseDoseAccessorConversion.cpp
 	rttbImageWriter.cpp
 	rttbITKImageAccessor.cpp
 	rttbITKImageAccessorConverter.cpp
@@ -26,6 +27,7 @@ SET(H_FILES
 	rttbImageReader.h
 	rttbImageReader.tpp
 	rttbImageWriter.h
+	rttbITKDenseDoseAccessorConversion.h
 	rttbITKException.h
 	rttbITKImageAccessor.h
 	rttbITKImageAccessorConverter.h
@@ -13,9 +13,10 @@
 //
 //------------------------------------------------------------------------
 
+#include <vector>
+
 #include "itkDoseAccessorImageFilter.h"
 #include "itkImageRegionIterator.h"
-#include "itkImageRegionConstIteratorWithIndex.h"
 #include "itkProgressReporter.h"
 
 namespace itk
@@ -36,16 +37,9 @@ namespace itk
 		//ProgressReporter progress(this, threadId,
 		//                          outputRegionForThread.GetNumberOfPixels());
 
-		using ImageRegionConstIteratorType = ImageRegionConstIteratorWithIndex<InputImageType>;
 		using OutputImageRegionIteratorType = ImageRegionIterator<OutputImageType>;
 
 		InputImagePointer inputPtr = dynamic_cast< InputImageType* >(ProcessObject::GetInput(0));
-		ImageRegionConstIteratorType inputItr;
-
-		if (inputPtr)
-		{
-			inputItr = ImageRegionConstIteratorType(inputPtr, outputRegionForThread);
-		}
 
 		OutputImagePointer outputPtr = dynamic_cast< OutputImageType* >(ProcessObject::GetOutput(0));
 		OutputImageRegionIteratorType outputItr;
@@ -57,15 +51,24 @@ namespace itk
 
 		if (inputPtr && outputPtr)
 		{
+			//read the values of the whole region at once; the region iterator visits the pixels in the same order
+			const OutputImageRegionType::IndexType& regionIndex = outputRegionForThread.GetIndex();
+			const OutputImageRegionType::SizeType& regionSize = outputRegionForThread.GetSize();
+			const rttb::VoxelGridIndex3D regionStart(regionIndex[0], regionIndex[1], regionIndex[2]);
+			const rttb::ImageSize size(static_cast<rttb::Index1D>(regionSize[0]), static_cast<rttb::Index1D>(regionSize[1]),
+			                           static_cast<rttb::Index1D>(regionSize[2]));
+
+			std::vector<rttb::GenericValueType> values(outputRegionForThread.GetNumberOfPixels());
+			m_Accessor->getValuesInRegion(regionStart, size, values.data());
+
+			auto valueItr = values.cbegin();
+
 			while (!(outputItr.IsAtEnd()))
 			{
-				ImageRegionConstIteratorType::IndexType index = inputItr.GetIndex();
-				rttb::VoxelGridIndex3D doseIndex(index[0], index[1], index[2]);
-
-				outputItr.Set(m_Accessor->getValueAt(doseIndex));
+				outputItr.Set(*valueItr);
 
 				++outputItr;
-				++inputItr;
+				++valueItr;
 
 				//progress.CompletedPixel();
 			}
@@ -0,0 +1,137 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+#include <boost/make_shared.hpp>
+
+#include "itkImportImageContainer.h"
+
+#include "rttbITKDenseDoseAccessorConversion.h"
+#include "rttbGeometricInfo.h"
+
+namespace rttb
+{
+	namespace io
+	{
+		namespace itk
+		{
+			namespace
+			{
+				using ImageType = ITKImageAccessor::ITKImageType;
+
+				/*! @brief pixel container that does not own its memory but keeps the owner of the memory alive.*/
+				class SharedBufferPixelContainer : public ImageType::PixelContainer
+				{
+				public:
+					using Self = SharedBufferPixelContainer;
+					using Superclass = ImageType::PixelContainer;
+					using Pointer = ::itk::SmartPointer<Self>;
+					using ConstPointer = ::itk::SmartPointer<const Self>;
+
+					itkNewMacro(Self);
+					itkTypeMacro(SharedBufferPixelContainer, ImportImageContainer);
+
+					void setBuffer(const core::DenseDoseAccessor::BufferPointer& buffer, ::itk::SizeValueType size)
+					{
+						_buffer = buffer;
+						//the memory is managed by _buffer, the image never writes to it (it is only handed out as const)
+						this->SetImportPointer(const_cast<GenericValueType*>(buffer.get()), size, false);
+					}
+
+				protected:
+					SharedBufferPixelContainer() = default;
+					~SharedBufferPixelContainer() override = default;
+
+				private:
+					core::DenseDoseAccessor::BufferPointer _buffer;
+				};
+			}
+
+			core::DenseDoseAccessor::Pointer convertToDenseDoseAccessor(const ITKImageAccessor& anAccessor)
+			{
+				ImageType::ConstPointer image = anAccessor.getITKImage();
+
+				if (image->GetBufferedRegion() != image->GetLargestPossibleRegion())
+				{
+					std::vector<GenericValueType> values(anAccessor.getGridSize());
+					anAccessor.getValues(0, anAccessor.getGridSize(), values.data());
+					return boost::make_shared<core::DenseDoseAccessor>(anAccessor.getGeometricInfo(), std::move(values),
+					        anAccessor.getUID());
+				}
+
+				//the deleter holds a reference to the image, so the buffer stays valid as long as it is used
+				const core::DenseDoseAccessor::BufferPointer buffer(image->GetBufferPointer(),
+				        [image](const GenericValueType*) {});
+				return boost::make_shared<core::DenseDoseAccessor>(anAccessor.getGeometricInfo(), buffer,
+				        anAccessor.getUID());
+			}
+
+			ITKImageAccessor::ITKImageType::ConstPointer convertToITKImage(const core::DenseDoseAccessor&
+			        aDenseAccessor)
+			{
+				const core::GeometricInfo& geoInfo = aDenseAccessor.getGeometricInfo();
+
+				ImageType::RegionType region;
+				ImageType::IndexType start;
+				ImageType::SizeType size;
+				ImageType::SpacingType spacing;
+				ImageType::PointType origin;
+
+				for (unsigned int i = 0; i < 3; ++i)
+				{
+					start[i] = 0;
+					spacing[i] = geoInfo.getSpacing()[i];
+					origin[i] = geoInfo.getImagePositionPatient()[i];
+				}
+
+				size[0] = geoInfo.getNumColumns();
+				size[1] = geoInfo.getNumRows();
+				size[2] = geoInfo.getNumSlices();
+
+				ImageType::DirectionType direction;
+				OrientationMatrix OM = geoInfo.getOrientationMatrix();
+
+				for (unsigned int col = 0; col < 3; ++col)
+				{
+					for (unsigned int row = 0; row < 3; ++row)
+					{
+						direction(col, row) = OM(col, row);
+					}
+				}
+
+				region.SetSize(size);
+				region.SetIndex(start);
+
+				SharedBufferPixelContainer::Pointer pixelContainer = SharedBufferPixelContainer::New();
+				pixelContainer->setBuffer(aDenseAccessor.getBuffer(), geoInfo.getNumberOfVoxels());
+
+				ImageType::Pointer image = ImageType::New();
+				image->SetRegions(region);
+				image->SetSpacing(spacing);
+				image->SetDirection(direction);
+				image->SetOrigin(origin);
+				image->SetPixelContainer(pixelContainer);
+
+				return image.GetPointer();
+			}
+
+			boost::shared_ptr<ITKImageAccessor> convertToITKImageAccessor(const core::DenseDoseAccessor&
+			        aDenseAccessor)
+			{
+				return boost::make_shared<ITKImageAccessor>(convertToITKImage(aDenseAccessor));
+			}
+
+		}//end namespace itk
+	}//end namespace io
+}//end namespace rttb
@@ -0,0 +1,57 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+#ifndef __ITK_DENSE_DOSE_ACCESSOR_CONVERSION_H
+#define __ITK_DENSE_DOSE_ACCESSOR_CONVERSION_H
+
+#include <boost/shared_ptr.hpp>
+
+#include "rttbDenseDoseAccessor.h"
+#include "rttbITKImageAccessor.h"
+
+#include "RTTBITKIOExports.h"
+
+namespace rttb
+{
+	namespace io
+	{
+		namespace itk
+		{
+			/*! @brief Creates a DenseDoseAccessor from an ITKImageAccessor.
+				@details The pixel type of ITKImageAccessor matches GenericValueType, thus the DenseDoseAccessor shares the
+				pixel buffer of the itk image (no copy) and keeps the image alive. If the buffered region of the image does
+				not cover the whole image, the values are copied.
+			*/
+			RTTBITKIO_EXPORT core::DenseDoseAccessor::Pointer convertToDenseDoseAccessor(const ITKImageAccessor&
+			        anAccessor);
+
+			/*! @brief Creates an itk image that uses the buffer of aDenseAccessor as pixel container (no copy).
+				@details The image keeps the buffer alive. It is returned as const image because the buffer of a
+				DenseDoseAccessor must not be modified.
+			*/
+			RTTBITKIO_EXPORT ITKImageAccessor::ITKImageType::ConstPointer convertToITKImage(const core::DenseDoseAccessor&
+			        aDenseAccessor);
+
+			/*! @brief Creates an ITKImageAccessor that shares the buffer of aDenseAccessor (no copy).
+				@sa convertToITKImage
+			*/
+			RTTBITKIO_EXPORT boost::shared_ptr<ITKImageAccessor> convertToITKImageAccessor(const core::DenseDoseAccessor&
+			        aDenseAccessor);
+
+		}//end namespace itk
+	}//end namespace io
+}//end namespace rttb
+
+#endif
@@ -13,11 +13,13 @@
 //
 //------------------------------------------------------------------------
 
+#include <algorithm>
 #include <cassert>
 
 #include "rttbITKImageAccessor.h"
 #include "rttbException.h"
 #include "rttbInvalidDoseException.h"
+#include "rttbIndexOutOfBoundsException.h"
 
 namespace rttb
 {
@@ -68,6 +70,25 @@ namespace rttb
 
 			}
 
+			void ITKImageAccessor::getValues(const VoxelGridID aFirstID, const GridSizeType aNumberOfValues,
+			                                 GenericValueType* values) const
+			{
+				if (_data->GetBufferedRegion() != _data->GetLargestPossibleRegion())
+				{
+					//buffer does not cover the whole grid, IDs do not map to buffer offsets
+					core::AccessorWithGeoInfoBase::getValues(aFirstID, aNumberOfValues, values);
+					return;
+				}
+
+				if (aFirstID < 0 || aNumberOfValues < 0 || aFirstID + aNumberOfValues > getGridSize())
+				{
+					throw core::IndexOutOfBoundsException("Requested voxel ID range is not inside the grid!");
+				}
+
+				const GenericValueType* buffer = _data->GetBufferPointer() + aFirstID;
+				std::copy(buffer, buffer + aNumberOfValues, values);
+			}
+
 			void ITKImageAccessor::assembleGeometricInfo()
 			{
 				_geoInfo.setSpacing(SpacingVectorType3D(_data->GetSpacing()[0], _data->GetSpacing()[1],
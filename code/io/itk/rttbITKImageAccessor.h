@@ -71,6 +71,18 @@ namespace rttb
 				*/
 				GenericValueType getValueAt(const VoxelGridIndex3D& aIndex) const override;
 
+				/*! @brief copies the values directly from the pixel buffer of the itk image.
+				@exception IndexOutOfBoundsException if the ID range is not completely inside the grid.
+				*/
+				void getValues(VoxelGridID aFirstID, GridSizeType aNumberOfValues, GenericValueType* values) const override;
+
+				/*! @brief returns the wrapped itk image
+				*/
+				ITKImageType::ConstPointer getITKImage() const
+				{
+					return _data;
+				};
+
 				const IDType getUID() const override
 				{
 					return _UID;
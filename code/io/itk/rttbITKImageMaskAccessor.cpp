@@ -13,6 +13,8 @@
 //
 //------------------------------------------------------------------------
 
+#include <iostream>
+
 #include <boost/make_shared.hpp>
 #include <boost/shared_ptr.hpp>
 
@@ -26,6 +28,21 @@ namespace rttb
 	{
 		namespace itk
 		{
+			namespace
+			{
+				/*! @brief checks that a mask pixel value is a volume fraction (>=0 and <=1), reports invalid values.*/
+				bool isValidMaskValue(const DoseTypeGy value)
+				{
+					if (value >= 0 && value <= 1)
+					{
+						return true;
+					}
+
+					std::cerr << "The pixel value of the mask should be >=0 and <=1!" << std::endl;
+					return false;
+				}
+			}
+
 			ITKImageMaskAccessor::ITKImageMaskAccessor(ITKMaskImageType::ConstPointer aMaskImage)
 				: _mask(aMaskImage)
 			{
@@ -101,15 +118,33 @@ namespace rttb
 				unsigned int size =  _geoInfo->getNumColumns() * _geoInfo->getNumRows() * _geoInfo->getNumSlices();
 				filteredVoxelVectorPointer->reserve(size);
 
-				for (unsigned int gridIndex = 0 ; gridIndex < size; gridIndex++)
+				if (_mask->GetBufferedRegion() == _mask->GetLargestPossibleRegion())
 				{
-					core::MaskVoxel currentVoxel = core::MaskVoxel(gridIndex);
+					//voxel IDs are offsets into the pixel buffer, so read it directly
+					const DoseTypeGy* buffer = _mask->GetBufferPointer();
 
-					if (getMaskAt(gridIndex, currentVoxel))
+					for (unsigned int gridIndex = 0 ; gridIndex < size; gridIndex++)
 					{
-						if (currentVoxel.getRelevantVolumeFraction() > lowerThreshold)
+						const DoseTypeGy value = buffer[gridIndex];
+
+						if (isValidMaskValue(value) && value > lowerThreshold)
 						{
-							filteredVoxelVectorPointer->push_back(currentVoxel);
+							filteredVoxelVectorPointer->emplace_back(gridIndex, value);
+						}
+					}
+				}
+				else
+				{
+					for (unsigned int gridIndex = 0 ; gridIndex < size; gridIndex++)
+					{
+						core::MaskVoxel currentVoxel = core::MaskVoxel(gridIndex);
+
+						if (getMaskAt(gridIndex, currentVoxel))
+						{
+							if (currentVoxel.getRelevantVolumeFraction() > lowerThreshold)
+							{
+								filteredVoxelVectorPointer->push_back(currentVoxel);
+							}
 						}
 					}
 				}
@@ -139,18 +174,15 @@ namespace rttb
 				if (_geoInfo->validIndex(aIndex))
 				{
 					const ITKMaskImageType::IndexType pixelIndex = {{aIndex[0], aIndex[1], aIndex[2]}};
-					double value = _mask->GetPixel(pixelIndex);
-					VoxelGridID gridId;
-					_geoInfo->convert(aIndex, gridId);
+					const DoseTypeGy value = _mask->GetPixel(pixelIndex);
 
-					if (value >= 0 && value <= 1)
+					if (isValidMaskValue(value))
 					{
 						voxel.setRelevantVolumeFraction(value);
 						return true;
 					}
 					else
 					{
-						std::cerr << "The pixel value of the mask should be >=0 and <=1!" << std::endl;
 						return false;
 					}
 				}
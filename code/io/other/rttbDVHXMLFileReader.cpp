@@ -13,6 +13,8 @@
 //
 //------------------------------------------------------------------------
 
+#include <utility>
+
 #include <boost/shared_ptr.hpp>
 #include <boost/make_shared.hpp>
 #include <boost/property_tree/ptree.hpp>
@@ -62,7 +64,7 @@ namespace rttb
 
 
 				std::string dvhType;
-				std::deque<DoseTypeGy> dataDifferential, dataCumulative;
+				core::DVH::DataDifferentialType dataDifferential, dataCumulative;
 
 				DoseTypeGy deltaD = 0;
 				DoseVoxelVolumeType deltaV = 0;
@@ -112,7 +114,7 @@ namespace rttb
 				if (dvhType == "CUMULATIVE") //dataDifferential should be calculated
 				{
 					DoseCalcType differentialDVHi = 0;
-					std::deque<DoseCalcType>::iterator it;
+					core::DVH::DataDifferentialType::const_iterator it;
 
 					for (it = dataCumulative.begin(); it != dataCumulative.end(); ++it)
 					{
@@ -129,7 +131,7 @@ namespace rttb
 					}
 				}
 
-				_dvh = boost::make_shared<core::DVH>(dataDifferential, deltaD, deltaV, strID, doseID);
+				_dvh = boost::make_shared<core::DVH>(std::move(dataDifferential), deltaD, deltaV, strID, doseID);
 				_resetFile = false;
 			}
 
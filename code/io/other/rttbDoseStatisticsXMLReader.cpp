@@ -87,6 +87,7 @@ namespace rttb
                 double numVoxels=-1;
                 double volume=-1;
                 double referenceDose = -1;
+                double relativeErrorBound = 0;
                 double mean=-1;
                 double stdDeviation=-1;
                 boost::shared_ptr<std::vector<std::pair<double, int> > > minimumVoxelPositions = nullptr;
@@ -149,6 +150,10 @@ namespace rttb
                         referenceDose = boost::lexical_cast<double>(datum);
 						Vx.setReferenceDose(referenceDose);
                     }
+                    else if (name == "relativeErrorBound")
+                    {
+                        relativeErrorBound = boost::lexical_cast<double>(datum);
+                    }
                     else if (name == "mean")
                     {
                         mean = boost::lexical_cast<double>(datum);
@@ -207,6 +212,7 @@ namespace rttb
                 _doseStatistic = boost::make_shared<rttb::algorithms::DoseStatistics>(
                     minimum, maximum, mean, stdDeviation, numVoxels, volume, minimumVoxelPositions,
                     maximumVoxelPositions , Dx, Vx, MOHx, MOCx, MaxOHx, MinOCx, referenceDose);
+                _doseStatistic->setRelativeErrorBound(relativeErrorBound);
             }
         }//end namespace other
     }//end namespace io
@@ -58,6 +58,14 @@ namespace rttb
 					"referenceDose");
 				pt.add_child(statisticsTag + "." + propertyTag, referenceNode);
 
+				//only approximated statistics carry their error bound
+				if (aDoseStatistics->getRelativeErrorBound() > 0)
+				{
+					ptree errorBoundNode = createNodeWithNameAttribute(aDoseStatistics->getRelativeErrorBound(),
+						"relativeErrorBound");
+					pt.add_child(statisticsTag + "." + propertyTag, errorBoundNode);
+				}
+
 				ptree minimumNode = createNodeWithNameAttribute(static_cast<float>(aDoseStatistics->getMinimum()),
 				                    "minimum");
 
@@ -4,6 +4,9 @@ SET(CPP_FILES
 	rttbBoostMaskAccessor.cpp
 	rttbBoostMaskGenerateMaskVoxelListThread.cpp	
 	rttbBoostMaskVoxelizationThread.cpp
+	rttbBoostMaskScanlineRasterizer.cpp
+	rttbBoostMaskBoundaryClassifier.cpp
+	rttbStructureSetVoxelizer.cpp
 )
 
 SET(H_FILES
@@ -12,4 +15,7 @@ SET(H_FILES
 	rttbBoostMaskAccessor.h
 	rttbBoostMaskGenerateMaskVoxelListThread.h
 	rttbBoostMaskVoxelizationThread.h
+	rttbBoostMaskScanlineRasterizer.h
+	rttbBoostMaskBoundaryClassifier.h
+	rttbStructureSetVoxelizer.h
 )
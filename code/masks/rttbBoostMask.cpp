@@ -13,8 +13,11 @@
 //
 //------------------------------------------------------------------------
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <functional>
 #include <limits>
-#include <thread>
 
 #include <boost/geometry/geometries/register/point.hpp>
 #include <boost/geometry/geometries/register/ring.hpp>
@@ -23,6 +26,7 @@
 #include "rttbBoostMask.h"
 #include "rttbNullPointerException.h"
 #include "rttbInvalidParameterException.h"
+#include "rttbThreadPool.h"
 #include "rttbBoostMaskGenerateMaskVoxelListThread.h"
 #include "rttbBoostMaskVoxelizationThread.h"
 
@@ -32,12 +36,54 @@ namespace rttb
 	{
 		namespace boost
 		{
+			namespace
+			{
+				/*! @brief Calls aFunction for every index in [0, numberOfItems) on core::ThreadPool::getDefault().
+					@details At most numberOfThreads tasks (0: as many as the pool has workers) run at the same time, one of
+					them in the calling thread. Each task takes the next index as soon as it is finished, so a few expensive
+					items do not keep the other threads waiting.
+					@exception rethrows the first exception of aFunction; the items that are not started yet are skipped.
+				*/
+				void forEachIndexConcurrently(std::size_t numberOfItems, unsigned int numberOfThreads,
+				                              const std::function<void(std::size_t)>& aFunction)
+				{
+					core::ThreadPool& pool = core::ThreadPool::getDefault();
+					const std::size_t numberOfTasks = std::min<std::size_t>(numberOfItems,
+					                                  numberOfThreads == 0 ? pool.getNumberOfThreads() : numberOfThreads);
+					std::atomic<std::size_t> nextIndex(0);
 
+					auto task = [&]()
+					{
+						for (std::size_t i = nextIndex++; i < numberOfItems; i = nextIndex++)
+						{
+							try
+							{
+								aFunction(i);
+							}
+							catch (...)
+							{
+								nextIndex = numberOfItems;
+								throw;
+							}
+						}
+					};
+
+					core::ThreadPool::TaskGroup tasks(pool);
+
+					for (std::size_t i = 1; i < numberOfTasks; ++i)
+					{
+						tasks.run(task);
+					}
+
+					task();
+					tasks.wait();
+				}
+			}
 
 			BoostMask::BoostMask(core::GeometricInfo::Pointer aDoseGeoInfo,
-        core::Structure::Pointer aStructure, bool strict, unsigned int numberOfThreads)
+        core::Structure::Pointer aStructure, bool strict, unsigned int numberOfThreads, VoxelizationEngine engine)
 				: _geometricInfo(aDoseGeoInfo), _structure(aStructure),
-                _strict(strict), _numberOfThreads(numberOfThreads), _voxelizationThickness(0.0),
+                _strict(strict), _engine(engine), _numberOfThreads(numberOfThreads), _voxelizationThickness(0.0),
 				  _voxelInStructure(::boost::make_shared<MaskVoxelList>())
 			{
 
@@ -52,15 +98,6 @@ namespace rttb
 					throw rttb::core::NullPointerException("Error: Structure is nullptr!");
 				}
 
-				if (_numberOfThreads == 0)
-				{
-					_numberOfThreads = std::thread::hardware_concurrency();
-                    if (_numberOfThreads == 0)
-                    {
-                        throw rttb::core::InvalidParameterException("Error: detection of the number of hardware threads is not possible. Please specify number of threads for voxelization explicitly as parameter in BoostMask.");
-                    }
-				}
-
 			}
 
 			BoostMask::MaskVoxelListPointer BoostMask::getRelevantVoxelVector()
@@ -83,19 +120,21 @@ namespace rttb
 
 			void BoostMask::preprocessing()
 			{
-				rttb::PolygonSequenceType polygonSequence = _structure->getStructureVector();
+				const rttb::PolygonSequenceType& polygonSequence = _structure->getStructureVector();
 
 				//Convert world coordinate polygons to the polygons with geometry coordinate
 				rttb::PolygonSequenceType geometryCoordinatePolygonVector;
-				rttb::PolygonSequenceType::iterator it;
-				rttb::ContinuousVoxelGridIndex3D globalMaxGridIndex(std::numeric_limits<double>::min(),
-				        std::numeric_limits<double>::min(), std::numeric_limits<double>::min());
-				rttb::ContinuousVoxelGridIndex3D globalMinGridIndex(_geometricInfo->getNumColumns(),
-				        _geometricInfo->getNumRows(), 0);
+				rttb::PolygonSequenceType::const_iterator it;
+				rttb::ContinuousVoxelGridIndex3D globalMaxGridIndex(std::numeric_limits<double>::lowest(),
+				        std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest());
+				rttb::ContinuousVoxelGridIndex3D globalMinGridIndex(std::numeric_limits<double>::max(),
+				        std::numeric_limits<double>::max(), std::numeric_limits<double>::max());
+
+				geometryCoordinatePolygonVector.reserve(polygonSequence.size());
 
 				for (it = polygonSequence.begin(); it != polygonSequence.end(); ++it)
 				{
-					PolygonType rttbPolygon = *it;
+					const PolygonType& rttbPolygon = *it;
 					PolygonType geometryCoordinatePolygon;
 
 					//1. convert polygon to geometry coordinate polygons
@@ -110,10 +149,18 @@ namespace rttb
 					geometryCoordinatePolygonVector.push_back(geometryCoordinatePolygon);
 				}
 
-				rttb::VoxelGridIndex3D minIndex = VoxelGridIndex3D(GridIndexType(globalMinGridIndex(0) ),
-				                                  GridIndexType(globalMinGridIndex(1) ), GridIndexType(globalMinGridIndex(2) ));
-				rttb::VoxelGridIndex3D maxIndex = VoxelGridIndex3D(GridIndexType(globalMaxGridIndex(0) ),
-				                                  GridIndexType(globalMaxGridIndex(1) ), GridIndexType(globalMaxGridIndex(2) ));
+				//the voxel x covers [x-0.5, x+0.5], so the continuous indices are rounded: truncating them would drop the
+				//partially covered voxel of a contour that ends in the upper half of a voxel. The bounding box is limited to the dose grid
+				const double gridMax[3] = {_geometricInfo->getNumColumns() - 1.0, _geometricInfo->getNumRows() - 1.0,
+				                           _geometricInfo->getNumSlices() - 1.0};
+				rttb::VoxelGridIndex3D minIndex;
+				rttb::VoxelGridIndex3D maxIndex;
+
+				for (unsigned int i = 0; i < 3; ++i)
+				{
+					minIndex[i] = GridIndexType(std::min(std::max(std::floor(globalMinGridIndex(i) + 0.5), 0.0), gridMax[i]));
+					maxIndex[i] = GridIndexType(std::min(std::max(std::floor(globalMaxGridIndex(i) + 0.5), 0.0), gridMax[i]));
+				}
 
 				_globalBoundingBox.push_back(minIndex);
 				_globalBoundingBox.push_back(maxIndex);
@@ -131,57 +178,30 @@ namespace rttb
 					throw rttb::core::InvalidParameterException("Bounding box calculation failed! ");
 				}
 
-				BoostRingMap::iterator itMap;
-
-				size_t mapSizeInAThread = _ringMap.size() / _numberOfThreads;
-				unsigned int count = 0;
-				unsigned int countThread = 0;
-				BoostPolygonMap polygonMap;
-				std::vector<BoostPolygonMap> polygonMapVector;
+				std::vector<BoostRingMap::const_iterator> planes;
+				planes.reserve(_ringMap.size());
 
-				//check donut and convert to a map of z index and a vector of boost polygon 2d (with or without holes)
-				for (itMap = _ringMap.begin(); itMap != _ringMap.end(); ++itMap)
+				for (auto itMap = _ringMap.cbegin(); itMap != _ringMap.cend(); ++itMap)
 				{
-					//the vector of all boost 2d polygons with the same z grid index(donut polygon is accepted).
-					BoostPolygonVector polygonVector = checkDonutAndConvert((*itMap).second);
-
-					if (count == mapSizeInAThread && countThread < (_numberOfThreads - 1))
-					{
-						polygonMapVector.push_back(polygonMap);
-						polygonMap.clear();
-						count = 0;
-						countThread++;
-					}
-
-					polygonMap.insert(std::pair<double, BoostPolygonVector>((*itMap).first,
-					                  polygonVector));
-					count++;
-
+					planes.push_back(itMap);
 				}
 
-                _voxelizationMap = ::boost::make_shared<std::map<double, BoostArray2DPointer> >();
-
-				polygonMapVector.push_back(polygonMap); //insert the last one
+				//every plane is a task that writes to its own slot, so no lock is needed
+				std::vector<BoostArray2DPointer> planeArrays(planes.size());
+				const BoostMaskVoxelizationThread voxelizePlane(_globalBoundingBox, _strict, _engine);
 
-				//generate voxelization map, multi-threading
-				std::vector<std::thread> threads;
+				forEachIndexConcurrently(planes.size(), _numberOfThreads, [&](std::size_t i)
+				{
+					//check donut and convert to a vector of boost polygon 2d (with or without holes)
+					planeArrays[i] = voxelizePlane(checkDonutAndConvert(planes[i]->second));
+				});
 
-        auto aMutex = ::boost::make_shared<std::mutex>();
+				_voxelizationMap = ::boost::make_shared<std::map<double, BoostArray2DPointer> >();
 
-				for (const auto & i : polygonMapVector)
+				for (std::size_t i = 0; i < planes.size(); ++i)
 				{
-          BoostMaskVoxelizationThread t(i, _globalBoundingBox,
-            _voxelizationMap, aMutex, _strict);
-					threads.emplace_back(t);
+					_voxelizationMap->emplace_hint(_voxelizationMap->end(), planes[i]->first, planeArrays[i]);
 				}
-
-        for (auto& thread : threads)
-        {
-          if (thread.joinable())
-          {
-            thread.join();
-          }
-        }
 			}
 
 			void BoostMask::generateMaskVoxelList()
@@ -197,45 +217,46 @@ namespace rttb
 					throw rttb::core::InvalidParameterException("Error: The contour plane should be homogeneous!");
 				}
 
+				if (_voxelizationMap->empty())
+				{
+					return;
+				}
 
+				//only the slices overlapped by the voxelization planes are processed
+				const double firstPlaneMin = _voxelizationMap->cbegin()->first - 0.5 * _voxelizationThickness;
+				const double lastPlaneMax = _voxelizationMap->crbegin()->first + 0.5 * _voxelizationThickness;
+				const auto firstSlice = static_cast<unsigned int>(std::max(std::floor(firstPlaneMin + 0.5), 0.0));
+				const auto lastSlice = static_cast<unsigned int>(std::min(std::max(std::floor(lastPlaneMax + 0.5), 0.0),
+				                       _geometricInfo->getNumSlices() - 1.0));
 
-        std::vector<std::thread> threads;
-        auto aMutex = ::boost::make_shared<std::mutex>();
-
-				unsigned int sliceNumberInAThread = _geometricInfo->getNumSlices() / _numberOfThreads;
-
-				//generate mask voxel list, multi-threading
-				for (unsigned int i = 0; i < _numberOfThreads; ++i)
+				if (firstSlice > lastSlice)
 				{
-					unsigned int beginSlice = i * sliceNumberInAThread;
-					unsigned int endSlice;
-
-					if (i < _numberOfThreads - 1)
-					{
-						endSlice = (i + 1) * sliceNumberInAThread;
-					}
-					else
-					{
-						endSlice = _geometricInfo->getNumSlices();
-					}
+					return;
+				}
 
+				//every slice is a task with its own voxel list, the lists are concatenated in slice order
+				std::vector<MaskVoxelList> sliceVoxelLists(lastSlice - firstSlice + 1);
+				const BoostMaskGenerateMaskVoxelListThread generateSlice(_geometricInfo, _voxelizationMap,
+				        _voxelizationThickness, _strict);
 
-					BoostMaskGenerateMaskVoxelListThread t(_globalBoundingBox, _geometricInfo, _voxelizationMap,
-					                                       _voxelizationThickness, beginSlice, endSlice,
-					                                       _voxelInStructure, _strict, aMutex);
+				forEachIndexConcurrently(sliceVoxelLists.size(), _numberOfThreads, [&](std::size_t i)
+				{
+					generateSlice(firstSlice + static_cast<unsigned int>(i), sliceVoxelLists[i]);
+				});
 
-          threads.emplace_back(t);
+				std::size_t numberOfVoxels = _voxelInStructure->size();
 
+				for (const auto& sliceVoxelList : sliceVoxelLists)
+				{
+					numberOfVoxels += sliceVoxelList.size();
 				}
 
-        for (auto& thread : threads)
-        {
-          if (thread.joinable())
-          {
-            thread.join();
-          }
-        }
+				_voxelInStructure->reserve(numberOfVoxels);
 
+				for (const auto& sliceVoxelList : sliceVoxelLists)
+				{
+					_voxelInStructure->insert(_voxelInStructure->end(), sliceVoxelList.begin(), sliceVoxelList.end());
+				}
 			}
 
 			bool BoostMask::preprocessingPolygon(const rttb::PolygonType& aRTTBPolygon,
@@ -246,11 +267,12 @@ namespace rttb
 				double minZ = _geometricInfo->getNumSlices();
 				double maxZ =  0.0;
 
-				for (auto worldCoordinatePoint : aRTTBPolygon)
+				geometryCoordinatePolygon.reserve(geometryCoordinatePolygon.size() + aRTTBPolygon.size());
+
+				for (const auto& worldCoordinatePoint : aRTTBPolygon)
 				{
 						//convert to geometry coordinate polygon
-					rttb::ContinuousVoxelGridIndex3D geometryCoordinatePoint;
-					_geometricInfo->worldCoordinateToContinuousIndex(worldCoordinatePoint, geometryCoordinatePoint);
+					const rttb::ContinuousVoxelGridIndex3D geometryCoordinatePoint = _geometricInfo->worldCoordinateToContinuousIndex(worldCoordinatePoint);
 
 					geometryCoordinatePolygon.push_back(geometryCoordinatePoint);
 
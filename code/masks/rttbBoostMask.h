@@ -49,16 +49,36 @@ namespace rttb
 				using MaskVoxelList = core::MaskAccessorInterface::MaskVoxelList;
 				using MaskVoxelListPointer = core::MaskAccessorInterface::MaskVoxelListPointer;
 
+				/*! @brief Algorithm that computes the voxelization planes.
+				*	@details BoostGeometry: intersection of every voxel of the bounding box with every polygon of the plane
+				*	(boost::geometry::intersection).
+				*	Scanline: exact area coverage with an edge based scanline rasterizer (see BoostMaskScanlineRasterizer).
+				*	BoostGeometryBoundary: voxels completely inside or outside of the contours are classified by a winding
+				*	test, only the voxels on the contours are intersected with boost::geometry (see BoostMaskBoundaryClassifier).
+				*	For valid contours the results agree up to floating point rounding; the cost of Scanline and
+				*	BoostGeometryBoundary grows with the perimeter of the contours and the size of the bounding box instead of
+				*	their product.
+				*	BoostGeometry is the default; the other engines are opt-in (see BoostMaskEngineComparisonTest).
+				*/
+				enum class VoxelizationEngine
+				{
+					BoostGeometry, Scanline, BoostGeometryBoundary
+				};
+
 				/*! @brief Constructor
 				* @exception rttb::core::NullPointerException thrown if aDoseGeoInfo or aStructure is nullptr
                 * @param aDoseGeoInfo the GeometricInfo
                 * @param aStructure the structure set
 				* @param strict indicates whether to allow self intersection in the structure. If it is set to true, an exception will be thrown when the given structure has self intersection.
-				* @param numberOfThreads number of threads used for voxelization. default value 0 means automatic detection, using the number of Hardware thread/cores
+				* @param numberOfThreads maximum number of threads used for voxelization. The voxelization planes and the mask slices are distributed
+				* as tasks to core::ThreadPool::getDefault(), which is shared by all masks. Default value 0 means one thread per worker of the pool
+				* (the number of hardware threads/cores); 1 computes the mask in the calling thread.
+				* @param engine the algorithm that computes the voxelization planes
 				* @exception InvalidParameterException thrown if strict is true and the structure has self intersections
 				*/
 				BoostMask(core::GeometricInfo::Pointer aDoseGeoInfo, core::Structure::Pointer aStructure,
-				          bool strict = true, unsigned int numberOfThreads = 0);
+				          bool strict = true, unsigned int numberOfThreads = 0,
+				          VoxelizationEngine engine = VoxelizationEngine::BoostGeometry);
 
 				/*! @brief Generate mask and return the voxels in the mask
 				* @exception rttb::core::InvalidParameterException thrown if the structure has self intersections
@@ -86,7 +106,9 @@ namespace rttb
 
         bool _strict;
 
-        /*! @brief The number of threads
+        VoxelizationEngine _engine;
+
+        /*! @brief The maximum number of threads, 0: one per worker of core::ThreadPool::getDefault()
         */
         unsigned int _numberOfThreads;
 
@@ -106,13 +128,15 @@ namespace rttb
 				/*! @brief The min and max index of the global bounding box.
 				*	@details The first index has the minimum for x/y/z of the global bounding box.
 				*	The second index has the maximum for x/y/z of the global bounding index.
+				*	The bounding box contains all voxels touched by the contours and is limited to the dose grid. A contour
+				*	ending in the upper half of a voxel includes this voxel (the continuous index is rounded, not truncated).
 				*/
 				VoxelIndexVector _globalBoundingBox;
 
 				/*! @brief The voxelization map
 				*	@details key: the converted double z grid index of a contour plane
-				*	value: the 2d mask, array[i][j] = the mask value of the position (i,j) in the global bounding box,
-				*			i: 0 - (_globalBoundingBoxSize0-1), j: 0 - (_globalBoundingBoxSize1-1)
+				*	value: the 2d mask, array[i][j] = the mask value of the voxel (i,j). The array only covers the bounding box
+				*			of the contours of the plane: its index bases are the grid index of the first voxel of this box.
 				*/
                 BoostArrayMapPointer _voxelizationMap;
 
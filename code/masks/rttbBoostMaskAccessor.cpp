@@ -16,6 +16,9 @@
 #include "rttbBoostMaskAccessor.h"
 #include "rttbBoostMask.h"
 
+#include <algorithm>
+#include <limits>
+
 #include <boost/make_shared.hpp>
 
 #include <boost/uuid/uuid.hpp>
@@ -28,10 +31,13 @@ namespace rttb
 	{
 		namespace boost
 		{
+			const BoostMaskAccessor::LookupPositionType BoostMaskAccessor::_noVoxel =
+			    std::numeric_limits<BoostMaskAccessor::LookupPositionType>::max();
 
 			BoostMaskAccessor::BoostMaskAccessor(StructTypePointer aStructurePointer,
-			                                     const core::GeometricInfo& aGeometricInfo, bool strict)
-				: _spStructure(aStructurePointer), _geoInfo(aGeometricInfo), _strict(strict)
+			                                     const core::GeometricInfo& aGeometricInfo, bool strict,
+			                                     BoostMask::VoxelizationEngine engine)
+				: _spStructure(aStructurePointer), _geoInfo(aGeometricInfo), _strict(strict), _engine(engine)
 			{
 				_spRelevantVoxelVector = MaskVoxelListPointer();
 
@@ -58,9 +64,80 @@ namespace rttb
 				}
 
 				BoostMask mask(::boost::make_shared<core::GeometricInfo>(_geoInfo),
-				               _spStructure, _strict);
+				               _spStructure, _strict, 0, _engine);
 
 				_spRelevantVoxelVector = mask.getRelevantVoxelVector();
+				buildLookup();
+			}
+
+			void BoostMaskAccessor::buildLookup()
+			{
+				_lookup.clear();
+				_denseLookup = false;
+
+				const MaskVoxelList& voxels = *_spRelevantVoxelVector;
+
+				if (voxels.empty())
+				{
+					return;
+				}
+
+				//bounding box of the mask
+				VoxelGridIndex3D minIndex(std::numeric_limits<GridIndexType>::max());
+				VoxelGridIndex3D maxIndex(0);
+				VoxelGridIndex3D index;
+
+				for (const auto& voxel : voxels)
+				{
+					_geoInfo.convert(voxel.getVoxelGridID(), index);
+
+					for (unsigned int i = 0; i < 3; ++i)
+					{
+						minIndex(i) = std::min(minIndex(i), index(i));
+						maxIndex(i) = std::max(maxIndex(i), index(i));
+					}
+				}
+
+				const GridSizeType sizeX = maxIndex.x() - minIndex.x() + 1;
+				const GridSizeType sizeY = maxIndex.y() - minIndex.y() + 1;
+				const GridSizeType sizeZ = maxIndex.z() - minIndex.z() + 1;
+				const GridSizeType boundingBoxVolume = sizeX * sizeY * sizeZ;
+
+				if (boundingBoxVolume <= 8 * static_cast<GridSizeType>(voxels.size()))
+				{
+					_denseLookup = true;
+					_lookupOrigin = minIndex;
+					_lookupSize = VoxelGridIndex3D(static_cast<GridIndexType>(sizeX), static_cast<GridIndexType>(sizeY),
+					                               static_cast<GridIndexType>(sizeZ));
+					_lookup.assign(boundingBoxVolume, _noVoxel);
+
+					for (LookupPositionType pos = 0; pos < voxels.size(); ++pos)
+					{
+						_geoInfo.convert(voxels[pos].getVoxelGridID(), index);
+						LookupPositionType& entry = _lookup[(index.x() - minIndex.x()) + sizeX * ((index.y() - minIndex.y()) + sizeY *
+						                                    (index.z() - minIndex.z()))];
+
+						//keep the first occurrence, like a linear search would
+						if (entry == _noVoxel)
+						{
+							entry = pos;
+						}
+					}
+				}
+				else
+				{
+					_lookup.resize(voxels.size());
+
+					for (LookupPositionType pos = 0; pos < voxels.size(); ++pos)
+					{
+						_lookup[pos] = pos;
+					}
+
+					std::stable_sort(_lookup.begin(), _lookup.end(), [&voxels](LookupPositionType a, LookupPositionType b)
+					{
+						return voxels[a].getVoxelGridID() < voxels[b].getVoxelGridID();
+					});
+				}
 			}
 
 			BoostMaskAccessor::MaskVoxelListPointer BoostMaskAccessor::getRelevantVoxelVector()
@@ -103,30 +180,61 @@ namespace rttb
 					return false;
 				}
 
+				// returns false if mask was not calculated without triggering calculation (otherwise not const!)
+				if (!_spRelevantVoxelVector || _lookup.empty())
+				{
+					return false;
+				}
+
 				//determine how a given voxel on the dose grid is masked
-				if (_spRelevantVoxelVector)
+				const MaskVoxelList& voxels = *_spRelevantVoxelVector;
+
+				if (_denseLookup)
 				{
-					auto it = _spRelevantVoxelVector->begin();
+					VoxelGridIndex3D index;
+					_geoInfo.convert(aID, index);
 
-					while (it != _spRelevantVoxelVector->end())
+					if (index.x() < _lookupOrigin.x() || index.y() < _lookupOrigin.y() || index.z() < _lookupOrigin.z())
 					{
-						if ((*it).getVoxelGridID() == aID)
-						{
-							voxel = (*it);
-							return true;
-						}
+						return false;
+					}
 
-						++it;
+					const GridIndexType x = index.x() - _lookupOrigin.x();
+					const GridIndexType y = index.y() - _lookupOrigin.y();
+					const GridIndexType z = index.z() - _lookupOrigin.z();
+
+					if (x >= _lookupSize.x() || y >= _lookupSize.y() || z >= _lookupSize.z())
+					{
+						return false;
 					}
 
+					const LookupPositionType pos = _lookup[x + static_cast<size_t>(_lookupSize.x()) * (y + static_cast<size_t>
+					                                       (_lookupSize.y()) * z)];
+
+					if (pos == _noVoxel)
+					{
+						return false;
+					}
+
+					voxel = voxels[pos];
+					return true;
 				}
-				// returns false if mask was not calculated without triggering calculation (otherwise not const!)
 				else
 				{
-					return false;
-				}
+					auto it = std::lower_bound(_lookup.cbegin(), _lookup.cend(), aID,
+					                           [&voxels](LookupPositionType pos, VoxelGridID id)
+					{
+						return voxels[pos].getVoxelGridID() < id;
+					});
 
-				return false;
+					if (it == _lookup.cend() || voxels[*it].getVoxelGridID() != aID)
+					{
+						return false;
+					}
+
+					voxel = voxels[*it];
+					return true;
+				}
 
 			}
 
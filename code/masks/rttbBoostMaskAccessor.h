@@ -16,10 +16,13 @@
 #ifndef __BOOST_MASK_R_ACCESSOR__H
 #define __BOOST_MASK_R_ACCESSOR__H
 
+#include <vector>
+
 #include "rttbBaseType.h"
 #include "rttbGeometricInfo.h"
 #include "rttbMaskAccessorInterface.h"
 #include "rttbStructure.h"
+#include "rttbBoostMask.h"
 
 #include "RTTBMaskExports.h"
 
@@ -49,12 +52,33 @@ namespace rttb
         StructTypePointer _spStructure;
 				core::GeometricInfo _geoInfo;
         bool _strict;
+				BoostMask::VoxelizationEngine _engine;
 
 				/*! vector containing list of mask voxels*/
 				MaskVoxelListPointer _spRelevantVoxelVector;
 
 				IDType _maskUID;
 
+				using LookupPositionType = unsigned int;
+
+				/*! marks grid voxels of the dense lookup that are not part of the mask*/
+				static const LookupPositionType _noVoxel;
+
+				/*! @brief true: _lookup is a dense grid over the bounding box of the mask, that stores for every voxel its
+					position in _spRelevantVoxelVector (or _noVoxel). false: _lookup holds the positions in
+					_spRelevantVoxelVector sorted by voxel grid ID (binary search).*/
+				bool _denseLookup = false;
+				std::vector<LookupPositionType> _lookup;
+				VoxelGridIndex3D _lookupOrigin;
+				VoxelGridIndex3D _lookupSize;
+
+				/*! @brief builds the lookup structure for getMaskAt() from _spRelevantVoxelVector.
+					The dense grid is used if the mask fills at least 1/8 of its bounding box, otherwise the sorted positions
+					are used. At this threshold the dense grid needs up to 8 entries (32 bytes) per mask voxel, i.e. up to 8
+					times the memory of the sorted positions (4 bytes per mask voxel) and about twice the memory of the
+					relevant voxel vector itself (16 bytes per MaskVoxel).*/
+				void buildLookup();
+
 			public:
 
 
@@ -62,10 +86,11 @@ namespace rttb
 				* @param aStructurePointer smart pointer of the structure
 				* @param aGeometricInfo smart pointer of the geometricInfo of the dose
 				* @param strict indicates whether to allow self intersection in the structure. If it is set to true, an exception will be thrown when the given structure has self intersection.
+				* @param engine the algorithm that computes the voxelization planes (see BoostMask::VoxelizationEngine)
 				* @exception InvalidParameterException thrown if strict is true and the structure has self intersections
 				*/
 				BoostMaskAccessor(StructTypePointer aStructurePointer, const core::GeometricInfo& aGeometricInfo,
-				                  bool strict = true);
+				                  bool strict = true, BoostMask::VoxelizationEngine engine = BoostMask::VoxelizationEngine::BoostGeometry);
 
 				/*! @brief destructor*/
 				~BoostMaskAccessor() override;
@@ -80,6 +105,7 @@ namespace rttb
 				MaskVoxelListPointer getRelevantVoxelVector(float lowerThreshold) override;
 
 				/*!@brief determine how a given voxel on the dose grid is masked
+				* @details O(1) (dense lookup) or O(log n) (sorted lookup) after updateMask(), see buildLookup().
 				* @param aID ID of the voxel in grid.
 				* @param voxel Reference to the voxel.
 				* @post after a valid call voxel containes the information of the specified grid voxel. If aID is not valid, voxel values are undefined.
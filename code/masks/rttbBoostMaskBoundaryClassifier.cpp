@@ -0,0 +1,238 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+#include "rttbBoostMaskBoundaryClassifier.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace rttb
+{
+	namespace masks
+	{
+		namespace boost
+		{
+			namespace
+			{
+				using BoostRing2D = BoostMaskBoundaryClassifier::BoostPolygon2D::ring_type;
+				/*! column position of a crossing of an edge with a row center line and the winding direction of the edge*/
+				using Crossing = std::pair<double, int>;
+
+				/*! @brief Region of the plane in pixel units: the pixel (i,j) of the region covers [i,i+1]x[j,j+1].*/
+				struct Region
+				{
+					double offsetR;
+					double offsetC;
+					long numberOfRows;
+					long numberOfColumns;
+				};
+
+				double calcSignedArea(const BoostRing2D& aRing)
+				{
+					double area = 0;
+					const std::size_t numberOfPoints = aRing.size();
+
+					for (std::size_t i = 0; i < numberOfPoints; ++i)
+					{
+						const auto& from = aRing[i];
+						const auto& to = aRing[(i + 1) % numberOfPoints];
+						area += from.x() * to.y() - to.x() * from.y();
+					}
+
+					return 0.5 * area;
+				}
+
+				long clampIndex(double aPosition, long aSize)
+				{
+					return std::max(0L, std::min(aSize - 1, static_cast<long>(std::floor(aPosition))));
+				}
+
+				/*! @brief Marks all pixels of the region touched by the edge (r0,c0)-(r1,c1).*/
+				void markEdge(double r0, double c0, double r1, double c1, const Region& aRegion,
+				              std::vector<char>& aBoundary)
+				{
+					if (r0 > r1)
+					{
+						std::swap(r0, r1);
+						std::swap(c0, c1);
+					}
+
+					if (r1 < 0 || r0 > aRegion.numberOfRows || std::max(c0, c1) < 0
+					    || std::min(c0, c1) > aRegion.numberOfColumns)
+					{
+						return;
+					}
+
+					const long firstRow = clampIndex(r0, aRegion.numberOfRows);
+					const long lastRow = clampIndex(r1, aRegion.numberOfRows);
+
+					for (long row = firstRow; row <= lastRow; ++row)
+					{
+						//column range of the part of the edge within the row
+						double cBegin = c0;
+						double cEnd = c1;
+
+						if (r1 > r0)
+						{
+							const double slope = (c1 - c0) / (r1 - r0);
+							cBegin = c0 + (std::max(r0, static_cast<double>(row)) - r0) * slope;
+							cEnd = c0 + (std::min(r1, static_cast<double>(row + 1)) - r0) * slope;
+						}
+
+						if (std::max(cBegin, cEnd) < 0 || std::min(cBegin, cEnd) > aRegion.numberOfColumns)
+						{
+							continue;
+						}
+
+						const long firstColumn = clampIndex(std::min(cBegin, cEnd), aRegion.numberOfColumns);
+						const long lastColumn = clampIndex(std::max(cBegin, cEnd), aRegion.numberOfColumns);
+						std::fill(aBoundary.begin() + row * aRegion.numberOfColumns + firstColumn,
+						          aBoundary.begin() + row * aRegion.numberOfColumns + lastColumn + 1, 1);
+					}
+				}
+
+				/*! @brief Adds the crossings of the edge (r0,c0)-(r1,c1) with the row center lines to aCrossings.
+				* @details The edge covers the half open interval [min(r0,r1), max(r0,r1)), so that a vertex on a center line
+				* is counted once.
+				*/
+				void addCrossings(double r0, double c0, double r1, double c1, int aSign, const Region& aRegion,
+				                  std::vector<std::vector<Crossing> >& aCrossings)
+				{
+					if (r0 == r1)
+					{
+						return;
+					}
+
+					const int direction = r1 > r0 ? aSign : -aSign;
+
+					if (r0 > r1)
+					{
+						std::swap(r0, r1);
+						std::swap(c0, c1);
+					}
+
+					//center line of row i at i+0.5
+					const long firstRow = std::max(0L, static_cast<long>(std::ceil(r0 - 0.5)));
+					const long endRow = std::min(aRegion.numberOfRows, static_cast<long>(std::ceil(r1 - 0.5)));
+					const double slope = (c1 - c0) / (r1 - r0);
+
+					for (long row = firstRow; row < endRow; ++row)
+					{
+						aCrossings[row].push_back(Crossing(c0 + (row + 0.5 - r0) * slope, direction));
+					}
+				}
+
+				void processRing(const BoostRing2D& aRing, int aSign, const Region& aRegion, std::vector<char>& aBoundary,
+				                 std::vector<std::vector<Crossing> >& aCrossings)
+				{
+					const std::size_t numberOfPoints = aRing.size();
+
+					for (std::size_t i = 0; i < numberOfPoints; ++i)
+					{
+						const auto& from = aRing[i];
+						const auto& to = aRing[(i + 1) % numberOfPoints];
+						const double r0 = from.x() - aRegion.offsetR;
+						const double c0 = from.y() - aRegion.offsetC;
+						const double r1 = to.x() - aRegion.offsetR;
+						const double c1 = to.y() - aRegion.offsetC;
+						markEdge(r0, c0, r1, c1, aRegion, aBoundary);
+						addCrossings(r0, c0, r1, c1, aSign, aRegion, aCrossings);
+					}
+				}
+			}
+
+			void BoostMaskBoundaryClassifier::classify(const BoostPolygonVector& aPolygonVector,
+			        const rttb::VoxelGridIndex3D& aMinIndex, BoostArray2D& aCoverage, PixelIndexVector& aBoundaryPixels)
+			{
+				std::fill(aCoverage.data(), aCoverage.data() + aCoverage.num_elements(), 0.0);
+				aBoundaryPixels.clear();
+
+				Region region;
+				region.offsetR = aMinIndex[0] - 0.5;
+				region.offsetC = aMinIndex[1] - 0.5;
+				region.numberOfRows = static_cast<long>(aCoverage.shape()[0]);
+				region.numberOfColumns = static_cast<long>(aCoverage.shape()[1]);
+
+				if (aCoverage.num_elements() == 0)
+				{
+					return;
+				}
+
+				std::vector<char> boundary(aCoverage.num_elements(), 0);
+				std::vector<std::vector<Crossing> > crossings(region.numberOfRows);
+
+				for (const auto& polygon : aPolygonVector)
+				{
+					for (auto& rowCrossings : crossings)
+					{
+						rowCrossings.clear();
+					}
+
+					//outer rings count positive, interior rings negative, independent of their orientation
+					processRing(polygon.outer(), calcSignedArea(polygon.outer()) < 0 ? -1 : 1, region, boundary, crossings);
+
+					for (const auto& inner : polygon.inners())
+					{
+						processRing(inner, calcSignedArea(inner) < 0 ? 1 : -1, region, boundary, crossings);
+					}
+
+					//sweep along the row center lines: pixels with a winding number other than 0 are inside of the polygon
+					for (long row = 0; row < region.numberOfRows; ++row)
+					{
+						auto& rowCrossings = crossings[row];
+
+						if (rowCrossings.empty())
+						{
+							continue;
+						}
+
+						std::sort(rowCrossings.begin(), rowCrossings.end());
+						double* rowData = aCoverage.data() + row * region.numberOfColumns;
+						auto crossing = rowCrossings.cbegin();
+						int winding = 0;
+
+						for (long column = 0; column < region.numberOfColumns; ++column)
+						{
+							for (; crossing != rowCrossings.cend() && crossing->first < column + 0.5; ++crossing)
+							{
+								winding += crossing->second;
+							}
+
+							if (winding != 0)
+							{
+								rowData[column] += 1;
+							}
+						}
+					}
+				}
+
+				for (long row = 0; row < region.numberOfRows; ++row)
+				{
+					for (long column = 0; column < region.numberOfColumns; ++column)
+					{
+						const long index = row * region.numberOfColumns + column;
+
+						if (boundary[index])
+						{
+							aCoverage.data()[index] = 0;
+							aBoundaryPixels.push_back(PixelIndex(static_cast<unsigned int>(row), static_cast<unsigned int>(column)));
+						}
+					}
+				}
+			}
+
+		}
+	}
+}
@@ -0,0 +1,68 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+#ifndef __BOOST_MASK_BOUNDARY_CLASSIFIER_H
+#define __BOOST_MASK_BOUNDARY_CLASSIFIER_H
+
+#include <utility>
+#include <vector>
+
+#include "rttbBaseType.h"
+
+#include <boost/multi_array.hpp>
+#include <boost/geometry/geometries/point_xy.hpp>
+#include <boost/geometry/geometries/polygon.hpp>
+
+namespace rttb
+{
+	namespace masks
+	{
+		namespace boost
+		{
+			/*! @class BoostMaskBoundaryClassifier
+			*	@brief Classifies the pixels of a voxelization plane as inside, outside or on the boundary of the polygons.
+			*	@details Pixels crossed by a polygon edge are boundary pixels (edge crossing bitmap). All other pixels are
+			*	either completely inside or completely outside of every polygon; they are classified by the winding number
+			*	of their center, which is computed for all pixels of a row with one sweep over the edge crossings of the
+			*	row center line. Only the boundary pixels need an exact area computation, so the cost of a plane grows with
+			*	the perimeter of the polygons instead of the size of the bounding box.
+			*/
+			class BoostMaskBoundaryClassifier
+			{
+			public:
+				using BoostPoint2D = ::boost::geometry::model::d2::point_xy<double>;
+				using BoostPolygon2D = ::boost::geometry::model::polygon< ::boost::geometry::model::d2::point_xy<double> >;
+				using BoostPolygonVector = std::vector<BoostPolygon2D>;//polygon with or without holes
+				typedef ::boost::multi_array<double, 2> BoostArray2D;
+				/*! array indices of a pixel of the classified region*/
+				using PixelIndex = std::pair<unsigned int, unsigned int>;
+				using PixelIndexVector = std::vector<PixelIndex>;
+
+				/*! @brief Classifies every pixel of aCoverage.
+				* @param aPolygonVector polygons in double grid index coordinates (the pixel (x,y) covers [x-0.5,x+0.5]x[y-0.5,y+0.5])
+				* @param aMinIndex grid index of the pixel aCoverage[0][0]
+				* @param aCoverage result, its extents define the classified region. Pixels that are not on the boundary get
+				* the number of polygons they are inside of (0 for outside pixels), boundary pixels get 0.
+				* @param aBoundaryPixels result, the array indices of all boundary pixels
+				*/
+				static void classify(const BoostPolygonVector& aPolygonVector, const rttb::VoxelGridIndex3D& aMinIndex,
+				                     BoostArray2D& aCoverage, PixelIndexVector& aBoundaryPixels);
+			};
+
+		}
+	}
+}
+
+#endif
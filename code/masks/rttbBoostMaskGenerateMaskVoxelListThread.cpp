@@ -16,6 +16,10 @@
 
 #include "rttbBoostMaskGenerateMaskVoxelListThread.h"
 
+#include <algorithm>
+#include <limits>
+#include <utility>
+
 #include "rttbInvalidParameterException.h"
 
 namespace rttb
@@ -25,86 +29,109 @@ namespace rttb
 		namespace boost
 		{
 			BoostMaskGenerateMaskVoxelListThread::BoostMaskGenerateMaskVoxelListThread(
-			    const VoxelIndexVector& aGlobalBoundingBox,
         core::GeometricInfo::Pointer aGeometricInfo,
                 BoostArrayMapPointer aVoxelizationMap,
 			    double aVoxelizationThickness,
-			    unsigned int aBeginSlice,
-			    unsigned int aEndSlice,
-                MaskVoxelListPointer aMaskVoxelList,
-        bool strictVoxelization,
-                ::boost::shared_ptr<std::mutex> aMutex) :
-				_globalBoundingBox(aGlobalBoundingBox), _geometricInfo(aGeometricInfo),
-				_voxelizationMap(aVoxelizationMap), _voxelizationThickness(aVoxelizationThickness),
-				_beginSlice(aBeginSlice), _endSlice(aEndSlice),
-                _resultMaskVoxelList(aMaskVoxelList), _strictVoxelization(strictVoxelization), _mutex(aMutex)
+        bool strictVoxelization) :
+				_geometricInfo(aGeometricInfo),
+				_voxelizationMap(aVoxelizationMap), _strictVoxelization(strictVoxelization),
+				_voxelizationThickness(aVoxelizationThickness)
 			{}
 
-			void BoostMaskGenerateMaskVoxelListThread::operator()()
+			void BoostMaskGenerateMaskVoxelListThread::operator()(unsigned int indexZ, MaskVoxelList& aMaskVoxelList) const
 			{
-				rttb::VoxelGridIndex3D minIndex = _globalBoundingBox.at(0);
-				rttb::VoxelGridIndex3D maxIndex = _globalBoundingBox.at(1);
-				unsigned int globalBoundingBoxSize0 = maxIndex[0] - minIndex[0] + 1;
-				unsigned int globalBoundingBoxSize1 = maxIndex[1] - minIndex[1] + 1;
+				//calculate weight vector
+				std::map<double, double> weightVectorForZ;
+				calcWeightVector(indexZ, weightVectorForZ);
+
+				//the bounding box of the slice is the union of the bounding boxes of the weighted voxelization planes
+				std::vector<std::pair<double, BoostArray2DPointer> > weightedPlanes;
+				BoostArray2D::index min0 = std::numeric_limits<BoostArray2D::index>::max();
+				BoostArray2D::index min1 = std::numeric_limits<BoostArray2D::index>::max();
+				BoostArray2D::index end0 = std::numeric_limits<BoostArray2D::index>::lowest();
+				BoostArray2D::index end1 = std::numeric_limits<BoostArray2D::index>::lowest();
+
+				auto it = weightVectorForZ.cbegin();
+				auto itMap = _voxelizationMap->cbegin();
+
+				for (; it != weightVectorForZ.cend()
+				     && itMap != _voxelizationMap->cend(); ++it, ++itMap)
+				{
+					const BoostArray2DPointer& voxelizationArray = itMap->second;
+
+					if (it->second > 0 && voxelizationArray->num_elements() > 0)
+					{
+						weightedPlanes.push_back(std::make_pair(it->second, voxelizationArray));
+						min0 = std::min(min0, voxelizationArray->index_bases()[0]);
+						min1 = std::min(min1, voxelizationArray->index_bases()[1]);
+						end0 = std::max(end0, voxelizationArray->index_bases()[0] + static_cast<BoostArray2D::index>
+						                (voxelizationArray->shape()[0]));
+						end1 = std::max(end1, voxelizationArray->index_bases()[1] + static_cast<BoostArray2D::index>
+						                (voxelizationArray->shape()[1]));
+					}
+				}
+
+				if (weightedPlanes.empty())
+				{
+					return;
+				}
 
-                std::vector<core::MaskVoxel> maskVoxelsInThread;
+				//calc sum of all voxelization planes, use weight
+				BoostArray2D sliceArray(::boost::extents[BoostArray2D::extent_range(min0, end0)]
+				                        [BoostArray2D::extent_range(min1, end1)]);
 
-				for (unsigned int indexZ = _beginSlice; indexZ < _endSlice; ++indexZ)
+				for (const auto& weightedPlane : weightedPlanes)
 				{
-					//calculate weight vector
-					std::map<double, double> weightVectorForZ;
-					calcWeightVector(indexZ, weightVectorForZ);
+					const BoostArray2D& voxelizationArray = *(weightedPlane.second);
+					const BoostArray2D::index planeMin0 = voxelizationArray.index_bases()[0];
+					const BoostArray2D::index planeMin1 = voxelizationArray.index_bases()[1];
+					const BoostArray2D::index planeEnd0 = planeMin0 + static_cast<BoostArray2D::index>(voxelizationArray.shape()[0]);
+					const BoostArray2D::index planeEnd1 = planeMin1 + static_cast<BoostArray2D::index>(voxelizationArray.shape()[1]);
 
-					//For each x,y, calc sum of all voxelization plane, use weight vector
-					for (unsigned int x = 0; x < globalBoundingBoxSize0; ++x)
+					for (BoostArray2D::index x = planeMin0; x < planeEnd0; ++x)
 					{
-						for (unsigned int y = 0; y < globalBoundingBoxSize1; ++y)
+						for (BoostArray2D::index y = planeMin1; y < planeEnd1; ++y)
 						{
-							rttb::VoxelGridIndex3D currentIndex;
-							currentIndex[0] = x + minIndex[0];
-							currentIndex[1] = y + minIndex[1];
-							currentIndex[2] = indexZ;
-							rttb::VoxelGridID gridID;
-							_geometricInfo->convert(currentIndex, gridID);
-							double volumeFraction = 0;
-
-                            auto it = weightVectorForZ.cbegin();
-                            auto itMap = _voxelizationMap->cbegin();
-
-							for (; it != weightVectorForZ.cend()
-							     && itMap != _voxelizationMap->cend(); ++it, ++itMap)
-							{
-								double weight = it->second;
-                                if (weight > 0){
-                                    BoostArray2DPointer voxelizationArray = itMap->second;
-				
-                                    //calc sum of all voxelization plane, use weight
-                                    volumeFraction += (*voxelizationArray)[x][y] * weight;
-                                }
-							}
-
-							if (volumeFraction > 1 && ((volumeFraction - 1) <= errorConstant || !_strictVoxelization))
-							{
-								volumeFraction = 1;
-							}
-							else if (volumeFraction < 0 || (volumeFraction - 1) > errorConstant)
-							{
-								throw rttb::core::InvalidParameterException("Mask calculation failed! The volume fraction should >= 0 and <= 1!");
-							}
-
-							//insert mask voxel if volumeFraction > 0
-							if (volumeFraction > 0)
-							{
-								core::MaskVoxel maskVoxelPtr = core::MaskVoxel(gridID, volumeFraction);
-                                maskVoxelsInThread.push_back(maskVoxelPtr);
-							}
+							sliceArray[x][y] += voxelizationArray[x][y] * weightedPlane.first;
 						}
-
 					}
 				}
 
-        std::unique_lock<std::mutex> lock(*_mutex);
-        _resultMaskVoxelList->insert(_resultMaskVoxelList->end(), maskVoxelsInThread.begin(), maskVoxelsInThread.end());
+				for (BoostArray2D::index x = min0; x < end0; ++x)
+				{
+					for (BoostArray2D::index y = min1; y < end1; ++y)
+					{
+						rttb::VoxelGridIndex3D currentIndex;
+						currentIndex[0] = static_cast<GridIndexType>(x);
+						currentIndex[1] = static_cast<GridIndexType>(y);
+						currentIndex[2] = indexZ;
+						rttb::VoxelGridID gridID;
+
+						if (!_geometricInfo->convert(currentIndex, gridID))
+						{
+							continue;
+						}
+
+						double volumeFraction = sliceArray[x][y];
+
+						if (volumeFraction > 1 && ((volumeFraction - 1) <= errorConstant || !_strictVoxelization))
+						{
+							volumeFraction = 1;
+						}
+						else if (volumeFraction < 0 || (volumeFraction - 1) > errorConstant)
+						{
+							throw rttb::core::InvalidParameterException("Mask calculation failed! The volume fraction should >= 0 and <= 1!");
+						}
+
+						//insert mask voxel if volumeFraction > 0
+						if (volumeFraction > 0)
+						{
+							core::MaskVoxel maskVoxelPtr = core::MaskVoxel(gridID, volumeFraction);
+                            aMaskVoxelList.push_back(maskVoxelPtr);
+						}
+					}
+
+				}
 			}
 
 			void BoostMaskGenerateMaskVoxelListThread::calcWeightVector(const rttb::VoxelGridID& aIndexZ,
@@ -20,7 +20,6 @@
 #include "rttbGeometricInfo.h"
 #include "rttbMaskAccessorInterface.h"
 
-#include <mutex>
 #include <map>
 
 #include <boost/multi_array.hpp>
@@ -33,7 +32,8 @@ namespace rttb
 		namespace boost
 		{
 			/*! @class BoostMaskGenerateMaskVoxelListThread
-			*
+			*	@brief Generates the mask voxels of one dose slice from the voxelization planes.
+			*	@details The functor has no mutable state, one instance may process different slices concurrently.
 			*/
 			class BoostMaskGenerateMaskVoxelListThread
 			{
@@ -43,33 +43,27 @@ namespace rttb
                 using BoostArray2DPointer = ::boost::shared_ptr<BoostArray2D>;
                 typedef ::boost::shared_ptr<std::map<double, BoostArray2DPointer> > BoostArrayMapPointer;
 				using VoxelIndexVector = std::vector<rttb::VoxelGridIndex3D>;
-                using MaskVoxelListPointer = core::MaskAccessorInterface::MaskVoxelListPointer;
+                using MaskVoxelList = core::MaskAccessorInterface::MaskVoxelList;
 
-				BoostMaskGenerateMaskVoxelListThread(const VoxelIndexVector& aGlobalBoundingBox,
-          core::GeometricInfo::Pointer aGeometricInfo,
+				/*! @brief Constructor
+				* @param aVoxelizationMap the voxelization planes, every array covers the bounding box of its plane (see BoostMask)
+				*/
+				BoostMaskGenerateMaskVoxelListThread(core::GeometricInfo::Pointer aGeometricInfo,
                                                      BoostArrayMapPointer aVoxelizationMap,
-				                                     double aVoxelizationThickness,
-				                                     unsigned int aBeginSlice,
-				                                     unsigned int aEndSlice,
-                                                     MaskVoxelListPointer aMaskVoxelList, bool strictVoxelization, ::boost::shared_ptr<std::mutex> aMutex);
-				void operator()();
+				                                     double aVoxelizationThickness, bool strictVoxelization);
+
+				/*! @brief Appends the mask voxels of the dose slice indexZ to aMaskVoxelList
+				* @exception rttb::core::InvalidParameterException thrown if a volume fraction is not within [0,1]
+				*/
+				void operator()(unsigned int indexZ, MaskVoxelList& aMaskVoxelList) const;
 
 			private:
-				VoxelIndexVector _globalBoundingBox;
 				core::GeometricInfo::Pointer _geometricInfo;
         BoostArrayMapPointer _voxelizationMap;
         bool _strictVoxelization=true;
 				//(for example, the first contour has the double grid index 0.1, the second 0.3, the third 0.5, then the thickness is 0.2)
 				double _voxelizationThickness;
 
-				unsigned int _beginSlice;
-				/*! @brief _endSlice is the first index not to be processed (like a end iterator)
-				*/
-				unsigned int _endSlice;
-
-                MaskVoxelListPointer _resultMaskVoxelList;
-                ::boost::shared_ptr<std::mutex> _mutex;
-
 				/*! @brief For each dose grid index z, calculate the weight vector for each structure contour
 				*/
 				void calcWeightVector(const rttb::VoxelGridID& aIndexZ,
@@ -0,0 +1,235 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+#include "rttbBoostMaskScanlineRasterizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace rttb
+{
+	namespace masks
+	{
+		namespace boost
+		{
+			const double BoostMaskScanlineRasterizer::zeroTolerance = 1e-10;
+
+			void BoostMaskScanlineRasterizer::calcCoverage(const BoostPolygonVector& aPolygonVector,
+			        const rttb::VoxelGridIndex3D& aMinIndex, BoostArray2D& aCoverage, bool strict)
+			{
+				std::fill(aCoverage.data(), aCoverage.data() + aCoverage.num_elements(), 0.0);
+
+				if (aCoverage.num_elements() == 0 || aPolygonVector.empty())
+				{
+					return;
+				}
+
+				if (aPolygonVector.size() == 1)
+				{
+					rasterizePolygon(aPolygonVector.front(), aMinIndex, aCoverage, strict);
+					return;
+				}
+
+				//several polygons add up like the intersection areas of the boost engine
+				BoostArray2D polygonCoverage(::boost::extents[aCoverage.shape()[0]][aCoverage.shape()[1]]);
+				double* coverage = aCoverage.data();
+				const double* polygonCoverageData = polygonCoverage.data();
+
+				for (const auto& polygon : aPolygonVector)
+				{
+					rasterizePolygon(polygon, aMinIndex, polygonCoverage, strict);
+
+					for (std::size_t i = 0; i < aCoverage.num_elements(); ++i)
+					{
+						coverage[i] += polygonCoverageData[i];
+					}
+				}
+			}
+
+			void BoostMaskScanlineRasterizer::rasterizePolygon(const BoostPolygon2D& aPolygon,
+			        const rttb::VoxelGridIndex3D& aMinIndex, BoostArray2D& aCoverage, bool strict)
+			{
+				std::fill(aCoverage.data(), aCoverage.data() + aCoverage.num_elements(), 0.0);
+
+				//outer rings count positive, interior rings negative, independent of their orientation
+				addRing(aPolygon.outer(), calcSignedArea(aPolygon.outer()) < 0 ? -1.0 : 1.0, aMinIndex, aCoverage);
+
+				for (const auto& inner : aPolygon.inners())
+				{
+					addRing(inner, calcSignedArea(inner) < 0 ? 1.0 : -1.0, aMinIndex, aCoverage);
+				}
+
+				//the prefix sums along the rows turn the edge contributions into the covered areas
+				const std::size_t numberOfRows = aCoverage.shape()[0];
+				const std::size_t numberOfColumns = aCoverage.shape()[1];
+
+				for (std::size_t row = 0; row < numberOfRows; ++row)
+				{
+					double* rowData = aCoverage.data() + row * numberOfColumns;
+					double area = 0;
+
+					for (std::size_t column = 0; column < numberOfColumns; ++column)
+					{
+						area += rowData[column];
+						//winding numbers other than 0 and 1 only occur for self-intersecting rings
+						const double coveredArea = strict ? std::abs(area) : std::min(std::abs(area), 1.0);
+						rowData[column] = coveredArea < zeroTolerance ? 0 : coveredArea;
+					}
+				}
+			}
+
+			void BoostMaskScanlineRasterizer::addRing(const BoostRing2D& aRing, double aSign,
+			        const rttb::VoxelGridIndex3D& aMinIndex, BoostArray2D& aCoverage)
+			{
+				//pixel borders at integer positions
+				const double offsetR = aMinIndex[0] - 0.5;
+				const double offsetC = aMinIndex[1] - 0.5;
+				const std::size_t numberOfPoints = aRing.size();
+
+				for (std::size_t i = 0; i < numberOfPoints; ++i)
+				{
+					//the closing edge is added as well, it has length 0 for closed rings
+					const BoostPoint2D& from = aRing[i];
+					const BoostPoint2D& to = aRing[(i + 1) % numberOfPoints];
+					addEdge(from.x() - offsetR, from.y() - offsetC, to.x() - offsetR, to.y() - offsetC, aSign, aCoverage);
+				}
+			}
+
+			void BoostMaskScanlineRasterizer::addEdge(double r0, double c0, double r1, double c1, double aSign,
+			        BoostArray2D& aCoverage)
+			{
+				if (r0 == r1)
+				{
+					return;
+				}
+
+				double sign = aSign;
+
+				if (r0 > r1)
+				{
+					std::swap(r0, r1);
+					std::swap(c0, c1);
+					sign = -sign;
+				}
+
+				const std::size_t numberOfRows = aCoverage.shape()[0];
+				const std::size_t numberOfColumns = aCoverage.shape()[1];
+
+				if (r1 <= 0 || r0 >= numberOfRows)
+				{
+					return;
+				}
+
+				const double slope = (c1 - c0) / (r1 - r0);
+				const std::size_t firstRow = r0 > 0 ? static_cast<std::size_t>(r0) : 0;
+				const std::size_t endRow = std::min(numberOfRows, static_cast<std::size_t>(std::ceil(r1)));
+
+				for (std::size_t row = firstRow; row < endRow; ++row)
+				{
+					const double rBegin = std::max(r0, static_cast<double>(row));
+					const double rEnd = std::min(r1, static_cast<double>(row + 1));
+
+					if (rEnd <= rBegin)
+					{
+						continue;
+					}
+
+					//positions are computed from the start point, so that no error accumulates along the edge
+					const double cBegin = c0 + (rBegin - r0) * slope;
+					const double cEnd = c0 + (rEnd - r0) * slope;
+					addRowPiece(aCoverage.data() + row * numberOfColumns, numberOfColumns, std::min(cBegin, cEnd),
+					            std::max(cBegin, cEnd), sign * (rEnd - rBegin));
+				}
+			}
+
+			void BoostMaskScanlineRasterizer::addRowPiece(double* aRow, std::size_t aNumberOfColumns, double cBegin,
+			        double cEnd, double aHeight)
+			{
+				//left of the region: the whole height counts for every pixel of the row
+				if (cEnd <= 0)
+				{
+					aRow[0] += aHeight;
+					return;
+				}
+
+				//right of the region: no pixel is affected
+				if (cBegin >= aNumberOfColumns)
+				{
+					return;
+				}
+
+				const double width = cEnd - cBegin;
+
+				if (width <= 0)
+				{
+					const auto column = static_cast<std::size_t>(cBegin);
+					aRow[column] += aHeight * (column + 1 - cBegin);
+
+					if (column + 1 < aNumberOfColumns)
+					{
+						aRow[column + 1] += aHeight * (cBegin - column);
+					}
+
+					return;
+				}
+
+				double begin = cBegin;
+
+				if (begin < 0)
+				{
+					aRow[0] += aHeight * (-begin) / width;
+					begin = 0;
+				}
+
+				const double end = std::min(cEnd, static_cast<double>(aNumberOfColumns));
+
+				//one part per crossed pixel: the part of the pixel right of the edge gets the area, the next pixel the rest
+				while (begin < end)
+				{
+					const auto column = static_cast<std::size_t>(begin);
+					const double partEnd = std::min(end, static_cast<double>(column + 1));
+					const double partHeight = aHeight * (partEnd - begin) / width;
+					const double partCenter = 0.5 * (begin + partEnd) - column;
+
+					aRow[column] += partHeight * (1 - partCenter);
+
+					if (column + 1 < aNumberOfColumns)
+					{
+						aRow[column + 1] += partHeight * partCenter;
+					}
+
+					begin = partEnd;
+				}
+			}
+
+			double BoostMaskScanlineRasterizer::calcSignedArea(const BoostRing2D& aRing)
+			{
+				double area = 0;
+				const std::size_t numberOfPoints = aRing.size();
+
+				for (std::size_t i = 0; i < numberOfPoints; ++i)
+				{
+					const BoostPoint2D& from = aRing[i];
+					const BoostPoint2D& to = aRing[(i + 1) % numberOfPoints];
+					area += from.x() * to.y() - to.x() * from.y();
+				}
+
+				return 0.5 * area;
+			}
+
+		}
+	}
+}
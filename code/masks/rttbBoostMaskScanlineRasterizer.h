@@ -0,0 +1,101 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+#ifndef __BOOST_MASK_SCANLINE_RASTERIZER_H
+#define __BOOST_MASK_SCANLINE_RASTERIZER_H
+
+#include <vector>
+
+#include "rttbBaseType.h"
+
+#include <boost/multi_array.hpp>
+#include <boost/geometry/geometries/point_xy.hpp>
+#include <boost/geometry/geometries/polygon.hpp>
+
+namespace rttb
+{
+	namespace masks
+	{
+		namespace boost
+		{
+			/*! @class BoostMaskScanlineRasterizer
+			*	@brief Computes the exact area of polygons within every pixel of a voxelization plane with an edge based
+			*	scanline algorithm (analytic coverage rasterization).
+			*	@details Every polygon edge adds, row by row, its signed contribution to the pixels it crosses and to the
+			*	pixel right of it; a prefix sum along each row then yields the covered area of every pixel. The cost is
+			*	proportional to the perimeter of the polygons plus the number of pixels, instead of one polygon intersection
+			*	per pixel and polygon.
+			*	The rings are oriented before rasterization (outer rings positive, interior rings negative), so donuts
+			*	are handled by winding. For valid polygons the result is the same as the sum of the intersection areas of
+			*	every pixel with every polygon (see BoostMaskVoxelizationThread), up to floating point rounding.
+			*	Self-intersecting rings are rasterized with the nonzero winding rule; pixels crossed by a self-intersection
+			*	get the absolute value of their mean winding, limited to 1 unless strict is set. In strict mode, pixels that
+			*	a ring covers several times get a coverage above 1, so that BoostMask detects the self intersection.
+			*/
+			class BoostMaskScanlineRasterizer
+			{
+			public:
+				using BoostPoint2D = ::boost::geometry::model::d2::point_xy<double>;
+				using BoostPolygon2D = ::boost::geometry::model::polygon< ::boost::geometry::model::d2::point_xy<double> >;
+				using BoostPolygonVector = std::vector<BoostPolygon2D>;//polygon with or without holes
+				typedef ::boost::multi_array<double, 2> BoostArray2D;
+
+				/*! @brief Areas with an absolute value below are set to 0, they are rounding errors of the prefix sums
+				*	(and would otherwise add voxels with a negligible or negative volume fraction to the mask).
+				*/
+				static const double zeroTolerance;
+
+				/*! @brief Computes the covered area of every pixel of aCoverage.
+				* @param aPolygonVector polygons in double grid index coordinates (the pixel (x,y) covers [x-0.5,x+0.5]x[y-0.5,y+0.5])
+				* @param aMinIndex grid index of the pixel aCoverage[0][0]
+				* @param aCoverage result, its extents define the rasterized region; aCoverage[i][j] is the area of the pixel
+				* (aMinIndex[0]+i, aMinIndex[1]+j) covered by the polygons. Parts of the polygons outside this region are ignored.
+				* @param strict if false, the coverage of every polygon is limited to 1.
+				*/
+				static void calcCoverage(const BoostPolygonVector& aPolygonVector, const rttb::VoxelGridIndex3D& aMinIndex,
+				                         BoostArray2D& aCoverage, bool strict = false);
+
+			private:
+				using BoostRing2D = BoostPolygon2D::ring_type;
+
+				/*! @brief Computes the covered area of every pixel of aCoverage for a single polygon (overwrites aCoverage).*/
+				static void rasterizePolygon(const BoostPolygon2D& aPolygon, const rttb::VoxelGridIndex3D& aMinIndex,
+				                             BoostArray2D& aCoverage, bool strict);
+
+				/*! @brief Adds the contributions of all edges of aRing, multiplied with aSign, to aCoverage.*/
+				static void addRing(const BoostRing2D& aRing, double aSign, const rttb::VoxelGridIndex3D& aMinIndex,
+				                    BoostArray2D& aCoverage);
+
+				/*! @brief Adds the contributions of the edge (r0,c0)-(r1,c1) to aCoverage.
+				* @details r is the row coordinate (first array index), c the column coordinate (second array index), both in
+				* pixel units relative to the border of aCoverage.
+				*/
+				static void addEdge(double r0, double c0, double r1, double c1, double aSign, BoostArray2D& aCoverage);
+
+				/*! @brief Adds the contributions of an edge piece within one row, that spans the columns [cBegin, cEnd]
+				* (cBegin<=cEnd) and the signed row height aHeight.
+				*/
+				static void addRowPiece(double* aRow, std::size_t aNumberOfColumns, double cBegin, double cEnd,
+				                        double aHeight);
+
+				/*! @brief Signed area of aRing (positive for counterclockwise rings).*/
+				static double calcSignedArea(const BoostRing2D& aRing);
+			};
+
+		}
+	}
+}
+
+#endif
@@ -15,7 +15,13 @@
 
 #include "rttbBoostMaskVoxelizationThread.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 #include "rttbInvalidParameterException.h"
+#include "rttbBoostMaskScanlineRasterizer.h"
+#include "rttbBoostMaskBoundaryClassifier.h"
 
 #include <boost/geometry.hpp>
 #include <boost/make_shared.hpp>
@@ -26,57 +32,130 @@ namespace rttb
 	{
 		namespace boost
 		{
-			BoostMaskVoxelizationThread::BoostMaskVoxelizationThread(const BoostPolygonMap& APolygonMap,
-                const VoxelIndexVector& aGlobalBoundingBox, BoostArrayMapPointer anArrayMap, ::boost::shared_ptr<std::mutex> aMutex, bool strict) : _geometryCoordinateBoostPolygonMap(APolygonMap),
-                _globalBoundingBox(aGlobalBoundingBox), _resultVoxelization(anArrayMap), _mutex(aMutex), _strict(strict)
+			BoostMaskVoxelizationThread::BoostMaskVoxelizationThread(const VoxelIndexVector& aGlobalBoundingBox, bool strict,
+                BoostMask::VoxelizationEngine engine) : _globalBoundingBox(aGlobalBoundingBox), _strict(strict),
+                _engine(engine)
 			{
 			}
 
-			void BoostMaskVoxelizationThread::operator()()
+			BoostMaskVoxelizationThread::BoostArray2DPointer BoostMaskVoxelizationThread::operator()(
+			    const BoostPolygonVector& aPolygonVector) const
 			{
-				rttb::VoxelGridIndex3D minIndex = _globalBoundingBox.at(0);
-				rttb::VoxelGridIndex3D maxIndex = _globalBoundingBox.at(1);
-				const unsigned int globalBoundingBoxSize0 = maxIndex[0] - minIndex[0] + 1;
-				const unsigned int globalBoundingBoxSize1 = maxIndex[1] - minIndex[1] + 1;
+				//the polygons are corrected once per plane instead of once per voxel
+				BoostPolygonVector boostPolygonVec = aPolygonVector;
+
+				for (auto& polygon : boostPolygonVec)
+				{
+					::boost::geometry::correct(polygon);
+				}
+
+				rttb::VoxelGridIndex3D minIndex;
+				rttb::VoxelGridIndex3D maxIndex;
+
+				if (!calcPlaneBoundingBox(boostPolygonVec, minIndex, maxIndex))
+				{
+					return ::boost::make_shared<BoostArray2D>(::boost::extents[0][0]);
+				}
 
-                std::map<double, ::boost::shared_ptr<BoostArray2D> > voxelizationMapInThread;
+				//the array of the plane covers its own bounding box, its index bases are the grid index of the first voxel
+				auto maskArray = ::boost::make_shared<BoostArray2D>(::boost::extents
+				                 [BoostArray2D::extent_range(minIndex[0], maxIndex[0] + 1)]
+				                 [BoostArray2D::extent_range(minIndex[1], maxIndex[1] + 1)]);
 
-                 for (auto & it : _geometryCoordinateBoostPolygonMap)
+				if (_engine == BoostMask::VoxelizationEngine::Scanline)
 				{
-                    BoostArray2D maskArray(::boost::extents[globalBoundingBoxSize0][globalBoundingBoxSize1]);
+					BoostMaskScanlineRasterizer::calcCoverage(boostPolygonVec, minIndex, *maskArray, _strict);
+				}
+				else if (_engine == BoostMask::VoxelizationEngine::BoostGeometryBoundary)
+				{
+					//inside and outside voxels are classified, only the boundary voxels need intersections
+					BoostMaskBoundaryClassifier::PixelIndexVector boundaryPixels;
+					BoostMaskBoundaryClassifier::classify(boostPolygonVec, minIndex, *maskArray, boundaryPixels);
 
-					BoostPolygonVector boostPolygonVec = it.second;
+					for (const auto& pixel : boundaryPixels)
+					{
+						rttb::VoxelGridIndex3D currentIndex;
+						currentIndex[0] = pixel.first + minIndex[0];
+						currentIndex[1] = pixel.second + minIndex[1];
+						currentIndex[2] = 0;
+						(*maskArray)[currentIndex[0]][currentIndex[1]] = calcArea(getIntersections(currentIndex,
+						        boostPolygonVec));
+					}
+				}
 
-					for (unsigned int x = 0; x < globalBoundingBoxSize0; ++x)
+				for (GridIndexType x = minIndex[0]; x <= maxIndex[0]; ++x)
+				{
+					for (GridIndexType y = minIndex[1]; y <= maxIndex[1]; ++y)
 					{
-						for (unsigned int y = 0; y < globalBoundingBoxSize1; ++y)
+						double volumeFraction = 0;
+
+						if (_engine != BoostMask::VoxelizationEngine::BoostGeometry)
+						{
+							volumeFraction = (*maskArray)[x][y];
+						}
+						else
 						{
 							rttb::VoxelGridIndex3D currentIndex;
-							currentIndex[0] = x + minIndex[0];
-							currentIndex[1] = y + minIndex[1];
+							currentIndex[0] = x;
+							currentIndex[1] = y;
 							currentIndex[2] = 0;
 
 							//Get intersection polygons of the dose voxel and the structure
 							BoostPolygonDeque polygons = getIntersections(currentIndex, boostPolygonVec);
 
 							//Calc areas of all intersection polygons
-							double volumeFraction = calcArea(polygons);
-                            volumeFraction = correctForErrorAndStrictness(volumeFraction, _strict);
-                            if (volumeFraction < 0 || volumeFraction > 1 )
-                            {
-                                throw rttb::core::InvalidParameterException("Mask calculation failed! The volume fraction should >= 0 and <= 1!");
-                            }
-
-							maskArray[x][y] = volumeFraction;
+							volumeFraction = calcArea(polygons);
 						}
+
+                        volumeFraction = correctForErrorAndStrictness(volumeFraction, _strict);
+                        if (volumeFraction < 0 || volumeFraction > 1 )
+                        {
+                            throw rttb::core::InvalidParameterException("Mask calculation failed! The volume fraction should >= 0 and <= 1!");
+                        }
+
+						(*maskArray)[x][y] = volumeFraction;
 					}
+				}
+
+				return maskArray;
+			}
+
+			bool BoostMaskVoxelizationThread::calcPlaneBoundingBox(const BoostPolygonVector& aPolygonVector,
+			        rttb::VoxelGridIndex3D& aMinIndex, rttb::VoxelGridIndex3D& aMaxIndex) const
+			{
+				double min0 = std::numeric_limits<double>::max();
+				double min1 = std::numeric_limits<double>::max();
+				double max0 = std::numeric_limits<double>::lowest();
+				double max1 = std::numeric_limits<double>::lowest();
 
-                    voxelizationMapInThread.insert(std::pair<double, BoostArray2DPointer>(it.first, ::boost::make_shared<BoostArray2D>(maskArray)));
+				//the interior rings are within the outer ring
+				for (const auto& polygon : aPolygonVector)
+				{
+					for (const auto& point : polygon.outer())
+					{
+						min0 = std::min(min0, point.x());
+						min1 = std::min(min1, point.y());
+						max0 = std::max(max0, point.x());
+						max1 = std::max(max1, point.y());
+					}
+				}
+
+				//the voxel x covers [x-0.5, x+0.5]
+				const rttb::VoxelGridIndex3D& globalMinIndex = _globalBoundingBox.at(0);
+				const rttb::VoxelGridIndex3D& globalMaxIndex = _globalBoundingBox.at(1);
+				min0 = std::max(std::floor(min0 + 0.5), static_cast<double>(globalMinIndex[0]));
+				min1 = std::max(std::floor(min1 + 0.5), static_cast<double>(globalMinIndex[1]));
+				max0 = std::min(std::floor(max0 + 0.5), static_cast<double>(globalMaxIndex[0]));
+				max1 = std::min(std::floor(max1 + 0.5), static_cast<double>(globalMaxIndex[1]));
+
+				if (min0 > max0 || min1 > max1)
+				{
+					return false;
 				}
-                //insert gathered values into voxelization map
-                std::unique_lock<std::mutex> lock(*_mutex);
-                _resultVoxelization->insert(voxelizationMapInThread.begin(), voxelizationMapInThread.end());
 
+				aMinIndex = rttb::VoxelGridIndex3D(GridIndexType(min0), GridIndexType(min1), 0);
+				aMaxIndex = rttb::VoxelGridIndex3D(GridIndexType(max0), GridIndexType(max1), 0);
+				return true;
 			}
 
 			/*Get intersection polygons of the contour and a voxel polygon*/
@@ -93,11 +172,8 @@ namespace rttb
 
 				for (it = intersectionSlicePolygons.begin(); it != intersectionSlicePolygons.end(); ++it)
 				{
-					BoostPolygon2D contour = *it;
-					::boost::geometry::correct(contour);
-					
 					BoostPolygonDeque intersection;
-					::boost::geometry::intersection(voxelPolygon, contour, intersection);
+					::boost::geometry::intersection(voxelPolygon, *it, intersection);
 					polygonDeque.insert(polygonDeque.end(), intersection.begin(), intersection.end());
 				}
 
@@ -17,10 +17,10 @@
 #define __BOOST_MASK_VOXELIZATION_THREAD_H
 
 #include <deque>
-#include <mutex>
 #include <map>
 
 #include "rttbBaseType.h"
+#include "rttbBoostMask.h"
 
 #include <boost/multi_array.hpp>
 #include <boost/shared_ptr.hpp>
@@ -33,8 +33,9 @@ namespace rttb
 	{
 		namespace boost
 		{
-			/*! @class BoostMaskGenerateMaskVoxelListThread
-			*
+			/*! @class BoostMaskVoxelizationThread
+			*	@brief Computes the voxelization plane of one contour plane.
+			*	@details The functor has no mutable state, one instance may compute different planes concurrently.
 			*/
 			class BoostMaskVoxelizationThread
 			{
@@ -47,16 +48,21 @@ namespace rttb
 				using VoxelIndexVector = std::vector<rttb::VoxelGridIndex3D>;
 				typedef ::boost::multi_array<double, 2> BoostArray2D;
                 using BoostArray2DPointer = ::boost::shared_ptr<BoostArray2D>;
-                typedef ::boost::shared_ptr<std::map<double, BoostArray2DPointer > > BoostArrayMapPointer;
 
                 /*! @brief Constructor
-                * @param aMutex a mutex for thread-safe handling of the _resultVoxelization
+                * @param aGlobalBoundingBox min and max index of the region that may be voxelized; the voxelization plane
+                * gets an array that covers the bounding box of its polygons within this region
                 * @param strict true means that volumeFractions of <0 and >1 are NOT corrected. Otherwise, they are automatically corrected to 0 or 1, respectively.
+                * @param engine the algorithm that computes the planes (see BoostMask::VoxelizationEngine)
                 */
-				BoostMaskVoxelizationThread(const BoostPolygonMap& APolygonMap,
-                    const VoxelIndexVector& aGlobalBoundingBox, BoostArrayMapPointer anArrayMap, ::boost::shared_ptr<std::mutex> aMutex, bool strict);
+				BoostMaskVoxelizationThread(const VoxelIndexVector& aGlobalBoundingBox, bool strict,
+                    BoostMask::VoxelizationEngine engine = BoostMask::VoxelizationEngine::BoostGeometry);
 
-				void operator()();
+				/*! @brief Computes the voxelization plane of the polygons of one z index
+				* @return the mask values of the plane, indexed by the grid index of the voxels (see BoostMask::_voxelizationMap)
+				* @exception rttb::core::InvalidParameterException thrown if a volume fraction is not within [0,1]
+				*/
+				BoostArray2DPointer operator()(const BoostPolygonVector& aPolygonVector) const;
 
 
 			private:
@@ -65,20 +71,24 @@ namespace rttb
 				using BoostPoint2D = ::boost::geometry::model::d2::point_xy<double>;
 
 
-				BoostPolygonMap _geometryCoordinateBoostPolygonMap;
 				VoxelIndexVector _globalBoundingBox;
-        BoostArrayMapPointer _resultVoxelization;
-        ::boost::shared_ptr<std::mutex> _mutex;
         bool _strict;
+        BoostMask::VoxelizationEngine _engine;
 
 				/*! @brief Get intersection polygons of the contour and a voxel polygon
 				* @param aVoxelIndex3D The 3d grid index of the voxel
-				* @param intersectionSlicePolygons The polygons of the slice intersecting the voxel
+				* @param intersectionSlicePolygons The polygons of the slice intersecting the voxel, corrected with boost::geometry::correct
 				* @return Return all intersection polygons of the structure and the voxel
 				*/
 				static BoostPolygonDeque getIntersections(const rttb::VoxelGridIndex3D& aVoxelIndex3D,
 				        const BoostPolygonVector& intersectionSlicePolygons);
 
+				/*! @brief Calculates the voxels covered by the bounding box of the polygons, limited to the global bounding box
+				* @return false if the bounding box is empty
+				*/
+				bool calcPlaneBoundingBox(const BoostPolygonVector& aPolygonVector, rttb::VoxelGridIndex3D& aMinIndex,
+				                          rttb::VoxelGridIndex3D& aMaxIndex) const;
+
 				/*! @brief Get the voxel 2d contour polygon in geometry coordinate*/
 				static BoostRing2D get2DContour(const rttb::VoxelGridIndex3D& aVoxelGrid3D);
 
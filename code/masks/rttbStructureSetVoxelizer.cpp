@@ -0,0 +1,104 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+#include "rttbStructureSetVoxelizer.h"
+
+#include <memory>
+
+#include <boost/make_shared.hpp>
+
+#include "rttbBoostMaskAccessor.h"
+#include "rttbNullPointerException.h"
+#include "rttbThreadPool.h"
+
+namespace rttb
+{
+	namespace masks
+	{
+		namespace boost
+		{
+			StructureSetVoxelizer::StructureSetVoxelizer(core::StructureSet::Pointer aStructureSet,
+			        const core::GeometricInfo& aGeometricInfo, bool strict, BoostMask::VoxelizationEngine engine)
+				: _structureSet(aStructureSet), _geoInfo(aGeometricInfo), _strict(strict), _engine(engine)
+			{
+				if (_structureSet == nullptr)
+				{
+					throw rttb::core::NullPointerException("Error: Structure set is nullptr!");
+				}
+			}
+
+			StructureSetVoxelizer::MaskAccessorVector StructureSetVoxelizer::voxelize() const
+			{
+				StructureIndexVector structureIndices(_structureSet->getNumberOfStructures());
+
+				for (size_t i = 0; i < structureIndices.size(); ++i)
+				{
+					structureIndices[i] = i;
+				}
+
+				return voxelize(structureIndices);
+			}
+
+			StructureSetVoxelizer::MaskAccessorVector StructureSetVoxelizer::voxelize(
+			    const StructureIndexVector& aStructureIndices) const
+			{
+				MaskAccessorVector masks(aStructureIndices.size());
+
+				voxelize(aStructureIndices, [&masks](size_t aPosition, core::MaskAccessorInterface::Pointer aMask)
+				{
+					masks[aPosition] = aMask;
+				});
+
+				return masks;
+			}
+
+			void StructureSetVoxelizer::voxelize(const StructureIndexVector& aStructureIndices,
+			                                     const MaskConsumer& aConsumer) const
+			{
+				//getStructure() checks the indices before any task is started
+				std::vector<::boost::shared_ptr<BoostMaskAccessor> > maskAccessors;
+				maskAccessors.reserve(aStructureIndices.size());
+
+				for (size_t structureIndex : aStructureIndices)
+				{
+					maskAccessors.push_back(::boost::make_shared<BoostMaskAccessor>(_structureSet->getStructure(structureIndex),
+					                        _geoInfo, _strict, _engine));
+				}
+
+				//one group per mask, so that each mask can be passed on as soon as it is computed
+				core::ThreadPool& pool = core::ThreadPool::getDefault();
+				std::vector<std::unique_ptr<core::ThreadPool::TaskGroup> > tasks;
+				tasks.reserve(maskAccessors.size());
+
+				for (const auto& maskAccessor : maskAccessors)
+				{
+					BoostMaskAccessor* mask = maskAccessor.get();
+					tasks.push_back(std::unique_ptr<core::ThreadPool::TaskGroup>(new core::ThreadPool::TaskGroup(pool)));
+					tasks.back()->run([mask]()
+					{
+						mask->updateMask();
+					});
+				}
+
+				for (size_t i = 0; i < maskAccessors.size(); ++i)
+				{
+					tasks[i]->wait();
+					aConsumer(i, maskAccessors[i]);
+					maskAccessors[i].reset();
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,97 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+#ifndef __STRUCTURE_SET_VOXELIZER_H
+#define __STRUCTURE_SET_VOXELIZER_H
+
+#include <functional>
+#include <vector>
+
+#include "rttbBaseType.h"
+#include "rttbGeometricInfo.h"
+#include "rttbMaskAccessorInterface.h"
+#include "rttbStructureSet.h"
+#include "rttbBoostMask.h"
+
+#include "RTTBMaskExports.h"
+
+namespace rttb
+{
+	namespace masks
+	{
+		namespace boost
+		{
+			/*! @class StructureSetVoxelizer
+			*   @brief Voxelizes several structures of a structure set on the same dose grid.
+			*   @details Every structure is a task on core::ThreadPool::getDefault(); its contour planes and mask slices are
+			*   tasks of the same pool (see BoostMask). Idle threads steal the planes of structures that are still running,
+			*   so many small structures and a few large ones keep all cores busy.
+			*   The masks are BoostMaskAccessor objects that are already computed.
+			*   @attention see BoostMaskAccessor for the meaning of "strict".
+			*/
+			class RTTBMask_EXPORT StructureSetVoxelizer
+			{
+			public:
+				using MaskAccessorVector = std::vector<core::MaskAccessorInterface::Pointer>;
+				using StructureIndexVector = std::vector<size_t>;
+				/*! @brief receives the position of a mask in the structure indices and the computed mask*/
+				using MaskConsumer = std::function<void(size_t aPosition, core::MaskAccessorInterface::Pointer aMask)>;
+
+			private:
+				core::StructureSet::Pointer _structureSet;
+				core::GeometricInfo _geoInfo;
+				bool _strict;
+				BoostMask::VoxelizationEngine _engine;
+
+			public:
+				/*! @brief Constructor
+				* @param aStructureSet the structures to voxelize
+				* @param aGeometricInfo the geometric info of the dose
+				* @param strict indicates whether to allow self intersection in the structures (see BoostMaskAccessor)
+				* @param engine the algorithm that computes the voxelization planes (see BoostMask::VoxelizationEngine)
+				* @exception rttb::core::NullPointerException thrown if aStructureSet is nullptr
+				*/
+				StructureSetVoxelizer(core::StructureSet::Pointer aStructureSet, const core::GeometricInfo& aGeometricInfo,
+				                      bool strict = true,
+				                      BoostMask::VoxelizationEngine engine = BoostMask::VoxelizationEngine::BoostGeometry);
+
+				/*! @brief Voxelizes all structures of the structure set
+				* @return the masks in the order of the structures
+				* @exception InvalidParameterException thrown if strict is true and a structure has self intersections
+				*/
+				MaskAccessorVector voxelize() const;
+
+				/*! @brief Voxelizes the structures with the given indices
+				* @return the masks in the order of aStructureIndices
+				* @exception InvalidParameterException thrown if an index is not valid, or if strict is true and a structure
+				* has self intersections
+				*/
+				MaskAccessorVector voxelize(const StructureIndexVector& aStructureIndices) const;
+
+				/*! @brief Voxelizes the structures with the given indices and passes every mask to aConsumer as soon as it and
+				* the masks before it are computed, e.g. to write it to a file.
+				* @details aConsumer is called in the calling thread in the order of aStructureIndices, while the remaining
+				* masks are computed. A mask that was passed is not referenced by the voxelizer anymore, so the masks do not
+				* have to be kept in memory all at once.
+				* @exception InvalidParameterException thrown if an index is not valid, or if strict is true and a structure
+				* has self intersections
+				*/
+				void voxelize(const StructureIndexVector& aStructureIndices, const MaskConsumer& aConsumer) const;
+			};
+		}
+	}
+}
+
+#endif
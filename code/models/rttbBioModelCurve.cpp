@@ -69,11 +69,7 @@ namespace rttb
 			{
 				DoseCalcType factor = minFactor + i * (maxFactor - minFactor) / (aBin - 1);
 
-				core::DVH variantDVH = core::DVH(_dvh->getDataDifferential(), _dvh->getDeltaD() * factor,
-				                                 _dvh->getDeltaV(),
-				                                 "temporary", "temporary");
-
-				auto spDVH = boost::make_shared<core::DVH>(variantDVH);
+				auto spDVH = boost::make_shared<core::DVH>(*_dvh, _dvh->getDeltaD() * factor);
 				double eud = getEUD(spDVH, aModel.getA());
 
 				aModel.init(factor);
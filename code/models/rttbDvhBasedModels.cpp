@@ -15,6 +15,7 @@
 
 #include "rttbDvhBasedModels.h"
 #include "rttbInvalidParameterException.h"
+#include "rttbCompensatedSum.h"
 
 namespace rttb
 {
@@ -27,14 +28,14 @@ namespace rttb
 				throw core::InvalidParameterException("Parameter invalid: aA should not be zero!");
 			}
 
-			DataDifferentialType dataDifferential = dvh->getDataDifferential();
+			const DataDifferentialType& dataDifferential = dvh->getDataDifferential();
 
 			if (dataDifferential.empty())
 			{
 				throw core::InvalidParameterException("Parameter invalid: DVH data differential should not be empty!");
 			}
 
-			double eud = 0;
+			core::CompensatedSum eudSum;
 
 			DoseTypeGy deltaD = dvh->getDeltaD();
 			DVHVoxelNumber numberOfVoxels = dvh->getNumberOfVoxels();
@@ -43,10 +44,10 @@ namespace rttb
 			{
 				double doseGyi = (i + 0.5) * deltaD;
 				double relativeVolumei = dataDifferential[i] / numberOfVoxels;
-				eud += pow((double)doseGyi, (double)aA) * relativeVolumei;
+				eudSum.add(pow((double)doseGyi, (double)aA) * relativeVolumei);
 			}
 
-			eud = pow((double)eud, (double)(1 / aA));
+			double eud = pow(eudSum.getSum(), (double)(1 / aA));
 			return eud;
 
 		}
@@ -58,7 +59,7 @@ namespace rttb
 			std::map<DoseTypeGy, DoseCalcType> dataBED;
 			std::map<DoseTypeGy, DoseCalcType> dataBEDRelative;
 
-			DataDifferentialType dataDifferential = dvh->getDataDifferential();
+			const DataDifferentialType& dataDifferential = dvh->getDataDifferential();
 
 			if (dataDifferential.empty())
 			{
@@ -78,7 +79,7 @@ namespace rttb
 			DoseTypeGy deltaD = dvh->getDeltaD();
 			DVHVoxelNumber numberOfVoxels = dvh->getNumberOfVoxels();
 
-			std::deque<rttb::DoseCalcType>::iterator it;
+			DataDifferentialType::const_iterator it;
 			int i = 0;
 
 			for (it = dataDifferential.begin(); it != dataDifferential.end(); ++it)
@@ -117,7 +118,7 @@ namespace rttb
 			std::map<rttb::DoseTypeGy, rttb::DoseCalcType> dataLQED2;
 			std::map<rttb::DoseTypeGy, rttb::DoseCalcType> dataLQED2Relative;
 
-			DataDifferentialType dataDifferential = dvh->getDataDifferential();
+			const DataDifferentialType& dataDifferential = dvh->getDataDifferential();
 
 			if (dataDifferential.empty())
 			{
@@ -137,7 +138,7 @@ namespace rttb
 			DoseTypeGy deltaD = dvh->getDeltaD();
 			DVHVoxelNumber numberOfVoxels = dvh->getNumberOfVoxels();
 
-			std::deque<rttb::DoseCalcType>::iterator it;
+			DataDifferentialType::const_iterator it;
 			int i = 0;
 
 			for (it = dataDifferential.begin(); it != dataDifferential.end(); ++it)
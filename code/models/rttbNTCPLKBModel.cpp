@@ -147,11 +147,8 @@ namespace rttb
 				throw core::InvalidParameterException("_m must not be zero");
 			}
 
-			core::DVH variantDVH = core::DVH(_dvh->getDataDifferential(),
-			                                 (DoseTypeGy)(_dvh->getDeltaD() * doseFactor),
-			                                 _dvh->getDeltaV(), "temporary", "temporary");
-
-			auto spDVH = boost::make_shared<core::DVH>(variantDVH);
+			//the scaled DVH shares the histogram of _dvh
+			auto spDVH = boost::make_shared<core::DVH>(*_dvh, (DoseTypeGy)(_dvh->getDeltaD() * doseFactor));
 			double eud = getEUD(spDVH, this->_a);
 			//_m must not be zero
 			double t = (eud - this->_d50) / (this->_m * this->_d50);
@@ -148,7 +148,7 @@ namespace rttb
 				throw core::InvalidParameterException("s must not be zero");
 			}
 
-			std::deque<DoseCalcType> dataDifferential = this->_dvh->getDataDifferential();
+			const core::DVH::DataDifferentialType& dataDifferential = this->_dvh->getDataDifferential();
 			double ntcp = 1;
 
 			for (GridIndexType i = 0; i < dataDifferential.size(); i++)
@@ -167,10 +167,8 @@ namespace rttb
 
 		BioModelValueType TCPLQModel::calcModel(const double doseFactor)
 		{
-			core::DVH variantDVH = core::DVH(_dvh->getDataDifferential(),
-			                                 (DoseTypeGy)(_dvh->getDeltaD() * doseFactor),
-			                                 _dvh->getDeltaV(), "temporary", "temporary");
-			auto spDVH = boost::make_shared<core::DVH>(variantDVH);
+			//the scaled DVH shares the histogram of _dvh
+			auto spDVH = boost::make_shared<core::DVH>(*_dvh, (DoseTypeGy)(_dvh->getDeltaD() * doseFactor));
 
 			BioModelValueType value = 0;
 
@@ -189,7 +187,7 @@ namespace rttb
 				std::map<rttb::DoseTypeGy, rttb::DoseCalcType> dataBED = calcBEDDVH(spDVH, _numberOfFractions,
 				        _alpha_beta);
 
-				value = (BioModelValueType)this->calcTCP(dataBED, _rho, _alphaMean, variantDVH.getDeltaV());
+				value = (BioModelValueType)this->calcTCP(dataBED, _rho, _alphaMean, spDVH->getDeltaV());
 				return value;
 			}
 
@@ -210,7 +208,7 @@ namespace rttb
 				        _alpha_beta);
 				value = (BioModelValueType)(this->calcTCPAlphaNormalDistribution(dataBED, _rho, _alphaMean,
 				                            _alphaVariance,
-				                            variantDVH.getDeltaV()));
+				                            spDVH->getDeltaV()));
 				return value;
 			}
 		}
@@ -0,0 +1,52 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+#include "DummyPolygon.h"
+
+namespace rttb
+{
+	namespace testing
+	{
+
+		DummyPolygon::BoostPolygon2D DummyPolygon::createRectangle(double xMin, double yMin, double xMax, double yMax,
+		        bool clockwise)
+		{
+			BoostPolygon2D polygon;
+			polygon.outer().push_back(BoostPoint2D(xMin, yMin));
+
+			if (clockwise)
+			{
+				polygon.outer().push_back(BoostPoint2D(xMin, yMax));
+				polygon.outer().push_back(BoostPoint2D(xMax, yMax));
+				polygon.outer().push_back(BoostPoint2D(xMax, yMin));
+			}
+			else
+			{
+				polygon.outer().push_back(BoostPoint2D(xMax, yMin));
+				polygon.outer().push_back(BoostPoint2D(xMax, yMax));
+				polygon.outer().push_back(BoostPoint2D(xMin, yMax));
+			}
+
+			polygon.outer().push_back(BoostPoint2D(xMin, yMin));
+			return polygon;
+		}
+
+		DummyPolygon::BoostPolygon2D DummyPolygon::createSquare(double xMin, double yMin, double size, bool clockwise)
+		{
+			return createRectangle(xMin, yMin, xMin + size, yMin + size, clockwise);
+		}
+
+	}//end namespace testing
+}//end namespace rttb
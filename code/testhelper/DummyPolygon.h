@@ -0,0 +1,52 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+#ifndef __DUMMY_POLYGON_H
+#define __DUMMY_POLYGON_H
+
+#include <boost/geometry/geometries/point_xy.hpp>
+#include <boost/geometry/geometries/polygon.hpp>
+
+#include "RTTBTestHelperExports.h"
+
+namespace rttb
+{
+	namespace testing
+	{
+
+		/*! @class DummyPolygon
+			@brief generate simple 2D polygons for testing the voxelization engines of BoostMask
+			(e.g. BoostMaskScanlineRasterizer and BoostMaskBoundaryClassifier).
+		*/
+		class RTTBTestHelper_EXPORT DummyPolygon
+		{
+		public:
+			using BoostPoint2D = ::boost::geometry::model::d2::point_xy<double>;
+			using BoostPolygon2D = ::boost::geometry::model::polygon<BoostPoint2D>;
+
+			/*! @brief closed rectangle [xMin, xMax] x [yMin, yMax] without holes
+				@param clockwise orientation of the outer ring
+			*/
+			static BoostPolygon2D createRectangle(double xMin, double yMin, double xMax, double yMax, bool clockwise);
+
+			/*! @brief closed square [xMin, xMin + size] x [yMin, yMin + size] without holes
+				@param clockwise orientation of the outer ring
+			*/
+			static BoostPolygon2D createSquare(double xMin, double yMin, double size, bool clockwise);
+		};
+	}
+}
+
+#endif
@@ -5,11 +5,13 @@ SET(CPP_FILES
 	DummyMutableDoseAccessor.cpp
 	DummyDVHGenerator.cpp
 	DummyStructure.cpp
+	DummyPolygon.cpp
 	CreateTestStructure.cpp	
   )
 
 SET(H_FILES 
 	DummyStructure.h
+	DummyPolygon.h
 	DummyDoseAccessor.h
 	DummyInhomogeneousDoseAccessor.h
 	DummyMaskAccessor.h
@@ -13,6 +13,8 @@
 //
 //------------------------------------------------------------------------
 
+#include <vector>
+
 #include <boost/make_shared.hpp>
 #include <boost/shared_ptr.hpp>
 
@@ -25,6 +27,7 @@
 #include "rttbArithmetic.h"
 #include "rttbNullPointerException.h"
 #include "rttbInvalidParameterException.h"
+#include "rttbIndexOutOfBoundsException.h"
 #include "rttbBinaryFunctorAccessor.h"
 
 namespace rttb
@@ -40,6 +43,7 @@ namespace rttb
 		/*! @brief BinaryFunctorAccessorTest - tests functors of two accessors
 				1) test constructor
 				2) test getDoseAt
+				3) test bulk access (getValues/getSlice)
 			*/
 
 		int BinaryFunctorAccessorTest(int argc, char* argv[])
@@ -119,6 +123,20 @@ namespace rttb
 			CHECK_EQUAL(spBinaryFunctorDoseAccessorAddWeighted->getValueAt(aIdInvalid), -1.0);
 			CHECK_EQUAL(spBinaryFunctorDoseAccessorAddWeighted->getValueAt(aIndexInvalid), -1.0);
 
+			//3) test bulk access
+			const core::GeometricInfo& geoInfo = spBinaryFunctorDoseAccessorAddWeighted->getGeometricInfo();
+			const GridSizeType sliceSize = geoInfo.getNumColumns() * geoInfo.getNumRows();
+			std::vector<GenericValueType> sliceValues(sliceSize);
+			CHECK_NO_THROW(spBinaryFunctorDoseAccessorAddWeighted->getSlice(2, sliceValues.data()));
+
+			for (GridSizeType i = 0; i < sliceSize; ++i)
+			{
+				CHECK_EQUAL(sliceValues[i], spBinaryFunctorDoseAccessorAddWeighted->getValueAt(static_cast<VoxelGridID>(2 * sliceSize + i)));
+			}
+
+			CHECK_THROW_EXPLICIT(spBinaryFunctorDoseAccessorAdd->getValues(aIdInvalid, 1, sliceValues.data()),
+			                     core::IndexOutOfBoundsException);
+
 			RETURN_AND_REPORT_TEST_SUCCESS;
 		}
 	}
@@ -0,0 +1,131 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+// this file defines the rttbAlgorithmsTests for the test driver
+// and all it expects is that you have a function called RegisterTests
+
+#include <vector>
+
+#include "litCheckMacros.h"
+
+#include "rttbBaseType.h"
+#include "rttbDoseExtremaTracker.h"
+
+namespace rttb
+{
+	namespace testing
+	{
+
+		/*! @brief DoseExtremaTrackerTest - test the API of DoseExtremaTracker
+		1) test empty tracker
+		2) test minimum/maximum positions (ties in iteration order, reset on a new extremum)
+		3) test hottest/coldest voxels (order, ties, block-wise insertion)
+		*/
+
+		int DoseExtremaTrackerTest(int /*argc*/, char* /*argv*/[])
+		{
+			PREPARE_DEFAULT_TEST_REPORTING;
+
+			//1) test empty tracker
+			algorithms::DoseExtremaTracker emptyTracker(3, 3);
+			CHECK_EQUAL(emptyTracker.getNumberOfValues(), 0);
+			CHECK(emptyTracker.getMinimumPositions()->empty());
+			CHECK(emptyTracker.getMaximumPositions()->empty());
+			CHECK(emptyTracker.getColdestVoxels()->empty());
+			CHECK(emptyTracker.getHottestVoxels()->empty());
+
+			//2) test minimum/maximum positions
+			const std::vector<DoseTypeGy> doseValues = {2, 5, 1, 5, 3, 1, 5, 0.5, 4, 5, 0.5};
+			std::vector<VoxelGridID> ids;
+
+			for (std::size_t i = 0; i < doseValues.size(); ++i)
+			{
+				ids.push_back(static_cast<VoxelGridID>(100 + i));
+			}
+
+			algorithms::DoseExtremaTracker tracker(3, 2);
+			tracker.insert(doseValues.data(), ids.data(), doseValues.size());
+			CHECK_EQUAL(tracker.getNumberOfValues(), doseValues.size());
+			CHECK_EQUAL(tracker.getMinimum(), 0.5);
+			CHECK_EQUAL(tracker.getMaximum(), 5);
+
+			auto maximumPositions = tracker.getMaximumPositions();
+			CHECK_EQUAL(maximumPositions->size(), 2);
+			CHECK_EQUAL(maximumPositions->at(0).first, 5);
+			CHECK_EQUAL(maximumPositions->at(0).second, 101);
+			CHECK_EQUAL(maximumPositions->at(1).second, 103);
+
+			//the positions of 1 Gy are dropped when 0.5 Gy is found
+			auto minimumPositions = tracker.getMinimumPositions();
+			CHECK_EQUAL(minimumPositions->size(), 2);
+			CHECK_EQUAL(minimumPositions->at(0).first, 0.5);
+			CHECK_EQUAL(minimumPositions->at(0).second, 107);
+			CHECK_EQUAL(minimumPositions->at(1).second, 110);
+
+			//3) test hottest/coldest voxels
+			auto hottestVoxels = tracker.getHottestVoxels();
+			CHECK_EQUAL(hottestVoxels->size(), 2);
+			CHECK_EQUAL(hottestVoxels->at(0).second, 101);
+			CHECK_EQUAL(hottestVoxels->at(1).second, 103);
+
+			auto coldestVoxels = tracker.getColdestVoxels();
+			CHECK_EQUAL(coldestVoxels->size(), 3);
+			CHECK_EQUAL(coldestVoxels->at(0).first, 0.5);
+			CHECK_EQUAL(coldestVoxels->at(0).second, 107);
+			CHECK_EQUAL(coldestVoxels->at(1).second, 110);
+			CHECK_EQUAL(coldestVoxels->at(2).first, 1);
+			CHECK_EQUAL(coldestVoxels->at(2).second, 102);
+
+			//more voxels than maximum ties: the hottest voxels include lower doses in descending order
+			algorithms::DoseExtremaTracker largeTracker(6, 6);
+
+			for (std::size_t i = 0; i < doseValues.size(); ++i)
+			{
+				largeTracker.insert(&doseValues[i], &ids[i], 1);
+			}
+
+			hottestVoxels = largeTracker.getHottestVoxels();
+			CHECK_EQUAL(largeTracker.getMaximumPositions()->size(), 4);
+			CHECK_EQUAL(hottestVoxels->size(), 6);
+			const std::vector<DoseTypeGy> expectedHottestDoses = {5, 5, 5, 5, 4, 3};
+			const std::vector<VoxelGridID> expectedHottestIDs = {101, 103, 106, 109, 108, 104};
+
+			for (std::size_t i = 0; i < hottestVoxels->size(); ++i)
+			{
+				CHECK_EQUAL(hottestVoxels->at(i).first, expectedHottestDoses[i]);
+				CHECK_EQUAL(hottestVoxels->at(i).second, expectedHottestIDs[i]);
+			}
+
+			coldestVoxels = largeTracker.getColdestVoxels();
+			CHECK_EQUAL(coldestVoxels->size(), 6);
+			const std::vector<VoxelGridID> expectedColdestIDs = {107, 110, 102, 105, 100, 104};
+
+			for (std::size_t i = 0; i < coldestVoxels->size(); ++i)
+			{
+				CHECK_EQUAL(coldestVoxels->at(i).second, expectedColdestIDs[i]);
+			}
+
+			//k = 0: nothing is kept
+			algorithms::DoseExtremaTracker noPositionsTracker(0, 0);
+			noPositionsTracker.insert(doseValues.data(), ids.data(), doseValues.size());
+			CHECK_EQUAL(noPositionsTracker.getMaximum(), 5);
+			CHECK(noPositionsTracker.getMaximumPositions()->empty());
+			CHECK(noPositionsTracker.getHottestVoxels()->empty());
+			CHECK(noPositionsTracker.getColdestVoxels()->empty());
+
+			RETURN_AND_REPORT_TEST_SUCCESS;
+		}
+
+	}//end namespace testing
+}//end namespace rttb
@@ -0,0 +1,136 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+// this file defines the rttbAlgorithmsTests for the test driver
+// and all it expects is that you have a function called RegisterTests
+
+#include <cmath>
+#include <vector>
+
+#include "litCheckMacros.h"
+
+#include "rttbBaseType.h"
+#include "rttbDoseQuantileSketch.h"
+#include "rttbSortedDoseBuffer.h"
+#include "rttbInvalidParameterException.h"
+
+namespace rttb
+{
+	namespace testing
+	{
+
+		/*! @brief DoseQuantileSketchTest - test the API of DoseQuantileSketch
+		1) test constructor
+		2) test insert and buckets (relative accuracy, zero bucket, clipping)
+		3) test merge
+		4) test that quantiles of the buckets are within the relative accuracy
+		*/
+
+		int DoseQuantileSketchTest(int /*argc*/, char* /*argv*/[])
+		{
+			PREPARE_DEFAULT_TEST_REPORTING;
+
+			//1) test constructor
+			CHECK_THROW_EXPLICIT(algorithms::DoseQuantileSketch(0), core::InvalidParameterException);
+			CHECK_THROW_EXPLICIT(algorithms::DoseQuantileSketch(1), core::InvalidParameterException);
+			CHECK_THROW_EXPLICIT(algorithms::DoseQuantileSketch(-0.1), core::InvalidParameterException);
+			CHECK_NO_THROW(algorithms::DoseQuantileSketch(0.01));
+			algorithms::DoseQuantileSketch emptySketch(0.05);
+			CHECK_EQUAL(emptySketch.getRelativeAccuracy(), 0.05);
+			CHECK_EQUAL(emptySketch.getTotalVoxelProportion(), 0);
+			CHECK_EQUAL(emptySketch.getNumberOfBuckets(), 0);
+			std::vector<DoseTypeGy> representatives;
+			std::vector<FractionType> proportions;
+			emptySketch.getBuckets(representatives, proportions);
+			CHECK(representatives.empty());
+			CHECK(proportions.empty());
+
+			//2) test insert and buckets
+			const double accuracy = 0.01;
+			algorithms::DoseQuantileSketch sketch(accuracy);
+			sketch.insert(0, 1);
+			sketch.insert(1e-8, 0.5);
+			sketch.insert(1.001, 1);
+			sketch.insert(1.002, 0.25);
+			sketch.insert(60.0, 1);
+			CHECK_EQUAL(sketch.getTotalVoxelProportion(), 3.75);
+			//0 and 1e-8 share the zero bucket, 1.001 and 1.002 one bucket
+			CHECK_EQUAL(sketch.getNumberOfBuckets(), 3);
+			sketch.getBuckets(representatives, proportions);
+			CHECK_EQUAL(representatives.size(), 3);
+			CHECK_EQUAL(proportions.size(), 3);
+			CHECK_EQUAL(representatives[0], 0);
+			CHECK_EQUAL(proportions[0], 1.5);
+			CHECK(std::abs(representatives[1] - 1.001) <= accuracy * 1.001);
+			CHECK(std::abs(representatives[1] - 1.002) <= accuracy * 1.002);
+			CHECK_EQUAL(proportions[1], 1.25);
+			//clipped to the maximum
+			CHECK(representatives[2] <= 60.0);
+			CHECK(std::abs(representatives[2] - 60.0) <= accuracy * 60.0);
+			CHECK_EQUAL(proportions[2], 1);
+			CHECK(sketch.getMemorySize() > 0);
+
+			//3) test merge
+			algorithms::DoseQuantileSketch allValues(accuracy);
+			algorithms::DoseQuantileSketch lowerHalf(accuracy);
+			algorithms::DoseQuantileSketch upperHalf(accuracy);
+
+			for (int i = 0; i < 1000; ++i)
+			{
+				const DoseTypeGy dose = 0.07 * i;
+				allValues.insert(dose, 1);
+				(i % 2 == 0 ? lowerHalf : upperHalf).insert(dose, 1);
+			}
+
+			algorithms::DoseQuantileSketch differentAccuracy(0.02);
+			CHECK_THROW_EXPLICIT(lowerHalf.merge(differentAccuracy), core::InvalidParameterException);
+			CHECK_NO_THROW(upperHalf.merge(lowerHalf));
+			CHECK_EQUAL(upperHalf.getTotalVoxelProportion(), allValues.getTotalVoxelProportion());
+			std::vector<DoseTypeGy> mergedRepresentatives;
+			std::vector<FractionType> mergedProportions;
+			upperHalf.getBuckets(mergedRepresentatives, mergedProportions);
+			allValues.getBuckets(representatives, proportions);
+			CHECK_EQUAL(mergedRepresentatives == representatives, true);
+			CHECK_EQUAL(mergedProportions == proportions, true);
+
+			//4) test quantiles: the n-th highest value of the buckets is within the accuracy of the exact one
+			std::vector<DoseTypeGy> doses;
+			std::vector<FractionType> ones;
+
+			for (int i = 0; i < 1000; ++i)
+			{
+				doses.push_back(0.07 * i);
+				ones.push_back(1);
+			}
+
+			algorithms::SortedDoseBuffer exact(doses, ones);
+			algorithms::SortedDoseBuffer approximated(representatives, proportions);
+			bool withinAccuracy = true;
+
+			for (double numberOfVoxels = 0.5; numberOfVoxels < 1000; numberOfVoxels += 7.3)
+			{
+				const DoseTypeGy exactDose = exact.getDoseValues()[exact.findFromTop(numberOfVoxels)];
+				const DoseTypeGy approximatedDose = approximated.getDoseValues()[approximated.findFromTop(numberOfVoxels)];
+				withinAccuracy = withinAccuracy && std::abs(approximatedDose - exactDose) <= accuracy * exactDose + 1e-12;
+			}
+
+			CHECK(withinAccuracy);
+			CHECK(allValues.getNumberOfBuckets() < 1000);
+
+			RETURN_AND_REPORT_TEST_SUCCESS;
+		}
+
+	}//end namespace testing
+}//end namespace rttb
@@ -13,6 +13,9 @@
 //
 //------------------------------------------------------------------------
 
+#include <algorithm>
+#include <cmath>
+
 #include <boost/make_shared.hpp>
 #include <boost/shared_ptr.hpp>
 
@@ -23,6 +26,7 @@
 #include "rttbDoseIteratorInterface.h"
 #include "rttbNullPointerException.h"
 #include "rttbDoseStatisticsCalculator.h"
+#include "rttbDVHCalculator.h"
 #include "rttbInvalidDoseException.h"
 #include "rttbInvalidParameterException.h"
 #include "rttbDataNotAvailableException.h"
@@ -51,6 +55,9 @@ namespace rttb
 			2) test setDoseIterator
 			3) test calculateDoseSatistics
 			4) get statistical values
+			5) test calculateDVH
+			6) test multithreading
+			7) test approximate mode
 		*/
 
 		int DoseStatisticsCalculatorTest(int argc, char* argv[])
@@ -294,6 +301,26 @@ namespace rttb
 				CHECK_EQUAL(minimaPositionsIterator->first, theStatistics->getMinimum());
 			}
 
+			//the (default) 10 hottest/coldest voxels are the top of the sorted doses, with matching positions
+			std::vector<DoseTypeGy> sortedDoseVals(*doseVals);
+			std::sort(sortedDoseVals.begin(), sortedDoseVals.end());
+			auto hottestVoxels = theStatistics->getHottestVoxels();
+			auto coldestVoxels = theStatistics->getColdestVoxels();
+			CHECK_EQUAL(hottestVoxels->size(), 10);
+			CHECK_EQUAL(coldestVoxels->size(), 10);
+
+			for (std::size_t i = 0; i < hottestVoxels->size(); ++i)
+			{
+				CHECK_EQUAL(hottestVoxels->at(i).first, sortedDoseVals.at(sortedDoseVals.size() - 1 - i));
+				CHECK_EQUAL(doseVals->at(hottestVoxels->at(i).second), hottestVoxels->at(i).first);
+			}
+
+			for (std::size_t i = 0; i < coldestVoxels->size(); ++i)
+			{
+				CHECK_EQUAL(coldestVoxels->at(i).first, sortedDoseVals.at(i));
+				CHECK_EQUAL(doseVals->at(coldestVoxels->at(i).second), coldestVoxels->at(i).first);
+			}
+
 
 			//generate specific example dose
 			maximum = 9.5;
@@ -349,6 +376,146 @@ namespace rttb
 				CHECK_EQUAL(minimaPositionsIterator->first, theStatistics3->getMinimum());
 			}
 
+			//5) test calculateDVH
+			const IDType structureID = "myStructure";
+			const IDType doseID = "myDose";
+			rttb::algorithms::DoseStatisticsCalculator myDVHStatsCalculator(spDoseIterator);
+			CHECK_THROW_EXPLICIT(myDVHStatsCalculator.calculateDVH(structureID, doseID), core::InvalidDoseException);
+			CHECK_NO_THROW(myDVHStatsCalculator.calculateDoseStatistics(true));
+
+			core::DVH::Pointer fusedDVH;
+			CHECK_NO_THROW(fusedDVH = myDVHStatsCalculator.calculateDVH(structureID, doseID));
+			core::DVHCalculator referenceDVHCalculator(spDoseIterator, structureID, doseID);
+			CHECK(*fusedDVH == *(referenceDVHCalculator.generateDVH()));
+
+			CHECK_NO_THROW(fusedDVH = myDVHStatsCalculator.calculateDVH(structureID, doseID, 5.0, 300));
+			core::DVHCalculator referenceDVHCalculator2(spDoseIterator, structureID, doseID, 5.0, 300);
+			CHECK(*fusedDVH == *(referenceDVHCalculator2.generateDVH()));
+			CHECK_THROW_EXPLICIT(myDVHStatsCalculator.calculateDVH(structureID, doseID, 0, 0),
+				core::InvalidParameterException);
+
+			//6) test multithreading: same results as the sequential computation, also after recalculateDoseStatistics()
+			std::vector<double> manyPrecomputeValues;
+
+			for (int i = 1; i < 100; ++i)
+			{
+				manyPrecomputeValues.push_back(i * 0.01);
+			}
+
+			rttb::algorithms::DoseStatisticsCalculator sequentialCalculator(spDoseIterator);
+			rttb::algorithms::DoseStatisticsCalculator parallelCalculator(spDoseIterator);
+			parallelCalculator.setMultiThreading(true);
+			DoseStatisticsPointer sequentialStatistics = sequentialCalculator.calculateDoseStatistics(manyPrecomputeValues,
+				manyPrecomputeValues, 100.0);
+			DoseStatisticsPointer parallelStatistics;
+			CHECK_NO_THROW(parallelStatistics = parallelCalculator.calculateDoseStatistics(manyPrecomputeValues,
+				manyPrecomputeValues, 100.0));
+			CHECK(checkEqualDoseStatistic(sequentialStatistics, parallelStatistics));
+			//the sums are reduced blockwise, so the simple statistics are bit-identical
+			CHECK_EQUAL(parallelStatistics->getMean(), sequentialStatistics->getMean());
+			CHECK_EQUAL(parallelStatistics->getStdDeviation(), sequentialStatistics->getStdDeviation());
+			CHECK_EQUAL(parallelStatistics->getNumberOfVoxels(), sequentialStatistics->getNumberOfVoxels());
+			CHECK_EQUAL(parallelStatistics->getVx().getAllValues().size(), manyPrecomputeValues.size());
+			CHECK_EQUAL(parallelStatistics->getMinOCx().getAllValues().size(), manyPrecomputeValues.size());
+
+			sequentialCalculator.addPrecomputeValues({ 0.005, 0.995 });
+			parallelCalculator.addPrecomputeValues({ 0.005, 0.995 });
+			sequentialCalculator.recalculateDoseStatistics();
+			CHECK_NO_THROW(parallelCalculator.recalculateDoseStatistics());
+			CHECK(checkEqualDoseStatistic(sequentialStatistics, parallelStatistics));
+			CHECK_EQUAL(parallelStatistics->getDx().getAllValues().size(), manyPrecomputeValues.size() + 2);
+
+			//7) test approximate mode: Dx, MOHx and MOCx within the relative error bound, Vx between the exact volumes of the
+			//doses x/(1-relativeAccuracy) and x/(1+relativeAccuracy), no MaxOHx/MinOCx.
+			//The exact MOHx/MOCx include the whole voxel at the border, which may add up to maximum/(number of voxels).
+			rttb::algorithms::DoseStatisticsCalculator approximateCalculator(spDoseIterator);
+			CHECK_THROW_EXPLICIT(approximateCalculator.setApproximateMode(true, 0), core::InvalidParameterException);
+			CHECK_THROW_EXPLICIT(approximateCalculator.setApproximateMode(true, 1.5), core::InvalidParameterException);
+			const double relativeAccuracy = 0.005;
+			CHECK_NO_THROW(approximateCalculator.setApproximateMode(true, relativeAccuracy));
+			DoseStatisticsPointer approximateStatistics;
+			CHECK_NO_THROW(approximateStatistics = approximateCalculator.calculateDoseStatistics(manyPrecomputeValues,
+				manyPrecomputeValues, 100.0));
+			CHECK_EQUAL(sequentialStatistics->getRelativeErrorBound(), 0);
+			CHECK_EQUAL(approximateStatistics->getRelativeErrorBound(), relativeAccuracy);
+			CHECK_EQUAL(approximateStatistics->getMinimum(), sequentialStatistics->getMinimum());
+			CHECK_EQUAL(approximateStatistics->getMaximum(), sequentialStatistics->getMaximum());
+			//the values are streamed in blocks instead of being buffered, the blockwise sums are still the same
+			CHECK_EQUAL(approximateStatistics->getMean(), sequentialStatistics->getMean());
+			CHECK_EQUAL(approximateStatistics->getStdDeviation(), sequentialStatistics->getStdDeviation());
+			CHECK_EQUAL(approximateStatistics->getNumberOfVoxels(), sequentialStatistics->getNumberOfVoxels());
+			CHECK(*(approximateStatistics->getMaximumVoxelPositions()) == *(sequentialStatistics->getMaximumVoxelPositions()));
+			CHECK(*(approximateStatistics->getMinimumVoxelPositions()) == *(sequentialStatistics->getMinimumVoxelPositions()));
+			const auto approximateVx = approximateStatistics->getVx().getAllValues();
+			CHECK_EQUAL(approximateVx.size(), manyPrecomputeValues.size());
+			std::vector<double> vxBoundValues;
+
+			for (const auto& value : manyPrecomputeValues)
+			{
+				vxBoundValues.push_back(value / (1 - relativeAccuracy));
+				vxBoundValues.push_back(value / (1 + relativeAccuracy));
+			}
+
+			rttb::algorithms::VxDoseToVolumeMeasureCollectionCalculator vxBoundCalculator(vxBoundValues, 100.0,
+				spDoseIterator);
+			vxBoundCalculator.compute();
+			const auto vxBounds = vxBoundCalculator.getMeasureCollection()->getAllValues();
+			bool vxWithinBounds = true;
+
+			for (const auto& value : manyPrecomputeValues)
+			{
+				const auto vx = approximateVx.find(value * 100.0);
+				vxWithinBounds = vxWithinBounds && vx != approximateVx.end() &&
+					vx->second >= vxBounds.find(value / (1 - relativeAccuracy) * 100.0)->second - errorConstant &&
+					vx->second <= vxBounds.find(value / (1 + relativeAccuracy) * 100.0)->second + errorConstant;
+			}
+
+			CHECK(vxWithinBounds);
+
+			//the partial sketches are merged in block order, so the result does not depend on the number of threads
+			rttb::algorithms::DoseStatisticsCalculator parallelApproximateCalculator(spDoseIterator);
+			parallelApproximateCalculator.setApproximateMode(true, relativeAccuracy);
+			parallelApproximateCalculator.setMultiThreading(true);
+			DoseStatisticsPointer parallelApproximateStatistics;
+			CHECK_NO_THROW(parallelApproximateStatistics = parallelApproximateCalculator.calculateDoseStatistics(
+				manyPrecomputeValues, manyPrecomputeValues, 100.0));
+			CHECK(parallelApproximateStatistics->getVx().getAllValues() == approximateVx);
+			CHECK(parallelApproximateStatistics->getDx().getAllValues() == approximateStatistics->getDx().getAllValues());
+			CHECK(parallelApproximateStatistics->getMOHx().getAllValues() == approximateStatistics->getMOHx().getAllValues());
+			CHECK(approximateStatistics->getMaxOHx().getAllValues().empty());
+			CHECK(approximateStatistics->getMinOCx().getAllValues().empty());
+
+			const std::vector<std::pair<rttb::algorithms::VolumeToDoseMeasureCollection, rttb::algorithms::VolumeToDoseMeasureCollection> >
+			approximatedCollections = { { approximateStatistics->getDx(), sequentialStatistics->getDx() },
+				{ approximateStatistics->getMOHx(), sequentialStatistics->getMOHx() },
+				{ approximateStatistics->getMOCx(), sequentialStatistics->getMOCx() } };
+
+			const double voxelVolume = sequentialStatistics->getVolume() / sequentialStatistics->getNumberOfVoxels();
+			double borderVoxelFactor = 0;
+
+			for (const auto& collections : approximatedCollections)
+			{
+				const auto approximatedValues = collections.first.getAllValues();
+				const auto exactValues = collections.second.getAllValues();
+				CHECK_EQUAL(approximatedValues.size(), manyPrecomputeValues.size());
+				bool withinErrorBound = true;
+
+				for (const auto& approximatedValue : approximatedValues)
+				{
+					const auto exactValue = exactValues.find(approximatedValue.first);
+					withinErrorBound = withinErrorBound && exactValue != exactValues.end() &&
+						std::abs(approximatedValue.second - exactValue->second) <= relativeAccuracy * exactValue->second + errorConstant +
+						borderVoxelFactor * sequentialStatistics->getMaximum() * voxelVolume / approximatedValue.first;
+				}
+
+				CHECK(withinErrorBound);
+				borderVoxelFactor = 1;
+			}
+
+			core::DVH::Pointer approximateDVH;
+			CHECK_NO_THROW(approximateDVH = approximateCalculator.calculateDVH(structureID, doseID));
+			CHECK(*approximateDVH == *(referenceDVHCalculator.generateDVH()));
+
 			// compare with actual XML
 			io::dicom::DicomFileDoseAccessorGenerator doseAccessorGenerator(doseFilename.c_str());
 			core::DoseAccessorInterface::Pointer doseAccessorPointer(doseAccessorGenerator.generateDoseAccessor());
@@ -0,0 +1,149 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+// this file defines the rttbAlgorithmsTests for the test driver
+// and all it expects is that you have a function called RegisterTests
+
+#include <map>
+#include <vector>
+
+#include <boost/make_shared.hpp>
+
+#include "litCheckMacros.h"
+
+#include "rttbBaseType.h"
+#include "rttbSortedDoseBuffer.h"
+#include "rttbInvalidParameterException.h"
+
+namespace rttb
+{
+	namespace testing
+	{
+
+		/*! @brief SortedDoseBufferTest - test the API of SortedDoseBuffer
+		1) test constructor
+		2) test sorting (ascending, equal doses keep their order) and cumulative sums
+		3) test queries
+		4) test that the result does not depend on the number of threads
+		*/
+
+		int SortedDoseBufferTest(int /*argc*/, char* /*argv*/[])
+		{
+			PREPARE_DEFAULT_TEST_REPORTING;
+
+			//1) test constructor
+			const std::vector<DoseTypeGy> emptyDoses;
+			const std::vector<FractionType> emptyProportions;
+			const std::vector<FractionType> oneProportion(1, 1.0);
+			CHECK_THROW_EXPLICIT(algorithms::SortedDoseBuffer(emptyDoses, oneProportion), core::InvalidParameterException);
+			CHECK_NO_THROW(algorithms::SortedDoseBuffer(emptyDoses, emptyProportions));
+			algorithms::SortedDoseBuffer emptyBuffer(emptyDoses, emptyProportions);
+			CHECK(emptyBuffer.empty());
+			CHECK_EQUAL(emptyBuffer.size(), 0);
+			CHECK_EQUAL(emptyBuffer.getTotalVoxelProportion(), 0);
+			CHECK_EQUAL(emptyBuffer.getVoxelProportionAtLeast(1.0), 0);
+			CHECK_EQUAL(emptyBuffer.findFromTop(1.0), 0);
+			CHECK_EQUAL(emptyBuffer.findFromBottom(1.0), 0);
+
+			//2) test sorting and cumulative sums
+			const std::vector<DoseTypeGy> doses = {3.5, 1.25, 7.0, 1.25, 0.0, 3.5};
+			const std::vector<FractionType> proportions = {0.1, 0.2, 0.3, 0.4, 0.5, 0.6};
+			algorithms::SortedDoseBuffer buffer(doses, proportions);
+
+			const std::vector<DoseTypeGy> expectedDoses = {0.0, 1.25, 1.25, 3.5, 3.5, 7.0};
+			//proportions in sorted order: 0.5, 0.2, 0.4, 0.1, 0.6, 0.3
+			const std::vector<FractionType> expectedCumulativeProportions = {2.1, 1.6, 1.4, 1.0, 0.9, 0.3, 0.0};
+			const std::vector<DoseCalcType> expectedCumulativeDoses = {5.3, 5.3, 5.05, 4.55, 4.2, 2.1, 0.0};
+			CHECK_EQUAL(buffer.size(), doses.size());
+			CHECK(buffer.getDoseValues() == expectedDoses);
+
+			for (std::size_t i = 0; i <= buffer.size(); ++i)
+			{
+				CHECK_CLOSE(buffer.getCumulativeVoxelProportion(i), expectedCumulativeProportions[i], errorConstant);
+				CHECK_CLOSE(buffer.getCumulativeDose(i), expectedCumulativeDoses[i], errorConstant);
+			}
+
+			CHECK_CLOSE(buffer.getTotalVoxelProportion(), 2.1, errorConstant);
+			CHECK_EQUAL(buffer.getMemorySize(), doses.size() * sizeof(DoseTypeGy) + (doses.size() + 1) * (sizeof(
+			                FractionType) + sizeof(DoseCalcType)));
+
+			//3) test queries
+			CHECK_CLOSE(buffer.getVoxelProportionAtLeast(-1.0), 2.1, errorConstant);
+			CHECK_CLOSE(buffer.getVoxelProportionAtLeast(1.25), 1.6, errorConstant);
+			CHECK_CLOSE(buffer.getVoxelProportionAtLeast(3.5), 1.0, errorConstant);
+			CHECK_CLOSE(buffer.getVoxelProportionAtLeast(3.6), 0.3, errorConstant);
+			CHECK_EQUAL(buffer.getVoxelProportionAtLeast(7.5), 0);
+
+			CHECK_EQUAL(buffer.findFromTop(0.0), 5);
+			CHECK_EQUAL(buffer.findFromTop(0.3), 5);
+			CHECK_EQUAL(buffer.findFromTop(0.5), 4);
+			CHECK_EQUAL(buffer.findFromTop(1.5), 1);
+			CHECK_EQUAL(buffer.findFromTop(2.0), 0);
+			CHECK_EQUAL(buffer.findFromTop(2.5), buffer.size());
+
+			CHECK_EQUAL(buffer.findFromBottom(0.0), 0);
+			CHECK_EQUAL(buffer.findFromBottom(0.4), 0);
+			CHECK_EQUAL(buffer.findFromBottom(0.6), 1);
+			CHECK_EQUAL(buffer.findFromBottom(1.15), 3);
+			CHECK_EQUAL(buffer.findFromBottom(2.0), 5);
+			CHECK_EQUAL(buffer.findFromBottom(2.5), buffer.size());
+
+			//4) test that the result does not depend on the number of threads
+			std::vector<DoseTypeGy> manyDoses(300000);
+			std::vector<FractionType> manyProportions(manyDoses.size());
+			std::multimap<DoseTypeGy, std::size_t> reference;
+
+			for (std::size_t i = 0; i < manyDoses.size(); ++i)
+			{
+				manyDoses[i] = static_cast<DoseTypeGy>((i * 7919) % 1000) / 10.0;
+				manyProportions[i] = static_cast<FractionType>(i % 13) / 13.0;
+				reference.insert(std::make_pair(manyDoses[i], i));
+			}
+
+			algorithms::SortedDoseBuffer singleThreadedBuffer(manyDoses, manyProportions, 1);
+			bool sortedAsReference = true;
+			FractionType cumulativeProportion = 0;
+			std::size_t pos = manyDoses.size();
+
+			for (auto entry = reference.crbegin(); entry != reference.crend(); ++entry)
+			{
+				--pos;
+				cumulativeProportion += manyProportions[entry->second];
+				sortedAsReference = sortedAsReference && singleThreadedBuffer.getDoseValues()[pos] == entry->first
+				                    && singleThreadedBuffer.getCumulativeVoxelProportion(pos) == cumulativeProportion;
+			}
+
+			CHECK(sortedAsReference);
+
+			for (unsigned int numberOfThreads : {2u, 3u, 0u})
+			{
+				algorithms::SortedDoseBuffer parallelBuffer(manyDoses, manyProportions, numberOfThreads);
+				bool sameAsSingleThreaded = parallelBuffer.getDoseValues() == singleThreadedBuffer.getDoseValues();
+
+				for (std::size_t i = 0; i <= parallelBuffer.size(); ++i)
+				{
+					sameAsSingleThreaded = sameAsSingleThreaded
+					                       && parallelBuffer.getCumulativeVoxelProportion(i) == singleThreadedBuffer.getCumulativeVoxelProportion(i)
+					                       && parallelBuffer.getCumulativeDose(i) == singleThreadedBuffer.getCumulativeDose(i);
+				}
+
+				CHECK(sameAsSingleThreaded);
+			}
+
+			RETURN_AND_REPORT_TEST_SUCCESS;
+		}
+
+	}//end namespace testing
+}//end namespace rttb
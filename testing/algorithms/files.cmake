@@ -3,6 +3,9 @@ SET(CPP_FILES
 	DoseStatisticsCalculatorTest.cpp
 	ArithmeticTest.cpp
 	BinaryFunctorAccessorTest.cpp
+	SortedDoseBufferTest.cpp
+	DoseQuantileSketchTest.cpp
+	DoseExtremaTrackerTest.cpp
 	rttbAlgorithmsTests.cpp
 	../io/other/CompareDoseStatistic.cpp
 	../../code/io/other/rttbDoseStatisticsXMLReader.cpp
@@ -33,6 +33,9 @@ namespace rttb
 			LIT_REGISTER_TEST(DoseStatisticsCalculatorTest);
 			LIT_REGISTER_TEST(ArithmeticTest);
 			LIT_REGISTER_TEST(BinaryFunctorAccessorTest);
+			LIT_REGISTER_TEST(SortedDoseBufferTest);
+			LIT_REGISTER_TEST(DoseQuantileSketchTest);
+			LIT_REGISTER_TEST(DoseExtremaTrackerTest);
 		}
 	}
 }
@@ -0,0 +1,113 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+#include <algorithm>
+#include <vector>
+
+#include <boost/make_shared.hpp>
+
+#include "litCheckMacros.h"
+
+#include "rttbBaseType.h"
+#include "rttbAccessorInterface.h"
+#include "rttbIndexOutOfBoundsException.h"
+#include "DummyDoseAccessor.h"
+
+namespace rttb
+{
+	namespace testing
+	{
+
+		/*! @brief AccessorInterfaceTest - test the bulk value access of AccessorInterface
+			1) test getValues
+			2) test getValuesInRegion
+			3) test getSlice
+		*/
+		int AccessorInterfaceTest(int /*argc*/, char* /*argv*/[])
+		{
+			PREPARE_DEFAULT_TEST_REPORTING;
+
+			boost::shared_ptr<DummyDoseAccessor> spTestDoseAccessor = boost::make_shared<DummyDoseAccessor>();
+			core::AccessorInterface::ConstPointer spAccessor(spTestDoseAccessor);
+			const std::vector<DoseTypeGy>* doseVals = spTestDoseAccessor->getDoseVector();
+			const core::GeometricInfo& geoInfo = spAccessor->getGeometricInfo();
+			const GridSizeType numberOfVoxels = spAccessor->getGridSize();
+
+			//1) test getValues
+			std::vector<GenericValueType> values(numberOfVoxels, -1);
+			CHECK_NO_THROW(spAccessor->getValues(0, numberOfVoxels, values.data()));
+			CHECK(values == *doseVals);
+
+			std::vector<GenericValueType> partialValues(5, -1);
+			CHECK_NO_THROW(spAccessor->getValues(17, 5, partialValues.data()));
+
+			for (VoxelGridID i = 0; i < 5; ++i)
+			{
+				CHECK_EQUAL(partialValues[i], doseVals->at(17 + i));
+			}
+
+			CHECK_NO_THROW(spAccessor->getValues(static_cast<VoxelGridID>(numberOfVoxels), 0, partialValues.data()));
+			CHECK_THROW_EXPLICIT(spAccessor->getValues(-1, 5, partialValues.data()), core::IndexOutOfBoundsException);
+			CHECK_THROW_EXPLICIT(spAccessor->getValues(static_cast<VoxelGridID>(numberOfVoxels) - 4, 5,
+			                     partialValues.data()), core::IndexOutOfBoundsException);
+
+			//2) test getValuesInRegion
+			const VoxelGridIndex3D regionStart(2, 3, 1);
+			const ImageSize regionSize(4, 5, 3);
+			std::vector<GenericValueType> regionValues(regionSize(0) * regionSize(1) * regionSize(2), -1);
+			CHECK_NO_THROW(spAccessor->getValuesInRegion(regionStart, regionSize, regionValues.data()));
+
+			auto regionValueItr = regionValues.cbegin();
+
+			for (GridIndexType z = regionStart.z(); z < regionStart.z() + regionSize(2); ++z)
+			{
+				for (GridIndexType y = regionStart.y(); y < regionStart.y() + regionSize(1); ++y)
+				{
+					for (GridIndexType x = regionStart.x(); x < regionStart.x() + regionSize(0); ++x)
+					{
+						CHECK_EQUAL(*regionValueItr, spAccessor->getValueAt(VoxelGridIndex3D(x, y, z)));
+						++regionValueItr;
+					}
+				}
+			}
+
+			std::vector<GenericValueType> wholeGridValues(numberOfVoxels, -1);
+			CHECK_NO_THROW(spAccessor->getValuesInRegion(VoxelGridIndex3D(0), geoInfo.getImageSize(),
+			               wholeGridValues.data()));
+			CHECK(wholeGridValues == *doseVals);
+
+			CHECK_THROW_EXPLICIT(spAccessor->getValuesInRegion(VoxelGridIndex3D(8, 0, 0), ImageSize(3, 1, 1),
+			                     regionValues.data()), core::IndexOutOfBoundsException);
+			CHECK_THROW_EXPLICIT(spAccessor->getValuesInRegion(VoxelGridIndex3D(0, 0, 9), ImageSize(1, 1, 2),
+			                     regionValues.data()), core::IndexOutOfBoundsException);
+
+			//3) test getSlice
+			const GridSizeType sliceSize = geoInfo.getNumColumns() * geoInfo.getNumRows();
+			std::vector<GenericValueType> sliceValues(sliceSize, -1);
+
+			for (GridIndexType slice = 0; slice < geoInfo.getNumSlices(); ++slice)
+			{
+				CHECK_NO_THROW(spAccessor->getSlice(slice, sliceValues.data()));
+				CHECK(std::equal(sliceValues.cbegin(), sliceValues.cend(), doseVals->cbegin() + slice * sliceSize));
+			}
+
+			CHECK_THROW_EXPLICIT(spAccessor->getSlice(geoInfo.getNumSlices(), sliceValues.data()),
+			                     core::IndexOutOfBoundsException);
+
+			RETURN_AND_REPORT_TEST_SUCCESS;
+		}
+
+	}//end namespace testing
+}//end namespace rttb
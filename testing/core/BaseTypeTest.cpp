@@ -13,6 +13,8 @@
 //
 //------------------------------------------------------------------------
 
+#include <type_traits>
+
 #include "litCheckMacros.h"
 
 #include "rttbBaseType.h"
@@ -126,6 +128,25 @@ namespace rttb
       CHECK_EQUAL(sameAsWcUblas.equalsAlmost(sameAsWcUblasAlmost), true);
       CHECK_EQUAL(sameAsWcUblas.equalsAlmost(resultWC3DCrossComputedOrder), false);
 
+      static_assert(std::is_trivially_copyable<WorldCoordinate3D>::value, "WorldCoordinate3D must be trivially copyable");
+      static_assert(sizeof(WorldCoordinate3D) == 3 * sizeof(WorldCoordinate), "WorldCoordinate3D must not carry extra storage");
+      constexpr WorldCoordinate3D constexprWC3D = WorldCoordinate3D(1, 2, 3) + WorldCoordinate3D(3, 2, 1);
+      static_assert(constexprWC3D.x() == 4 && constexprWC3D.y() == 4 && constexprWC3D.z() == 4, "constexpr arithmetic");
+
+      WorldCoordinate3D normWC3D(3, 4, 12);
+      CHECK_EQUAL(normWC3D.dot(normWC3D), 169);
+      CHECK_EQUAL(normWC3D.norm(), 13);
+      CHECK_EQUAL(norm_2(normWC3D), 13);
+      CHECK_EQUAL(normWC3D.size(), 3);
+      CHECK_EQUAL(normWC3D[1], normWC3D(1));
+      CHECK_EQUAL(WorldCoordinate3D(1, 0, 0).cross(WorldCoordinate3D(0, 1, 0)) == WorldCoordinate3D(0, 0, 1), true);
+      WorldCoordinate3D scaledWC3D = normWC3D * 2.;
+      CHECK_EQUAL(scaledWC3D == WorldCoordinate3D(6, 8, 24), true);
+      scaledWC3D -= normWC3D;
+      CHECK_EQUAL(scaledWC3D == normWC3D, true);
+      scaledWC3D += normWC3D;
+      CHECK_EQUAL(scaledWC3D != normWC3D, true);
+
       //3) SpacingVectorType
       CHECK_NO_THROW(SpacingVectorType3D svt);
       SpacingVectorType3D emptySvt;
@@ -240,6 +261,11 @@ namespace rttb
 
       CHECK_EQUAL(vgi==vgiValue, false);
       CHECK_EQUAL(vgiValueDifferentSame == vgiValueDifferent, true);
+      CHECK_EQUAL(vgiValueDifferentSame != vgi, true);
+
+      static_assert(std::is_trivially_copyable<VoxelGridIndex3D>::value, "VoxelGridIndex3D must be trivially copyable");
+      vgiValueDifferentSame[2] -= 2;
+      CHECK_EQUAL(vgiValueDifferentSame.z(), 40u);
 
       //6) VoxelGridIndex2D
       CHECK_NO_THROW(VoxelGridIndex2D vgi2Dempty);
@@ -0,0 +1,158 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include <boost/make_shared.hpp>
+
+#include "litCheckMacros.h"
+
+#include "rttbBaseType.h"
+#include "rttbBlockCachedDoseAccessor.h"
+#include "rttbNullPointerException.h"
+#include "rttbInvalidParameterException.h"
+#include "rttbIndexOutOfBoundsException.h"
+#include "DummyDoseAccessor.h"
+
+namespace rttb
+{
+	namespace testing
+	{
+
+		/*! @brief BlockCachedDoseAccessorTest - test the API of BlockCachedDoseAccessor
+			1) test constructor
+			2) test getValueAt and hit/miss counters
+			3) test LRU eviction
+			4) test getValues
+			5) test concurrent access
+		*/
+		int BlockCachedDoseAccessorTest(int /*argc*/, char* /*argv*/[])
+		{
+			PREPARE_DEFAULT_TEST_REPORTING;
+
+			boost::shared_ptr<DummyDoseAccessor> spTestDoseAccessor = boost::make_shared<DummyDoseAccessor>();
+			core::AccessorInterface::ConstPointer spSourceAccessor(spTestDoseAccessor);
+			const std::vector<DoseTypeGy>* doseVals = spTestDoseAccessor->getDoseVector();
+			const core::GeometricInfo& geoInfo = spSourceAccessor->getGeometricInfo();
+			const GridSizeType numberOfVoxels = geoInfo.getNumberOfVoxels();
+
+			//1) test constructor
+			CHECK_THROW_EXPLICIT(core::BlockCachedDoseAccessor(core::AccessorInterface::ConstPointer()),
+			                     core::NullPointerException);
+			CHECK_THROW_EXPLICIT(core::BlockCachedDoseAccessor(spSourceAccessor, 0), core::InvalidParameterException);
+			CHECK_THROW_EXPLICIT(core::BlockCachedDoseAccessor(spSourceAccessor, 4, 0), core::InvalidParameterException);
+
+			//grid is 10x11x10 -> 3x3x3 tiles of (at most) 4x4x4 voxels
+			core::BlockCachedDoseAccessor cached(spSourceAccessor, 2, 4);
+			CHECK(cached.getGeometricInfo() == geoInfo);
+			CHECK_EQUAL(cached.getUID(), spSourceAccessor->getUID());
+			CHECK_EQUAL(cached.getTileSize(), 4);
+			CHECK_EQUAL(cached.getMaximumNumberOfTiles(), 2);
+			CHECK_EQUAL(cached.getNumberOfCachedTiles(), 0);
+
+			//2) test getValueAt and hit/miss counters
+			VoxelGridID id = 0;
+			const VoxelGridIndex3D index1(1, 2, 3);
+			geoInfo.convert(index1, id);
+			CHECK_EQUAL(cached.getValueAt(index1), doseVals->at(id));
+			CHECK_EQUAL(cached.getNumberOfMisses(), 1);
+			CHECK_EQUAL(cached.getNumberOfHits(), 0);
+			CHECK_EQUAL(cached.getValueAt(VoxelGridIndex3D(3, 3, 0)), spTestDoseAccessor->getValueAt(VoxelGridIndex3D(3, 3,
+			            0)));
+			CHECK_EQUAL(cached.getNumberOfMisses(), 1);
+			CHECK_EQUAL(cached.getNumberOfHits(), 1);
+
+			//border tile (clipped)
+			const VoxelGridIndex3D index2(9, 10, 9);
+			geoInfo.convert(index2, id);
+			CHECK_EQUAL(cached.getValueAt(id), doseVals->at(id));
+			CHECK_EQUAL(cached.getNumberOfMisses(), 2);
+			CHECK_EQUAL(cached.getNumberOfCachedTiles(), 2);
+
+			CHECK_EQUAL(cached.getValueAt(static_cast<VoxelGridID>(numberOfVoxels)), -1);
+			CHECK_EQUAL(cached.getValueAt(VoxelGridIndex3D(geoInfo.getNumColumns(), 0, 0)), -1);
+			CHECK_EQUAL(cached.getNumberOfMisses(), 2);
+
+			//3) test LRU eviction
+			//touch tile of index1 -> tile of index2 is least recently used
+			cached.getValueAt(index1);
+			cached.getValueAt(VoxelGridIndex3D(5, 0, 0));
+			CHECK_EQUAL(cached.getNumberOfMisses(), 3);
+			CHECK_EQUAL(cached.getNumberOfCachedTiles(), 2);
+			cached.getValueAt(index1);
+			CHECK_EQUAL(cached.getNumberOfMisses(), 3);
+			cached.getValueAt(index2);
+			CHECK_EQUAL(cached.getNumberOfMisses(), 4);
+			CHECK_EQUAL(cached.getNumberOfCachedTiles(), 2);
+
+			cached.resetCounters();
+			CHECK_EQUAL(cached.getNumberOfHits(), 0);
+			CHECK_EQUAL(cached.getNumberOfMisses(), 0);
+			cached.clearCache();
+			CHECK_EQUAL(cached.getNumberOfCachedTiles(), 0);
+			//the tile last read by this thread is not used after clearing
+			CHECK_EQUAL(cached.getValueAt(index2), doseVals->at(id));
+			CHECK_EQUAL(cached.getNumberOfMisses(), 1);
+			CHECK_EQUAL(cached.getValueAt(index2), doseVals->at(id));
+			CHECK_EQUAL(cached.getNumberOfHits(), 1);
+			CHECK_EQUAL(cached.getNumberOfCachedTiles(), 1);
+
+			//4) test getValues
+			std::vector<GenericValueType> values(numberOfVoxels);
+			CHECK_NO_THROW(cached.getValues(0, numberOfVoxels, values.data()));
+			CHECK(std::equal(values.cbegin(), values.cend(), doseVals->cbegin()));
+			CHECK_NO_THROW(cached.getValues(17, 23, values.data()));
+			CHECK(std::equal(values.cbegin(), values.cbegin() + 23, doseVals->cbegin() + 17));
+			CHECK_NO_THROW(cached.getValues(0, 0, values.data()));
+			CHECK_THROW_EXPLICIT(cached.getValues(static_cast<VoxelGridID>(numberOfVoxels) - 5, 10, values.data()),
+			                     core::IndexOutOfBoundsException);
+
+			//5) test concurrent access
+			core::BlockCachedDoseAccessor sharedCache(spSourceAccessor, 3, 4);
+			std::vector<std::thread> threads;
+			std::vector<int> errors(4, 0);
+
+			for (unsigned int i = 0; i < errors.size(); ++i)
+			{
+				threads.emplace_back([&sharedCache, &errors, doseVals, numberOfVoxels, i]()
+				{
+					for (GridSizeType j = 0; j < numberOfVoxels; ++j)
+					{
+						const auto aID = static_cast<VoxelGridID>((j * 7 + i * 101) % numberOfVoxels);
+
+						if (sharedCache.getValueAt(aID) != doseVals->at(aID))
+						{
+							++errors[i];
+						}
+					}
+				});
+			}
+
+			for (auto& thread : threads)
+			{
+				thread.join();
+			}
+
+			CHECK_EQUAL(std::count(errors.cbegin(), errors.cend(), 0), 4);
+			CHECK(sharedCache.getNumberOfCachedTiles() <= 3);
+			CHECK_EQUAL(sharedCache.getNumberOfHits() + sharedCache.getNumberOfMisses(), 4 * numberOfVoxels);
+
+			RETURN_AND_REPORT_TEST_SUCCESS;
+		}
+
+	}//end namespace testing
+}//end namespace rttb
@@ -0,0 +1,124 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+// this file defines the rttbCoreTests for the test driver
+// and all it expects is that you have a function called RegisterTests
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "litCheckMacros.h"
+
+#include "rttbBlockwiseReduction.h"
+#include "rttbCompensatedSum.h"
+#include "rttbInvalidParameterException.h"
+
+namespace rttb
+{
+	namespace testing
+	{
+		namespace
+		{
+			/*! @brief counts the values and the blocks that were reduced*/
+			struct ValueCounter
+			{
+				std::size_t numberOfValues = 0;
+				std::size_t numberOfMerges = 0;
+
+				void add(const ValueCounter& other)
+				{
+					numberOfValues += other.numberOfValues;
+					numberOfMerges += other.numberOfMerges + 1;
+				}
+			};
+
+			/*! @brief reduces values in calls of the given sizes (the last call takes the rest)*/
+			double reduceInCalls(const std::vector<double>& values, const std::vector<std::size_t>& callSizes,
+			                     bool multiThreading)
+			{
+				core::BlockwiseReduction<core::CompensatedSum> reduction(64);
+				std::size_t offset = 0;
+
+				for (std::size_t call = 0; call <= callSizes.size(); ++call)
+				{
+					const std::size_t callSize = call < callSizes.size() ? std::min(callSizes[call],
+					                             values.size() - offset) : values.size() - offset;
+					const double* callValues = values.data() + offset;
+
+					reduction.process(callSize, [callValues](std::size_t begin, std::size_t end, core::CompensatedSum & sum)
+					{
+						for (std::size_t i = begin; i < end; ++i)
+						{
+							sum.add(callValues[i]);
+						}
+					}, multiThreading);
+
+					offset += callSize;
+				}
+
+				return reduction.getResult().getSum();
+			}
+		}
+
+		/*! @brief BlockwiseReductionTest.
+			1) test constructor
+			2) test that every value is reduced once and blocks are merged
+			3) test that the result does not depend on the split into calls or on multi threading
+		*/
+		int BlockwiseReductionTest(int /*argc*/, char* /*argv*/[])
+		{
+			PREPARE_DEFAULT_TEST_REPORTING;
+
+			//1) test constructor
+			CHECK_THROW_EXPLICIT(core::BlockwiseReduction<core::CompensatedSum>(0), core::InvalidParameterException);
+			CHECK_EQUAL(core::BlockwiseReduction<core::CompensatedSum>().getBlockSize(),
+			            core::BlockwiseReduction<core::CompensatedSum>::defaultBlockSize);
+			CHECK_EQUAL(core::BlockwiseReduction<core::CompensatedSum>(10).getBlockSize(), 10);
+			CHECK_EQUAL(core::BlockwiseReduction<core::CompensatedSum>().getResult().getSum(), 0.0);
+
+			//2) test that every value is reduced once and blocks are merged
+			core::BlockwiseReduction<ValueCounter> counting(10);
+			auto countValues = [](std::size_t begin, std::size_t end, ValueCounter & counter)
+			{
+				counter.numberOfValues += end - begin;
+			};
+			counting.process(7, countValues);
+			counting.process(25, countValues, true);
+			counting.process(0, countValues);
+			counting.process(3, countValues);
+			//35 values: 3 complete blocks and 5 values of the current block
+			CHECK_EQUAL(counting.getResult().numberOfValues, 35);
+			CHECK_EQUAL(counting.getResult().numberOfMerges, 4);
+
+			//3) test that the result does not depend on the split into calls or on multi threading
+			std::vector<double> values(10000);
+
+			for (std::size_t i = 0; i < values.size(); ++i)
+			{
+				values[i] = (i % 7 == 0 ? 1e8 : 1e-3) * (i % 3 == 0 ? -1.0 : 1.0) + 0.1 * i;
+			}
+
+			const double reference = reduceInCalls(values, {}, false);
+			CHECK_EQUAL(reduceInCalls(values, {}, true), reference);
+			CHECK_EQUAL(reduceInCalls(values, { 1, 63, 64, 1000, 5 }, false), reference);
+			CHECK_EQUAL(reduceInCalls(values, { 1, 63, 64, 1000, 5 }, true), reference);
+			CHECK_EQUAL(reduceInCalls(values, { 100, 100, 100, 100, 100, 100 }, true), reference);
+
+			RETURN_AND_REPORT_TEST_SUCCESS;
+		}
+
+	}//end namespace testing
+}//end namespace rttb
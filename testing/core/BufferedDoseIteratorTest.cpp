@@ -0,0 +1,127 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+// this file defines the rttbCoreTests for the test driver
+// and all it expects is that you have a function called RegisterTests
+
+#include <vector>
+
+#include <boost/make_shared.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include "litCheckMacros.h"
+
+#include "rttbBaseType.h"
+#include "rttbBufferedDoseIterator.h"
+#include "rttbGenericDoseIterator.h"
+#include "rttbGenericMaskedDoseIterator.h"
+#include "rttbNullPointerException.h"
+#include "DummyDoseAccessor.h"
+#include "DummyMaskAccessor.h"
+
+namespace rttb
+{
+	namespace testing
+	{
+
+		typedef core::GenericMaskedDoseIterator::MaskAccessorPointer MaskAccessorPointer;
+		typedef core::GenericMaskedDoseIterator::DoseAccessorPointer DoseAccessorPointer;
+		typedef core::DoseIteratorInterface::Pointer DoseIteratorPointer;
+
+		/*! @brief BufferedDoseIteratorTest.
+			1) test constructor
+			2) test that all positions are replayed as read from the source (dose iterator and masked dose iterator)
+			3) test nextBlock
+		*/
+		int BufferedDoseIteratorTest(int /*argc*/, char* /*argv*/[])
+		{
+			PREPARE_DEFAULT_TEST_REPORTING;
+
+			DoseAccessorPointer spDoseAccessor = boost::make_shared<DummyDoseAccessor>();
+			MaskAccessorPointer spMaskAccessor = boost::make_shared<DummyMaskAccessor>(spDoseAccessor->getGeometricInfo());
+
+			DoseIteratorPointer spDoseIterator = boost::make_shared<core::GenericDoseIterator>(spDoseAccessor);
+			DoseIteratorPointer spMaskedDoseIterator = boost::make_shared<core::GenericMaskedDoseIterator>(spMaskAccessor,
+			        spDoseAccessor);
+
+			//1) test constructor
+			DoseIteratorPointer spNullDoseIterator;
+			CHECK_THROW_EXPLICIT(core::BufferedDoseIterator bufferedIterator(spNullDoseIterator),
+			                     core::NullPointerException);
+			CHECK_NO_THROW(core::BufferedDoseIterator{spDoseIterator});
+
+			//2) test that all positions are replayed as read from the source
+			for (const auto& spSourceIterator : {spDoseIterator, spMaskedDoseIterator})
+			{
+				core::BufferedDoseIterator bufferedIterator(spSourceIterator);
+
+				CHECK_EQUAL(bufferedIterator.getDoseUID(), spSourceIterator->getDoseUID());
+				CHECK_EQUAL(bufferedIterator.getVoxelizationID(), spSourceIterator->getVoxelizationID());
+
+				CHECK(bufferedIterator.reset());
+				spSourceIterator->reset();
+				CHECK_EQUAL(bufferedIterator.getCurrentVoxelVolume(), spSourceIterator->getCurrentVoxelVolume());
+
+				std::size_t numberOfValues = 0;
+
+				while (spSourceIterator->isPositionValid())
+				{
+					CHECK(bufferedIterator.isPositionValid());
+					CHECK_EQUAL(bufferedIterator.getCurrentDoseValue(), spSourceIterator->getCurrentDoseValue());
+					CHECK_EQUAL(bufferedIterator.getCurrentRelevantVolumeFraction(),
+					            spSourceIterator->getCurrentRelevantVolumeFraction());
+					CHECK_EQUAL(bufferedIterator.getCurrentVoxelGridID(), spSourceIterator->getCurrentVoxelGridID());
+					bufferedIterator.next();
+					spSourceIterator->next();
+					++numberOfValues;
+				}
+
+				CHECK(!bufferedIterator.isPositionValid());
+				CHECK_EQUAL(bufferedIterator.getNumberOfValues(), numberOfValues);
+				CHECK_EQUAL(bufferedIterator.getDoseValues().size(), numberOfValues);
+				CHECK_EQUAL(bufferedIterator.getRelevantVolumeFractions().size(), numberOfValues);
+				CHECK_EQUAL(bufferedIterator.getVoxelGridIDs().size(), numberOfValues);
+
+				//3) test nextBlock
+				const std::size_t blockSize = 37;
+				std::vector<DoseTypeGy> doseValues(blockSize);
+				std::vector<FractionType> fractions(blockSize);
+				std::vector<VoxelGridID> ids(blockSize);
+				std::size_t position = 0;
+				std::size_t count = 0;
+				bool blocksAsBuffered = true;
+
+				bufferedIterator.reset();
+
+				while ((count = bufferedIterator.nextBlock(blockSize, doseValues.data(), fractions.data(), ids.data())) > 0)
+				{
+					for (std::size_t i = 0; i < count; ++i, ++position)
+					{
+						blocksAsBuffered = blocksAsBuffered && doseValues[i] == bufferedIterator.getDoseValues()[position]
+						                   && fractions[i] == bufferedIterator.getRelevantVolumeFractions()[position]
+						                   && ids[i] == bufferedIterator.getVoxelGridIDs()[position];
+					}
+				}
+
+				CHECK(blocksAsBuffered);
+				CHECK_EQUAL(position, numberOfValues);
+				CHECK_EQUAL(bufferedIterator.nextBlock(blockSize, doseValues.data(), nullptr, nullptr), 0);
+			}
+
+			RETURN_AND_REPORT_TEST_SUCCESS;
+		}
+
+	}//end namespace testing
+}//end namespace rttb
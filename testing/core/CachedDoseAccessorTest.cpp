@@ -0,0 +1,158 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+#include <boost/make_shared.hpp>
+
+#include "litCheckMacros.h"
+
+#include "rttbBaseType.h"
+#include "rttbCachedDoseAccessor.h"
+#include "rttbNullPointerException.h"
+#include "rttbInvalidParameterException.h"
+#include "rttbIndexOutOfBoundsException.h"
+#include "DummyDoseAccessor.h"
+
+namespace rttb
+{
+	namespace testing
+	{
+
+		/*! @brief Accessor that forwards to another accessor and counts the evaluated voxels.*/
+		class CountingDoseAccessor : public core::AccessorInterface
+		{
+		private:
+			core::AccessorInterface::ConstPointer _source;
+			mutable std::atomic<GridSizeType> _evaluations;
+
+		public:
+			explicit CountingDoseAccessor(core::AccessorInterface::ConstPointer source) : _source(source), _evaluations(0) {};
+
+			const core::GeometricInfo& getGeometricInfo() const override
+			{
+				return _source->getGeometricInfo();
+			};
+
+			GenericValueType getValueAt(const VoxelGridID aID) const override
+			{
+				++_evaluations;
+				return _source->getValueAt(aID);
+			};
+
+			GenericValueType getValueAt(const VoxelGridIndex3D& aIndex) const override
+			{
+				++_evaluations;
+				return _source->getValueAt(aIndex);
+			};
+
+			const IDType getUID() const override
+			{
+				return _source->getUID();
+			};
+
+			GridSizeType getNumberOfEvaluations() const
+			{
+				return _evaluations;
+			};
+		};
+
+		/*! @brief CachedDoseAccessorTest - test the API of CachedDoseAccessor
+			1) test constructor
+			2) test eager mode (single and multi-threaded)
+			3) test on demand mode
+			4) test getValues
+		*/
+		int CachedDoseAccessorTest(int /*argc*/, char* /*argv*/[])
+		{
+			PREPARE_DEFAULT_TEST_REPORTING;
+
+			boost::shared_ptr<DummyDoseAccessor> spTestDoseAccessor = boost::make_shared<DummyDoseAccessor>();
+			core::AccessorInterface::ConstPointer spSourceAccessor(spTestDoseAccessor);
+			const std::vector<DoseTypeGy>* doseVals = spTestDoseAccessor->getDoseVector();
+			const core::GeometricInfo& geoInfo = spSourceAccessor->getGeometricInfo();
+			const GridSizeType numberOfVoxels = geoInfo.getNumberOfVoxels();
+			const GridSizeType sliceSize = geoInfo.getNumColumns() * geoInfo.getNumRows();
+
+			//1) test constructor
+			CHECK_THROW_EXPLICIT(core::CachedDoseAccessor(core::AccessorInterface::ConstPointer()),
+			                     core::NullPointerException);
+			CHECK_THROW_EXPLICIT(core::CachedDoseAccessor(spSourceAccessor, core::CachedDoseAccessor::CachingMode::Eager, 1, 0),
+			                     core::InvalidParameterException);
+			CHECK_NO_THROW(core::CachedDoseAccessor{spSourceAccessor});
+
+			//2) test eager mode (single and multi-threaded)
+			for (unsigned int numberOfThreads : {1u, 3u, 0u})
+			{
+				auto spCounting = boost::make_shared<CountingDoseAccessor>(spSourceAccessor);
+				core::CachedDoseAccessor cached(spCounting, core::CachedDoseAccessor::CachingMode::Eager, numberOfThreads);
+
+				CHECK(cached.getGeometricInfo() == geoInfo);
+				CHECK_EQUAL(cached.getUID(), spSourceAccessor->getUID());
+				CHECK_EQUAL(cached.getNumberOfBlocks(), geoInfo.getNumSlices());
+				CHECK_EQUAL(cached.getNumberOfCachedBlocks(), geoInfo.getNumSlices());
+				CHECK_EQUAL(spCounting->getNumberOfEvaluations(), numberOfVoxels);
+
+				bool allEqual = true;
+
+				for (VoxelGridID id = 0; id < numberOfVoxels; ++id)
+				{
+					allEqual = allEqual && (cached.getValueAt(id) == doseVals->at(id));
+				}
+
+				CHECK(allEqual);
+				//repeated reads are answered from the cache
+				CHECK_EQUAL(spCounting->getNumberOfEvaluations(), numberOfVoxels);
+			}
+
+			//3) test on demand mode
+			auto spCounting = boost::make_shared<CountingDoseAccessor>(spSourceAccessor);
+			core::CachedDoseAccessor onDemand(spCounting, core::CachedDoseAccessor::CachingMode::OnDemand, 1, 3);
+			CHECK_EQUAL(onDemand.getNumberOfBlocks(), 4);
+			CHECK_EQUAL(onDemand.getNumberOfCachedBlocks(), 0);
+			CHECK_EQUAL(spCounting->getNumberOfEvaluations(), 0);
+
+			const VoxelGridIndex3D index(3, 4, 4);
+			VoxelGridID id = 0;
+			geoInfo.convert(index, id);
+			CHECK_EQUAL(onDemand.getValueAt(index), doseVals->at(id));
+			CHECK_EQUAL(onDemand.getNumberOfCachedBlocks(), 1);
+			CHECK_EQUAL(spCounting->getNumberOfEvaluations(), 3 * sliceSize);
+			CHECK_EQUAL(onDemand.getValueAt(id + 1), doseVals->at(id + 1));
+			CHECK_EQUAL(spCounting->getNumberOfEvaluations(), 3 * sliceSize);
+			//the last block only contains one slice
+			CHECK_EQUAL(onDemand.getValueAt(static_cast<VoxelGridID>(numberOfVoxels - 1)), doseVals->back());
+			CHECK_EQUAL(spCounting->getNumberOfEvaluations(), 4 * sliceSize);
+			CHECK_EQUAL(onDemand.getValueAt(static_cast<VoxelGridID>(numberOfVoxels)), -1);
+			CHECK_EQUAL(onDemand.getValueAt(VoxelGridIndex3D(geoInfo.getNumColumns(), 0, 0)), -1);
+
+			//4) test getValues
+			std::vector<GenericValueType> values(numberOfVoxels);
+			CHECK_NO_THROW(onDemand.getValues(0, numberOfVoxels, values.data()));
+			CHECK(std::equal(values.cbegin(), values.cend(), doseVals->cbegin()));
+			CHECK_EQUAL(onDemand.getNumberOfCachedBlocks(), 4);
+			CHECK_EQUAL(spCounting->getNumberOfEvaluations(), numberOfVoxels);
+			CHECK_NO_THROW(onDemand.getValues(0, 0, values.data()));
+			CHECK_THROW_EXPLICIT(onDemand.getValues(static_cast<VoxelGridID>(numberOfVoxels) - 5, 10, values.data()),
+			                     core::IndexOutOfBoundsException);
+			CHECK_THROW_EXPLICIT(onDemand.getValues(-1, 2, values.data()), core::IndexOutOfBoundsException);
+
+			RETURN_AND_REPORT_TEST_SUCCESS;
+		}
+
+	}//end namespace testing
+}//end namespace rttb
@@ -0,0 +1,202 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+#include <boost/make_shared.hpp>
+
+#include "litCheckMacros.h"
+
+#include "rttbBaseType.h"
+#include "rttbCompactMask.h"
+#include "rttbCompactMaskAccessor.h"
+#include "rttbCompactMaskedDoseIterator.h"
+#include "rttbGenericMaskedDoseIterator.h"
+#include "rttbNullPointerException.h"
+#include "DummyDoseAccessor.h"
+#include "DummyMaskAccessor.h"
+
+namespace rttb
+{
+	namespace testing
+	{
+
+		/*! @brief CompactMaskTest - test CompactMask, CompactMaskAccessor and CompactMaskedDoseIterator
+			1) test CompactMask conversion from/to MaskVoxelList
+			2) test CompactMask getMaskAt
+			3) test memory of a fully covered mask
+			4) test CompactMaskAccessor
+			5) test CompactMaskedDoseIterator against GenericMaskedDoseIterator
+		*/
+		int CompactMaskTest(int /*argc*/, char* /*argv*/[])
+		{
+			PREPARE_DEFAULT_TEST_REPORTING;
+
+			boost::shared_ptr<DummyDoseAccessor> spTestDoseAccessor = boost::make_shared<DummyDoseAccessor>();
+			core::DoseAccessorInterface::Pointer spDoseAccessor(spTestDoseAccessor);
+			const core::GeometricInfo& geoInfo = spDoseAccessor->getGeometricInfo();
+			const GridSizeType numberOfVoxels = geoInfo.getNumberOfVoxels();
+
+			//unsorted mask with full and partial voxels, whole rows and a duplicate
+			core::CompactMask::MaskVoxelList voxels;
+			std::map<VoxelGridID, FractionType> expected;
+
+			for (VoxelGridID id = static_cast<VoxelGridID>(numberOfVoxels) - 1; id >= 0; id -= 3)
+			{
+				const FractionType fraction = (id % 7 == 0) ? 0.3 : 1.;
+				voxels.emplace_back(id, fraction);
+				expected[id] = fraction;
+
+				//neighbor voxels so that runs longer than one voxel (and across row ends) occur
+				if (id > 0 && id % 2 == 0)
+				{
+					voxels.emplace_back(id - 1, 1.);
+					expected[id - 1] = 1.;
+				}
+			}
+
+			voxels.emplace_back(voxels.front().getVoxelGridID(), 0.5);
+
+			//1) test CompactMask conversion from/to MaskVoxelList
+			core::CompactMask compactMask(voxels, geoInfo);
+			CHECK_EQUAL(compactMask.getNumberOfVoxels(), static_cast<GridSizeType>(expected.size()));
+			CHECK(!compactMask.empty());
+			CHECK(core::CompactMask().empty());
+
+			core::CompactMask::MaskVoxelList expandedVoxels = compactMask.toMaskVoxelList();
+			CHECK_EQUAL(expandedVoxels.size(), expected.size());
+
+			unsigned int mismatches = 0;
+			auto expectedIt = expected.cbegin();
+
+			for (const auto& voxel : expandedVoxels)
+			{
+				if (expectedIt == expected.cend() || voxel.getVoxelGridID() != expectedIt->first
+				    || std::abs(voxel.getRelevantVolumeFraction() - expectedIt->second) > 1e-7)
+				{
+					++mismatches;
+				}
+
+				++expectedIt;
+			}
+
+			CHECK_EQUAL(mismatches, 0);
+
+			bool runsInsideRows = true;
+			GridSizeType voxelsInRuns = 0;
+
+			for (const auto& run : compactMask.getRuns())
+			{
+				runsInsideRows = runsInsideRows
+				                 && (run.firstID % geoInfo.getNumColumns()) + run.length <= geoInfo.getNumColumns();
+				voxelsInRuns += run.length;
+			}
+
+			CHECK(runsInsideRows);
+			CHECK_EQUAL(voxelsInRuns + static_cast<GridSizeType>(compactMask.getPartialVoxels().size()),
+			            compactMask.getNumberOfVoxels());
+
+			//2) test CompactMask getMaskAt
+			mismatches = 0;
+
+			for (VoxelGridID id = 0; id < numberOfVoxels; ++id)
+			{
+				core::MaskVoxel voxel(0);
+				const bool found = compactMask.getMaskAt(id, voxel);
+				const auto pos = expected.find(id);
+
+				if (found != (pos != expected.cend()) || (found && (voxel.getVoxelGridID() != id
+				        || std::abs(voxel.getRelevantVolumeFraction() - pos->second) > 1e-7)))
+				{
+					++mismatches;
+				}
+			}
+
+			CHECK_EQUAL(mismatches, 0);
+
+			//3) test memory of a fully covered mask
+			core::CompactMask::MaskVoxelList fullVoxels;
+
+			for (VoxelGridID id = 0; id < numberOfVoxels; ++id)
+			{
+				fullVoxels.emplace_back(id, 1.);
+			}
+
+			core::CompactMask fullMask(fullVoxels, geoInfo);
+			CHECK_EQUAL(fullMask.getRuns().size(), geoInfo.getNumRows() * geoInfo.getNumSlices());
+			CHECK(fullMask.getPartialVoxels().empty());
+			CHECK(fullMask.getMemorySize() * 10 < fullVoxels.size() * sizeof(core::MaskVoxel));
+
+			//4) test CompactMaskAccessor
+			auto spVoxels = boost::make_shared<core::MaskAccessorInterface::MaskVoxelList>(voxels);
+			auto spDummyMask = boost::make_shared<DummyMaskAccessor>(geoInfo, spVoxels);
+			core::MaskAccessorInterface::Pointer spMaskAccessor(spDummyMask);
+
+			CHECK_THROW_EXPLICIT(core::CompactMaskAccessor(core::MaskAccessorInterface::Pointer()),
+			                     core::NullPointerException);
+			CHECK_THROW_EXPLICIT(core::CompactMaskAccessor(core::CompactMaskAccessor::CompactMaskPointer(), geoInfo),
+			                     core::NullPointerException);
+
+			auto spCompactMaskAccessor = boost::make_shared<core::CompactMaskAccessor>(spMaskAccessor);
+			CHECK_EQUAL(spCompactMaskAccessor->getMaskUID(), spMaskAccessor->getMaskUID());
+			CHECK(spCompactMaskAccessor->getGeometricInfo() == geoInfo);
+			CHECK_EQUAL(spCompactMaskAccessor->getRelevantVoxelVector()->size(), expected.size());
+			CHECK_EQUAL(spCompactMaskAccessor->getRelevantVoxelVector(0.5)->size(), compactMask.getNumberOfVoxels() -
+			            compactMask.getPartialVoxels().size());
+
+			core::MaskVoxel voxel(0);
+			CHECK(!spCompactMaskAccessor->getMaskAt(static_cast<VoxelGridID>(numberOfVoxels), voxel));
+			CHECK(spCompactMaskAccessor->getMaskAt(static_cast<VoxelGridID>(numberOfVoxels) - 1, voxel));
+			CHECK_EQUAL(voxel.getVoxelGridID(), static_cast<VoxelGridID>(numberOfVoxels) - 1);
+
+			//5) test CompactMaskedDoseIterator against GenericMaskedDoseIterator
+			for (auto mask : { spMaskAccessor, core::MaskAccessorInterface::Pointer(spCompactMaskAccessor) })
+			{
+				core::CompactMaskedDoseIterator compactIterator(mask, spDoseAccessor);
+				core::GenericMaskedDoseIterator genericIterator(spCompactMaskAccessor, spDoseAccessor);
+				CHECK(compactIterator.reset());
+				CHECK(genericIterator.reset());
+				CHECK_EQUAL(compactIterator.getCurrentVoxelVolume(), genericIterator.getCurrentVoxelVolume());
+
+				mismatches = 0;
+				GridSizeType count = 0;
+
+				while (genericIterator.isPositionValid())
+				{
+					if (!compactIterator.isPositionValid()
+					    || compactIterator.getCurrentVoxelGridID() != genericIterator.getCurrentVoxelGridID()
+					    || compactIterator.getCurrentRelevantVolumeFraction() != genericIterator.getCurrentRelevantVolumeFraction()
+					    || compactIterator.getCurrentMaskedDoseValue() != genericIterator.getCurrentMaskedDoseValue())
+					{
+						++mismatches;
+					}
+
+					compactIterator.next();
+					genericIterator.next();
+					++count;
+				}
+
+				CHECK_EQUAL(mismatches, 0);
+				CHECK(!compactIterator.isPositionValid());
+				CHECK_EQUAL(count, compactMask.getNumberOfVoxels());
+			}
+
+			RETURN_AND_REPORT_TEST_SUCCESS;
+		}
+
+	}//end namespace testing
+}//end namespace rttb
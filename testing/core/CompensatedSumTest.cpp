@@ -0,0 +1,76 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+// this file defines the rttbCoreTests for the test driver
+// and all it expects is that you have a function called RegisterTests
+
+#include "litCheckMacros.h"
+
+#include "rttbCompensatedSum.h"
+
+namespace rttb
+{
+	namespace testing
+	{
+
+		/*! @brief CompensatedSumTest.
+			1) test constructors
+			2) test cancellation of large values
+			3) test sum of many small values
+			4) test adding another sum
+		*/
+		int CompensatedSumTest(int /*argc*/, char* /*argv*/[])
+		{
+			PREPARE_DEFAULT_TEST_REPORTING;
+
+			//1) test constructors
+			CHECK_EQUAL(core::CompensatedSum().getSum(), 0.0);
+			CHECK_EQUAL(core::CompensatedSum(2.5).getSum(), 2.5);
+
+			//2) test cancellation of large values
+			core::CompensatedSum cancellation;
+			cancellation.add(1.0);
+			cancellation.add(1e100);
+			cancellation.add(1.0);
+			cancellation.add(-1e100);
+			CHECK_EQUAL(cancellation.getSum(), 2.0);
+
+			//3) test sum of many small values
+			core::CompensatedSum smallValues;
+
+			for (int i = 0; i < 1000000; ++i)
+			{
+				smallValues.add(0.1);
+			}
+
+			CHECK_EQUAL(smallValues.getSum(), 100000.0);
+
+			//4) test adding another sum
+			core::CompensatedSum first(1e100);
+			first.add(1.0);
+			core::CompensatedSum second(-1e100);
+			second.add(1.0);
+			first.add(second);
+			CHECK_EQUAL(first.getSum(), 2.0);
+
+			core::CompensatedSum empty;
+			empty.add(cancellation);
+			CHECK_EQUAL(empty.getSum(), cancellation.getSum());
+
+			RETURN_AND_REPORT_TEST_SUCCESS;
+		}
+
+	}//end namespace testing
+}//end namespace rttb
@@ -16,6 +16,9 @@
 // this file defines the rttbCoreTests for the test driver
 // and all it expects is that you have a function called RegisterTests
 
+#include <algorithm>
+#include <cmath>
+
 #include <boost/make_shared.hpp>
 #include <boost/shared_ptr.hpp>
 
@@ -41,9 +44,61 @@ namespace rttb
 		typedef core::DVHCalculator::DoseIteratorPointer DoseIteratorPointer;
 		typedef core::DVHCalculator::MaskedDoseIteratorPointer MaskedDoseIteratorPointer;
 
+		namespace
+		{
+			/*! @brief dose iterator without positional reads, generateDVH() has to read it sequentially*/
+			class SequentialDoseIterator : public core::DoseIteratorInterface
+			{
+			private:
+				core::GenericDoseIterator _iterator;
+
+			public:
+				explicit SequentialDoseIterator(DoseAccessorPointer aDoseAccessor) : core::DoseIteratorInterface(aDoseAccessor),
+					_iterator(aDoseAccessor)
+				{
+				};
+
+				bool reset() override
+				{
+					return _iterator.reset();
+				};
+
+				void next() override
+				{
+					_iterator.next();
+				};
+
+				bool isPositionValid() const override
+				{
+					return _iterator.isPositionValid();
+				};
+
+				DoseVoxelVolumeType getCurrentVoxelVolume() const override
+				{
+					return _iterator.getCurrentVoxelVolume();
+				};
+
+				DoseTypeGy getCurrentDoseValue() const override
+				{
+					return _iterator.getCurrentDoseValue();
+				};
+
+				FractionType getCurrentRelevantVolumeFraction() const override
+				{
+					return _iterator.getCurrentRelevantVolumeFraction();
+				};
+
+				VoxelGridID getCurrentVoxelGridID() const override
+				{
+					return _iterator.getCurrentVoxelGridID();
+				};
+			};
+		}
 
 		/*!@brief DVHTest - test the API of DVH
 		 1) test constructors (values as expected?)
+		 2) test generateDVH with several threads (same result for any number of threads?)
+		 3) test generateDVH with an iterator without positional reads
 		*/
 
 		int DVHCalculatorTest(int /*argc*/, char* /*argv*/[])
@@ -141,6 +196,88 @@ namespace rttb
       CHECK_NO_THROW(dvh = myDVHCalc3.generateDVH());
       CHECK(dvh);
 
+			//2) test generateDVH with several threads; the grid spans more than one chunk
+			core::GeometricInfo largeGeoInfo;
+			largeGeoInfo.setNumColumns(50);
+			largeGeoInfo.setNumRows(50);
+			largeGeoInfo.setNumSlices(60);
+			largeGeoInfo.setSpacing({1.0, 1.0, 1.0});
+			std::vector<DoseTypeGy> largeDoseVals(largeGeoInfo.getNumberOfVoxels());
+
+			for (std::size_t i = 0; i < largeDoseVals.size(); ++i)
+			{
+				largeDoseVals[i] = 50 + 40 * std::sin(0.001 * i) + (i % 7);
+			}
+
+			DoseAccessorPointer spLargeDoseAccessor = boost::make_shared<DummyDoseAccessor>(largeDoseVals, largeGeoInfo);
+			DoseIteratorPointer spLargeDoseIterator = boost::make_shared<core::GenericDoseIterator>(spLargeDoseAccessor);
+			//more than one chunk
+			CHECK(largeDoseVals.size() > (1 << 16));
+
+			const DoseTypeGy largeBinSize = 0.5;
+			const int largeNumBins = 250;
+			std::vector<DoseCalcType> referenceDifferential(largeNumBins, 0);
+
+			for (const auto dose : largeDoseVals)
+			{
+				referenceDifferential[static_cast<int>(dose / largeBinSize)] += 1;
+			}
+
+			core::DVHCalculator singleThreadedCalc(spLargeDoseIterator, structureID, doseID, largeBinSize, largeNumBins);
+			CHECK_EQUAL(singleThreadedCalc.getNumberOfThreads(), 1);
+			core::DVH::Pointer singleThreadedDVH = singleThreadedCalc.generateDVH();
+			CHECK_EQUAL(singleThreadedDVH->getDataDifferential().size(), referenceDifferential.size());
+
+			for (std::size_t i = 0; i < referenceDifferential.size(); ++i)
+			{
+				CHECK_EQUAL(singleThreadedDVH->getDataDifferential().at(i), referenceDifferential[i]);
+			}
+
+			core::DVHCalculator singleThreadedCalcNoDelta(spLargeDoseIterator, structureID, doseID, 0, largeNumBins);
+			core::DVH::Pointer singleThreadedDVHNoDelta = singleThreadedCalcNoDelta.generateDVH();
+
+			//the automatic bin width is max*1.5/numberOfBins, rounded up by at most 1/64
+			const DoseTypeGy largeMaximum = *std::max_element(largeDoseVals.cbegin(), largeDoseVals.cend());
+			const DoseTypeGy minimalBinSize = largeMaximum * 1.5 / largeNumBins;
+			CHECK(singleThreadedDVHNoDelta->getDeltaD() >= minimalBinSize);
+			CHECK(singleThreadedDVHNoDelta->getDeltaD() <= minimalBinSize * (1 + 1. / 64));
+			CHECK_CLOSE(singleThreadedDVHNoDelta->getNumberOfVoxels(), largeDoseVals.size(), errorConstant);
+
+			for (unsigned int numberOfThreads : {2u, 3u, 0u})
+			{
+				core::DVHCalculator parallelCalc(spLargeDoseIterator, structureID, doseID, largeBinSize, largeNumBins,
+				                                 numberOfThreads);
+				CHECK(parallelCalc.getNumberOfThreads() > 0);
+				core::DVH::Pointer parallelDVH = parallelCalc.generateDVH();
+				CHECK(parallelDVH->getDataDifferential() == singleThreadedDVH->getDataDifferential());
+
+				core::DVHCalculator parallelCalcNoDelta(spLargeDoseIterator, structureID, doseID, 0, largeNumBins,
+				                                        numberOfThreads);
+				core::DVH::Pointer parallelDVHNoDelta = parallelCalcNoDelta.generateDVH();
+				CHECK_EQUAL(parallelDVHNoDelta->getDeltaD(), singleThreadedDVHNoDelta->getDeltaD());
+				CHECK(parallelDVHNoDelta->getDataDifferential() == singleThreadedDVHNoDelta->getDataDifferential());
+
+				//errors of the chunk tasks are rethrown
+				core::DVHCalculator tooFewBinsCalc(spLargeDoseIterator, structureID, doseID, largeBinSize, 100,
+				                                   numberOfThreads);
+				CHECK_THROW_EXPLICIT(tooFewBinsCalc.generateDVH(), core::InvalidParameterException);
+			}
+
+			core::DVHCalculator parallelMaskedCalc(spMaskedDoseIterator, structureID, doseID, 0, 201, 4);
+			core::DVH::Pointer parallelMaskedDVH = parallelMaskedCalc.generateDVH();
+			CHECK_EQUAL(parallelMaskedDVH->getDeltaD(), dvh->getDeltaD());
+			CHECK(parallelMaskedDVH->getDataDifferential() == dvh->getDataDifferential());
+
+			//3) test generateDVH with an iterator without positional reads
+			DoseIteratorPointer spSequentialDoseIterator = boost::make_shared<SequentialDoseIterator>(spLargeDoseAccessor);
+			CHECK_EQUAL(spSequentialDoseIterator->getNumberOfPositions(), 0);
+			core::DVHCalculator sequentialCalc(spSequentialDoseIterator, structureID, doseID, largeBinSize, largeNumBins, 3);
+			CHECK(sequentialCalc.generateDVH()->getDataDifferential() == singleThreadedDVH->getDataDifferential());
+			core::DVHCalculator sequentialCalcNoDelta(spSequentialDoseIterator, structureID, doseID, 0, largeNumBins, 3);
+			core::DVH::Pointer sequentialDVHNoDelta = sequentialCalcNoDelta.generateDVH();
+			CHECK_EQUAL(sequentialDVHNoDelta->getDeltaD(), singleThreadedDVHNoDelta->getDeltaD());
+			CHECK(sequentialDVHNoDelta->getDataDifferential() == singleThreadedDVHNoDelta->getDataDifferential());
+
 			RETURN_AND_REPORT_TEST_SUCCESS;
 		}
 
@@ -0,0 +1,184 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+// this file defines the rttbCoreTests for the test driver
+// and all it expects is that you have a function called RegisterTests
+
+#include <vector>
+
+#include "litCheckMacros.h"
+
+#include "rttbBaseType.h"
+#include "rttbDVH.h"
+#include "rttbDVHSet.h"
+#include "rttbDVHSetArithmetic.h"
+#include "rttbInvalidParameterException.h"
+
+namespace rttb
+{
+	namespace testing
+	{
+
+		/*! @brief DVHSetArithmeticTest.
+			1) test alignBinWidths
+			2) test calculateDVHBand
+			3) test calculateWeightedSum
+			4) test getVx and getDx
+			5) test the DVHSet overloads
+		*/
+		int DVHSetArithmeticTest(int /*argc*/, char* /*argv*/[])
+		{
+			PREPARE_DEFAULT_TEST_REPORTING;
+
+			core::DVH dvhA({ 0, 2, 4, 2 }, 0.5, 0.1, "structure", "scenarioA");
+			core::DVH dvhB({ 1, 1, 1, 1, 1, 1 }, 0.25, 0.1, "structure", "scenarioB");
+			core::DVH dvhC({ 0, 2, 4, 2 }, 0.5, 0.2, "structure", "scenarioC");
+			dvhB.setLabel("labelB");
+
+			//1) test alignBinWidths
+			CHECK_THROW_EXPLICIT(core::alignBinWidths(core::DVHSet::DVHSetType()), core::InvalidParameterException);
+			CHECK_THROW_EXPLICIT(core::alignBinWidths({ dvhA }, -1), core::InvalidParameterException);
+
+			core::DVHSet::DVHSetType aligned;
+			CHECK_NO_THROW(aligned = core::alignBinWidths({ dvhA, dvhB }));
+			CHECK_EQUAL(aligned.size(), 2);
+			CHECK_EQUAL(aligned[0].getDeltaD(), 0.5);
+			CHECK_EQUAL(aligned[1].getDeltaD(), 0.5);
+			//same bin width: the histogram is shared
+			CHECK(&(aligned[0].getDataDifferential()) == &(dvhA.getDataDifferential()));
+			CHECK(aligned[1].getDataDifferential() == core::DVH::DataDifferentialType({ 2, 2, 2 }));
+			CHECK_EQUAL(aligned[1].getDoseID(), "scenarioB");
+			CHECK_EQUAL(aligned[1].getLabel(), "labelB");
+			CHECK_EQUAL(aligned[1].getNumberOfVoxels(), dvhB.getNumberOfVoxels());
+
+			core::DVHSet::DVHSetType refined = core::alignBinWidths({ dvhA }, 0.25);
+			CHECK(refined[0].getDataDifferential() == core::DVH::DataDifferentialType({ 0, 0, 1, 1, 2, 2, 1, 1 }));
+
+			core::DVHSet::DVHSetType coarsened = core::alignBinWidths({ dvhA }, 0.75);
+			const core::DVH::DataDifferentialType& coarsenedData = coarsened[0].getDataDifferential();
+			CHECK_EQUAL(coarsenedData.size(), 3);
+			CHECK_CLOSE(coarsenedData[0], 1, errorConstant);
+			CHECK_CLOSE(coarsenedData[1], 5, errorConstant);
+			CHECK_CLOSE(coarsenedData[2], 2, errorConstant);
+
+			//2) test calculateDVHBand
+			core::DVHBand band = core::calculateDVHBand({ dvhA, dvhB });
+			CHECK_EQUAL(band.deltaD, 0.5);
+			CHECK_EQUAL(band.type.Type, DVHType::Cumulative);
+			CHECK_EQUAL(band.minimum.size(), 4);
+			CHECK_EQUAL(band.maximum.size(), 4);
+			CHECK_EQUAL(band.mean.size(), 4);
+			const std::vector<VolumeType> expectedMinimum = { 0.6, 0.4, 0.2, 0 };
+			const std::vector<VolumeType> expectedMaximum = { 0.8, 0.8, 0.6, 0.2 };
+			const std::vector<VolumeType> expectedMean = { 0.7, 0.6, 0.4, 0.1 };
+
+			for (std::size_t bin = 0; bin < 4; ++bin)
+			{
+				CHECK_CLOSE(band.minimum[bin], expectedMinimum[bin], errorConstant);
+				CHECK_CLOSE(band.maximum[bin], expectedMaximum[bin], errorConstant);
+				CHECK_CLOSE(band.mean[bin], expectedMean[bin], errorConstant);
+			}
+
+			core::DVHBand differentialBand = core::calculateDVHBand({ dvhA, dvhB }, { DVHType::Differential });
+			CHECK_CLOSE(differentialBand.minimum[0], 0, errorConstant);
+			CHECK_CLOSE(differentialBand.maximum[0], 0.2, errorConstant);
+			CHECK_CLOSE(differentialBand.minimum[2], 0.2, errorConstant);
+			CHECK_CLOSE(differentialBand.maximum[2], 0.4, errorConstant);
+			CHECK_CLOSE(differentialBand.minimum[3], 0, errorConstant);
+
+			//3) test calculateWeightedSum
+			CHECK_THROW_EXPLICIT(core::calculateWeightedSum({ dvhA, dvhC }, { 1 }), core::InvalidParameterException);
+			CHECK_THROW_EXPLICIT(core::calculateWeightedSum({ dvhA, dvhC }, { 1, -1 }), core::InvalidParameterException);
+
+			core::DVH::Pointer weightedSum;
+			CHECK_NO_THROW(weightedSum = core::calculateWeightedSum({ dvhA, dvhC }, { 0.5, 0.25 }));
+			//dvhC has the double voxel volume
+			CHECK(weightedSum->getDataDifferential() == dvhA.getDataDifferential());
+			CHECK_EQUAL(weightedSum->getDeltaV(), dvhA.getDeltaV());
+			CHECK_EQUAL(weightedSum->getDoseID(), "scenarioA");
+
+			core::DVH::Pointer expectedDVH = core::calculateWeightedSum({ dvhA, dvhB }, { 0.5, 0.5 });
+			CHECK_EQUAL(expectedDVH->getDeltaD(), 0.5);
+			CHECK(expectedDVH->getDataDifferential() == core::DVH::DataDifferentialType({ 1, 2, 3, 1 }));
+
+			//4) test getVx and getDx
+			const core::DVHSet::DVHSetType scenarios = { dvhA, dvhB, dvhC };
+
+			for (DoseTypeGy x : { 0.0, 0.3, 0.5, 1.2, 5.0 })
+			{
+				std::vector<VolumeType> vx = core::getVx(scenarios, x);
+				CHECK_EQUAL(vx.size(), scenarios.size());
+
+				for (std::size_t index = 0; index < scenarios.size(); ++index)
+				{
+					CHECK_EQUAL(vx[index], scenarios[index].getVx(x));
+				}
+			}
+
+			for (VolumeType x : { 0.0, 0.1, 0.5, 0.7, 0.9, 2.0 })
+			{
+				std::vector<DoseTypeGy> dx = core::getDx(scenarios, x);
+				CHECK_EQUAL(dx.size(), scenarios.size());
+
+				for (std::size_t index = 0; index < scenarios.size(); ++index)
+				{
+					CHECK_EQUAL(dx[index], scenarios[index].getDx(x));
+				}
+			}
+
+			//cumulative volumes of dvhA: 0.8, 0.8, 0.6, 0.2
+			CHECK_EQUAL(dvhA.getDx(0.9), 0);
+			CHECK_EQUAL(dvhA.getDx(0.7), 0.5);
+			CHECK_EQUAL(dvhA.getDx(0.5), 1.0);
+			CHECK_EQUAL(dvhA.getDx(0.1), 1.5);
+
+			//5) test the DVHSet overloads
+			CHECK_THROW_EXPLICIT(core::alignBinWidths(core::DVHSet()), core::InvalidParameterException);
+			const core::DVHSet dvhSet({ dvhA }, { dvhB }, { dvhC }, "structureSet", "dose");
+			//all DVHs of the set in the order target volume, healthy tissue, whole volume
+			const core::DVHSet::DVHSetType allDVHs = { dvhA, dvhB, dvhC };
+
+			core::DVHSet alignedSet = core::alignBinWidths(dvhSet);
+			CHECK_EQUAL(alignedSet.getStrSetID(), "structureSet");
+			CHECK_EQUAL(alignedSet.getDoseID(), "dose");
+			CHECK_EQUAL(alignedSet.getTargetVolumeSet().size(), 1);
+			CHECK_EQUAL(alignedSet.getHealthyTissueSet().size(), 1);
+			CHECK_EQUAL(alignedSet.getWholeVolumeSet().size(), 1);
+			CHECK_EQUAL(alignedSet.getHealthyTissueSet()[0].getDeltaD(), 0.5);
+			CHECK(alignedSet.getHealthyTissueSet()[0].getDataDifferential() == core::DVH::DataDifferentialType({ 2, 2, 2 }));
+
+			//only the target volume subset: the healthy tissue subset is not needed for the bin width
+			const core::DVHSet partialSet({ dvhB }, {}, "structureSet", "dose");
+			CHECK_EQUAL(core::alignBinWidths(partialSet).getTargetVolumeSet()[0].getDeltaD(), 0.25);
+			CHECK(core::alignBinWidths(partialSet).getHealthyTissueSet().empty());
+
+			core::DVHBand setBand = core::calculateDVHBand(dvhSet);
+			core::DVHBand listBand = core::calculateDVHBand(allDVHs);
+			CHECK(setBand.minimum == listBand.minimum);
+			CHECK(setBand.maximum == listBand.maximum);
+			CHECK(setBand.mean == listBand.mean);
+
+			CHECK_THROW_EXPLICIT(core::calculateWeightedSum(dvhSet, { 1, 1 }), core::InvalidParameterException);
+			CHECK(core::calculateWeightedSum(dvhSet, { 0.5, 0.25, 0.25 })->getDataDifferential()
+			      == core::calculateWeightedSum(allDVHs, { 0.5, 0.25, 0.25 })->getDataDifferential());
+
+			CHECK(core::getVx(dvhSet, 0.5) == core::getVx(allDVHs, 0.5));
+			CHECK(core::getDx(dvhSet, 0.5) == core::getDx(allDVHs, 0.5));
+
+			RETURN_AND_REPORT_TEST_SUCCESS;
+		}
+
+	}//end namespace testing
+}//end namespace rttb
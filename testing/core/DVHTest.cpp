@@ -13,7 +13,9 @@
 //
 //------------------------------------------------------------------------
 
-#include <deque>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 #include <boost/make_shared.hpp>
 #include <boost/shared_ptr.hpp>
@@ -39,6 +41,7 @@ namespace rttb
 		3) test set/getLabel
 		4) test set/get<Values>
 		5) test equality
+		6) test sharing the histogram and moving
 		*/
 		int DVHTest(int argc, char* argv[])
 		{
@@ -105,7 +108,7 @@ namespace rttb
 			DoseStatisticType variance = (squareSum / numberOfVoxels - mean * mean);
 			DoseStatisticType stdDeviation = pow(variance, 0.5);
 
-			std::deque<DoseCalcType>::iterator it;
+			DataDifferentialType::iterator it;
 
 			for (it = aDataDifferential.begin(); it != aDataDifferential.end(); ++it)
 			{
@@ -229,6 +232,37 @@ namespace rttb
 
       CHECK_NO_THROW(myDVH.getDataCumulative());
 
+			//6) test sharing the histogram with a different bin width and moving
+			core::DVH scaledDVH(myDVH, 2 * binSize);
+			CHECK(scaledDVH.getDataDifferential() == myDVH.getDataDifferential());
+			CHECK_EQUAL(scaledDVH.getDeltaD(), 2 * binSize);
+			CHECK_EQUAL(scaledDVH.getStructureID(), myDVH.getStructureID());
+			CHECK_CLOSE(scaledDVH.getMaximum(), 2 * myDVH.getMaximum(), errorConstant);
+			CHECK_CLOSE(scaledDVH.getMean(), 2 * myDVH.getMean(), errorConstant);
+			CHECK_EQUAL(scaledDVH.getNumberOfVoxels(), myDVH.getNumberOfVoxels());
+			CHECK_THROW(core::DVH(myDVH, 0));
+
+			CHECK(std::is_nothrow_move_constructible<core::DVH>::value);
+			CHECK(std::is_nothrow_move_assignable<core::DVH>::value);
+			core::DVH movedDVH(std::move(scaledDVH));
+			CHECK_EQUAL(movedDVH.getDeltaD(), 2 * binSize);
+			CHECK(movedDVH.getDataDifferential() == aDataDifferential);
+			CHECK(movedDVH.getDataCumulative() == myDVH.getDataCumulative());
+			CHECK_CLOSE(movedDVH.getMean(), 2 * myDVH.getMean(), errorConstant);
+
+			//the moved-from DVH keeps the shared histogram
+			CHECK(scaledDVH.getDataDifferential() == aDataDifferential);
+			CHECK(scaledDVH.getDataCumulative() == myDVH.getDataCumulative());
+			CHECK_CLOSE(scaledDVH.getMean(), 2 * myDVH.getMean(), errorConstant);
+
+			core::DVH assignedDVH(myOtherDVH);
+			assignedDVH = std::move(movedDVH);
+			CHECK_EQUAL(assignedDVH.getDeltaD(), 2 * binSize);
+			CHECK(assignedDVH.getDataDifferential() == aDataDifferential);
+			CHECK(assignedDVH.getDataCumulative() == myDVH.getDataCumulative());
+			CHECK(movedDVH.getDataDifferential() == aDataDifferential);
+			CHECK_EQUAL(movedDVH.getNumberOfVoxels(), myDVH.getNumberOfVoxels());
+
 			RETURN_AND_REPORT_TEST_SUCCESS;
 		}
 
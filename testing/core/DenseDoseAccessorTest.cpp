@@ -0,0 +1,135 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+#include <algorithm>
+#include <vector>
+
+#include <boost/make_shared.hpp>
+
+#include "litCheckMacros.h"
+
+#include "rttbBaseType.h"
+#include "rttbDenseDoseAccessor.h"
+#include "rttbMutableDenseDoseAccessor.h"
+#include "rttbGenericDoseIterator.h"
+#include "rttbNullPointerException.h"
+#include "rttbInvalidParameterException.h"
+#include "rttbIndexOutOfBoundsException.h"
+#include "DummyDoseAccessor.h"
+
+namespace rttb
+{
+	namespace testing
+	{
+
+		/*! @brief DenseDoseAccessorTest - test the API of DenseDoseAccessor and MutableDenseDoseAccessor
+			1) test constructors
+			2) test getValueAt/getValues/data
+			3) test MutableDenseDoseAccessor setDoseAt
+			4) test buffer sharing between MutableDenseDoseAccessor and DenseDoseAccessor
+		*/
+		int DenseDoseAccessorTest(int /*argc*/, char* /*argv*/[])
+		{
+			PREPARE_DEFAULT_TEST_REPORTING;
+
+			boost::shared_ptr<DummyDoseAccessor> spTestDoseAccessor = boost::make_shared<DummyDoseAccessor>();
+			core::AccessorInterface::ConstPointer spSourceAccessor(spTestDoseAccessor);
+			const std::vector<DoseTypeGy>* doseVals = spTestDoseAccessor->getDoseVector();
+			const core::GeometricInfo& geoInfo = spSourceAccessor->getGeometricInfo();
+			const GridSizeType numberOfVoxels = geoInfo.getNumberOfVoxels();
+
+			//1) test constructors
+			CHECK_NO_THROW(core::DenseDoseAccessor(geoInfo, *doseVals, "dense"));
+			CHECK_THROW_EXPLICIT(core::DenseDoseAccessor(geoInfo, std::vector<GenericValueType>(3)),
+			                     core::InvalidParameterException);
+			CHECK_THROW_EXPLICIT(core::DenseDoseAccessor(geoInfo, core::DenseDoseAccessor::BufferPointer()),
+			                     core::NullPointerException);
+			CHECK_THROW_EXPLICIT(core::DenseDoseAccessor(core::AccessorInterface::ConstPointer()),
+			                     core::NullPointerException);
+			CHECK_NO_THROW(core::DenseDoseAccessor{spSourceAccessor});
+
+			CHECK_NO_THROW(core::MutableDenseDoseAccessor{geoInfo});
+			CHECK_NO_THROW(core::MutableDenseDoseAccessor(geoInfo, *doseVals));
+			CHECK_THROW_EXPLICIT(core::MutableDenseDoseAccessor(geoInfo, std::vector<GenericValueType>(3)),
+			                     core::InvalidParameterException);
+			CHECK_THROW_EXPLICIT(core::MutableDenseDoseAccessor(geoInfo, core::MutableDenseDoseAccessor::BufferPointer()),
+			                     core::NullPointerException);
+			CHECK_THROW_EXPLICIT(core::MutableDenseDoseAccessor(core::AccessorInterface::ConstPointer()),
+			                     core::NullPointerException);
+
+			//2) test getValueAt/getValues/data
+			auto spDenseAccessor = boost::make_shared<core::DenseDoseAccessor>(spSourceAccessor);
+			CHECK(spDenseAccessor->getGeometricInfo() == geoInfo);
+			CHECK_EQUAL(spDenseAccessor->getUID(), spSourceAccessor->getUID());
+			CHECK(std::equal(doseVals->cbegin(), doseVals->cend(), spDenseAccessor->data()));
+
+			const VoxelGridIndex3D index(3, 4, 2);
+			VoxelGridID id = 0;
+			geoInfo.convert(index, id);
+			CHECK_EQUAL(spDenseAccessor->getValueAt(id), doseVals->at(id));
+			CHECK_EQUAL(spDenseAccessor->getValueAt(index), doseVals->at(id));
+			CHECK_EQUAL(spDenseAccessor->getValueAt(static_cast<VoxelGridID>(numberOfVoxels)), -1);
+			CHECK_EQUAL(spDenseAccessor->getValueAt(VoxelGridIndex3D(geoInfo.getNumColumns(), 0, 0)), -1);
+
+			std::vector<GenericValueType> values(10);
+			CHECK_NO_THROW(spDenseAccessor->getValues(id, 10, values.data()));
+			CHECK(std::equal(values.cbegin(), values.cend(), doseVals->cbegin() + id));
+			CHECK_THROW_EXPLICIT(spDenseAccessor->getValues(static_cast<VoxelGridID>(numberOfVoxels) - 5, 10,
+			                     values.data()), core::IndexOutOfBoundsException);
+
+			//the dense accessor can be used wherever an accessor is expected
+			core::GenericDoseIterator doseIterator(spDenseAccessor);
+			doseIterator.reset();
+			VoxelGridID position = 0;
+
+			while (doseIterator.isPositionValid())
+			{
+				CHECK_EQUAL(doseIterator.getCurrentDoseValue(), doseVals->at(position));
+				doseIterator.next();
+				++position;
+			}
+
+			//3) test MutableDenseDoseAccessor setDoseAt
+			auto spMutableAccessor = boost::make_shared<core::MutableDenseDoseAccessor>(geoInfo, 2.5, "mutable");
+			CHECK_EQUAL(spMutableAccessor->getUID(), "mutable");
+			CHECK_EQUAL(spMutableAccessor->getValueAt(id), 2.5);
+			CHECK_NO_THROW(spMutableAccessor->setDoseAt(id, 7.0));
+			CHECK_EQUAL(spMutableAccessor->getValueAt(index), 7.0);
+			CHECK_EQUAL(spMutableAccessor->data()[id], 7.0);
+			CHECK_NO_THROW(spMutableAccessor->setDoseAt(VoxelGridIndex3D(0, 0, 0), 3.0));
+			CHECK_EQUAL(spMutableAccessor->getValueAt(0), 3.0);
+			spMutableAccessor->data()[1] = 4.0;
+			CHECK_EQUAL(spMutableAccessor->getValueAt(1), 4.0);
+			CHECK_THROW_EXPLICIT(spMutableAccessor->setDoseAt(static_cast<VoxelGridID>(numberOfVoxels), 1.0),
+			                     core::IndexOutOfBoundsException);
+			CHECK_THROW_EXPLICIT(spMutableAccessor->setDoseAt(VoxelGridIndex3D(geoInfo.getNumColumns(), 0, 0), 1.0),
+			                     core::IndexOutOfBoundsException);
+
+			auto spMutableCopy = boost::make_shared<core::MutableDenseDoseAccessor>(spSourceAccessor);
+			spMutableCopy->setDoseAt(id, -5.0);
+			CHECK_EQUAL(spTestDoseAccessor->getValueAt(id), doseVals->at(id));
+			CHECK_EQUAL(spMutableCopy->getValueAt(id + 1), doseVals->at(id + 1));
+
+			//4) test buffer sharing between MutableDenseDoseAccessor and DenseDoseAccessor
+			core::DenseDoseAccessor sharedAccessor(spMutableAccessor->getGeometricInfo(), spMutableAccessor->getBuffer());
+			CHECK_EQUAL(sharedAccessor.data(), spMutableAccessor->data());
+			spMutableAccessor->setDoseAt(id, 9.0);
+			CHECK_EQUAL(sharedAccessor.getValueAt(id), 9.0);
+
+			RETURN_AND_REPORT_TEST_SUCCESS;
+		}
+
+	}//end namespace testing
+}//end namespace rttb
@@ -34,6 +34,8 @@ namespace rttb
 			1) test constructor (values as expected?)
 			2) test reset/next/get current values/isPositionValid
       3) test DoseIteratorInterface functions
+			4) test nextBlock
+			5) test readPositions
 		*/
 		int GenericDoseIteratorTest(int /*argc*/, char* /*argv*/[])
 		{
@@ -98,6 +100,50 @@ namespace rttb
 
       CHECK_THROW_EXPLICIT(genDoseIteratorInhomo.getCurrentVoxelVolume(), core::InvalidParameterException);
 
+			//4) test nextBlock (block size that does not divide the number of voxels)
+			genDoseIterator.reset();
+			std::vector<DoseTypeGy> blockDoses(97);
+			std::vector<FractionType> blockFractions(97);
+			std::vector<VoxelGridID> blockIDs(97);
+			std::size_t blockSize = 0;
+			position = 0;
+			unsigned int mismatches = 0;
+
+			while ((blockSize = genDoseIterator.nextBlock(blockDoses.size(), blockDoses.data(), blockFractions.data(),
+			                    blockIDs.data())) > 0)
+			{
+				for (std::size_t i = 0; i < blockSize; ++i, ++position)
+				{
+					if (blockDoses[i] != doseVals->at(position) || blockFractions[i] != 1 || blockIDs[i] != position)
+					{
+						++mismatches;
+					}
+				}
+			}
+
+			CHECK_EQUAL(mismatches, 0);
+			CHECK_EQUAL(position, spTestDoseAccessor->getGridSize());
+			CHECK(!genDoseIterator.isPositionValid());
+			CHECK_EQUAL(genDoseIterator.nextBlock(blockDoses.size(), blockDoses.data(), nullptr, nullptr), 0);
+
+			//mixing block and single voxel iteration
+			genDoseIterator.reset();
+			CHECK_EQUAL(genDoseIterator.nextBlock(5, blockDoses.data(), nullptr, nullptr), 5);
+			CHECK_EQUAL(genDoseIterator.getCurrentVoxelGridID(), 5);
+			CHECK_EQUAL(genDoseIterator.getCurrentDoseValue(), doseVals->at(5));
+
+			//5) test readPositions (does not move the iterator)
+			const auto numberOfPositions = static_cast<std::size_t>(spTestDoseAccessor->getGridSize());
+			CHECK_EQUAL(genDoseIterator.getNumberOfPositions(), numberOfPositions);
+			CHECK_EQUAL(genDoseIterator.readPositions(10, 20, blockDoses.data(), blockFractions.data(), blockIDs.data()), 20);
+			CHECK_EQUAL(blockDoses[19], doseVals->at(29));
+			CHECK_EQUAL(blockFractions[19], 1);
+			CHECK_EQUAL(blockIDs[19], 29);
+			CHECK_EQUAL(genDoseIterator.getCurrentVoxelGridID(), 5);
+			CHECK_EQUAL(genDoseIterator.readPositions(numberOfPositions - 3, 20, blockDoses.data(), nullptr, nullptr), 3);
+			CHECK_EQUAL(blockDoses[2], doseVals->at(numberOfPositions - 1));
+			CHECK_EQUAL(genDoseIterator.readPositions(numberOfPositions, 20, blockDoses.data(), nullptr, nullptr), 0);
+
 			RETURN_AND_REPORT_TEST_SUCCESS;
 		}
 
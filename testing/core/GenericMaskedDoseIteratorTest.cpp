@@ -38,6 +38,8 @@ namespace rttb
 		/*! @brief GenericMaskedDoseIteratorTest.
 			1) test constructor (values as expected?)
 			2) test reset/next/get current values/isPositionValid
+			3) test nextBlock
+			4) test readPositions
 		*/
 		int GenericMaskedDoseIteratorTest(int /*argc*/, char* /*argv*/[])
 		{
@@ -127,6 +129,50 @@ namespace rttb
 			CHECK_EQUAL(defaultDoseVoxelGridID, genMaskedDoseIterator.getCurrentVoxelGridID());
 			CHECK(genMaskedDoseIterator.isPositionValid());//at start of dose
 
+			//3) test nextBlock (block size that does not divide the number of mask voxels)
+			genMaskedDoseIterator.reset();
+			std::vector<DoseTypeGy> blockDoses(97);
+			std::vector<FractionType> blockFractions(97);
+			std::vector<VoxelGridID> blockIDs(97);
+			std::size_t blockSize = 0;
+			position = 0;
+			unsigned int mismatches = 0;
+
+			while ((blockSize = genMaskedDoseIterator.nextBlock(blockDoses.size(), blockDoses.data(),
+			                    blockFractions.data(), blockIDs.data())) > 0)
+			{
+				for (std::size_t i = 0; i < blockSize; ++i, ++position)
+				{
+					const core::MaskVoxel& voxel = maskedVoxelListPtr->at(position);
+
+					if (blockDoses[i] != doseVals->at(voxel.getVoxelGridID())
+					    || blockFractions[i] != voxel.getRelevantVolumeFraction() || blockIDs[i] != voxel.getVoxelGridID())
+					{
+						++mismatches;
+					}
+				}
+			}
+
+			CHECK_EQUAL(mismatches, 0);
+			CHECK_EQUAL(position, maskedVoxelListPtr->size());
+			CHECK(!genMaskedDoseIterator.isPositionValid());
+
+			//without fraction and ID buffers
+			genMaskedDoseIterator.reset();
+			CHECK_EQUAL(genMaskedDoseIterator.nextBlock(3, blockDoses.data(), nullptr, nullptr), 3);
+			CHECK_EQUAL(blockDoses[2], doseVals->at(maskedVoxelListPtr->at(2).getVoxelGridID()));
+			CHECK_EQUAL(genMaskedDoseIterator.getCurrentVoxelGridID(), maskedVoxelListPtr->at(3).getVoxelGridID());
+
+			//4) test readPositions (does not move the iterator)
+			CHECK_EQUAL(genMaskedDoseIterator.getNumberOfPositions(), maskedVoxelListPtr->size());
+			CHECK_EQUAL(genMaskedDoseIterator.readPositions(5, 4, blockDoses.data(), blockFractions.data(), nullptr), 4);
+			CHECK_EQUAL(blockDoses[3], doseVals->at(maskedVoxelListPtr->at(8).getVoxelGridID()));
+			CHECK_EQUAL(blockFractions[3], maskedVoxelListPtr->at(8).getRelevantVolumeFraction());
+			CHECK_EQUAL(genMaskedDoseIterator.getCurrentVoxelGridID(), maskedVoxelListPtr->at(3).getVoxelGridID());
+			CHECK_EQUAL(genMaskedDoseIterator.readPositions(maskedVoxelListPtr->size() - 1, 4, blockDoses.data(), nullptr,
+			            blockIDs.data()), 1);
+			CHECK_EQUAL(blockIDs[0], maskedVoxelListPtr->back().getVoxelGridID());
+
 			RETURN_AND_REPORT_TEST_SUCCESS;
 		}
 
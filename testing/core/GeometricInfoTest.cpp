@@ -13,6 +13,8 @@
 //
 //------------------------------------------------------------------------
 
+#include <vector>
+
 #include "litCheckMacros.h"
 
 #include "rttbBaseType.h"
@@ -38,6 +40,8 @@ namespace rttb
 			13) test getNumberOfVoxels
 			14) Test convert, validID and validIndex
 			15) Cloning of information
+			16) test cached affine matrices and batch conversions
+			17) test world to index conversion of a grid far away from the origin
 		*/
 
 		int GeometricInfoTest(int /*argc*/, char* /*argv*/[])
@@ -563,6 +567,118 @@ namespace rttb
 			core::GeometricInfo::Pointer clone2 = sourceInfo.clone();
 			CHECK(*clone2 == sourceInfo);
 
+			//16) test cached affine matrices and batch conversions
+			core::GeometricInfo affineInfo;
+			affineInfo.setImageSize(ImageSize(4, 3, 2));
+			affineInfo.setSpacing(SpacingVectorType3D(2, 0.5, 3));
+			affineInfo.setImagePositionPatient(WorldCoordinate3D(20, 100, -1000));
+			CHECK_NO_THROW(affineInfo.setOrientationMatrix(newOrientation));
+
+			const core::GeometricInfo::AffineMatrixType& indexToWorld = affineInfo.getIndexToWorldMatrix();
+			const core::GeometricInfo::AffineMatrixType& worldToIndex = affineInfo.getWorldToIndexMatrix();
+			CHECK_EQUAL(indexToWorld[0][0], 1.0);
+			CHECK_EQUAL(indexToWorld[1][2], -9.0);
+			CHECK_EQUAL(indexToWorld[2][1], 0.5);
+			CHECK_EQUAL(indexToWorld[0][3], 20.0);
+			CHECK_EQUAL(indexToWorld[1][3], 100.0);
+			CHECK_EQUAL(indexToWorld[2][3], -1000.0);
+
+			//world to index matrix has to be the inverse of index to world matrix
+			for (std::size_t i = 0; i < 3; ++i)
+			{
+				for (std::size_t j = 0; j < 3; ++j)
+				{
+					const double product = worldToIndex[i][0] * indexToWorld[0][j] + worldToIndex[i][1] * indexToWorld[1][j]
+					                       + worldToIndex[i][2] * indexToWorld[2][j];
+					CHECK_CLOSE(product, (i == j) ? 1.0 : 0.0, errorConstant);
+				}
+			}
+
+			//matrices follow changes of spacing and image position
+			affineInfo.setSpacing(SpacingVectorType3D(1));
+			CHECK_EQUAL(affineInfo.getIndexToWorldMatrix()[1][2], -3.0);
+			affineInfo.setImagePositionPatient(WorldCoordinate3D(0));
+			CHECK_EQUAL(affineInfo.getIndexToWorldMatrix()[2][3], 0.0);
+			affineInfo.setSpacing(SpacingVectorType3D(2, 0.5, 3));
+			affineInfo.setImagePositionPatient(WorldCoordinate3D(20, 100, -1000));
+
+			//inline conversions give the same result as the checked ones
+			const ContinuousVoxelGridIndex3D affineIndex(1.5, 2.25, -0.5);
+			WorldCoordinate3D checkedWorld;
+			CHECK(affineInfo.continuousIndexToWorldCoordinate(affineIndex, checkedWorld));
+			CHECK_EQUAL(affineInfo.continuousIndexToWorldCoordinate(affineIndex), checkedWorld);
+			CHECK_EQUAL(checkedWorld, WorldCoordinate3D(21.5, 104.5, -998.875));
+			ContinuousVoxelGridIndex3D checkedIndex;
+			affineInfo.worldCoordinateToContinuousIndex(checkedWorld, checkedIndex);
+			CHECK_EQUAL(affineInfo.worldCoordinateToContinuousIndex(checkedWorld), checkedIndex);
+			CHECK(checkedIndex.equalsAlmost(affineIndex, errorConstant));
+			const VoxelGridIndex3D affineGridIndex(3, 2, 1);
+			CHECK(affineInfo.indexToWorldCoordinate(affineGridIndex, checkedWorld));
+			CHECK_EQUAL(affineInfo.indexToWorldCoordinate(affineGridIndex), checkedWorld);
+
+			//batch conversion of point arrays
+			const std::vector<WorldCoordinate3D> batchWorld = { WorldCoordinate3D(20, 100, -1000), WorldCoordinate3D(21.5, 104.5, -998.875), WorldCoordinate3D(-3.3, 7.1, 12.9) };
+			std::vector<ContinuousVoxelGridIndex3D> batchIndices(batchWorld.size());
+			affineInfo.worldCoordinateToContinuousIndex(batchWorld.data(), batchWorld.size(), batchIndices.data());
+			std::vector<WorldCoordinate3D> batchBack(batchWorld.size());
+			affineInfo.continuousIndexToWorldCoordinate(batchIndices.data(), batchIndices.size(), batchBack.data());
+
+			for (std::size_t i = 0; i < batchWorld.size(); ++i)
+			{
+				CHECK_EQUAL(batchIndices[i], affineInfo.worldCoordinateToContinuousIndex(batchWorld[i]));
+				CHECK(batchBack[i].equalsAlmost(batchWorld[i], errorConstant));
+			}
+
+			//batch conversion of whole index rows is bit identical to the per voxel conversion
+			std::vector<WorldCoordinate3D> rowWorld(affineInfo.getNumColumns());
+
+			for (GridIndexType slice = 0; slice < affineInfo.getNumSlices(); ++slice)
+			{
+				for (GridIndexType row = 0; row < affineInfo.getNumRows(); ++row)
+				{
+					affineInfo.indexRowToWorldCoordinates(row, slice, rowWorld.data());
+
+					for (GridIndexType column = 0; column < affineInfo.getNumColumns(); ++column)
+					{
+						WorldCoordinate3D expectedWorld;
+						affineInfo.indexToWorldCoordinate(VoxelGridIndex3D(column, row, slice), expectedWorld);
+						CHECK_EQUAL(rowWorld[column], expectedWorld);
+					}
+				}
+			}
+
+			//17) test world to index conversion of a grid far away from the origin
+			core::GeometricInfo farInfo;
+			farInfo.setImageSize(ImageSize(512, 512, 200));
+			farInfo.setSpacing(SpacingVectorType3D(0.977, 0.977, 2.5));
+			farInfo.setImagePositionPatient(WorldCoordinate3D(1e6 + 0.1, -2.5e6 + 0.3, 7.5e5 + 0.7));
+			farInfo.setOrientationMatrix(OrientationMatrix());
+			int farMismatches = 0;
+
+			for (GridIndexType farIndex = 0; farIndex < 200; farIndex += 3)
+			{
+				const VoxelGridIndex3D voxel(farIndex * 2, 511 - farIndex * 2, farIndex);
+				const WorldCoordinate3D center = farInfo.indexToWorldCoordinate(voxel);
+				const ContinuousVoxelGridIndex3D continuousIndex = farInfo.worldCoordinateToContinuousIndex(center);
+				VoxelGridIndex3D convertedIndex;
+
+				if (!farInfo.worldCoordinateToIndex(center, convertedIndex) || !(convertedIndex == voxel)
+				    || !continuousIndex.equalsAlmost(ContinuousVoxelGridIndex3D(voxel.x(), voxel.y(), voxel.z()), 1e-9))
+				{
+					++farMismatches;
+				}
+
+				//points close to the voxel border are assigned to the same voxel
+				const WorldCoordinate3D nearBorder = center + WorldCoordinate3D(0.45 * 0.977, -0.45 * 0.977, 0.45 * 2.5);
+
+				if (!farInfo.worldCoordinateToIndex(nearBorder, convertedIndex) || !(convertedIndex == voxel))
+				{
+					++farMismatches;
+				}
+			}
+
+			CHECK_EQUAL(farMismatches, 0);
+
 			RETURN_AND_REPORT_TEST_SUCCESS;
 		}
 
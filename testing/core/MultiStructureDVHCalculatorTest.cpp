@@ -0,0 +1,206 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+// this file defines the rttbCoreTests for the test driver
+// and all it expects is that you have a function called RegisterTests
+
+#include <vector>
+
+#include <boost/make_shared.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include "litCheckMacros.h"
+
+#include "rttbBaseType.h"
+#include "rttbDVHCalculator.h"
+#include "rttbMultiStructureDVHCalculator.h"
+#include "rttbGenericMaskedDoseIterator.h"
+#include "rttbGeometricInfo.h"
+#include "rttbException.h"
+#include "rttbNullPointerException.h"
+#include "rttbInvalidParameterException.h"
+#include "DummyDoseAccessor.h"
+#include "DummyMaskAccessor.h"
+
+namespace rttb
+{
+
+	namespace testing
+	{
+		typedef core::MultiStructureDVHCalculator::DoseAccessorPointer DoseAccessorPointer;
+		typedef core::MultiStructureDVHCalculator::MaskAccessorPointer MaskAccessorPointer;
+		typedef core::MaskAccessorInterface::MaskVoxelList MaskVoxelList;
+
+		/*!@brief MultiStructureDVHCalculatorTest - test the API of MultiStructureDVHCalculator
+		 1) test constructor
+		 2) test generateDVHs (same DVHs as DVHCalculator for every structure, with and without multi-threading)
+		 3) test generateDVHSet
+		*/
+
+		int MultiStructureDVHCalculatorTest(int /*argc*/, char* /*argv*/[])
+		{
+			PREPARE_DEFAULT_TEST_REPORTING;
+
+			DoseAccessorPointer spDoseAccessor = boost::make_shared<DummyDoseAccessor>();
+			const core::GeometricInfo& geoInfo = spDoseAccessor->getGeometricInfo();
+			const IDType doseID = spDoseAccessor->getUID();
+
+			//two random masks, a mask that overlaps both of them and an empty mask
+			auto spOverlapVoxels = boost::make_shared<MaskVoxelList>();
+
+			for (VoxelGridID id = 0; id < geoInfo.getNumberOfVoxels(); id += 3)
+			{
+				spOverlapVoxels->emplace_back(id, 0.5);
+			}
+
+			std::vector<MaskAccessorPointer> masks;
+			masks.push_back(boost::make_shared<DummyMaskAccessor>(geoInfo));
+			masks.push_back(boost::make_shared<DummyMaskAccessor>(geoInfo));
+			masks.push_back(boost::make_shared<DummyMaskAccessor>(geoInfo, spOverlapVoxels));
+			masks.push_back(boost::make_shared<DummyMaskAccessor>(geoInfo, boost::make_shared<MaskVoxelList>()));
+
+			for (auto& mask : masks)
+			{
+				mask->updateMask();
+			}
+
+			const std::vector<IDType> structureIDs = {"struct1", "struct2", "overlap", "empty"};
+
+			//1) test constructor
+			CHECK_NO_THROW(core::MultiStructureDVHCalculator(spDoseAccessor, masks, structureIDs, doseID));
+			CHECK_THROW_EXPLICIT(core::MultiStructureDVHCalculator(DoseAccessorPointer(), masks, structureIDs, doseID),
+			                     core::NullPointerException);
+
+			std::vector<MaskAccessorPointer> masksWithNull(masks);
+			masksWithNull.push_back(MaskAccessorPointer());
+			std::vector<IDType> structureIDsWithNull(structureIDs);
+			structureIDsWithNull.push_back("null");
+			CHECK_THROW_EXPLICIT(core::MultiStructureDVHCalculator(spDoseAccessor, masksWithNull, structureIDsWithNull,
+			                     doseID), core::NullPointerException);
+			CHECK_THROW_EXPLICIT(core::MultiStructureDVHCalculator(spDoseAccessor, masks, std::vector<IDType>(1, "struct1"),
+			                     doseID), core::InvalidParameterException);
+			CHECK_THROW_EXPLICIT(core::MultiStructureDVHCalculator(spDoseAccessor, masks, structureIDs, doseID, -1),
+			                     core::InvalidParameterException);
+			CHECK_THROW_EXPLICIT(core::MultiStructureDVHCalculator(spDoseAccessor, masks, structureIDs, doseID, 0, 0),
+			                     core::InvalidParameterException);
+
+			core::GeometricInfo otherGeoInfo(geoInfo);
+			otherGeoInfo.setNumSlices(geoInfo.getNumSlices() + 1);
+			std::vector<MaskAccessorPointer> otherGridMasks(1, boost::make_shared<DummyMaskAccessor>(otherGeoInfo));
+			CHECK_THROW_EXPLICIT(core::MultiStructureDVHCalculator(spDoseAccessor, otherGridMasks,
+			                     std::vector<IDType>(1, "struct1"), doseID), core::Exception);
+
+			//2) test generateDVHs
+			core::MultiStructureDVHCalculator multiCalc(spDoseAccessor, masks, structureIDs, doseID);
+			CHECK(!multiCalc.getMultiThreading());
+			core::MultiStructureDVHCalculator::DVHListType dvhs;
+			CHECK_NO_THROW(dvhs = multiCalc.generateDVHs());
+			CHECK_EQUAL(dvhs.size(), masks.size());
+
+			multiCalc.setMultiThreading(true);
+			CHECK(multiCalc.getMultiThreading());
+			core::MultiStructureDVHCalculator::DVHListType parallelDVHs = multiCalc.generateDVHs();
+			CHECK_EQUAL(parallelDVHs.size(), masks.size());
+
+			for (std::size_t i = 0; i < masks.size() && i < dvhs.size() && i < parallelDVHs.size(); ++i)
+			{
+				auto spMaskedDoseIterator = boost::make_shared<core::GenericMaskedDoseIterator>(masks[i], spDoseAccessor);
+				core::DVHCalculator referenceCalc(spMaskedDoseIterator, structureIDs[i], doseID);
+				core::DVH::Pointer referenceDVH = referenceCalc.generateDVH();
+
+				CHECK_EQUAL(dvhs[i]->getStructureID(), structureIDs[i]);
+				CHECK_EQUAL(dvhs[i]->getDoseID(), doseID);
+				CHECK_EQUAL(dvhs[i]->getDeltaD(), referenceDVH->getDeltaD());
+				CHECK_EQUAL(dvhs[i]->getDeltaV(), referenceDVH->getDeltaV());
+				CHECK(dvhs[i]->getDataDifferential() == referenceDVH->getDataDifferential());
+				CHECK_EQUAL(dvhs[i]->getVoxelizationID(), referenceDVH->getVoxelizationID());
+
+				CHECK_EQUAL(parallelDVHs[i]->getDeltaD(), dvhs[i]->getDeltaD());
+				CHECK(parallelDVHs[i]->getDataDifferential() == dvhs[i]->getDataDifferential());
+			}
+
+			CHECK_CLOSE(dvhs[3]->getDeltaD(), 0.1, errorConstant);
+			CHECK_EQUAL(dvhs[3]->getNumberOfVoxels(), 0);
+
+			//fixed bin width
+			const DoseTypeGy binSize = dvhs[0]->getDeltaD();
+			core::MultiStructureDVHCalculator fixedBinCalc(spDoseAccessor, masks, structureIDs, doseID, binSize);
+			core::MultiStructureDVHCalculator::DVHListType fixedBinDVHs = fixedBinCalc.generateDVHs();
+
+			for (std::size_t i = 0; i < masks.size(); ++i)
+			{
+				auto spMaskedDoseIterator = boost::make_shared<core::GenericMaskedDoseIterator>(masks[i], spDoseAccessor);
+				core::DVHCalculator referenceCalc(spMaskedDoseIterator, structureIDs[i], doseID, binSize);
+				CHECK(fixedBinDVHs[i]->getDataDifferential() == referenceCalc.generateDVH()->getDataDifferential());
+			}
+
+			core::MultiStructureDVHCalculator tooFewBinsCalc(spDoseAccessor, masks, structureIDs, doseID, binSize, 1);
+			CHECK_THROW_EXPLICIT(tooFewBinsCalc.generateDVHs(), core::InvalidParameterException);
+			tooFewBinsCalc.setMultiThreading(true);
+			CHECK_THROW_EXPLICIT(tooFewBinsCalc.generateDVHs(), core::InvalidParameterException);
+
+			//large grid: the voxel table is read in several blocks
+			core::GeometricInfo largeGeoInfo;
+			largeGeoInfo.setNumColumns(50);
+			largeGeoInfo.setNumRows(50);
+			largeGeoInfo.setNumSlices(60);
+			largeGeoInfo.setSpacing({1.0, 1.0, 1.0});
+			std::vector<DoseTypeGy> largeDoseVals(largeGeoInfo.getNumberOfVoxels());
+
+			for (std::size_t i = 0; i < largeDoseVals.size(); ++i)
+			{
+				largeDoseVals[i] = static_cast<DoseTypeGy>(i % 1000) / 10;
+			}
+
+			DoseAccessorPointer spLargeDoseAccessor = boost::make_shared<DummyDoseAccessor>(largeDoseVals, largeGeoInfo);
+			auto spLargeVoxels = boost::make_shared<MaskVoxelList>();
+
+			for (VoxelGridID id = 0; id < largeGeoInfo.getNumberOfVoxels(); id += 2)
+			{
+				spLargeVoxels->emplace_back(id, 1);
+			}
+
+			std::vector<MaskAccessorPointer> largeMasks(1, boost::make_shared<DummyMaskAccessor>(largeGeoInfo, spLargeVoxels));
+			core::MultiStructureDVHCalculator largeCalc(spLargeDoseAccessor, largeMasks, std::vector<IDType>(1, "large"),
+			        doseID, 0, 201, true);
+			core::MultiStructureDVHCalculator::DVHListType largeDVHs = largeCalc.generateDVHs();
+			auto spLargeMaskedDoseIterator = boost::make_shared<core::GenericMaskedDoseIterator>(largeMasks[0],
+			                                 spLargeDoseAccessor);
+			core::DVHCalculator largeReferenceCalc(spLargeMaskedDoseIterator, "large", doseID);
+			core::DVH::Pointer largeReferenceDVH = largeReferenceCalc.generateDVH();
+			CHECK_EQUAL(largeDVHs[0]->getDeltaD(), largeReferenceDVH->getDeltaD());
+			CHECK(largeDVHs[0]->getDataDifferential() == largeReferenceDVH->getDataDifferential());
+
+			//3) test generateDVHSet
+			core::DVHSet::Pointer dvhSet;
+			CHECK_NO_THROW(dvhSet = multiCalc.generateDVHSet("myStructureSet"));
+			CHECK_EQUAL(dvhSet->size(), masks.size());
+			CHECK_EQUAL(dvhSet->getHealthyTissueSet().size(), masks.size());
+			CHECK_EQUAL(dvhSet->getStrSetID(), "myStructureSet");
+			CHECK_EQUAL(dvhSet->getDoseID(), doseID);
+			CHECK(*(dvhSet->getDVH("overlap")) == *(dvhs[2]));
+
+			std::vector<DVHRole> roles = {{DVHRole::TargetVolume}, {DVHRole::HealthyTissue}, {DVHRole::HealthyTissue}, {DVHRole::WholeVolume}};
+			CHECK_NO_THROW(dvhSet = multiCalc.generateDVHSet("myStructureSet", roles));
+			CHECK_EQUAL(dvhSet->getTargetVolumeSet().size(), 1);
+			CHECK_EQUAL(dvhSet->getHealthyTissueSet().size(), 2);
+			CHECK_EQUAL(dvhSet->getWholeVolumeSet().size(), 1);
+			roles.pop_back();
+			CHECK_THROW_EXPLICIT(multiCalc.generateDVHSet("myStructureSet", roles), core::InvalidParameterException);
+
+			RETURN_AND_REPORT_TEST_SUCCESS;
+		}
+
+	}//end namespace testing
+}//end namespace rttb
@@ -0,0 +1,161 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+// this file defines the rttbCoreTests for the test driver
+// and all it expects is that you have a function called RegisterTests
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "litCheckMacros.h"
+
+#include "rttbThreadPool.h"
+
+namespace rttb
+{
+	namespace testing
+	{
+
+		/*! @brief ThreadPoolTest.
+			1) test constructor
+			2) test that all tasks of a group are executed
+			3) test nested groups on a single worker
+			4) test exception propagation
+			5) test that the tasks queued by a worker are stolen by the other workers
+		*/
+		int ThreadPoolTest(int /*argc*/, char* /*argv*/[])
+		{
+			PREPARE_DEFAULT_TEST_REPORTING;
+
+			//1) test constructor
+			CHECK_NO_THROW(core::ThreadPool{2});
+			core::ThreadPool pool(3);
+			CHECK_EQUAL(pool.getNumberOfThreads(), 3);
+			CHECK(core::ThreadPool::getDefault().getNumberOfThreads() >= 1);
+
+			//2) test that all tasks of a group are executed
+			std::vector<int> results(1000, 0);
+			{
+				core::ThreadPool::TaskGroup tasks(pool);
+
+				for (size_t i = 0; i < results.size(); ++i)
+				{
+					tasks.run([&results, i]()
+					{
+						results[i] = static_cast<int>(i) * 2;
+					});
+				}
+
+				CHECK_NO_THROW(tasks.wait());
+			}
+
+			bool allExecuted = true;
+
+			for (size_t i = 0; i < results.size(); ++i)
+			{
+				allExecuted = allExecuted && results[i] == static_cast<int>(i) * 2;
+			}
+
+			CHECK(allExecuted);
+
+			//3) test nested groups on a single worker: the waiting task has to process the inner tasks itself
+			core::ThreadPool singleWorkerPool(1);
+			std::atomic<int> counter(0);
+			{
+				core::ThreadPool::TaskGroup outerTasks(singleWorkerPool);
+
+				for (int i = 0; i < 4; ++i)
+				{
+					outerTasks.run([&singleWorkerPool, &counter]()
+					{
+						core::ThreadPool::TaskGroup innerTasks(singleWorkerPool);
+
+						for (int j = 0; j < 10; ++j)
+						{
+							innerTasks.run([&counter]()
+							{
+								++counter;
+							});
+						}
+
+						innerTasks.wait();
+					});
+				}
+
+				CHECK_NO_THROW(outerTasks.wait());
+			}
+			CHECK_EQUAL(counter.load(), 40);
+
+			//4) test exception propagation: remaining tasks are still executed, the group can be reused
+			counter = 0;
+			core::ThreadPool::TaskGroup tasks(pool);
+
+			for (int i = 0; i < 10; ++i)
+			{
+				tasks.run([&counter, i]()
+				{
+					++counter;
+
+					if (i == 5)
+					{
+						throw std::runtime_error("task failed");
+					}
+				});
+			}
+
+			CHECK_THROW_EXPLICIT(tasks.wait(), std::runtime_error);
+			CHECK_EQUAL(counter.load(), 10);
+			tasks.run([&counter]()
+			{
+				++counter;
+			});
+			CHECK_NO_THROW(tasks.wait());
+			CHECK_EQUAL(counter.load(), 11);
+
+			//5) test that the tasks queued by a worker are stolen by the other workers
+			std::mutex threadIDMutex;
+			std::set<std::thread::id> threadIDs;
+			{
+				core::ThreadPool::TaskGroup outerTasks(pool);
+				outerTasks.run([&pool, &threadIDMutex, &threadIDs]()
+				{
+					core::ThreadPool::TaskGroup innerTasks(pool);
+
+					for (int i = 0; i < 12; ++i)
+					{
+						innerTasks.run([&threadIDMutex, &threadIDs]()
+						{
+							std::this_thread::sleep_for(std::chrono::milliseconds(10));
+							std::lock_guard<std::mutex> lock(threadIDMutex);
+							threadIDs.insert(std::this_thread::get_id());
+						});
+					}
+
+					innerTasks.wait();
+				});
+				CHECK_NO_THROW(outerTasks.wait());
+			}
+			CHECK(threadIDs.size() > 1);
+
+			RETURN_AND_REPORT_TEST_SUCCESS;
+		}
+
+	}//end namespace testing
+}//end namespace rttb
@@ -11,6 +11,17 @@ SET(CPP_FILES
 	StrVectorStructureSetGeneratorTest.cpp
 	StructureSetTest.cpp
 	BaseTypeTest.cpp
+	AccessorInterfaceTest.cpp
+	DenseDoseAccessorTest.cpp
+	CachedDoseAccessorTest.cpp
+	BlockCachedDoseAccessorTest.cpp
+	CompactMaskTest.cpp
+	BufferedDoseIteratorTest.cpp
+	ThreadPoolTest.cpp
+	MultiStructureDVHCalculatorTest.cpp
+	CompensatedSumTest.cpp
+	BlockwiseReductionTest.cpp
+	DVHSetArithmeticTest.cpp
   )
 
 SET(H_FILES 
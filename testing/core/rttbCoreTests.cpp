@@ -43,6 +43,17 @@ namespace rttb
 			LIT_REGISTER_TEST(StrVectorStructureSetGeneratorTest);
 			LIT_REGISTER_TEST(StructureSetTest);
       LIT_REGISTER_TEST(BaseTypeTest);
+			LIT_REGISTER_TEST(AccessorInterfaceTest);
+			LIT_REGISTER_TEST(DenseDoseAccessorTest);
+			LIT_REGISTER_TEST(CachedDoseAccessorTest);
+			LIT_REGISTER_TEST(BlockCachedDoseAccessorTest);
+			LIT_REGISTER_TEST(CompactMaskTest);
+			LIT_REGISTER_TEST(BufferedDoseIteratorTest);
+			LIT_REGISTER_TEST(ThreadPoolTest);
+			LIT_REGISTER_TEST(MultiStructureDVHCalculatorTest);
+			LIT_REGISTER_TEST(CompensatedSumTest);
+			LIT_REGISTER_TEST(BlockwiseReductionTest);
+			LIT_REGISTER_TEST(DVHSetArithmeticTest);
 		}
 	}
 }
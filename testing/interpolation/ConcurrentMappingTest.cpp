@@ -0,0 +1,129 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+#include <atomic>
+#include <vector>
+
+#include "boost/make_shared.hpp"
+
+#include "litCheckMacros.h"
+
+#include "rttbBaseType.h"
+#include "rttbThreadPool.h"
+#include "rttbCachedDoseAccessor.h"
+#include "rttbArithmetic.h"
+#include "rttbNullPointerException.h"
+#include "rttbInvalidParameterException.h"
+#include "rttbBinaryFunctorAccessor.h"
+#include "rttbSimpleMappableDoseAccessor.h"
+#include "rttbRosuMappableDoseAccessor.h"
+#include "rttbLinearInterpolation.h"
+#include "DummyTransformation.h"
+#include "DummyDoseAccessor.h"
+
+namespace rttb
+{
+	namespace testing
+	{
+		typedef rttb::interpolation::SimpleMappableDoseAccessor SimpleMappableDoseAccessor;
+		typedef rttb::interpolation::RosuMappableDoseAccessor RosuMappableDoseAccessor;
+		typedef rttb::interpolation::TransformationInterface TransformationInterface;
+		typedef rttb::interpolation::LinearInterpolation LinearInterpolation;
+		typedef rttb::algorithms::BinaryFunctorAccessor<rttb::algorithms::arithmetic::doseOp::Add> AddedDoseAccessor;
+
+		/*! Reads every voxel of the accessor from numberOfTasks tasks on the shared thread pool at the same time (every
+			task starts at a different voxel) and returns the number of values that differ from the reference.
+		*/
+		GridSizeType countConcurrentMismatches(const core::AccessorInterface& accessor,
+		                                       const std::vector<GenericValueType>& reference, unsigned int numberOfTasks)
+		{
+			const auto numberOfVoxels = static_cast<VoxelGridID>(reference.size());
+			std::atomic<GridSizeType> mismatches(0);
+			core::ThreadPool::TaskGroup group(core::ThreadPool::getDefault());
+
+			for (unsigned int task = 0; task < numberOfTasks; ++task)
+			{
+				group.run([&accessor, &reference, &mismatches, numberOfVoxels, numberOfTasks, task]()
+				{
+					const VoxelGridID offset = numberOfVoxels * task / numberOfTasks;
+
+					for (VoxelGridID i = 0; i < numberOfVoxels; ++i)
+					{
+						const VoxelGridID id = (i + offset) % numberOfVoxels;
+
+						if (accessor.getValueAt(id) != reference[id])
+						{
+							++mismatches;
+						}
+					}
+				});
+			}
+
+			group.wait();
+			return mismatches;
+		}
+
+		/*! @brief ConcurrentMappingTest - test that a lazy mapped accessor chain can be evaluated concurrently
+			The chain adds a RosuMappableDoseAccessor and a SimpleMappableDoseAccessor (linear interpolation) of two
+			doses with a BinaryFunctorAccessor, as CachedDoseAccessor requires it of its source. The reference values
+			are read sequentially.
+			1) concurrent reads of the chain
+			2) CachedDoseAccessor in eager mode (parallel slabs)
+			3) CachedDoseAccessor in on demand mode with concurrent reads
+		*/
+		int ConcurrentMappingTest(int /*argc*/, char* /*argv*/[])
+		{
+			PREPARE_DEFAULT_TEST_REPORTING;
+
+			auto dose1 = boost::make_shared<DummyDoseAccessor>();
+			auto dose2 = boost::make_shared<DummyDoseAccessor>();
+			const core::GeometricInfo& geoInfo = dose1->getGeometricInfo();
+			TransformationInterface::Pointer transformDummy = boost::make_shared<DummyTransformation>();
+
+			auto rosuMapped = boost::make_shared<RosuMappableDoseAccessor>(geoInfo, dose1, transformDummy);
+			auto linearMapped = boost::make_shared<SimpleMappableDoseAccessor>(geoInfo, dose2, transformDummy,
+			                    boost::make_shared<LinearInterpolation>());
+			auto chain = boost::make_shared<AddedDoseAccessor>(rosuMapped, linearMapped,
+			             rttb::algorithms::arithmetic::doseOp::Add());
+
+			const GridSizeType numberOfVoxels = geoInfo.getNumberOfVoxels();
+			std::vector<GenericValueType> reference(numberOfVoxels);
+
+			for (VoxelGridID id = 0; id < numberOfVoxels; ++id)
+			{
+				reference[id] = chain->getValueAt(id);
+			}
+
+			const unsigned int numberOfTasks = 8;
+
+			//1) concurrent reads of the chain
+			CHECK_EQUAL(countConcurrentMismatches(*chain, reference, numberOfTasks), 0);
+
+			//2) CachedDoseAccessor in eager mode (parallel slabs)
+			core::CachedDoseAccessor eager(chain, core::CachedDoseAccessor::CachingMode::Eager, numberOfTasks);
+			CHECK_EQUAL(eager.getNumberOfCachedBlocks(), eager.getNumberOfBlocks());
+			CHECK_EQUAL(countConcurrentMismatches(eager, reference, 1), 0);
+
+			//3) CachedDoseAccessor in on demand mode with concurrent reads
+			core::CachedDoseAccessor onDemand(chain, core::CachedDoseAccessor::CachingMode::OnDemand);
+			CHECK_EQUAL(onDemand.getNumberOfCachedBlocks(), 0);
+			CHECK_EQUAL(countConcurrentMismatches(onDemand, reference, numberOfTasks), 0);
+			CHECK_EQUAL(onDemand.getNumberOfCachedBlocks(), onDemand.getNumberOfBlocks());
+
+			RETURN_AND_REPORT_TEST_SUCCESS;
+		}
+
+	}//end namespace testing
+}//end namespace rttb
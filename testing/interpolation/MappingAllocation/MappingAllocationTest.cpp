@@ -0,0 +1,128 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <new>
+
+#include "boost/make_shared.hpp"
+
+#include "litCheckMacros.h"
+
+#include "rttbBaseType.h"
+#include "rttbSimpleMappableDoseAccessor.h"
+#include "rttbNearestNeighborInterpolation.h"
+#include "rttbLinearInterpolation.h"
+#include "DummyTransformation.h"
+#include "DummyDoseAccessor.h"
+
+namespace
+{
+	std::atomic<std::size_t> numberOfAllocations(0);
+}
+
+//count every heap allocation of the test driver to be able to check the inner mapping loop.
+//This replaces operator new/delete for the whole executable, so the test has its own driver.
+void* operator new (std::size_t size)
+{
+	++numberOfAllocations;
+
+	if (void* ptr = std::malloc(size == 0 ? 1 : size))
+	{
+		return ptr;
+	}
+
+	throw std::bad_alloc();
+}
+
+void operator delete (void* ptr) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete (void* ptr, std::size_t) noexcept
+{
+	std::free(ptr);
+}
+
+namespace rttb
+{
+	namespace testing
+	{
+		typedef rttb::interpolation::SimpleMappableDoseAccessor SimpleMappableDoseAccessor;
+		typedef rttb::interpolation::TransformationInterface TransformationInterface;
+		typedef rttb::interpolation::LinearInterpolation LinearInterpolation;
+		typedef rttb::interpolation::NearestNeighborInterpolation NearestNeighborInterpolation;
+
+		/*! Maps every voxel of the accessor and returns the number of heap allocations done meanwhile.*/
+		std::size_t mapAllVoxels(const core::AccessorInterface& accessor, DoseTypeGy& doseSum)
+		{
+			const auto numberOfVoxels = accessor.getGridSize();
+			const auto allocationsBefore = numberOfAllocations.load();
+
+			for (VoxelGridID id = 0; id < numberOfVoxels; ++id)
+			{
+				doseSum += accessor.getValueAt(id);
+			}
+
+			return numberOfAllocations.load() - allocationsBefore;
+		}
+
+		/*! @brief MappingAllocationTest - test that the mapping inner loop does not allocate
+			Maps a dose with an identity transformation and counts the heap allocations.
+			The coordinate types, the geometric conversions and the interpolation neighborhood are fixed-size
+			value types, so the inner loop must not allocate at all.
+			1) test that allocations are counted
+			2) linear interpolation
+			3) nearest neighbor interpolation
+		*/
+		int MappingAllocationTest(int /*argc*/, char* /*argv*/[])
+		{
+			PREPARE_DEFAULT_TEST_REPORTING;
+
+			auto dose = boost::make_shared<DummyDoseAccessor>();
+			TransformationInterface::Pointer transformDummy = boost::make_shared<DummyTransformation>();
+
+			SimpleMappableDoseAccessor linearMapped(dose->getGeometricInfo(), dose, transformDummy,
+			                                        boost::make_shared<LinearInterpolation>());
+			SimpleMappableDoseAccessor nnMapped(dose->getGeometricInfo(), dose, transformDummy,
+			                                    boost::make_shared<NearestNeighborInterpolation>());
+
+			DoseTypeGy doseSum = 0;
+
+			//1) test that allocations are counted
+			const auto allocationsBefore = numberOfAllocations.load();
+			auto allocated = std::make_unique<DoseTypeGy>(1);
+			//the check macros allocate themselves, so the counts are taken before
+			std::size_t numberOfCountedAllocations = numberOfAllocations.load() - allocationsBefore;
+			CHECK_EQUAL(numberOfCountedAllocations, 1);
+			doseSum += *allocated;
+
+			//2) linear interpolation
+			numberOfCountedAllocations = mapAllVoxels(linearMapped, doseSum);
+			CHECK_EQUAL(numberOfCountedAllocations, 0);
+
+			//3) nearest neighbor interpolation
+			numberOfCountedAllocations = mapAllVoxels(nnMapped, doseSum);
+			CHECK_EQUAL(numberOfCountedAllocations, 0);
+
+			CHECK(doseSum > 0);
+
+			RETURN_AND_REPORT_TEST_SUCCESS;
+		}
+
+	}//end namespace testing
+}//end namespace rttb
@@ -0,0 +1,9 @@
+SET(CPP_FILES
+	MappingAllocationTest.cpp
+	../DummyTransformation.cpp
+	rttbInterpolationMappingAllocationTests.cpp
+   )
+
+SET(H_FILES
+	../DummyTransformation.h
+   )
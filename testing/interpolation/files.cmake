@@ -2,6 +2,7 @@ SET(CPP_FILES
 	SimpleMappableDoseAccessorTest.cpp
 	RosuMappableDoseAccessorTest.cpp
 	InterpolationTest.cpp
+	ConcurrentMappingTest.cpp
 	DummyTransformation.cpp
 	rttbInterpolationTests.cpp
    )
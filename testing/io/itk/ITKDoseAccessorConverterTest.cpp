@@ -31,6 +31,9 @@
 #include "rttbDicomFileDoseAccessorGenerator.h"
 #include "rttbDicomDoseAccessor.h"
 #include "rttbITKImageAccessorConverter.h"
+#include "rttbITKImageAccessor.h"
+#include "rttbITKDenseDoseAccessorConversion.h"
+#include "rttbDenseDoseAccessor.h"
 #include "rttbITKImageFileAccessorGenerator.h"
 #include "rttbDoseAccessorProcessorBase.h"
 #include "rttbDoseAccessorConversionSettingInterface.h"
@@ -45,6 +48,7 @@ namespace rttb
 		/*!@brief ITKDoseAccessorConverterTest - test the conversion rttb dose accessor ->itk
 		1) test with dicom file (DicomDoseAccessorGenerator)
 		2) test with mhd file (ITKImageFileDoseAccessorGenerator)
+		3) test zero-copy conversion ITKImageAccessor <-> DenseDoseAccessor
 		*/
 
 		int ITKDoseAccessorConverterTest(int argc, char* argv[])
@@ -119,6 +123,31 @@ namespace rttb
 
 			CHECK_TESTER(tester);
 
+			//3) test zero-copy conversion ITKImageAccessor <-> DenseDoseAccessor
+			boost::shared_ptr<io::itk::ITKImageAccessor> itkAccessor =
+			    boost::dynamic_pointer_cast<io::itk::ITKImageAccessor>(doseAccessor2);
+			CHECK(itkAccessor != nullptr);
+
+			core::DenseDoseAccessor::Pointer denseAccessor = io::itk::convertToDenseDoseAccessor(*itkAccessor);
+			CHECK_EQUAL(denseAccessor->data(), itkAccessor->getITKImage()->GetBufferPointer());
+			CHECK(denseAccessor->getGeometricInfo() == itkAccessor->getGeometricInfo());
+			CHECK_EQUAL(denseAccessor->getUID(), itkAccessor->getUID());
+
+			rttbIndex = VoxelGridIndex3D(itkAccessor->getGeometricInfo().getNumColumns() / 2,
+			                             itkAccessor->getGeometricInfo().getNumRows() / 2, 0);
+			CHECK_EQUAL(denseAccessor->getValueAt(rttbIndex), itkAccessor->getValueAt(rttbIndex));
+
+			boost::shared_ptr<io::itk::ITKImageAccessor> itkAccessor2 = io::itk::convertToITKImageAccessor(
+			            *denseAccessor);
+			CHECK_EQUAL(itkAccessor2->getITKImage()->GetBufferPointer(), denseAccessor->data());
+			CHECK(itkAccessor2->getGeometricInfo() == denseAccessor->getGeometricInfo());
+			CHECK_EQUAL(itkAccessor2->getValueAt(rttbIndex), itkAccessor->getValueAt(rttbIndex));
+
+			//the itk image keeps the buffer alive
+			const GenericValueType expectedValue = denseAccessor->getValueAt(rttbIndex);
+			denseAccessor.reset();
+			CHECK_EQUAL(itkAccessor2->getValueAt(rttbIndex), expectedValue);
+
 			RETURN_AND_REPORT_TEST_SUCCESS;
 		}
 
@@ -0,0 +1,182 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+
+#include <boost/make_shared.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include "litCheckMacros.h"
+
+#include "rttbBaseType.h"
+
+#include "DummyStructure.h"
+#include "DummyPolygon.h"
+#include "DummyDoseAccessor.h"
+#include "rttbBoostMask.h"
+#include "rttbBoostMaskBoundaryClassifier.h"
+
+namespace rttb
+{
+	namespace testing
+	{
+		using Classifier = masks::boost::BoostMaskBoundaryClassifier;
+
+		bool isBoundaryPixel(const Classifier::PixelIndexVector& aBoundaryPixels, unsigned int aRow,
+		                     unsigned int aColumn)
+		{
+			return std::find(aBoundaryPixels.begin(), aBoundaryPixels.end(),
+			                 Classifier::PixelIndex(aRow, aColumn)) != aBoundaryPixels.end();
+		}
+
+		/*! @brief BoostMaskBoundaryClassifierTest.
+			1) test classify with a square and a donut
+			2) test classify with several polygons and polygons outside of the region
+			3) test the boundary engine of BoostMask against the boost::geometry engine
+		*/
+		int BoostMaskBoundaryClassifierTest(int argc, char* argv[])
+		{
+			PREPARE_DEFAULT_TEST_REPORTING;
+
+			const VoxelGridIndex3D minIndex(2, 3, 0);
+			Classifier::BoostArray2D coverage(::boost::extents[8][8]);
+			Classifier::PixelIndexVector boundaryPixels;
+
+			//1) test classify with a square and a donut
+			//pixel (2,3) covers [1.5,2.5]x[2.5,3.5]: the square covers the pixels [1..5]x[1..5], the outer ones partially
+			Classifier::BoostPolygonVector polygons;
+			polygons.push_back(DummyPolygon::createSquare(2.75, 3.75, 4, false));
+			CHECK_NO_THROW(Classifier::classify(polygons, minIndex, coverage, boundaryPixels));
+			CHECK_EQUAL(16, boundaryPixels.size());
+			CHECK(isBoundaryPixel(boundaryPixels, 1, 1));
+			CHECK(isBoundaryPixel(boundaryPixels, 5, 2));
+			CHECK(!isBoundaryPixel(boundaryPixels, 2, 2));
+			CHECK(!isBoundaryPixel(boundaryPixels, 4, 4));
+			CHECK(!isBoundaryPixel(boundaryPixels, 0, 0));
+			CHECK_EQUAL(1, coverage[2][2]);
+			CHECK_EQUAL(1, coverage[3][3]);
+			CHECK_EQUAL(1, coverage[4][4]);
+			CHECK_EQUAL(0, coverage[1][1]);
+			CHECK_EQUAL(0, coverage[0][0]);
+			CHECK_EQUAL(0, coverage[6][6]);
+
+			Classifier::BoostArray2D coverageClockwise(::boost::extents[8][8]);
+			Classifier::PixelIndexVector boundaryPixelsClockwise;
+			polygons.clear();
+			polygons.push_back(DummyPolygon::createSquare(2.75, 3.75, 4, true));
+			Classifier::classify(polygons, minIndex, coverageClockwise, boundaryPixelsClockwise);
+			CHECK(coverage == coverageClockwise);
+			CHECK(boundaryPixels == boundaryPixelsClockwise);
+
+			//donut with edges on the pixel borders
+			Classifier::BoostPolygon2D donut = DummyPolygon::createSquare(1.5, 2.5, 6, false);
+			donut.inners().push_back(DummyPolygon::createSquare(3.5, 4.5, 2, false).outer());
+			polygons.clear();
+			polygons.push_back(donut);
+			Classifier::classify(polygons, minIndex, coverage, boundaryPixels);
+			CHECK_EQUAL(1, coverage[1][1]);
+			CHECK_EQUAL(1, coverage[1][5]);
+			CHECK_EQUAL(1, coverage[5][5]);
+			CHECK_EQUAL(0, coverage[3][3]);
+			CHECK_EQUAL(0, coverage[7][7]);
+
+			for (const auto& pixel : boundaryPixels)
+			{
+				CHECK_EQUAL(0, coverage[pixel.first][pixel.second]);
+			}
+
+			//2) test classify with several polygons and polygons outside of the region
+			polygons.clear();
+			polygons.push_back(DummyPolygon::createSquare(1.75, 2.75, 4.5, false));
+			polygons.push_back(DummyPolygon::createSquare(2.25, 3.25, 1.5, true));
+			polygons.push_back(DummyPolygon::createSquare(-10, -10, 12.2, false));
+			polygons.push_back(DummyPolygon::createSquare(20, 20, 10, false));
+			Classifier::classify(polygons, minIndex, coverage, boundaryPixels);
+			CHECK_EQUAL(2, coverage[1][1]);
+			CHECK_EQUAL(1, coverage[1][3]);
+			CHECK_EQUAL(1, coverage[3][3]);
+			CHECK_EQUAL(0, coverage[2][2]);
+			CHECK(isBoundaryPixel(boundaryPixels, 2, 2));
+			CHECK_EQUAL(0, coverage[6][6]);
+			CHECK(isBoundaryPixel(boundaryPixels, 0, 0));
+			CHECK(!isBoundaryPixel(boundaryPixels, 7, 7));
+
+			polygons.clear();
+			Classifier::classify(polygons, minIndex, coverage, boundaryPixels);
+			CHECK(boundaryPixels.empty());
+			CHECK_EQUAL(0, coverage[0][0]);
+
+			//3) test the boundary engine of BoostMask against the boost::geometry engine
+			boost::shared_ptr<DummyDoseAccessor> spTestDoseAccessor = boost::make_shared<DummyDoseAccessor>();
+			boost::shared_ptr<core::GeometricInfo> geometricPtr = boost::make_shared<core::GeometricInfo>
+			        (spTestDoseAccessor->getGeometricInfo());
+			DummyStructure myStructGenerator(spTestDoseAccessor->getGeometricInfo());
+
+			std::vector<core::Structure> structures;
+			structures.push_back(myStructGenerator.CreateRectangularStructureCentered(2, 3));
+			structures.push_back(myStructGenerator.CreateRectangularStructureCentered(2, 3, 6, 7));
+			structures.push_back(
+			    myStructGenerator.CreateRectangularStructureCenteredContourPlaneThicknessNotEqualDosePlaneThickness(2));
+			structures.push_back(myStructGenerator.CreateRectangularStructureUpperLeftRotated(2));
+			structures.push_back(myStructGenerator.CreateTestStructureSeveralSeperateSectionsInsideOneVoxel(2));
+			structures.push_back(myStructGenerator.CreateRectangularStructureCenteredRotatedIntermediatePlacement(2));
+			structures.push_back(myStructGenerator.CreateTestStructureSelfTouchingA(2));
+			structures.push_back(myStructGenerator.CreateTestStructureInsideInsideTouches(2));
+			structures.push_back(myStructGenerator.CreateTestStructureInsideInsideTouchesRotatedQuaterPi(2));
+
+			for (const auto& structure : structures)
+			{
+				auto spStructure = boost::make_shared<core::Structure>(structure);
+
+				for (bool strict : { true, false })
+				{
+					masks::boost::BoostMask boostGeometryMask(geometricPtr, spStructure, strict, 1,
+					        masks::boost::BoostMask::VoxelizationEngine::BoostGeometry);
+					masks::boost::BoostMask boundaryMask(geometricPtr, spStructure, strict, 1,
+					                                     masks::boost::BoostMask::VoxelizationEngine::BoostGeometryBoundary);
+
+					std::map<VoxelGridID, FractionType> expectedFractions;
+
+					for (const auto& voxel : *(boostGeometryMask.getRelevantVoxelVector()))
+					{
+						expectedFractions[voxel.getVoxelGridID()] = voxel.getRelevantVolumeFraction();
+					}
+
+					auto boundaryVoxels = boundaryMask.getRelevantVoxelVector();
+					CHECK_EQUAL(expectedFractions.size(), boundaryVoxels->size());
+
+					unsigned int mismatches = 0;
+
+					for (const auto& voxel : *boundaryVoxels)
+					{
+						const auto expected = expectedFractions.find(voxel.getVoxelGridID());
+
+						if (expected == expectedFractions.end()
+						    || std::abs(expected->second - voxel.getRelevantVolumeFraction()) > errorConstant)
+						{
+							++mismatches;
+						}
+					}
+
+					CHECK_EQUAL(mismatches, 0);
+				}
+			}
+
+			RETURN_AND_REPORT_TEST_SUCCESS;
+		}
+	}//testing
+}//rttb
@@ -0,0 +1,205 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+#define _USE_MATH_DEFINES
+
+#include <cmath>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <boost/make_shared.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include "litCheckMacros.h"
+
+#include "rttbBaseType.h"
+#include "rttbStructureSet.h"
+
+#include "DummyDoseAccessor.h"
+#include "rttbBoostMask.h"
+#include "rttbDicomFileDoseAccessorGenerator.h"
+#include "rttbDicomFileStructureSetGenerator.h"
+
+namespace rttb
+{
+	namespace testing
+	{
+		namespace
+		{
+			using Engine = masks::boost::BoostMask::VoxelizationEngine;
+
+			/*! @brief star-shaped polygon around (centerX, centerY) on the given slice (all in continuous index
+				coordinates). Every angle between two neighbouring points is smaller than pi, so the polygon is simple.*/
+			PolygonType createRandomStarPolygon(const core::GeometricInfo& aGeoInfo, std::mt19937& aGenerator,
+			                                    double centerX, double centerY, double maxRadius, double slice)
+			{
+				std::uniform_int_distribution<int> numberOfPointsDistribution(4, 40);
+				std::uniform_real_distribution<double> angleDistribution(0, 1);
+				std::uniform_real_distribution<double> radiusDistribution(0.2 * maxRadius, maxRadius);
+
+				const int numberOfPoints = numberOfPointsDistribution(aGenerator);
+				PolygonType polygon;
+
+				for (int i = 0; i < numberOfPoints; ++i)
+				{
+					//one point per sector of 2*pi/numberOfPoints
+					const double angle = 2 * M_PI * (i + angleDistribution(aGenerator)) / numberOfPoints;
+					const double radius = radiusDistribution(aGenerator);
+					WorldCoordinate3D worldCoordinate;
+					aGeoInfo.continuousIndexToWorldCoordinate(ContinuousVoxelGridIndex3D(centerX + radius * std::cos(angle),
+					        centerY + radius * std::sin(angle), slice), worldCoordinate);
+					polygon.push_back(worldCoordinate);
+				}
+
+				return polygon;
+			}
+
+			/*! @brief number of voxels whose volume fractions of the BoostGeometry engine and of anEngine differ by more
+				than errorConstant (a voxel that is missing in one mask counts with the fraction 0).*/
+			unsigned int countMismatches(core::GeometricInfo::Pointer aGeoInfo, core::Structure::Pointer aStructure,
+			                             bool strict, Engine anEngine)
+			{
+				masks::boost::BoostMask boostGeometryMask(aGeoInfo, aStructure, strict, 1, Engine::BoostGeometry);
+				masks::boost::BoostMask otherMask(aGeoInfo, aStructure, strict, 1, anEngine);
+
+				std::map<VoxelGridID, std::pair<FractionType, FractionType> > fractions;
+
+				for (const auto& voxel : *(boostGeometryMask.getRelevantVoxelVector()))
+				{
+					fractions[voxel.getVoxelGridID()].first = voxel.getRelevantVolumeFraction();
+				}
+
+				for (const auto& voxel : *(otherMask.getRelevantVoxelVector()))
+				{
+					fractions[voxel.getVoxelGridID()].second = voxel.getRelevantVolumeFraction();
+				}
+
+				unsigned int mismatches = 0;
+
+				for (const auto& fraction : fractions)
+				{
+					if (std::abs(fraction.second.first - fraction.second.second) > errorConstant)
+					{
+						++mismatches;
+					}
+				}
+
+				return mismatches;
+			}
+		}
+
+		/*! @brief BoostMaskEngineComparisonTest - regression test of the Scanline and BoostGeometryBoundary engines
+			against the BoostGeometry engine of BoostMask (the default).
+			1) test random star-shaped polygons, one or two per contour plane, partially outside of the dose grid
+			2) test the structures of a real RTSTRUCT (if a structure set and a dose file are given)
+		*/
+		int BoostMaskEngineComparisonTest(int argc, char* argv[])
+		{
+			PREPARE_DEFAULT_TEST_REPORTING;
+
+			std::string structFilename;
+			std::string doseFilename;
+
+			if (argc > 2)
+			{
+				structFilename = argv[1];
+				doseFilename = argv[2];
+			}
+
+			const std::vector<Engine> engines = { Engine::Scanline, Engine::BoostGeometryBoundary };
+
+			//1) test random star-shaped polygons
+			boost::shared_ptr<DummyDoseAccessor> spTestDoseAccessor = boost::make_shared<DummyDoseAccessor>();
+			auto spGeoInfo = boost::make_shared<core::GeometricInfo>(spTestDoseAccessor->getGeometricInfo());
+
+			//fixed seed, so that a failure can be reproduced
+			std::mt19937 generator(20241017);
+			std::uniform_real_distribution<double> centerDistribution(1, 7);
+			std::uniform_real_distribution<double> radiusDistribution(0.5, 3.5);
+			std::uniform_int_distribution<int> sliceDistribution(1, 7);
+
+			unsigned int randomMismatches = 0;
+			unsigned int numberOfRandomVoxels = 0;
+
+			for (int i = 0; i < 60; ++i)
+			{
+				PolygonSequenceType polygons;
+				const int firstSlice = sliceDistribution(generator);
+
+				for (int slice = firstSlice; slice < firstSlice + 2; ++slice)
+				{
+					const double centerX = centerDistribution(generator);
+					const double centerY = centerDistribution(generator);
+
+					if (i % 2 == 0)
+					{
+						polygons.push_back(createRandomStarPolygon(*spGeoInfo, generator, centerX, centerY,
+						                   radiusDistribution(generator), slice));
+					}
+					else
+					{
+						//two disjoint polygons left and right of centerX
+						polygons.push_back(createRandomStarPolygon(*spGeoInfo, generator, centerX - 2.5, centerY, 2.4, slice));
+						polygons.push_back(createRandomStarPolygon(*spGeoInfo, generator, centerX + 2.5, centerY, 2.4, slice));
+					}
+				}
+
+				auto spStructure = boost::make_shared<core::Structure>(polygons);
+				masks::boost::BoostMask boostGeometryMask(spGeoInfo, spStructure, false, 1, Engine::BoostGeometry);
+				numberOfRandomVoxels += static_cast<unsigned int>(boostGeometryMask.getRelevantVoxelVector()->size());
+
+				for (const auto engine : engines)
+				{
+					for (bool strict : { true, false })
+					{
+						randomMismatches += countMismatches(spGeoInfo, spStructure, strict, engine);
+					}
+				}
+			}
+
+			CHECK(numberOfRandomVoxels > 0);
+			CHECK_EQUAL(randomMismatches, 0);
+
+			//2) test the structures of a real RTSTRUCT
+			if (!structFilename.empty() && !doseFilename.empty())
+			{
+				io::dicom::DicomFileDoseAccessorGenerator doseAccessorGenerator(doseFilename.c_str());
+				core::DoseAccessorInterface::Pointer spDoseAccessor(doseAccessorGenerator.generateDoseAccessor());
+				auto spDoseGeoInfo = boost::make_shared<core::GeometricInfo>(spDoseAccessor->getGeometricInfo());
+
+				io::dicom::DicomFileStructureSetGenerator structureSetGenerator(structFilename.c_str());
+				core::StructureSet::Pointer spStructureSet = structureSetGenerator.generateStructureSet();
+				CHECK(spStructureSet->getNumberOfStructures() > 0);
+
+				for (size_t i = 0; i < spStructureSet->getNumberOfStructures(); ++i)
+				{
+					unsigned int mismatches = 0;
+
+					for (const auto engine : engines)
+					{
+						//clinical contours may have self intersections, so only the non-strict mode is compared
+						mismatches += countMismatches(spDoseGeoInfo, spStructureSet->getStructure(i), false, engine);
+					}
+
+					CHECK_EQUAL(mismatches, 0);
+				}
+			}
+
+			RETURN_AND_REPORT_TEST_SUCCESS;
+		}
+	}//testing
+}//rttb
@@ -0,0 +1,237 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+#include <cmath>
+#include <map>
+
+#include <boost/make_shared.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include "litCheckMacros.h"
+
+#include "rttbBaseType.h"
+#include "rttbInvalidParameterException.h"
+
+#include "DummyStructure.h"
+#include "DummyPolygon.h"
+#include "DummyDoseAccessor.h"
+#include "rttbBoostMask.h"
+#include "rttbBoostMaskScanlineRasterizer.h"
+
+namespace rttb
+{
+	namespace testing
+	{
+		using Rasterizer = masks::boost::BoostMaskScanlineRasterizer;
+
+		double sumCoverage(const Rasterizer::BoostArray2D& aCoverage)
+		{
+			double sum = 0;
+
+			for (std::size_t i = 0; i < aCoverage.num_elements(); ++i)
+			{
+				sum += aCoverage.data()[i];
+			}
+
+			return sum;
+		}
+
+		/*! @brief BoostMaskScanlineRasterizerTest.
+			1) test calcCoverage with rectangles, triangles and orientations
+			2) test calcCoverage with donuts, several polygons and polygons outside of the region
+			3) test calcCoverage with a self-intersecting ring
+			4) test the scanline engine of BoostMask against the boost::geometry engine
+			5) test the strict mode of the scanline engine with a self-intersecting structure
+		*/
+		int BoostMaskScanlineRasterizerTest(int argc, char* argv[])
+		{
+			PREPARE_DEFAULT_TEST_REPORTING;
+
+			const double errorConstantRasterizer = 1e-10;
+			const VoxelGridIndex3D minIndex(2, 3, 0);
+			Rasterizer::BoostArray2D coverage(::boost::extents[6][5]);
+
+			//1) test calcCoverage with rectangles, triangles and orientations
+			//pixel (2,3) covers [1.5,2.5]x[2.5,3.5]
+			Rasterizer::BoostPolygonVector polygons;
+			polygons.push_back(DummyPolygon::createRectangle(2, 3, 4.25, 5, false));
+			CHECK_NO_THROW(Rasterizer::calcCoverage(polygons, minIndex, coverage));
+			CHECK_CLOSE(0.25, coverage[0][0], errorConstantRasterizer);
+			CHECK_CLOSE(0.5, coverage[0][1], errorConstantRasterizer);
+			CHECK_CLOSE(0.5, coverage[1][0], errorConstantRasterizer);
+			CHECK_CLOSE(1, coverage[1][1], errorConstantRasterizer);
+			CHECK_CLOSE(0.75, coverage[2][1], errorConstantRasterizer);
+			CHECK_CLOSE(0.375, coverage[2][2], errorConstantRasterizer);
+			CHECK_EQUAL(0, coverage[3][1]);
+			CHECK_EQUAL(0, coverage[1][3]);
+			CHECK_CLOSE(4.5, sumCoverage(coverage), errorConstantRasterizer);
+
+			Rasterizer::BoostArray2D coverageClockwise(::boost::extents[6][5]);
+			polygons.clear();
+			polygons.push_back(DummyPolygon::createRectangle(2, 3, 4.25, 5, true));
+			Rasterizer::calcCoverage(polygons, minIndex, coverageClockwise);
+			CHECK(coverage == coverageClockwise);
+
+			//triangle with the corners in pixel centers: the diagonal halves the pixels
+			Rasterizer::BoostPolygon2D triangle;
+			triangle.outer().push_back(Rasterizer::BoostPoint2D(2.5, 3.5));
+			triangle.outer().push_back(Rasterizer::BoostPoint2D(4.5, 3.5));
+			triangle.outer().push_back(Rasterizer::BoostPoint2D(4.5, 5.5));
+			triangle.outer().push_back(Rasterizer::BoostPoint2D(2.5, 3.5));
+			polygons.clear();
+			polygons.push_back(triangle);
+			Rasterizer::calcCoverage(polygons, minIndex, coverage);
+			CHECK_CLOSE(0.5, coverage[1][1], errorConstantRasterizer);
+			CHECK_CLOSE(1, coverage[2][1], errorConstantRasterizer);
+			CHECK_CLOSE(0.5, coverage[2][2], errorConstantRasterizer);
+			CHECK_EQUAL(0, coverage[1][2]);
+			CHECK_CLOSE(2, sumCoverage(coverage), errorConstantRasterizer);
+
+			//2) test calcCoverage with donuts, several polygons and polygons outside of the region
+			Rasterizer::BoostPolygon2D donut = DummyPolygon::createRectangle(1.5, 2.5, 5.5, 6.5, false);
+			donut.inners().push_back(DummyPolygon::createRectangle(2.5, 3.5, 4.5, 5.5, false).outer());
+			polygons.clear();
+			polygons.push_back(donut);
+			Rasterizer::calcCoverage(polygons, minIndex, coverage);
+			CHECK_CLOSE(1, coverage[0][0], errorConstantRasterizer);
+			CHECK_EQUAL(0, coverage[1][1]);
+			CHECK_EQUAL(0, coverage[2][2]);
+			CHECK_CLOSE(1, coverage[3][3], errorConstantRasterizer);
+			CHECK_CLOSE(12, sumCoverage(coverage), errorConstantRasterizer);
+
+			//overlapping polygons add up like the intersection areas of the boost engine
+			polygons.clear();
+			polygons.push_back(DummyPolygon::createRectangle(1.5, 2.5, 3.5, 4.5, false));
+			polygons.push_back(DummyPolygon::createRectangle(2.5, 3.5, 3.5, 4.5, true));
+			Rasterizer::calcCoverage(polygons, minIndex, coverage);
+			CHECK_CLOSE(1, coverage[0][0], errorConstantRasterizer);
+			CHECK_CLOSE(2, coverage[1][1], errorConstantRasterizer);
+			CHECK_CLOSE(5, sumCoverage(coverage), errorConstantRasterizer);
+
+			//only the part inside of the region is rasterized
+			polygons.clear();
+			polygons.push_back(DummyPolygon::createRectangle(-10, -10, 2, 3.75, false));
+			polygons.push_back(DummyPolygon::createRectangle(6, 6, 20, 20, false));
+			Rasterizer::calcCoverage(polygons, minIndex, coverage);
+			CHECK_CLOSE(0.5, coverage[0][0], errorConstantRasterizer);
+			CHECK_CLOSE(0.125, coverage[0][1], errorConstantRasterizer);
+			CHECK_EQUAL(0, coverage[1][0]);
+			CHECK_CLOSE(0.25, coverage[4][3], errorConstantRasterizer);
+			CHECK_CLOSE(1, coverage[5][4], errorConstantRasterizer);
+			CHECK_CLOSE(2.875, sumCoverage(coverage), errorConstantRasterizer);
+
+			polygons.clear();
+			Rasterizer::calcCoverage(polygons, minIndex, coverage);
+			CHECK_EQUAL(0, sumCoverage(coverage));
+
+			//3) test calcCoverage with a self-intersecting ring (bow tie): each pixel is covered at most once
+			Rasterizer::BoostPolygon2D bowTie;
+			bowTie.outer().push_back(Rasterizer::BoostPoint2D(1.5, 2.5));
+			bowTie.outer().push_back(Rasterizer::BoostPoint2D(5.5, 6.5));
+			bowTie.outer().push_back(Rasterizer::BoostPoint2D(5.5, 2.5));
+			bowTie.outer().push_back(Rasterizer::BoostPoint2D(1.5, 6.5));
+			bowTie.outer().push_back(Rasterizer::BoostPoint2D(1.5, 2.5));
+			polygons.clear();
+			polygons.push_back(bowTie);
+			Rasterizer::calcCoverage(polygons, minIndex, coverage);
+			CHECK_CLOSE(0.5, coverage[0][0], errorConstantRasterizer);
+			CHECK_CLOSE(1, coverage[0][2], errorConstantRasterizer);
+			CHECK_CLOSE(1, coverage[3][1], errorConstantRasterizer);
+			CHECK_EQUAL(0, coverage[2][0]);
+			CHECK_CLOSE(8, sumCoverage(coverage), errorConstantRasterizer);
+
+			//ring that winds twice around the same square: the coverage is only limited to 1 if not strict
+			Rasterizer::BoostPolygon2D twiceWound = DummyPolygon::createRectangle(2.5, 3.5, 4.5, 5.5, false);
+			const Rasterizer::BoostPolygon2D::ring_type secondLoop = twiceWound.outer();
+			twiceWound.outer().insert(twiceWound.outer().end(), secondLoop.begin() + 1, secondLoop.end());
+			polygons.clear();
+			polygons.push_back(twiceWound);
+			Rasterizer::calcCoverage(polygons, minIndex, coverage);
+			CHECK_CLOSE(1, coverage[1][1], errorConstantRasterizer);
+			CHECK_CLOSE(4, sumCoverage(coverage), errorConstantRasterizer);
+			Rasterizer::calcCoverage(polygons, minIndex, coverage, true);
+			CHECK_CLOSE(2, coverage[1][1], errorConstantRasterizer);
+			CHECK_CLOSE(8, sumCoverage(coverage), errorConstantRasterizer);
+
+			//4) test the scanline engine of BoostMask against the boost::geometry engine
+			boost::shared_ptr<DummyDoseAccessor> spTestDoseAccessor = boost::make_shared<DummyDoseAccessor>();
+			boost::shared_ptr<core::GeometricInfo> geometricPtr = boost::make_shared<core::GeometricInfo>
+			        (spTestDoseAccessor->getGeometricInfo());
+			DummyStructure myStructGenerator(spTestDoseAccessor->getGeometricInfo());
+
+			std::vector<core::Structure> structures;
+			structures.push_back(myStructGenerator.CreateRectangularStructureCentered(2, 3));
+			structures.push_back(myStructGenerator.CreateRectangularStructureCentered(2, 3, 6, 7));
+			structures.push_back(
+			    myStructGenerator.CreateRectangularStructureCenteredContourPlaneThicknessNotEqualDosePlaneThickness(2));
+			structures.push_back(myStructGenerator.CreateRectangularStructureUpperLeftRotated(2));
+			structures.push_back(myStructGenerator.CreateTestStructureSeveralSeperateSectionsInsideOneVoxel(2));
+			structures.push_back(myStructGenerator.CreateRectangularStructureCenteredRotatedIntermediatePlacement(2));
+			structures.push_back(myStructGenerator.CreateTestStructureSelfTouchingA(2));
+			structures.push_back(myStructGenerator.CreateTestStructureInsideInsideTouches(2));
+			structures.push_back(myStructGenerator.CreateTestStructureInsideInsideTouchesRotatedQuaterPi(2));
+
+			for (const auto& structure : structures)
+			{
+				auto spStructure = boost::make_shared<core::Structure>(structure);
+
+				for (bool strict : { true, false })
+				{
+					masks::boost::BoostMask boostGeometryMask(geometricPtr, spStructure, strict, 1,
+					        masks::boost::BoostMask::VoxelizationEngine::BoostGeometry);
+					masks::boost::BoostMask scanlineMask(geometricPtr, spStructure, strict, 1,
+					                                     masks::boost::BoostMask::VoxelizationEngine::Scanline);
+
+					std::map<VoxelGridID, FractionType> expectedFractions;
+
+					for (const auto& voxel : *(boostGeometryMask.getRelevantVoxelVector()))
+					{
+						expectedFractions[voxel.getVoxelGridID()] = voxel.getRelevantVolumeFraction();
+					}
+
+					auto scanlineVoxels = scanlineMask.getRelevantVoxelVector();
+					CHECK_EQUAL(expectedFractions.size(), scanlineVoxels->size());
+
+					unsigned int mismatches = 0;
+
+					for (const auto& voxel : *scanlineVoxels)
+					{
+						const auto expected = expectedFractions.find(voxel.getVoxelGridID());
+
+						if (expected == expectedFractions.end()
+						    || std::abs(expected->second - voxel.getRelevantVolumeFraction()) > errorConstant)
+						{
+							++mismatches;
+						}
+					}
+
+					CHECK_EQUAL(mismatches, 0);
+				}
+			}
+
+			//5) test the strict mode of the scanline engine with a self-intersecting structure
+			auto spCircleStructure = boost::make_shared<core::Structure>(myStructGenerator.CreateTestStructureCircle(2));
+			masks::boost::BoostMask strictScanlineMask(geometricPtr, spCircleStructure, true, 1,
+			        masks::boost::BoostMask::VoxelizationEngine::Scanline);
+			CHECK_THROW_EXPLICIT(strictScanlineMask.getRelevantVoxelVector(), core::InvalidParameterException);
+			masks::boost::BoostMask scanlineMask(geometricPtr, spCircleStructure, false, 1,
+			                                     masks::boost::BoostMask::VoxelizationEngine::Scanline);
+			CHECK_NO_THROW(scanlineMask.getRelevantVoxelVector());
+			CHECK(!scanlineMask.getRelevantVoxelVector()->empty());
+
+			RETURN_AND_REPORT_TEST_SUCCESS;
+		}
+	}//testing
+}//rttb
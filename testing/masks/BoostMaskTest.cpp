@@ -13,6 +13,9 @@
 //
 //------------------------------------------------------------------------
 
+#include <algorithm>
+#include <map>
+
 #include <boost/make_shared.hpp>
 #include <boost/shared_ptr.hpp>
 
@@ -42,6 +45,10 @@ namespace rttb
 			1) test constructors
 			2) test getRelevantVoxelVector
 			3) test getMaskAt
+			4) test getMaskAt against the relevant voxel vector for all grid IDs
+			5) test a structure with different contour planes, partially outside of the dose grid
+			6) test that the voxel list does not depend on the number of threads and that errors of the tasks are rethrown
+			7) test the extent of the bounding box: a contour ending in the upper half of a voxel includes this voxel
 		*/
 		int BoostMaskTest(int argc, char* argv[])
 		{
@@ -241,6 +248,117 @@ namespace rttb
 				spTestDoseAccessor->getGeometricInfo(), true);
 			CHECK_NO_THROW(boostMaskAccessor3.getRelevantVoxelVector());
 
+			//4) test getMaskAt against the relevant voxel vector for all grid IDs
+			for (auto accessor : { &boostMaskAccessor, &boostMaskAccessor2, &boostMaskAccessor3 })
+			{
+				auto relevantVoxels = accessor->getRelevantVoxelVector();
+				std::map<VoxelGridID, core::MaskVoxel> expectedVoxels;
+
+				for (const auto& voxel : *relevantVoxels)
+				{
+					expectedVoxels.insert(std::make_pair(voxel.getVoxelGridID(), voxel));
+				}
+
+				unsigned int mismatches = 0;
+
+				for (VoxelGridID id = -1; id <= geometricPtr->getNumberOfVoxels(); ++id)
+				{
+					core::MaskVoxel voxel(0);
+					const bool found = accessor->getMaskAt(id, voxel);
+					const auto expected = expectedVoxels.find(id);
+
+					if (found != (expected != expectedVoxels.end()) || (found && !(voxel == expected->second)))
+					{
+						++mismatches;
+					}
+				}
+
+				CHECK_EQUAL(mismatches, 0);
+			}
+
+			//5) test a structure with different contour planes, partially outside of the dose grid
+			//plane 2 covers the voxels (0..1, 0..1), plane 3 the voxels (1..2, 1..2)
+			PolygonSequenceType planeSequence;
+
+			for (GridIndexType zPlane = 2; zPlane <= 3; ++zPlane)
+			{
+				const double from = (zPlane == 2) ? -3.5 : 0.5;
+				const double to = (zPlane == 2) ? 1.5 : 2.5;
+				PolygonType polygon;
+				polygon.push_back(geometricPtr->continuousIndexToWorldCoordinate(ContinuousVoxelGridIndex3D(from, from, zPlane)));
+				polygon.push_back(geometricPtr->continuousIndexToWorldCoordinate(ContinuousVoxelGridIndex3D(to, from, zPlane)));
+				polygon.push_back(geometricPtr->continuousIndexToWorldCoordinate(ContinuousVoxelGridIndex3D(to, to, zPlane)));
+				polygon.push_back(geometricPtr->continuousIndexToWorldCoordinate(ContinuousVoxelGridIndex3D(from, to, zPlane)));
+				planeSequence.push_back(polygon);
+			}
+
+			StructTypePointer spMyStruct4 = boost::make_shared<core::Structure>(planeSequence);
+			rttb::masks::boost::BoostMaskAccessor boostMaskAccessor4(spMyStruct4,
+			        spTestDoseAccessor->getGeometricInfo(), true);
+			auto relevantVoxels4 = boostMaskAccessor4.getRelevantVoxelVector();
+			CHECK_EQUAL(8, relevantVoxels4->size());
+
+			for (const auto& voxel : *relevantVoxels4)
+			{
+				CHECK(geometricPtr->validID(voxel.getVoxelGridID()));
+				CHECK_CLOSE(1, voxel.getRelevantVolumeFraction(), errorConstantBoostMask);
+			}
+
+			CHECK(boostMaskAccessor4.getMaskAt(VoxelGridIndex3D(0, 0, 2), tmpMV1));
+			CHECK(boostMaskAccessor4.getMaskAt(VoxelGridIndex3D(1, 1, 2), tmpMV1));
+			CHECK(!boostMaskAccessor4.getMaskAt(VoxelGridIndex3D(2, 2, 2), tmpMV1));
+			CHECK(!boostMaskAccessor4.getMaskAt(VoxelGridIndex3D(0, 0, 3), tmpMV1));
+			CHECK(boostMaskAccessor4.getMaskAt(VoxelGridIndex3D(2, 2, 3), tmpMV1));
+			CHECK(!boostMaskAccessor4.getMaskAt(VoxelGridIndex3D(1, 1, 4), tmpMV1));
+
+			//6) test that the voxel list does not depend on the number of threads and that errors of the tasks are rethrown
+			rttb::masks::boost::BoostMask boostMaskSingleThread(geometricPtr, spMyStruct3, true, 1);
+			auto voxelsSingleThread = boostMaskSingleThread.getRelevantVoxelVector();
+
+			for (unsigned int numberOfThreads : { 0u, 3u })
+			{
+				rttb::masks::boost::BoostMask boostMaskThreads(geometricPtr, spMyStruct3, true, numberOfThreads);
+				CHECK(*voxelsSingleThread == *(boostMaskThreads.getRelevantVoxelVector()));
+			}
+
+			//the two polygons overlap, so the volume fractions exceed 1
+			StructTypePointer spIntersectingStruct = boost::make_shared<core::Structure>(
+			            myStructGenerator.CreateTestStructureIntersectingTwoPolygons(2));
+			rttb::masks::boost::BoostMask boostMaskIntersecting(geometricPtr, spIntersectingStruct, true, 3);
+			CHECK_THROW_EXPLICIT(boostMaskIntersecting.getRelevantVoxelVector(), rttb::core::InvalidParameterException);
+
+			//7) test the extent of the bounding box: a contour ending in the upper half of a voxel includes this voxel
+			//x: [0.8, 2.7] covers 0.7 of voxel 1, voxel 2 and 0.2 of voxel 3; y: [1.6, 2.4] covers 0.8 of voxel 2
+			PolygonType edgePolygon;
+			edgePolygon.push_back(geometricPtr->continuousIndexToWorldCoordinate(ContinuousVoxelGridIndex3D(0.8, 1.6, 2)));
+			edgePolygon.push_back(geometricPtr->continuousIndexToWorldCoordinate(ContinuousVoxelGridIndex3D(2.7, 1.6, 2)));
+			edgePolygon.push_back(geometricPtr->continuousIndexToWorldCoordinate(ContinuousVoxelGridIndex3D(2.7, 2.4, 2)));
+			edgePolygon.push_back(geometricPtr->continuousIndexToWorldCoordinate(ContinuousVoxelGridIndex3D(0.8, 2.4, 2)));
+			PolygonSequenceType edgeSequence;
+			edgeSequence.push_back(edgePolygon);
+
+			StructTypePointer spEdgeStruct = boost::make_shared<core::Structure>(edgeSequence);
+			rttb::masks::boost::BoostMask boostMaskEdge(geometricPtr, spEdgeStruct, false);
+			auto edgeVoxels = boostMaskEdge.getRelevantVoxelVector();
+			CHECK_EQUAL(3, edgeVoxels->size());
+			const double expectedFractions[3] = {0.7 * 0.8, 0.8, 0.2 * 0.8};
+
+			for (GridIndexType x = 1; x <= 3; ++x)
+			{
+				VoxelGridID edgeID = 0;
+				geometricPtr->convert(VoxelGridIndex3D(x, 2, 2), edgeID);
+				const auto voxel = std::find_if(edgeVoxels->cbegin(), edgeVoxels->cend(), [edgeID](const core::MaskVoxel& aVoxel)
+				{
+					return aVoxel.getVoxelGridID() == edgeID;
+				});
+				CHECK(voxel != edgeVoxels->cend());
+
+				if (voxel != edgeVoxels->cend())
+				{
+					CHECK_CLOSE(expectedFractions[x - 1], voxel->getRelevantVolumeFraction(), errorConstantBoostMask);
+				}
+			}
+
             RETURN_AND_REPORT_TEST_SUCCESS;
 		}
 	}//testing
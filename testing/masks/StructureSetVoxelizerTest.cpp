@@ -0,0 +1,133 @@
+// -----------------------------------------------------------------------
+// RTToolbox - DKFZ radiotherapy quantitative evaluation library
+//
+// Copyright (c) German Cancer Research Center (DKFZ),
+// Software development for Integrated Diagnostics and Therapy (SIDT).
+// ALL RIGHTS RESERVED.
+// See rttbCopyright.txt or
+// http://www.dkfz.de/en/sidt/projects/rttb/copyright.html
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even
+// the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+// PURPOSE.  See the above copyright notices for more information.
+//
+//------------------------------------------------------------------------
+
+#include <vector>
+
+#include <boost/make_shared.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include "litCheckMacros.h"
+
+#include "rttbBaseType.h"
+
+#include "DummyStructure.h"
+#include "DummyDoseAccessor.h"
+#include "rttbBoostMaskAccessor.h"
+#include "rttbStructureSetVoxelizer.h"
+#include "rttbInvalidParameterException.h"
+#include "rttbNullPointerException.h"
+
+namespace rttb
+{
+	namespace testing
+	{
+		/*! @brief StructureSetVoxelizerTest.
+			1) test constructor
+			2) test voxelize against a BoostMaskAccessor per structure
+			3) test voxelize with structure indices
+			4) test voxelize with a mask consumer
+			5) test exceptions of voxelize
+		*/
+		int StructureSetVoxelizerTest(int argc, char* argv[])
+		{
+			PREPARE_DEFAULT_TEST_REPORTING;
+
+			boost::shared_ptr<DummyDoseAccessor> spTestDoseAccessor = boost::make_shared<DummyDoseAccessor>();
+			const core::GeometricInfo& geoInfo = spTestDoseAccessor->getGeometricInfo();
+			DummyStructure myStructGenerator(geoInfo);
+
+			std::vector<core::Structure::Pointer> structures;
+			structures.push_back(boost::make_shared<core::Structure>(myStructGenerator.CreateRectangularStructureCentered(2,
+			                     3)));
+			structures.push_back(boost::make_shared<core::Structure>(myStructGenerator.CreateRectangularStructureCentered(2,
+			                     3, 6, 7)));
+			structures.push_back(boost::make_shared<core::Structure>(myStructGenerator.CreateTestStructureCircle(4)));
+			structures.push_back(boost::make_shared<core::Structure>(
+			                         myStructGenerator.CreateRectangularStructureUpperLeftRotated(2)));
+			structures.push_back(boost::make_shared<core::Structure>(
+			                         myStructGenerator.CreateTestStructureInsideInsideTouches(3)));
+			auto spStructureSet = boost::make_shared<core::StructureSet>(structures);
+
+			//1) test constructor
+			CHECK_NO_THROW(masks::boost::StructureSetVoxelizer(spStructureSet, geoInfo));
+			CHECK_NO_THROW(masks::boost::StructureSetVoxelizer(spStructureSet, geoInfo, false,
+			               masks::boost::BoostMask::VoxelizationEngine::BoostGeometry));
+			CHECK_THROW_EXPLICIT(masks::boost::StructureSetVoxelizer(core::StructureSet::Pointer(), geoInfo),
+			                     core::NullPointerException);
+
+			//2) test voxelize against a BoostMaskAccessor per structure
+			masks::boost::StructureSetVoxelizer voxelizer(spStructureSet, geoInfo, false);
+			masks::boost::StructureSetVoxelizer::MaskAccessorVector masks;
+			CHECK_NO_THROW(masks = voxelizer.voxelize());
+			CHECK_EQUAL(masks.size(), structures.size());
+
+			for (size_t i = 0; i < masks.size() && i < structures.size(); ++i)
+			{
+				masks::boost::BoostMaskAccessor expectedMask(structures[i], geoInfo, false);
+				CHECK(*(expectedMask.getRelevantVoxelVector()) == *(masks[i]->getRelevantVoxelVector()));
+				CHECK(!masks[i]->getRelevantVoxelVector()->empty());
+				CHECK(masks[i]->getGeometricInfo() == geoInfo);
+			}
+
+			//3) test voxelize with structure indices
+			masks::boost::StructureSetVoxelizer::MaskAccessorVector selectedMasks;
+			CHECK_NO_THROW(selectedMasks = voxelizer.voxelize({ 3, 0 }));
+			CHECK_EQUAL(selectedMasks.size(), 2);
+
+			if (selectedMasks.size() == 2)
+			{
+				CHECK(*(selectedMasks[0]->getRelevantVoxelVector()) == *(masks[3]->getRelevantVoxelVector()));
+				CHECK(*(selectedMasks[1]->getRelevantVoxelVector()) == *(masks[0]->getRelevantVoxelVector()));
+			}
+
+			CHECK(voxelizer.voxelize({}).empty());
+
+			//4) test voxelize with a mask consumer
+			std::vector<size_t> consumedPositions;
+			masks::boost::StructureSetVoxelizer::MaskAccessorVector consumedMasks;
+			CHECK_NO_THROW(voxelizer.voxelize({ 3, 0, 2 }, [&](size_t aPosition, core::MaskAccessorInterface::Pointer aMask)
+			{
+				consumedPositions.push_back(aPosition);
+				consumedMasks.push_back(aMask);
+			}));
+			CHECK(consumedPositions == std::vector<size_t>({ 0, 1, 2 }));
+
+			if (consumedMasks.size() == 3)
+			{
+				CHECK(*(consumedMasks[0]->getRelevantVoxelVector()) == *(masks[3]->getRelevantVoxelVector()));
+				CHECK(*(consumedMasks[1]->getRelevantVoxelVector()) == *(masks[0]->getRelevantVoxelVector()));
+				CHECK(*(consumedMasks[2]->getRelevantVoxelVector()) == *(masks[2]->getRelevantVoxelVector()));
+				//the voxelizer keeps no reference to a passed mask
+				CHECK_EQUAL(consumedMasks[0].use_count(), 1);
+			}
+
+			//5) test exceptions of voxelize
+			CHECK_THROW_EXPLICIT(voxelizer.voxelize({ 0, 5 }), core::InvalidParameterException);
+			CHECK_THROW_EXPLICIT(voxelizer.voxelize({ 0, 5 }, [](size_t, core::MaskAccessorInterface::Pointer) {}),
+			                     core::InvalidParameterException);
+
+			//the two polygons overlap, which is an error in strict mode
+			structures.push_back(boost::make_shared<core::Structure>(
+			                         myStructGenerator.CreateTestStructureIntersectingTwoPolygons(2)));
+			auto spStructureSetIntersecting = boost::make_shared<core::StructureSet>(structures);
+			masks::boost::StructureSetVoxelizer strictVoxelizer(spStructureSetIntersecting, geoInfo, true);
+			CHECK_THROW_EXPLICIT(strictVoxelizer.voxelize(), core::InvalidParameterException);
+			masks::boost::StructureSetVoxelizer nonStrictVoxelizer(spStructureSetIntersecting, geoInfo, false);
+			CHECK_EQUAL(nonStrictVoxelizer.voxelize().size(), structures.size());
+
+			RETURN_AND_REPORT_TEST_SUCCESS;
+		}
+	}//testing
+}//rttb
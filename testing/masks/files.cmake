@@ -1,5 +1,9 @@
 SET(CPP_FILES 
 	BoostMaskTest.cpp
+	BoostMaskScanlineRasterizerTest.cpp
+	BoostMaskBoundaryClassifierTest.cpp
+	StructureSetVoxelizerTest.cpp
+	BoostMaskEngineComparisonTest.cpp
 	rttbBoostMaskTests.cpp
 )
 
@@ -29,6 +29,10 @@ namespace rttb
 		void registerTests()
 		{
 			LIT_REGISTER_TEST(BoostMaskTest);
+			LIT_REGISTER_TEST(BoostMaskScanlineRasterizerTest);
+			LIT_REGISTER_TEST(BoostMaskBoundaryClassifierTest);
+			LIT_REGISTER_TEST(StructureSetVoxelizerTest);
+			LIT_REGISTER_TEST(BoostMaskEngineComparisonTest);
 		}
 	}
 }